@@ -1,17 +1,17 @@
-/*
- * @Descripttion: 
- * @version: 
- * @Author: Kevincoooool
- * @Date: 2020-07-19 16:06:37
- * @LastEditors: Kevincoooool
- * @LastEditTime: 2020-07-19 17:03:57
- * @FilePath: \STM32F103C8_HID\CMSIS-DAP\Include\DAP_Common.h
- */
-#ifndef __DAP_COMMON_H__
-#define __DAP_COMMON_H__
-
-
-
-
-
-#endif /* __DAP_CONFIG_H__ */
+/*
+ * @Descripttion: 
+ * @version: 
+ * @Author: Kevincoooool
+ * @Date: 2020-07-19 16:06:37
+ * @LastEditors: Kevincoooool
+ * @LastEditTime: 2020-07-19 17:03:57
+ * @FilePath: \STM32F103C8_HID\CMSIS-DAP\Include\DAP_Common.h
+ */
+#ifndef __DAP_COMMON_H__
+#define __DAP_COMMON_H__
+
+
+
+
+
+#endif /* __DAP_CONFIG_H__ */
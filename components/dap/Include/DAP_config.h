@@ -1,532 +1,658 @@
-/**
- * @file    DAP_config.h
- * @brief
- *
- * DAPLink Interface Firmware
- * Copyright (c) 2009-2021, ARM Limited, All Rights Reserved
- * SPDX-License-Identifier: Apache-2.0
- *
- * Licensed under the Apache License, Version 2.0 (the "License"); you may
- * not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
- * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#ifndef __DAP_CONFIG_H__
-#define __DAP_CONFIG_H__
-
-//**************************************************************************************************
-/**
-\defgroup DAP_Config_Debug_gr CMSIS-DAP Debug Unit Information
-\ingroup DAP_ConfigIO_gr
-@{
-Provides definitions about the hardware and configuration of the Debug Unit.
-
-This information includes:
- - Definition of Cortex-M processor parameters used in CMSIS-DAP Debug Unit.
- - Debug Unit Identification strings (Vendor, Product, Serial Number).
- - Debug Unit communication packet size.
- - Debug Access Port supported modes and settings (JTAG/SWD and SWO).
- - Optional information about a connected Target Device (for Evaluation Boards).
-*/
-
-#include "esp32s3/rom/gpio.h"
-#include "driver/gpio.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-
-#if defined(__GNUC__) && !defined(__STATIC_FORCEINLINE)
-#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
-#endif
-
-#if defined(__GNUC__) && !defined(__STATIC_INLINE)
-#define __STATIC_INLINE static inline
-#endif
-
-/// Processor Clock of the Cortex-M MCU used in the Debug Unit.
-/// This value is used to calculate the SWD/JTAG clock speed.
-#define CPU_CLOCK               240000000U        ///< Specifies the CPU Clock in Hz
-
-/// Number of processor cycles for I/O Port write operations.
-/// This value is used to calculate the SWD/JTAG clock speed that is generated with I/O
-/// Port write operations in the Debug Unit by a Cortex-M MCU. Most Cortex-M processors
-/// require 2 processor cycles for a I/O Port Write operation.  If the Debug Unit uses
-/// a Cortex-M0+ processor with high-speed peripheral I/O only 1 processor cycle might be
-/// required.
-#define IO_PORT_WRITE_CYCLES    1U              ///< I/O Cycles: 2=default, 1=Cortex-M0+ fast I/0
-
-/// Indicate that Serial Wire Debug (SWD) communication mode is available at the Debug Access Port.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#ifndef DAP_SWD
-#define DAP_SWD                 1               ///< SWD Mode:  1 = available, 0 = not available
-#endif
-
-/// Indicate that JTAG communication mode is available at the Debug Port.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#ifndef DAP_JTAG
-#define DAP_JTAG                0               ///< JTAG Mode: 1 = available, 0 = not available.
-#endif
-
-/// Configure maximum number of JTAG devices on the scan chain connected to the Debug Access Port.
-/// This setting impacts the RAM requirements of the Debug Unit. Valid range is 1 .. 255.
-#define DAP_JTAG_DEV_CNT        8               ///< Maximum number of JTAG devices on scan chain
-
-/// Default communication mode on the Debug Access Port.
-/// Used for the command \ref DAP_Connect when Port Default mode is selected.
-#if (DAP_SWD == 1)
-#define DAP_DEFAULT_PORT        1               ///< Default JTAG/SWJ Port Mode: 1 = SWD, 2 = JTAG.
-#elif (DAP_JTAG == 1)
-#define DAP_DEFAULT_PORT        2               ///< Default JTAG/SWJ Port Mode: 1 = SWD, 2 = JTAG.
-#else
-#error Must enable DAP_SWD and/or DAP_JTAG
-#endif
-
-/// Default communication speed on the Debug Access Port for SWD and JTAG mode.
-/// Used to initialize the default SWD/JTAG clock frequency.
-/// The command \ref DAP_SWJ_Clock can be used to overwrite this default setting.
-#define DAP_DEFAULT_SWJ_CLOCK   4000000U         ///< Default SWD/JTAG clock frequency in Hz.
-
-/// Maximum Package Size for Command and Response data.
-/// This configuration settings is used to optimize the communication performance with the
-/// debugger and depends on the USB peripheral. Typical vales are 64 for Full-speed USB HID or WinUSB,
-/// 1024 for High-speed USB HID and 512 for High-speed USB WinUSB.
-#define DAP_PACKET_SIZE         64              ///< Specifies Packet Size in bytes.
-
-/// Maximum Package Buffers for Command and Response data.
-/// This configuration settings is used to optimize the communication performance with the
-/// debugger and depends on the USB peripheral. For devices with limited RAM or USB buffer the
-/// setting can be reduced (valid range is 1 .. 255). Change setting to 4 for High-Speed USB.
-#define DAP_PACKET_COUNT        1              ///< Buffers: 64 = Full-Speed, 4 = High-Speed.
-
-/// Indicate that UART Serial Wire Output (SWO) trace is available.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#define SWO_UART                0               ///< SWO UART:  1 = available, 0 = not available
-
-/// USART Driver instance number for the UART SWO.
-#define SWO_UART_DRIVER         0               ///< USART Driver instance number (Driver_USART#).
-
-/// Maximum SWO UART Baudrate
-#define SWO_UART_MAX_BAUDRATE   10000000U       ///< SWO UART Maximum Baudrate in Hz
-
-/// Indicate that Manchester Serial Wire Output (SWO) trace is available.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#define SWO_MANCHESTER          0               ///< SWO Manchester:  1 = available, 0 = not available.
-
-/// SWO Trace Buffer Size.
-#define SWO_BUFFER_SIZE         8192U           ///< SWO Trace Buffer Size in bytes (must be 2^n).
-
-/// SWO Streaming Trace.
-#define SWO_STREAM              0               ///< SWO Streaming Trace: 1 = available, 0 = not available.
-
-/// Clock frequency of the Test Domain Timer. Timer value is returned with \ref TIMESTAMP_GET.
-#define TIMESTAMP_CLOCK         240000000U      ///< Timestamp clock in Hz (0 = timestamps not supported).
-// DAPLink: disabled because we use DWT for timestamps and M0 doesn't have a DWT.
-
-/// Indicate that UART Communication Port is available.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#define DAP_UART                0               ///< DAP UART:  1 = available, 0 = not available.
-
-/// USART Driver instance number for the UART Communication Port.
-#define DAP_UART_DRIVER         1               ///< USART Driver instance number (Driver_USART#).
-
-/// UART Receive Buffer Size.
-#define DAP_UART_RX_BUFFER_SIZE 1024U           ///< Uart Receive Buffer Size in bytes (must be 2^n).
-
-/// UART Transmit Buffer Size.
-#define DAP_UART_TX_BUFFER_SIZE 1024U           ///< Uart Transmit Buffer Size in bytes (must be 2^n).
-
-/// Indicate that UART Communication via USB COM Port is available.
-/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
-#define DAP_UART_USB_COM_PORT   1               ///< USB COM Port:  1 = available, 0 = not available.
-
-/// Debug Unit is connected to fixed Target Device.
-/// The Debug Unit may be part of an evaluation board and always connected to a fixed
-/// known device. In this case a Device Vendor, Device Name, Board Vendor and Board Name strings
-/// are stored and may be used by the debugger or IDE to configure device parameters.
-#define TARGET_FIXED            0               ///< Target: 1 = known, 0 = unknown;
-
-///@}
-
-//**************************************************************************************************
-/**
-\defgroup DAP_Config_PortIO_gr CMSIS-DAP Hardware I/O Pin Access
-\ingroup DAP_ConfigIO_gr
-@{
-
-Standard I/O Pins of the CMSIS-DAP Hardware Debug Port support standard JTAG mode
-and Serial Wire Debug (SWD) mode. In SWD mode only 2 pins are required to implement the debug
-interface of a device. The following I/O Pins are provided:
-
-JTAG I/O Pin                 | SWD I/O Pin          | CMSIS-DAP Hardware pin mode
----------------------------- | -------------------- | ---------------------------------------------
-TCK: Test Clock              | SWCLK: Clock         | Output Push/Pull
-TMS: Test Mode Select        | SWDIO: Data I/O      | Output Push/Pull; Input (for receiving data)
-TDI: Test Data Input         |                      | Output Push/Pull
-TDO: Test Data Output        |                      | Input
-nTRST: Test Reset (optional) |                      | Output Open Drain with pull-up resistor
-nRESET: Device Reset         | nRESET: Device Reset | Output Open Drain with pull-up resistor
-
-
-DAP Hardware I/O Pin Access Functions
--------------------------------------
-The various I/O Pins are accessed by functions that implement the Read, Write, Set, or Clear to
-these I/O Pins.
-
-For the SWDIO I/O Pin there are additional functions that are called in SWD I/O mode only.
-This functions are provided to achieve faster I/O that is possible with some advanced GPIO
-peripherals that can independently write/read a single I/O pin without affecting any other pins
-of the same I/O port. The following SWDIO I/O Pin functions are provided:
- - \ref PIN_SWDIO_OUT_ENABLE to enable the output mode from the DAP hardware.
- - \ref PIN_SWDIO_OUT_DISABLE to enable the input mode to the DAP hardware.
- - \ref PIN_SWDIO_IN to read from the SWDIO I/O pin with utmost possible speed.
- - \ref PIN_SWDIO_OUT to write to the SWDIO I/O pin with utmost possible speed.
-*/
-
-
-// Configure DAP I/O pins ------------------------------
-#define PIN_SWDIO GPIO_NUM_8
-#define PIN_SWCLK GPIO_NUM_9
-#define PIN_nRESET GPIO_NUM_10
-#define PIN_LED_CONNECTED GPIO_NUM_17
-#define PIN_LED_RUNNING GPIO_NUM_18
-
-/** Setup JTAG I/O pins: TCK, TMS, TDI, TDO, nTRST, and nRESET.
-Configures the DAP Hardware I/O pins for JTAG mode:
- - TCK, TMS, TDI, nTRST, nRESET to output mode and set to high level.
- - TDO to input mode.
-*/
-__STATIC_INLINE void PORT_JTAG_SETUP(void)
-{
-}
-
-/** Setup SWD I/O pins: SWCLK, SWDIO, and nRESET.
-Configures the DAP Hardware I/O pins for Serial Wire Debug (SWD) mode:
- - SWCLK, SWDIO, nRESET to output mode and set to default high level.
- - TDI, TMS, nTRST to HighZ mode (pins are unused in SWD mode).
-*/
-__STATIC_INLINE void PORT_SWD_SETUP(void)
-{
-    gpio_pad_select_gpio(PIN_SWCLK);
-	gpio_set_direction(PIN_SWCLK, GPIO_MODE_INPUT_OUTPUT);
-	gpio_pad_select_gpio(PIN_SWDIO);
-	gpio_set_direction(PIN_SWDIO, GPIO_MODE_INPUT_OUTPUT);
-
-	gpio_set_level(PIN_SWCLK, 1);
-	gpio_set_level(PIN_SWDIO, 1);
-}
-
-/** Disable JTAG/SWD I/O Pins.
-Disables the DAP Hardware I/O pins which configures:
- - TCK/SWCLK, TMS/SWDIO, TDI, TDO, nTRST, nRESET to High-Z mode.
-*/
-__STATIC_INLINE void PORT_OFF(void)
-{
-	gpio_pad_select_gpio(PIN_SWCLK);
-	gpio_set_direction(PIN_SWCLK, GPIO_MODE_INPUT);
-	gpio_set_level(PIN_SWCLK, 0);
-	gpio_pad_select_gpio(PIN_SWDIO);
-	gpio_set_direction(PIN_SWDIO, GPIO_MODE_INPUT);
-	gpio_set_level(PIN_SWDIO, 0);
-}
-
-
-// SWCLK/TCK I/O pin -------------------------------------
-
-/** SWCLK/TCK I/O pin: Get Input.
-\return Current status of the SWCLK/TCK DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_SWCLK_TCK_IN(void)
-{
-    return (uint32_t)gpio_get_level(PIN_SWCLK);
-}
-
-/** SWCLK/TCK I/O pin: Set Output to High.
-Set the SWCLK/TCK DAP hardware I/O pin to high level.
-*/
-__STATIC_FORCEINLINE void     PIN_SWCLK_TCK_SET(void)
-{
-    WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_SWCLK));
-}
-
-/** SWCLK/TCK I/O pin: Set Output to Low.
-Set the SWCLK/TCK DAP hardware I/O pin to low level.
-*/
-__STATIC_FORCEINLINE void     PIN_SWCLK_TCK_CLR(void)
-{
-    WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_SWCLK));
-}
-
-
-// SWDIO/TMS Pin I/O --------------------------------------
-
-/** SWDIO/TMS I/O pin: Get Input.
-\return Current status of the SWDIO/TMS DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_SWDIO_TMS_IN(void)
-{
-    return gpio_get_level(PIN_SWDIO);
-}
-
-/** SWDIO/TMS I/O pin: Set Output to High.
-Set the SWDIO/TMS DAP hardware I/O pin to high level.
-*/
-__STATIC_FORCEINLINE void     PIN_SWDIO_TMS_SET(void)
-{
-    WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_SWDIO));
-}
-
-/** SWDIO/TMS I/O pin: Set Output to Low.
-Set the SWDIO/TMS DAP hardware I/O pin to low level.
-*/
-__STATIC_FORCEINLINE void     PIN_SWDIO_TMS_CLR(void)
-{
-    WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_SWDIO));
-}
-
-/** SWDIO I/O pin: Get Input (used in SWD mode only).
-\return Current status of the SWDIO DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_SWDIO_IN(void)
-{
-    return (uint32_t)gpio_get_level(PIN_SWDIO);
-}
-
-/** SWDIO I/O pin: Set Output (used in SWD mode only).
-\param bit Output value for the SWDIO DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE void     PIN_SWDIO_OUT(uint32_t bit)
-{
-    if ((bit & 1U) == 1)
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_SWDIO));
-	}
-	else
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_SWDIO));
-	}
-}
-
-/** SWDIO I/O pin: Switch to Output mode (used in SWD mode only).
-Configure the SWDIO DAP hardware I/O pin to output mode. This function is
-called prior \ref PIN_SWDIO_OUT function calls.
-*/
-__STATIC_FORCEINLINE void     PIN_SWDIO_OUT_ENABLE(void)
-{
-    gpio_set_direction(PIN_SWDIO, GPIO_MODE_OUTPUT);
-}
-
-/** SWDIO I/O pin: Switch to Input mode (used in SWD mode only).
-Configure the SWDIO DAP hardware I/O pin to input mode. This function is
-called prior \ref PIN_SWDIO_IN function calls.
-*/
-__STATIC_FORCEINLINE void     PIN_SWDIO_OUT_DISABLE(void)
-{
-	gpio_set_direction(PIN_SWDIO, GPIO_MODE_INPUT);
-}
-
-
-// TDI Pin I/O ---------------------------------------------
-
-/** TDI I/O pin: Get Input.
-\return Current status of the TDI DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_TDI_IN(void)
-{
-	return (0);   // Not available
-}
-
-/** TDI I/O pin: Set Output.
-\param bit Output value for the TDI DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE void     PIN_TDI_OUT(uint32_t bit)
-{
-	(void)bit;   // Not available
-}
-
-
-// TDO Pin I/O ---------------------------------------------
-
-/** TDO I/O pin: Get Input.
-\return Current status of the TDO DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_TDO_IN(void)
-{
-	return (0);   // Not available
-}
-
-
-// nTRST Pin I/O -------------------------------------------
-
-/** nTRST I/O pin: Get Input.
-\return Current status of the nTRST DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_nTRST_IN(void)
-{
-    return (0);   // Not available
-}
-
-/** nTRST I/O pin: Set Output.
-\param bit JTAG TRST Test Reset pin status:
-           - 0: issue a JTAG TRST Test Reset.
-           - 1: release JTAG TRST Test Reset.
-*/
-__STATIC_FORCEINLINE void     PIN_nTRST_OUT(uint32_t bit)
-{
-    (void)bit;   // Not available
-}
-
-// nRESET Pin I/O------------------------------------------
-
-/** nRESET I/O pin: Get Input.
-\return Current status of the nRESET DAP hardware I/O pin.
-*/
-__STATIC_FORCEINLINE uint32_t PIN_nRESET_IN(void)
-{
-	return (uint32_t)gpio_get_level(PIN_nRESET);
-}
-
-/** nRESET I/O pin: Set Output.
-\param bit target device hardware reset pin status:
-           - 0: issue a device hardware reset.
-           - 1: release device hardware reset.
-*/
-__STATIC_FORCEINLINE void     PIN_nRESET_OUT(uint32_t bit)
-{
-	if (bit)
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_nRESET));
-	}
-	else
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_nRESET));
-	}
-}
-
-///@}
-
-
-//**************************************************************************************************
-/**
-\defgroup DAP_Config_LEDs_gr CMSIS-DAP Hardware Status LEDs
-\ingroup DAP_ConfigIO_gr
-@{
-
-CMSIS-DAP Hardware may provide LEDs that indicate the status of the CMSIS-DAP Debug Unit.
-
-It is recommended to provide the following LEDs for status indication:
- - Connect LED: is active when the DAP hardware is connected to a debugger.
- - Running LED: is active when the debugger has put the target device into running state.
-*/
-
-/** Debug Unit: Set status of Connected LED.
-\param bit status of the Connect LED.
-           - 1: Connect LED ON: debugger is connected to CMSIS-DAP Debug Unit.
-           - 0: Connect LED OFF: debugger is not connected to CMSIS-DAP Debug Unit.
-*/
-__STATIC_INLINE void LED_CONNECTED_OUT(uint32_t bit)
-{
-	if (bit)
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_LED_CONNECTED));
-	}
-	else
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_LED_CONNECTED));
-	}
-}
-
-/** Debug Unit: Set status Target Running LED.
-\param bit status of the Target Running LED.
-           - 1: Target Running LED ON: program execution in target started.
-           - 0: Target Running LED OFF: program execution in target stopped.
-*/
-__STATIC_INLINE void LED_RUNNING_OUT(uint32_t bit)
-{
-    if (bit)
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_LED_RUNNING));
-	}
-	else
-	{
-		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_LED_RUNNING));
-	}
-}
-
-///@}
-
-
-//**************************************************************************************************
-/**
-\defgroup DAP_Config_Timestamp_gr CMSIS-DAP Timestamp
-\ingroup DAP_ConfigIO_gr
-@{
-Access function for Test Domain Timer.
-
-The value of the Test Domain Timer in the Debug Unit is returned by the function \ref TIMESTAMP_GET. By
-default, the DWT timer is used.  The frequency of this timer is configured with \ref TIMESTAMP_CLOCK.
-
-*/
-
-/** Get timestamp of Test Domain Timer.
-\return Current timestamp value.
-*/
-__STATIC_INLINE uint32_t TIMESTAMP_GET (void) {
-  return xTaskGetTickCount();
-}
-
-///@}
-
-
-//**************************************************************************************************
-/**
-\defgroup DAP_Config_Initialization_gr CMSIS-DAP Initialization
-\ingroup DAP_ConfigIO_gr
-@{
-
-CMSIS-DAP Hardware I/O and LED Pins are initialized with the function \ref DAP_SETUP.
-*/
-
-/** Setup of the Debug Unit I/O pins and LEDs (called when Debug Unit is initialized).
-This function performs the initialization of the CMSIS-DAP Hardware I/O Pins and the
-Status LEDs. In detail the operation of Hardware I/O and LED pins are enabled and set:
- - I/O clock system enabled.
- - all I/O pins: input buffer enabled, output pins are set to HighZ mode.
- - for nTRST, nRESET a weak pull-up (if available) is enabled.
- - LED output pins are enabled and LEDs are turned off.
-*/
-__STATIC_INLINE void DAP_SETUP(void)
-{
-    PORT_JTAG_SETUP();
-	PORT_SWD_SETUP();
-	gpio_set_direction(PIN_nRESET, GPIO_MODE_INPUT_OUTPUT);
-	gpio_set_level(PIN_nRESET, 1);
-	// Configure: LED as output (turned off)
-	gpio_set_direction(PIN_LED_CONNECTED, GPIO_MODE_OUTPUT);
-	LED_CONNECTED_OUT(0);
-	gpio_set_direction(PIN_LED_RUNNING, GPIO_MODE_OUTPUT);
-	LED_RUNNING_OUT(0);
-}
-
-/** Reset Target Device with custom specific I/O pin or command sequence.
-This function allows the optional implementation of a device specific reset sequence.
-It is called when the command \ref DAP_ResetTarget and is for example required
-when a device needs a time-critical unlock sequence that enables the debug port.
-\return 0 = no device specific reset sequence is implemented.\n
-        1 = a device specific reset sequence is implemented.
-*/
-__STATIC_INLINE uint32_t RESET_TARGET(void)
-{
-    return (0);              // change to '1' when a device reset sequence is implemented
-}
-
-///@}
-
-
-#endif /* __DAP_CONFIG_H__ */
+/**
+ * @file    DAP_config.h
+ * @brief
+ *
+ * DAPLink Interface Firmware
+ * Copyright (c) 2009-2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __DAP_CONFIG_H__
+#define __DAP_CONFIG_H__
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_Debug_gr CMSIS-DAP Debug Unit Information
+\ingroup DAP_ConfigIO_gr
+@{
+Provides definitions about the hardware and configuration of the Debug Unit.
+
+This information includes:
+ - Definition of Cortex-M processor parameters used in CMSIS-DAP Debug Unit.
+ - Debug Unit Identification strings (Vendor, Product, Serial Number).
+ - Debug Unit communication packet size.
+ - Debug Access Port supported modes and settings (JTAG/SWD and SWO).
+ - Optional information about a connected Target Device (for Evaluation Boards).
+*/
+
+#include "sdkconfig.h"
+#include "esp32s3/rom/gpio.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+
+#if defined(__GNUC__) && !defined(__STATIC_FORCEINLINE)
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+#endif
+
+#if defined(__GNUC__) && !defined(__STATIC_INLINE)
+#define __STATIC_INLINE static inline
+#endif
+
+/// Processor Clock of the Cortex-M MCU used in the Debug Unit.
+/// This value is used to calculate the SWD/JTAG clock speed. The SWD clock itself is
+/// measured at boot (see swd_clock_calib.c); the constants below are only a fallback.
+#define CPU_CLOCK               (CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000U) ///< Specifies the CPU Clock in Hz
+
+/// Number of processor cycles for I/O Port write operations.
+/// This value is used to calculate the SWD/JTAG clock speed that is generated with I/O
+/// Port write operations in the Debug Unit by a Cortex-M MCU. Most Cortex-M processors
+/// require 2 processor cycles for a I/O Port Write operation.  If the Debug Unit uses
+/// a Cortex-M0+ processor with high-speed peripheral I/O only 1 processor cycle might be
+/// required.
+#define IO_PORT_WRITE_CYCLES    1U              ///< I/O Cycles: 2=default, 1=Cortex-M0+ fast I/0
+
+/// Indicate that Serial Wire Debug (SWD) communication mode is available at the Debug Access Port.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#ifndef DAP_SWD
+#define DAP_SWD                 1               ///< SWD Mode:  1 = available, 0 = not available
+#endif
+
+/// Indicate that JTAG communication mode is available at the Debug Port.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#ifndef DAP_JTAG
+#define DAP_JTAG                1               ///< JTAG Mode: 1 = available, 0 = not available.
+#endif
+
+/// Configure maximum number of JTAG devices on the scan chain connected to the Debug Access Port.
+/// This setting impacts the RAM requirements of the Debug Unit. Valid range is 1 .. 255.
+#define DAP_JTAG_DEV_CNT        8               ///< Maximum number of JTAG devices on scan chain
+
+/// Default communication mode on the Debug Access Port.
+/// Used for the command \ref DAP_Connect when Port Default mode is selected.
+#if (DAP_SWD == 1)
+#define DAP_DEFAULT_PORT        1               ///< Default JTAG/SWJ Port Mode: 1 = SWD, 2 = JTAG.
+#elif (DAP_JTAG == 1)
+#define DAP_DEFAULT_PORT        2               ///< Default JTAG/SWJ Port Mode: 1 = SWD, 2 = JTAG.
+#else
+#error Must enable DAP_SWD and/or DAP_JTAG
+#endif
+
+/// Default communication speed on the Debug Access Port for SWD and JTAG mode.
+/// Used to initialize the default SWD/JTAG clock frequency.
+/// The command \ref DAP_SWJ_Clock can be used to overwrite this default setting.
+#define DAP_DEFAULT_SWJ_CLOCK   4000000U         ///< Default SWD/JTAG clock frequency in Hz.
+
+/// Maximum Package Size for Command and Response data.
+/// This configuration settings is used to optimize the communication performance with the
+/// debugger and depends on the USB peripheral. Typical vales are 64 for Full-speed USB HID or WinUSB,
+/// 1024 for High-speed USB HID and 512 for High-speed USB WinUSB.
+#define DAP_PACKET_SIZE         64              ///< Specifies Packet Size in bytes.
+
+/// Maximum Package Buffers for Command and Response data.
+/// This configuration settings is used to optimize the communication performance with the
+/// debugger and depends on the USB peripheral. For devices with limited RAM or USB buffer the
+/// setting can be reduced (valid range is 1 .. 255). Change setting to 4 for High-Speed USB.
+#define DAP_PACKET_COUNT        1              ///< Buffers: 64 = Full-Speed, 4 = High-Speed.
+
+/// Indicate that UART Serial Wire Output (SWO) trace is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define SWO_UART                1               ///< SWO UART:  1 = available, 0 = not available
+
+/// UART port number for the UART SWO (ESP-IDF uart driver, UART0 is the console).
+#define SWO_UART_DRIVER         1               ///< UART port number (UART_NUM_x).
+
+/// Maximum SWO UART Baudrate
+/// ESP32-S3: UART clocked from APB (80 MHz) with 16x oversampling.
+#define SWO_UART_MAX_BAUDRATE   5000000U        ///< SWO UART Maximum Baudrate in Hz
+
+/// Indicate that Manchester Serial Wire Output (SWO) trace is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+/// ESP32-S3: RMT receive channel with DMA timestamps the edges, swo_manchester.c decodes them.
+#define SWO_MANCHESTER          1               ///< SWO Manchester:  1 = available, 0 = not available.
+
+/// SWO Trace Buffer Size.
+#define SWO_BUFFER_SIZE         16384U          ///< SWO Trace Buffer Size in bytes (must be 2^n).
+
+/// SWO Streaming Trace.
+/// Trace data is sent on the third (bulk IN) endpoint of the CMSIS-DAP v2 interface.
+/// ESP32-S3: that endpoint takes the IN FIFO of the MSC drive, Kconfig DAP_USB_EXTRA_IN selects one.
+#ifdef CONFIG_DAP_USB_SWO_STREAM
+#define SWO_STREAM              1               ///< SWO Streaming Trace: 1 = available, 0 = not available.
+#else
+#define SWO_STREAM              0               ///< SWO Streaming Trace: 1 = available, 0 = not available.
+#endif
+
+/// ITM/DWT decoder behind the SWO capture (itm_decoder.c).
+/// Enabled with the SWO filter vendor command: the Trace Buffer then holds compact records of the
+/// selected stimulus ports and DWT packets, text ports are forwarded to the CDC interface.
+#define SWO_ITM                 1               ///< SWO ITM decoder: 1 = available, 0 = not available.
+
+/// Clock frequency of the Test Domain Timer. Timer value is returned with \ref TIMESTAMP_GET.
+/// ESP32-S3: CPU cycle counter (CCOUNT), wraps every 2^32 / CPU_CLOCK seconds (~26.8 s at 160 MHz).
+#define TIMESTAMP_CLOCK         CPU_CLOCK       ///< Timestamp clock in Hz (0 = timestamps not supported).
+#if CONFIG_PM_ENABLE
+#warning "Dynamic frequency scaling changes the CCOUNT rate, DAP timestamps will be inaccurate"
+#endif
+
+/// Indicate that UART Communication Port is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define DAP_UART                1               ///< DAP UART:  1 = available, 0 = not available.
+
+/// UART port number for the UART Communication Port (ESP-IDF uart driver, UART0 is the console,
+/// UART1 is used by the UART SWO).
+#define DAP_UART_DRIVER         2               ///< UART port number (UART_NUM_x).
+
+/// Maximum UART Communication Port Baudrate
+/// ESP32-S3: UART clocked from APB (80 MHz) with 16x oversampling.
+#define DAP_UART_MAX_BAUDRATE   5000000U        ///< UART Maximum Baudrate in Hz
+
+/// UART Receive Buffer Size.
+#define DAP_UART_RX_BUFFER_SIZE 4096U           ///< Uart Receive Buffer Size in bytes (must be 2^n).
+
+/// UART Transmit Buffer Size.
+#define DAP_UART_TX_BUFFER_SIZE 2048U           ///< Uart Transmit Buffer Size in bytes (must be 2^n).
+
+/// Indicate that UART Communication via USB COM Port is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define DAP_UART_USB_COM_PORT   1               ///< USB COM Port:  1 = available, 0 = not available.
+
+/// Debug Unit is connected to fixed Target Device.
+/// The Debug Unit may be part of an evaluation board and always connected to a fixed
+/// known device. In this case a Device Vendor, Device Name, Board Vendor and Board Name strings
+/// are stored and may be used by the debugger or IDE to configure device parameters.
+#define TARGET_FIXED            0               ///< Target: 1 = known, 0 = unknown;
+
+///@}
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_PortIO_gr CMSIS-DAP Hardware I/O Pin Access
+\ingroup DAP_ConfigIO_gr
+@{
+
+Standard I/O Pins of the CMSIS-DAP Hardware Debug Port support standard JTAG mode
+and Serial Wire Debug (SWD) mode. In SWD mode only 2 pins are required to implement the debug
+interface of a device. The following I/O Pins are provided:
+
+JTAG I/O Pin                 | SWD I/O Pin          | CMSIS-DAP Hardware pin mode
+---------------------------- | -------------------- | ---------------------------------------------
+TCK: Test Clock              | SWCLK: Clock         | Output Push/Pull
+TMS: Test Mode Select        | SWDIO: Data I/O      | Output Push/Pull; Input (for receiving data)
+TDI: Test Data Input         |                      | Output Push/Pull
+TDO: Test Data Output        |                      | Input
+nTRST: Test Reset (optional) |                      | Output Open Drain with pull-up resistor
+nRESET: Device Reset         | nRESET: Device Reset | Output Open Drain with pull-up resistor
+
+
+DAP Hardware I/O Pin Access Functions
+-------------------------------------
+The various I/O Pins are accessed by functions that implement the Read, Write, Set, or Clear to
+these I/O Pins.
+
+For the SWDIO I/O Pin there are additional functions that are called in SWD I/O mode only.
+This functions are provided to achieve faster I/O that is possible with some advanced GPIO
+peripherals that can independently write/read a single I/O pin without affecting any other pins
+of the same I/O port. The following SWDIO I/O Pin functions are provided:
+ - \ref PIN_SWDIO_OUT_ENABLE to enable the output mode from the DAP hardware.
+ - \ref PIN_SWDIO_OUT_DISABLE to enable the input mode to the DAP hardware.
+ - \ref PIN_SWDIO_IN to read from the SWDIO I/O pin with utmost possible speed.
+ - \ref PIN_SWDIO_OUT to write to the SWDIO I/O pin with utmost possible speed.
+*/
+
+
+// Configure DAP I/O pins ------------------------------
+#define PIN_SWDIO GPIO_NUM_8
+#define PIN_SWCLK GPIO_NUM_9
+#define PIN_nRESET GPIO_NUM_10
+#define PIN_TDI GPIO_NUM_15
+#define PIN_TDO GPIO_NUM_16
+#define PIN_SWO PIN_TDO                 // SWO shares TDO as on the Cortex debug connectors
+#define PIN_LED_CONNECTED GPIO_NUM_17
+#define PIN_LED_RUNNING GPIO_NUM_18
+#define PIN_UART_TX GPIO_NUM_48         // UART Communication Port, to target RX
+#define PIN_UART_RX GPIO_NUM_47         // UART Communication Port, from target TX
+
+// Gang programming (swd_gang.c): targets share PIN_SWCLK, each has its own SWDIO and nRESET.
+// SWDIO pins must be GPIO0..31 so one GPIO_OUT/GPIO_IN register access covers all of them,
+// nRESET pins may be any GPIO. Target 0 uses the standard debug port pins. GPIO3 is a
+// strapping pin, but only read when the JTAG source eFuse is burned; nRESET idles high.
+#define SWD_GANG_MAX            8U
+#define SWD_GANG_SWDIO_PINS     { PIN_SWDIO, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_4, \
+                                  GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7, GPIO_NUM_11 }
+#define SWD_GANG_nRESET_PINS    { PIN_nRESET, GPIO_NUM_21, GPIO_NUM_38, GPIO_NUM_39, \
+                                  GPIO_NUM_40, GPIO_NUM_41, GPIO_NUM_42, GPIO_NUM_3 }
+
+// Debug ports: independent SWD interfaces, each with its own pins, DAP_Data and engine task
+// (see DAP_Port_t in DAP.h and dap_handle.c). All pins must be GPIO0..31 so they are driven
+// through GPIO_OUT_W1TS/W1TC and sampled from GPIO_IN. Port 0 uses the standard debug port
+// pins. JTAG uses SWCLK as TCK and SWDIO as TMS; a port without TDI/TDO (GPIO_NUM_NC) is
+// SWD only.
+#define DAP_PORT_COUNT          2U
+
+// SWO and the target UART are single peripherals wired to the connector of this port. Their
+// commands are served on this port only, so their state is only touched by its engine task.
+#define DAP_TRACE_PORT          0U
+
+/// I/O pins of one debug port
+typedef struct {
+  gpio_num_t swclk;
+  gpio_num_t swdio;
+  gpio_num_t nreset;
+  gpio_num_t tdi;
+  gpio_num_t tdo;
+  uint32_t   swclk_mask;
+  uint32_t   swdio_mask;
+  uint32_t   nreset_mask;
+  uint32_t   tdi_mask;
+  uint32_t   tdo_mask;
+} DAP_Pins_t;
+
+#define DAP_PIN_MASK(pin)       (((pin) >= 0) ? (1UL << ((pin) & 31)) : 0UL)
+#define DAP_PINS(swclk, swdio, nreset, tdi, tdo) \
+  { (swclk), (swdio), (nreset), (tdi), (tdo), \
+    DAP_PIN_MASK(swclk), DAP_PIN_MASK(swdio), DAP_PIN_MASK(nreset), DAP_PIN_MASK(tdi), DAP_PIN_MASK(tdo) }
+
+#define DAP_PORT_PINS           { DAP_PINS(PIN_SWCLK, PIN_SWDIO, PIN_nRESET, PIN_TDI, PIN_TDO), \
+                                  DAP_PINS(GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_NC, GPIO_NUM_NC) }
+
+// JTAG shift engine (jtag_spi.c): runs of TCK cycles with constant TMS are clocked by the SPI
+// peripheral (TCK = SCLK, TDI = MOSI, TDO = MISO through the GPIO matrix) instead of bit-banged
+// when that is faster: the bits saved against the bit-banged clock must cover the fixed cost of
+// a shift, measured at run time and starting from JTAG_SPI_SHIFT_US. The SPI clock follows the
+// requested JTAG clock up to JTAG_SPI_MAX_CLOCK (MISO through the GPIO matrix is not reliable
+// above it).
+#define JTAG_SPI                1               ///< JTAG SPI engine: 1 = enabled, 0 = bit-banged only
+#define JTAG_SPI_HOST           SPI2_HOST
+#define JTAG_SPI_SHIFT_US       8U              ///< Fixed cost of one shift in us until measured
+#define JTAG_SPI_MAX_CLOCK      20000000U
+
+/// Pins of the debug port bound to the calling task (DAP_PortBind in DAP.c)
+extern __thread const DAP_Pins_t *DAP_Pins;
+
+/** Setup JTAG I/O pins: TCK, TMS, TDI, TDO, nTRST, and nRESET.
+Configures the DAP Hardware I/O pins for JTAG mode:
+ - TCK, TMS, TDI, nTRST, nRESET to output mode and set to high level.
+ - TDO to input mode.
+*/
+__STATIC_INLINE void PORT_JTAG_SETUP(void)
+{
+	if ((DAP_Pins->tdi == GPIO_NUM_NC) || (DAP_Pins->tdo == GPIO_NUM_NC))
+	{
+		return;
+	}
+	gpio_pad_select_gpio(DAP_Pins->swclk);
+	gpio_set_direction(DAP_Pins->swclk, GPIO_MODE_INPUT_OUTPUT);
+	gpio_pad_select_gpio(DAP_Pins->swdio);
+	gpio_set_direction(DAP_Pins->swdio, GPIO_MODE_INPUT_OUTPUT);
+	gpio_pad_select_gpio(DAP_Pins->tdi);
+	gpio_set_direction(DAP_Pins->tdi, GPIO_MODE_INPUT_OUTPUT);
+	gpio_pad_select_gpio(DAP_Pins->tdo);
+	gpio_set_direction(DAP_Pins->tdo, GPIO_MODE_INPUT);
+
+	gpio_set_level(DAP_Pins->swclk, 1);
+	gpio_set_level(DAP_Pins->swdio, 1);
+	gpio_set_level(DAP_Pins->tdi, 1);
+}
+
+/** JTAG available on the bound debug port (TDI and TDO assigned).
+\return 1 = JTAG pins present, 0 = SWD only port.
+*/
+__STATIC_INLINE uint32_t PORT_JTAG_AVAILABLE(void)
+{
+	return ((DAP_Pins->tdi != GPIO_NUM_NC) && (DAP_Pins->tdo != GPIO_NUM_NC)) ? 1U : 0U;
+}
+
+/** Setup SWD I/O pins: SWCLK, SWDIO, and nRESET.
+Configures the DAP Hardware I/O pins for Serial Wire Debug (SWD) mode:
+ - SWCLK, SWDIO, nRESET to output mode and set to default high level.
+ - TDI, TMS, nTRST to HighZ mode (pins are unused in SWD mode).
+*/
+__STATIC_INLINE void PORT_SWD_SETUP(void)
+{
+    gpio_pad_select_gpio(DAP_Pins->swclk);
+	gpio_set_direction(DAP_Pins->swclk, GPIO_MODE_INPUT_OUTPUT);
+	gpio_pad_select_gpio(DAP_Pins->swdio);
+	gpio_set_direction(DAP_Pins->swdio, GPIO_MODE_INPUT_OUTPUT);
+
+	gpio_set_level(DAP_Pins->swclk, 1);
+	gpio_set_level(DAP_Pins->swdio, 1);
+}
+
+/** Disable JTAG/SWD I/O Pins.
+Disables the DAP Hardware I/O pins which configures:
+ - TCK/SWCLK, TMS/SWDIO, TDI, TDO, nTRST, nRESET to High-Z mode.
+*/
+__STATIC_INLINE void PORT_OFF(void)
+{
+	gpio_pad_select_gpio(DAP_Pins->swclk);
+	gpio_set_direction(DAP_Pins->swclk, GPIO_MODE_INPUT);
+	gpio_set_level(DAP_Pins->swclk, 0);
+	gpio_pad_select_gpio(DAP_Pins->swdio);
+	gpio_set_direction(DAP_Pins->swdio, GPIO_MODE_INPUT);
+	gpio_set_level(DAP_Pins->swdio, 0);
+	if (DAP_Pins->tdi != GPIO_NUM_NC)
+	{
+		gpio_set_direction(DAP_Pins->tdi, GPIO_MODE_INPUT);
+		gpio_set_level(DAP_Pins->tdi, 0);
+	}
+}
+
+
+// SWCLK/TCK I/O pin -------------------------------------
+
+/** SWCLK/TCK I/O pin: Get Input.
+\return Current status of the SWCLK/TCK DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_SWCLK_TCK_IN(void)
+{
+    return (uint32_t)gpio_get_level(DAP_Pins->swclk);
+}
+
+/** SWCLK/TCK I/O pin: Set Output to High.
+Set the SWCLK/TCK DAP hardware I/O pin to high level.
+*/
+__STATIC_FORCEINLINE void     PIN_SWCLK_TCK_SET(void)
+{
+    WRITE_PERI_REG(GPIO_OUT_W1TS_REG, DAP_Pins->swclk_mask);
+}
+
+/** SWCLK/TCK I/O pin: Set Output to Low.
+Set the SWCLK/TCK DAP hardware I/O pin to low level.
+*/
+__STATIC_FORCEINLINE void     PIN_SWCLK_TCK_CLR(void)
+{
+    WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->swclk_mask);
+}
+
+
+// SWDIO/TMS Pin I/O --------------------------------------
+
+/** SWDIO/TMS I/O pin: Get Input.
+\return Current status of the SWDIO/TMS DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_SWDIO_TMS_IN(void)
+{
+    return gpio_get_level(DAP_Pins->swdio);
+}
+
+/** SWDIO/TMS I/O pin: Set Output to High.
+Set the SWDIO/TMS DAP hardware I/O pin to high level.
+*/
+__STATIC_FORCEINLINE void     PIN_SWDIO_TMS_SET(void)
+{
+    WRITE_PERI_REG(GPIO_OUT_W1TS_REG, DAP_Pins->swdio_mask);
+}
+
+/** SWDIO/TMS I/O pin: Set Output to Low.
+Set the SWDIO/TMS DAP hardware I/O pin to low level.
+*/
+__STATIC_FORCEINLINE void     PIN_SWDIO_TMS_CLR(void)
+{
+    WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->swdio_mask);
+}
+
+/** SWDIO I/O pin: Get Input (used in SWD mode only).
+\return Current status of the SWDIO DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_SWDIO_IN(void)
+{
+    return (uint32_t)gpio_get_level(DAP_Pins->swdio);
+}
+
+/** SWDIO I/O pin: Set Output (used in SWD mode only).
+\param bit Output value for the SWDIO DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE void     PIN_SWDIO_OUT(uint32_t bit)
+{
+    if ((bit & 1U) == 1)
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, DAP_Pins->swdio_mask);
+	}
+	else
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->swdio_mask);
+	}
+}
+
+/** SWDIO I/O pin: Switch to Output mode (used in SWD mode only).
+Configure the SWDIO DAP hardware I/O pin to output mode. This function is
+called prior \ref PIN_SWDIO_OUT function calls.
+*/
+__STATIC_FORCEINLINE void     PIN_SWDIO_OUT_ENABLE(void)
+{
+    gpio_set_direction(DAP_Pins->swdio, GPIO_MODE_OUTPUT);
+}
+
+/** SWDIO I/O pin: Switch to Input mode (used in SWD mode only).
+Configure the SWDIO DAP hardware I/O pin to input mode. This function is
+called prior \ref PIN_SWDIO_IN function calls.
+*/
+__STATIC_FORCEINLINE void     PIN_SWDIO_OUT_DISABLE(void)
+{
+	gpio_set_direction(DAP_Pins->swdio, GPIO_MODE_INPUT);
+}
+
+
+// TDI Pin I/O ---------------------------------------------
+
+/** TDI I/O pin: Get Input.
+\return Current status of the TDI DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_TDI_IN(void)
+{
+	return (READ_PERI_REG(GPIO_IN_REG) & DAP_Pins->tdi_mask) ? 1U : 0U;
+}
+
+/** TDI I/O pin: Set Output.
+\param bit Output value for the TDI DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE void     PIN_TDI_OUT(uint32_t bit)
+{
+	if (bit & 1U)
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, DAP_Pins->tdi_mask);
+	}
+	else
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->tdi_mask);
+	}
+}
+
+
+// TDO Pin I/O ---------------------------------------------
+
+/** TDO I/O pin: Get Input.
+\return Current status of the TDO DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_TDO_IN(void)
+{
+	return (READ_PERI_REG(GPIO_IN_REG) & DAP_Pins->tdo_mask) ? 1U : 0U;
+}
+
+
+// nTRST Pin I/O -------------------------------------------
+
+/** nTRST I/O pin: Get Input.
+\return Current status of the nTRST DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_nTRST_IN(void)
+{
+    return (0);   // Not available
+}
+
+/** nTRST I/O pin: Set Output.
+\param bit JTAG TRST Test Reset pin status:
+           - 0: issue a JTAG TRST Test Reset.
+           - 1: release JTAG TRST Test Reset.
+*/
+__STATIC_FORCEINLINE void     PIN_nTRST_OUT(uint32_t bit)
+{
+    (void)bit;   // Not available
+}
+
+// nRESET Pin I/O------------------------------------------
+
+/** nRESET I/O pin: Get Input.
+\return Current status of the nRESET DAP hardware I/O pin.
+*/
+__STATIC_FORCEINLINE uint32_t PIN_nRESET_IN(void)
+{
+	return (uint32_t)gpio_get_level(DAP_Pins->nreset);
+}
+
+/** nRESET I/O pin: Set Output.
+\param bit target device hardware reset pin status:
+           - 0: issue a device hardware reset.
+           - 1: release device hardware reset.
+*/
+__STATIC_FORCEINLINE void     PIN_nRESET_OUT(uint32_t bit)
+{
+	if (bit)
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, DAP_Pins->nreset_mask);
+	}
+	else
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->nreset_mask);
+	}
+}
+
+///@}
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_LEDs_gr CMSIS-DAP Hardware Status LEDs
+\ingroup DAP_ConfigIO_gr
+@{
+
+CMSIS-DAP Hardware may provide LEDs that indicate the status of the CMSIS-DAP Debug Unit.
+
+It is recommended to provide the following LEDs for status indication:
+ - Connect LED: is active when the DAP hardware is connected to a debugger.
+ - Running LED: is active when the debugger has put the target device into running state.
+*/
+
+/** Debug Unit: Set status of Connected LED.
+\param bit status of the Connect LED.
+           - 1: Connect LED ON: debugger is connected to CMSIS-DAP Debug Unit.
+           - 0: Connect LED OFF: debugger is not connected to CMSIS-DAP Debug Unit.
+*/
+__STATIC_INLINE void LED_CONNECTED_OUT(uint32_t bit)
+{
+	if (bit)
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_LED_CONNECTED));
+	}
+	else
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_LED_CONNECTED));
+	}
+}
+
+/** Debug Unit: Set status Target Running LED.
+\param bit status of the Target Running LED.
+           - 1: Target Running LED ON: program execution in target started.
+           - 0: Target Running LED OFF: program execution in target stopped.
+*/
+__STATIC_INLINE void LED_RUNNING_OUT(uint32_t bit)
+{
+    if (bit)
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TS_REG, (0x1 << PIN_LED_RUNNING));
+	}
+	else
+	{
+		WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (0x1 << PIN_LED_RUNNING));
+	}
+}
+
+///@}
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_Timestamp_gr CMSIS-DAP Timestamp
+\ingroup DAP_ConfigIO_gr
+@{
+Access function for Test Domain Timer.
+
+The value of the Test Domain Timer in the Debug Unit is returned by the function \ref TIMESTAMP_GET. By
+default, the DWT timer is used.  The frequency of this timer is configured with \ref TIMESTAMP_CLOCK.
+
+ESP32-S3: the CCOUNT register of the executing core is used. The counters of the two cores are
+not synchronised, so the DAP task of every debug port is pinned to one core (see dap_handle.c). Differences of two
+timestamps are valid across a wraparound when computed with unsigned 32-bit arithmetic.
+
+*/
+
+/** Get timestamp of Test Domain Timer.
+\return Current timestamp value.
+*/
+__STATIC_INLINE uint32_t TIMESTAMP_GET (void) {
+  return ((uint32_t)esp_cpu_get_cycle_count());
+}
+
+///@}
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_Initialization_gr CMSIS-DAP Initialization
+\ingroup DAP_ConfigIO_gr
+@{
+
+CMSIS-DAP Hardware I/O and LED Pins are initialized with the function \ref DAP_SETUP.
+*/
+
+/** Setup of the Debug Unit I/O pins and LEDs (called when Debug Unit is initialized).
+This function performs the initialization of the CMSIS-DAP Hardware I/O Pins and the
+Status LEDs. In detail the operation of Hardware I/O and LED pins are enabled and set:
+ - I/O clock system enabled.
+ - all I/O pins: input buffer enabled, output pins are set to HighZ mode.
+ - for nTRST, nRESET a weak pull-up (if available) is enabled.
+ - LED output pins are enabled and LEDs are turned off.
+*/
+__STATIC_INLINE void DAP_SETUP(void)
+{
+    PORT_JTAG_SETUP();
+	PORT_SWD_SETUP();
+	gpio_set_direction(DAP_Pins->nreset, GPIO_MODE_INPUT_OUTPUT);
+	gpio_set_level(DAP_Pins->nreset, 1);
+	// Configure: LED as output (turned off)
+	gpio_set_direction(PIN_LED_CONNECTED, GPIO_MODE_OUTPUT);
+	LED_CONNECTED_OUT(0);
+	gpio_set_direction(PIN_LED_RUNNING, GPIO_MODE_OUTPUT);
+	LED_RUNNING_OUT(0);
+}
+
+/** Reset Target Device with custom specific I/O pin or command sequence.
+This function allows the optional implementation of a device specific reset sequence.
+It is called when the command \ref DAP_ResetTarget and is for example required
+when a device needs a time-critical unlock sequence that enables the debug port.
+\return 0 = no device specific reset sequence is implemented.\n
+        1 = a device specific reset sequence is implemented.
+*/
+__STATIC_INLINE uint32_t RESET_TARGET(void)
+{
+    return (0);              // change to '1' when a device reset sequence is implemented
+}
+
+///@}
+
+
+#endif /* __DAP_CONFIG_H__ */
@@ -0,0 +1,77 @@
+/**
+ * @file    blank_check.h
+ * @brief   Blank check of flash sectors and erase/skip planning
+ */
+#ifndef BLANK_CHECK_H
+#define BLANK_CHECK_H
+
+#include <stdint.h>
+#include "flash_blob.h"
+#include "flash_algo.h"
+#include "sector_map.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Sectors checked per call of the on-target scanner.
+#define BLANK_CHECK_BATCH       32U
+
+//! Bytes scanned per call of the on-target scanner, bounds the syscall time.
+#define BLANK_CHECK_BATCH_BYTES 0x40000U
+
+typedef enum
+{
+	BLANK_CHECK_NONE = 0,           // not memory mapped, erase everything
+	BLANK_CHECK_PROBE,              // SWD block reads, compared on the probe
+	BLANK_CHECK_TARGET,             // scanner routine next to the flash algorithm
+} blank_method_t;
+
+// Sectors waiting to be checked
+typedef struct
+{
+	sector_info_t sector[BLANK_CHECK_BATCH];
+	uint32_t index[BLANK_CHECK_BATCH];
+	uint8_t check[BLANK_CHECK_BATCH];       // 0 = erase without checking
+	uint8_t blank[BLANK_CHECK_BATCH];
+	uint32_t count;
+	uint32_t bytes;                         // bytes to be scanned
+} blank_batch_t;
+
+typedef struct
+{
+	blank_method_t method;
+	uint32_t value;                 // erased word (valEmpty in every byte)
+	const program_syscall_t *sys;
+	uint32_t code;                  // scanner load address
+	uint32_t entry;                 // scanner entry point (Thumb)
+	uint32_t table;                 // {address, bytes} per sector, result written over bytes
+
+	// Cost model, all times in microseconds
+	uint32_t check_kbps;            // blank check throughput in KB/s
+	uint32_t call_us;               // fixed cost of one syscall or read burst
+	uint32_t erase_us_per_kb;       // sector erase time per KB
+	uint32_t chip_us;               // chip erase time, 0 = chip erase not allowed
+
+	// Result of the last plan
+	uint32_t checked;               // sectors read
+	uint32_t skipped;               // blank sectors removed from the plan
+
+	// Working state of blank_check_plan, one planner per debug port
+	blank_batch_t batch;
+	uint32_t probe_buf[256];        // SWD block reads
+} blank_check_t;
+
+void blank_check_init(blank_check_t *bc, const flash_algo_t *algo, uint8_t allow_chip);
+dap_err_t blank_check_place(blank_check_t *bc, const program_target_t *target);
+dap_err_t blank_check_load(const blank_check_t *bc);
+void blank_check_learn(blank_check_t *bc, uint32_t bytes, uint32_t us);
+dap_err_t blank_check_plan(blank_check_t *bc, sector_map_t *map, const sector_extent_t *plan, uint32_t plan_count,
+                           sector_extent_t *erase, uint32_t erase_size, uint32_t *erase_count, uint8_t *chip);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
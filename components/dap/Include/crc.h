@@ -0,0 +1,21 @@
+/**
+ * @file    crc.h
+ * @brief   CRC-32 (IEEE 802.3, reflected) used by the image and algorithm caches
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t crc32(const void *data, uint32_t size);
+uint32_t crc32_continue(uint32_t prev_crc, const void *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file    flash_algo.h
+ * @brief   CMSIS-Pack flash algorithm (.FLM) loader and cache image
+ */
+#ifndef FLASH_ALGO_H
+#define FLASH_ALGO_H
+
+#include <stdint.h>
+#include "flash_blob.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Cache image magic ("FLMC") and layout version.
+#define FLASH_ALGO_CACHE_MAGIC      0x434D4C46U
+#define FLASH_ALGO_CACHE_VERSION    1U
+
+//! Maximum number of FlashDevice sector runs (SECTOR_NUM in FlashOS.h).
+#define FLASH_ALGO_MAX_SECTORS      512U
+
+//! Stack reserved at the top of target RAM for the algorithm.
+#define FLASH_ALGO_STACK_SIZE       0x400U
+
+//! Length of the device name kept in the cache image (including terminator).
+#define FLASH_ALGO_NAME_LEN         64U
+
+//! Read callback: copy len bytes at offset of the .FLM file into buf.
+//!   return: 1 = ok, 0 = read error or out of range
+typedef uint8_t (*flash_algo_read_t)(void *ctx, uint32_t offset, void *buf, uint32_t len);
+
+//! FlashDevice fields needed to drive the algorithm.
+typedef struct
+{
+	char     name[FLASH_ALGO_NAME_LEN];
+	uint16_t type;                  // DevType: 1 = on-chip, 2 = 8-bit ext, ...
+	uint16_t version;               // Vers: FlashOS driver version
+	uint32_t start;                 // DevAdr
+	uint32_t size;                  // szDev
+	uint32_t page_size;             // szPage, ProgramPage granularity
+	uint32_t erased_value;          // valEmpty
+	uint32_t program_timeout;       // toProg in ms
+	uint32_t erase_timeout;         // toErase in ms
+} flash_algo_device_t;
+
+//! Cache image header. It is followed by sector_info_t[sector_count] and the
+//! algorithm blob (algo_size bytes). All fields are fixed-size little-endian
+//! words so host and probe builds produce identical images.
+typedef struct
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t sector_count;
+	uint32_t size;                  // total image size including this header
+	uint32_t crc;                   // CRC-32 of the image from 'device' onwards
+	flash_algo_device_t device;
+	uint32_t init;
+	uint32_t uninit;
+	uint32_t erase_chip;
+	uint32_t erase_sector;
+	uint32_t program_page;
+	uint32_t verify;
+	uint32_t breakpoint;
+	uint32_t static_base;
+	uint32_t stack_pointer;
+	uint32_t program_buffer;
+	uint32_t program_buffer_size;
+	uint32_t algo_start;
+	uint32_t algo_size;
+} flash_algo_cache_t;
+
+//! Loaded algorithm. Pointers refer into the cache image passed to flash_algo_load.
+typedef struct
+{
+	program_target_t target;
+	flash_algo_device_t device;
+	const sector_info_t *sectors;
+	uint32_t sector_count;
+} flash_algo_t;
+
+dap_err_t flash_algo_build(flash_algo_read_t read, void *ctx, uint32_t ram_start, uint32_t ram_size,
+                           void *cache, uint32_t cache_size, uint32_t *cache_used);
+dap_err_t flash_algo_load(const void *cache, uint32_t cache_size, flash_algo_t *algo);
+uint8_t flash_algo_read_file(void *ctx, uint32_t offset, void *buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
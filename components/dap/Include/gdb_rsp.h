@@ -0,0 +1,95 @@
+/**
+ * @file    gdb_rsp.h
+ * @brief   GDB remote serial protocol server for a Cortex-M target
+ */
+#ifndef GDB_RSP_H
+#define GDB_RSP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Largest packet accepted from GDB (announced as PacketSize).
+#define GDB_RSP_PACKET_SIZE     1024U
+
+//! Comparators used for hardware breakpoints and watchpoints.
+#define GDB_RSP_FPB_MAX         8U
+#define GDB_RSP_DWT_MAX         4U
+
+//! Target access, all functions return 1 on success and 0 on an error.
+//! The register functions take a DCRSR register selector.
+typedef struct
+{
+	uint8_t (*read_mem)(void *ctx, uint32_t addr, uint8_t *data, uint32_t size);
+	uint8_t (*write_mem)(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size);
+	uint8_t (*read_reg)(void *ctx, uint32_t sel, uint32_t *val);
+	uint8_t (*write_reg)(void *ctx, uint32_t sel, uint32_t val);
+
+	// Flash programming (vFlashErase/vFlashWrite/vFlashDone), NULL if not supported.
+	// Writes arrive in address order between an erase and flash_done.
+	uint8_t (*flash_erase)(void *ctx, uint32_t addr, uint32_t size);
+	uint8_t (*flash_write)(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size);
+	uint8_t (*flash_done)(void *ctx);
+
+	// Memory map XML for qXfer:memory-map:read, NULL if there is none
+	const char *(*memory_map)(void *ctx);
+
+	// Send bytes to GDB
+	void (*output)(void *ctx, const uint8_t *data, uint32_t num);
+	void *ctx;
+} gdb_rsp_target_t;
+
+typedef struct
+{
+	const gdb_rsp_target_t *target;
+
+	// Packet parser
+	uint8_t state;
+	uint8_t escape;                 // next data byte is escaped
+	uint8_t overflow;               // packet longer than the buffer
+	uint8_t checksum;               // sum of the received data bytes
+	uint8_t received;               // checksum sent by GDB
+	uint32_t length;
+
+	// Session
+	uint8_t attached;               // target halted by gdb_rsp_attach(), until detach or kill
+	uint8_t noack;                  // QStartNoAckMode
+	uint8_t running;                // target resumed, waiting for it to halt
+	uint8_t interrupted;            // halted on a ^C from GDB
+	uint8_t stepping;
+
+	// Breakpoint and watchpoint units
+	uint8_t fpb_count;
+	uint8_t fpb_rev;                // FP_CTRL.REV, 0 = ARMv7-M, 1 = ARMv8-M
+	uint8_t dwt_count;
+	uint32_t fpb[GDB_RSP_FPB_MAX];  // breakpoint address | 1, 0 = free
+	struct
+	{
+		uint32_t addr;
+		uint32_t size;
+		uint8_t type;               // Z packet type 2..4, 0 = free
+	} dwt[GDB_RSP_DWT_MAX];
+
+	char packet[GDB_RSP_PACKET_SIZE + 1];
+	uint8_t reply[GDB_RSP_PACKET_SIZE + 4]; // last reply, resent on a NAK
+	uint32_t reply_length;
+	uint8_t mem[GDB_RSP_PACKET_SIZE / 2];
+
+	// Statistics
+	uint32_t packets;               // packets handled
+	uint32_t errors;                // packets dropped for a bad checksum or length
+} gdb_rsp_t;
+
+void gdb_rsp_init(gdb_rsp_t *rsp, const gdb_rsp_target_t *target);
+uint8_t gdb_rsp_attach(gdb_rsp_t *rsp);
+void gdb_rsp_input(gdb_rsp_t *rsp, const uint8_t *data, uint32_t num);
+uint8_t gdb_rsp_poll(gdb_rsp_t *rsp);
+void gdb_rsp_detach(gdb_rsp_t *rsp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file    image_cache.h
+ * @brief   RAM cache of decoded images with LRU eviction
+ */
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <stdint.h>
+#include "page_asm.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Target size of one page chunk allocation (at least one page per chunk).
+#define IMAGE_CACHE_CHUNK_SIZE  0x10000U
+
+//! Content hash of the source file: size plus two independent 32-bit hashes.
+typedef struct
+{
+	uint32_t size;
+	uint32_t crc;                   // CRC-32
+	uint32_t fnv;                   // FNV-1a
+} image_cache_key_t;
+
+//! Memory provider, NULL selects PSRAM on the probe and malloc on a host.
+typedef struct
+{
+	void *(*alloc)(void *ctx, uint32_t size);
+	void (*free)(void *ctx, void *ptr);
+	void *ctx;
+} image_cache_alloc_t;
+
+typedef struct
+{
+	uint32_t addr;                  // page_size aligned target address
+	uint32_t crc;                   // CRC-32 of the page
+} image_cache_page_t;
+
+typedef struct image_cache_chunk image_cache_chunk_t;
+typedef struct image_cache_entry image_cache_entry_t;
+
+struct image_cache_entry
+{
+	image_cache_entry_t *prev;      // LRU list, head is the most recently used
+	image_cache_entry_t *next;
+	image_cache_key_t key;
+	uint32_t page_size;             // normally the sector size, so page CRCs are sector hashes
+	uint32_t page_count;
+	uint32_t bytes;                 // memory charged to the cache
+	uint32_t users;                 // pinned while non-zero
+	uint8_t complete;               // only complete entries are found
+	image_cache_chunk_t *first;
+	image_cache_chunk_t *last;
+};
+
+typedef struct
+{
+	image_cache_alloc_t alloc;
+	uint32_t capacity;              // bytes
+	uint32_t used;
+	uint32_t entry_count;
+	image_cache_entry_t *head;
+	image_cache_entry_t *tail;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;
+} image_cache_t;
+
+//! Builder: page_write_t sink that fills a new entry.
+typedef struct
+{
+	image_cache_t *cache;
+	image_cache_entry_t *entry;
+} image_cache_builder_t;
+
+void image_cache_init(image_cache_t *c, uint32_t capacity, const image_cache_alloc_t *alloc);
+void image_cache_deinit(image_cache_t *c);
+
+void image_cache_key_init(image_cache_key_t *key);
+void image_cache_key_update(image_cache_key_t *key, const uint8_t *data, uint32_t size);
+
+image_cache_entry_t *image_cache_find(image_cache_t *c, const image_cache_key_t *key);
+void image_cache_release(image_cache_t *c, image_cache_entry_t *entry);
+
+dap_err_t image_cache_begin(image_cache_t *c, const image_cache_key_t *key, uint32_t page_size,
+                            image_cache_builder_t *b);
+dap_err_t image_cache_page(void *b, uint32_t addr, const uint8_t *data, uint32_t size);
+image_cache_entry_t *image_cache_commit(image_cache_builder_t *b);
+void image_cache_abort(image_cache_builder_t *b);
+
+dap_err_t image_cache_replay(const image_cache_entry_t *entry, page_write_t write, void *ctx);
+uint8_t image_cache_page_crc(const image_cache_entry_t *entry, uint32_t addr, uint32_t *crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
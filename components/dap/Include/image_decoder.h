@@ -0,0 +1,100 @@
+/**
+ * @file    image_decoder.h
+ * @brief   Streaming Intel HEX / S-record / ELF / UF2 / binary image decoder
+ */
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <stdint.h>
+#include "page_asm.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+	IMAGE_FORMAT_UNKNOWN = 0,       // detect from the first bytes
+	IMAGE_FORMAT_HEX,
+	IMAGE_FORMAT_SREC,
+	IMAGE_FORMAT_ELF,
+	IMAGE_FORMAT_UF2,
+	IMAGE_FORMAT_BIN,               // raw binary at the base address, never detected
+} image_format_t;
+
+//! Longest decoded HEX / S-record line: length, address, type, 255 data bytes, checksum.
+#define IMAGE_LINE_MAX          260U
+
+//! Maximum number of PT_LOAD segments with file contents in an ELF image.
+#define IMAGE_ELF_MAX_SEGMENTS  16U
+
+//! UF2 block layout.
+#define IMAGE_UF2_BLOCK_SIZE    512U
+#define IMAGE_UF2_HEADER_SIZE   32U
+#define IMAGE_UF2_PAYLOAD_MAX   476U
+
+typedef struct
+{
+	uint32_t offset;                // file offset
+	uint32_t size;                  // bytes in file (p_filesz)
+	uint32_t addr;                  // load address (p_paddr)
+} image_segment_t;
+
+typedef struct
+{
+	image_format_t format;
+	image_record_t record;
+	void *ctx;
+	uint32_t position;              // input bytes consumed
+	uint32_t base;                  // BIN base, HEX extended address
+	uint32_t uf2_family;            // UF2 family ID filter, 0 = family of the first block
+	uint8_t done;                   // end of image reached, further input is ignored
+	uint8_t state;
+	uint8_t detect[4];              // first bytes while the format is unknown
+	uint8_t detect_len;
+	union
+	{
+		struct
+		{
+			uint8_t line[IMAGE_LINE_MAX];
+			uint16_t len;           // decoded bytes in line
+			uint8_t high;           // pending high nibble
+			uint8_t type;           // S-record type digit
+		} text;
+		struct
+		{
+			uint8_t hdr[52];        // ELF header, then one program header at a time
+			uint32_t hdr_len;
+			uint32_t phoff;
+			uint32_t phnum;
+			uint32_t ph_index;
+			image_segment_t seg[IMAGE_ELF_MAX_SEGMENTS];
+			uint32_t seg_count;
+			uint32_t seg_index;
+		} elf;
+		struct
+		{
+			uint8_t hdr[IMAGE_UF2_HEADER_SIZE];
+			uint8_t tail[4];
+			uint32_t pos;           // position within the current block
+			uint32_t blocks;        // blocks of the selected family seen
+			uint32_t num_blocks;    // numBlocks of the selected family
+			uint32_t family;        // selected family, 0 = blocks without family ID
+			uint8_t selected;       // family chosen (first block matching uf2_family)
+			uint8_t match;          // current block belongs to the selected family
+		} uf2;
+	} u;
+} image_decoder_t;
+
+image_format_t image_detect(const uint8_t *data, uint32_t size);
+void image_decoder_init(image_decoder_t *dec, image_format_t format, uint32_t base,
+                        image_record_t record, void *ctx);
+dap_err_t image_decoder_write(image_decoder_t *dec, const uint8_t *data, uint32_t size);
+dap_err_t image_decoder_finish(image_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
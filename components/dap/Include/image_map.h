@@ -0,0 +1,99 @@
+/**
+ * @file    image_map.h
+ * @brief   Read-only mapped image partition
+ */
+#ifndef IMAGE_MAP_H
+#define IMAGE_MAP_H
+
+#include <stdint.h>
+#include "page_asm.h"
+#include "error.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_partition.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Header magic ("DIMG") and layout version.
+#define IMAGE_MAP_MAGIC         0x474D4944U
+#define IMAGE_MAP_VERSION       1U
+
+//! Partition type and subtype of image partitions (data, custom).
+#define IMAGE_MAP_PART_TYPE     0x01
+#define IMAGE_MAP_PART_SUBTYPE  0x40
+
+//! header.format of an image_store container (not an image_format_t).
+#define IMAGE_MAP_FORMAT_STORE  0x80U
+
+//! Partitions that can be open at the same time (see image_map.c, partition owners).
+#define IMAGE_MAP_OWNERS        4U
+
+//! Erase granularity of the writer, larger aligned ranges are erased in blocks.
+#define IMAGE_MAP_SECTOR_SIZE   0x1000U
+#define IMAGE_MAP_BLOCK_SIZE    0x10000U
+
+//! Partition header, the image follows directly.
+typedef struct
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t format;                // image_format_t or IMAGE_MAP_FORMAT_STORE
+	uint32_t base;                  // load address of IMAGE_FORMAT_BIN
+	uint32_t size;                  // image bytes after the header
+	uint32_t crc;                   // CRC-32 of the image bytes
+	uint32_t reserved[3];
+} image_map_header_t;
+
+typedef struct
+{
+	image_map_header_t header;
+	const uint8_t *data;            // header.size bytes, read only
+	const char *owner;              // partition held as a reader, NULL when closed
+#ifdef ESP_PLATFORM
+	esp_partition_mmap_handle_t handle;
+#else
+	void *base;
+	uint32_t map_size;
+#endif
+} image_map_t;
+
+//! Sequential writer, erases ahead of the data.
+typedef struct
+{
+	image_map_header_t header;
+	uint32_t offset;                // next image byte
+	uint32_t erased;                // partition bytes erased so far
+	uint32_t part_size;
+	uint32_t checked;               // image bytes read back for the CRC
+	uint32_t crc;                   // CRC-32 of the bytes read back
+	const char *owner;              // partition held as the writer, NULL when closed
+#ifdef ESP_PLATFORM
+	const esp_partition_t *part;
+#else
+	int fd;
+#endif
+} image_map_writer_t;
+
+dap_err_t image_map_open(image_map_t *m, const char *name);
+void image_map_close(image_map_t *m);
+dap_err_t image_map_check(const image_map_t *m);
+const uint8_t *image_map_view(const image_map_t *m, uint32_t offset, uint32_t size);
+dap_err_t image_map_program(const image_map_t *m, uint32_t page_size, uint8_t fill, uint8_t *buf,
+                            page_write_t write, void *ctx);
+
+dap_err_t image_map_writer_open(image_map_writer_t *w, const char *name);
+dap_err_t image_map_writer_write(void *w, const void *data, uint32_t size);
+dap_err_t image_map_writer_patch(image_map_writer_t *w, uint32_t offset, const void *data, uint32_t size);
+dap_err_t image_map_writer_verify(image_map_writer_t *w, uint32_t max);
+dap_err_t image_map_writer_close(image_map_writer_t *w, uint16_t format, uint32_t base,
+                                 const uint32_t *crc_expected);
+void image_map_writer_abort(image_map_writer_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
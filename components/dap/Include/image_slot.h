@@ -0,0 +1,49 @@
+/**
+ * @file    image_slot.h
+ * @brief   Store decoded images as compressed containers on the image partition
+ */
+#ifndef IMAGE_SLOT_H
+#define IMAGE_SLOT_H
+
+#include <stdint.h>
+#include "image_decoder.h"
+#include "image_store.h"
+#include "image_map.h"
+#include "page_asm.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Default partition label.
+#define IMAGE_SLOT_PARTITION    "image"
+
+//! Block size of the stored container, also the page size of the assembler.
+#define IMAGE_SLOT_BLOCK_SIZE   0x1000U
+
+//! Page buffers of the assembler.
+#define IMAGE_SLOT_PAGES        4U
+
+typedef struct
+{
+	const char *name;               // partition label (file path on a host)
+	image_map_writer_t out;
+	image_store_writer_t store;
+	page_asm_t pages;
+	uint8_t *pool;
+	uint16_t *hash;
+	uint8_t *comp;
+	uint8_t open;
+} image_slot_t;
+
+void image_slot_init(image_slot_t *slot, const char *name);
+dap_err_t image_slot_open(void *slot, image_format_t format);
+dap_err_t image_slot_record(void *slot, uint32_t addr, const uint8_t *data, uint32_t size);
+dap_err_t image_slot_close(void *slot, dap_err_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file    image_store.h
+ * @brief   Compressed image container with per-sector blocks
+ */
+#ifndef IMAGE_STORE_H
+#define IMAGE_STORE_H
+
+#include <stdint.h>
+#include "page_asm.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Container magic ("DLZ1") and layout version.
+#define IMAGE_STORE_MAGIC       0x315A4C44U
+#define IMAGE_STORE_VERSION     1U
+
+//! Largest block (raw bytes). Block offsets must fit the 16-bit match window.
+#define IMAGE_STORE_BLOCK_MAX   0x8000U
+
+//! comp_size flag: block is stored without compression.
+#define IMAGE_STORE_STORED      0x80000000U
+
+//! Compressor hash table: (1 << IMAGE_STORE_HASH_BITS) uint16_t entries.
+#define IMAGE_STORE_HASH_BITS   12U
+#define IMAGE_STORE_HASH_SIZE   (1U << IMAGE_STORE_HASH_BITS)
+
+//! Worst case compressed size of a block of n bytes.
+#define IMAGE_STORE_BOUND(n)    ((n) + ((n) / 255U) + 16U)
+
+//! Sequential output callback of the writer.
+typedef dap_err_t (*image_store_out_t)(void *ctx, const void *data, uint32_t size);
+
+//! Container header at offset 0. Blocks follow, each as image_store_block_t
+//! plus comp_size bytes of LZ4 block data (or raw data if stored).
+typedef struct
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t flags;                 // reserved, 0
+	uint32_t block_size;            // blocks never cross a block_size boundary
+	uint32_t block_count;
+	uint32_t raw_size;              // sum of raw block sizes
+	uint32_t data_size;             // bytes following the header
+	uint32_t crc;                   // CRC-32 of all raw data in block order
+	uint32_t reserved;
+} image_store_header_t;
+
+typedef struct
+{
+	uint32_t addr;                  // target address, block_size aligned
+	uint32_t raw_size;
+	uint32_t comp_size;             // bytes following, | IMAGE_STORE_STORED
+	uint32_t crc;                   // CRC-32 of the raw block
+} image_store_block_t;
+
+//! Writer: page_write_t sink for a page_asm_t with page_size == block_size.
+typedef struct
+{
+	image_store_header_t header;
+	image_store_out_t out;
+	void *ctx;
+	uint16_t *hash;                 // IMAGE_STORE_HASH_SIZE entries
+	uint8_t *comp;                  // IMAGE_STORE_BOUND(block_size) bytes
+} image_store_writer_t;
+
+uint32_t image_store_compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size, uint16_t *hash);
+dap_err_t image_store_decompress(const uint8_t *src, uint32_t src_size, uint8_t *dst, uint32_t dst_size,
+                                 uint32_t *size);
+
+dap_err_t image_store_writer_init(image_store_writer_t *w, uint32_t block_size, image_store_out_t out, void *ctx,
+                                  uint16_t *hash, uint8_t *comp);
+dap_err_t image_store_writer_block(void *w, uint32_t addr, const uint8_t *data, uint32_t size);
+
+dap_err_t image_store_check_header(const image_store_header_t *header);
+dap_err_t image_store_check_block(const image_store_header_t *header, const image_store_block_t *block);
+dap_err_t image_store_decode_block(const image_store_block_t *block, const uint8_t *src, uint8_t *dst,
+                                   uint32_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file    itm_decoder.h
+ * @brief   Streaming ITM/DWT packet decoder with port and packet filtering
+ */
+#ifndef ITM_DECODER_H
+#define ITM_DECODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Filter flags
+#define ITM_FILTER_ENABLE       (1U << 0)   // decode instead of passing raw SWO data
+#define ITM_FILTER_TIMESTAMP    (1U << 1)   // records carry the local timestamp delta
+#define ITM_FILTER_GLOBAL       (1U << 2)   // emit global timestamp records
+#define ITM_FILTER_OVERFLOW     (1U << 3)   // emit overflow records
+
+// Compact record: header [, timestamp] [, payload]
+//   header    bits 7..6 payload size (0 = none, 1, 2 or 4 bytes)
+//             bit  5    0 = stimulus port, 1 = DWT packet
+//             bits 4..0 stimulus port or DWT discriminator
+//   timestamp LEB128 local time since the previous record (ITM_FILTER_TIMESTAMP)
+//   payload   little endian
+// Records without payload: ITM_RECORD_OVERFLOW, and ITM_RECORD_GLOBAL
+// followed by the LEB128 global timestamp.
+#define ITM_RECORD_HEADER(size, hw, id) \
+	((uint8_t)((((size) == 4U ? 3U : (size)) << 6) | ((hw) ? 0x20U : 0U) | ((id) & 0x1FU)))
+#define ITM_RECORD_OVERFLOW     0x00U
+#define ITM_RECORD_GLOBAL       0x20U
+#define ITM_RECORD_MAX          16U         // header, 5 byte delta, 10 byte global timestamp
+
+// Records held back until the local timestamp that follows them
+#define ITM_DECODER_PENDING     8U
+
+// Output space that always holds the records decoded from num input bytes
+// (worst case: 2 byte global timestamp packets)
+#define ITM_DECODER_SPACE(num)  ((num) * 8U + ITM_DECODER_PENDING * ITM_RECORD_MAX)
+
+typedef void (*itm_output_t)(void *ctx, const uint8_t *data, uint32_t num);
+
+typedef struct
+{
+	uint32_t ports;                 // stimulus ports forwarded as records
+	uint32_t text;                  // stimulus ports forwarded as text
+	uint32_t hardware;              // DWT discriminators forwarded as records
+	uint32_t flags;                 // ITM_FILTER_*
+} itm_filter_t;
+
+typedef struct
+{
+	itm_filter_t filter;
+	itm_output_t record;            // compact records
+	itm_output_t text;              // payload of the text ports
+	void *ctx;
+
+	// Packet parser
+	uint8_t state;
+	uint8_t header;
+	uint8_t need;                   // payload bytes of a source packet
+	uint8_t count;                  // payload bytes received
+	uint8_t zeros;                  // zero bytes seen, 5 and 0x80 is a sync packet
+	uint8_t page;                   // stimulus port page from an extension packet
+	uint32_t value;
+
+	// Timestamps
+	uint8_t timed;                  // local timestamps seen, records wait for them
+	uint8_t pending;
+	struct
+	{
+		uint8_t header;
+		uint32_t value;
+	} queue[ITM_DECODER_PENDING];
+	uint64_t local;                 // sum of local timestamp deltas
+	uint64_t emitted;               // local time of the last record
+	uint64_t global;
+
+	uint8_t line[64];               // text, output per line and per chunk
+	uint32_t length;
+
+	// Statistics
+	uint32_t packets;               // source packets decoded
+	uint32_t filtered;              // source packets dropped by the filter
+	                                // (stimulus pages above 0 are always dropped)
+	uint32_t overflows;             // overflow packets received
+} itm_decoder_t;
+
+void itm_decoder_init(itm_decoder_t *dec, const itm_filter_t *filter, itm_output_t record,
+                      itm_output_t text, void *ctx);
+void itm_decoder_decode(itm_decoder_t *dec, const uint8_t *data, uint32_t num);
+void itm_decoder_flush(itm_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file    jtag_spi.h
+ * @brief   JTAG shift engine on the SPI peripheral
+ */
+#ifndef JTAG_SPI_H
+#define JTAG_SPI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Longest run of TCK cycles shifted in one SPI transaction (64 byte FIFO, no DMA)
+#define JTAG_SPI_MAX_BITS       512U
+
+void jtag_spi_init(void);
+uint8_t jtag_spi_available(void);
+uint8_t jtag_spi_worth(uint32_t bits);
+uint8_t jtag_spi_shift(const uint8_t *tdi, uint8_t *tdo, uint32_t bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file    page_asm.h
+ * @brief   Zero-allocation flash page assembler
+ */
+#ifndef PAGE_ASM_H
+#define PAGE_ASM_H
+
+#include <stdint.h>
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Maximum number of page buffers an assembler can use.
+#define PAGE_ASM_MAX_SLOTS      8U
+
+//! Record callback: data at a target address, used by the image decoders.
+typedef dap_err_t (*image_record_t)(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size);
+
+//! Page callback: one complete, page-aligned page to be programmed.
+typedef dap_err_t (*page_write_t)(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size);
+
+typedef struct
+{
+	uint8_t *pool;                  // slot_count * page_size bytes, supplied by the caller
+	uint32_t page_size;             // power of 2
+	uint32_t slot_count;
+	uint32_t slot_addr[PAGE_ASM_MAX_SLOTS];
+	uint8_t slot_used[PAGE_ASM_MAX_SLOTS];
+	uint8_t fill;                   // value of bytes not covered by any record
+	uint32_t flushed;               // pages below this address have been written
+	uint32_t page_count;            // number of pages written
+	page_write_t write;
+	void *ctx;
+} page_asm_t;
+
+dap_err_t page_asm_init(page_asm_t *pa, uint8_t *pool, uint32_t pool_size, uint32_t page_size,
+                        uint8_t fill, page_write_t write, void *ctx);
+dap_err_t page_asm_record(void *pa, uint32_t addr, const uint8_t *data, uint32_t size);
+dap_err_t page_asm_flush(page_asm_t *pa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file    sector_map.h
+ * @brief   Mixed-geometry flash sector map and erase planning
+ */
+#ifndef SECTOR_MAP_H
+#define SECTOR_MAP_H
+
+#include <stdint.h>
+#include "flash_blob.h"
+#include "flash_algo.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Maximum number of runs (regions of equally sized sectors) in a map.
+#define SECTOR_MAP_MAX_RUNS     64U
+
+//! Run of equally sized, contiguous sectors.
+typedef struct
+{
+	uint32_t start;                 // address of the first sector
+	uint32_t end;                   // address following the last sector
+	uint32_t size;                  // sector size
+	uint32_t first;                 // map-wide index of the first sector
+} sector_run_t;
+
+//! Sector map, runs sorted by address and non-overlapping.
+typedef struct
+{
+	sector_run_t runs[SECTOR_MAP_MAX_RUNS];
+	uint32_t run_count;
+	uint32_t sector_count;          // total number of sectors
+	uint32_t hint;                  // run of the last lookup, speeds up sequential access
+} sector_map_t;
+
+//! Contiguous sectors, the unit of an erase plan.
+typedef struct
+{
+	uint32_t start;                 // address of the first sector
+	uint32_t size;                  // number of bytes covered
+	uint32_t first;                 // map-wide index of the first sector
+	uint32_t count;                 // number of sectors
+} sector_extent_t;
+
+//! Address range to be programmed.
+typedef struct
+{
+	uint32_t start;
+	uint32_t size;
+} sector_range_t;
+
+void sector_map_init(sector_map_t *map);
+dap_err_t sector_map_add(sector_map_t *map, const sector_info_t *sectors, uint32_t count,
+                         uint32_t dev_start, uint32_t dev_size);
+dap_err_t sector_map_add_algo(sector_map_t *map, const flash_algo_t *algo);
+uint8_t sector_map_lookup(sector_map_t *map, uint32_t addr, sector_info_t *sector, uint32_t *index);
+dap_err_t sector_map_range(sector_map_t *map, uint32_t addr, uint32_t size, sector_extent_t *extent);
+dap_err_t sector_map_plan(sector_map_t *map, sector_range_t *ranges, uint32_t range_count,
+                          sector_extent_t *plan, uint32_t plan_size, uint32_t *plan_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file    swd_autotune.h
+ * @brief   SWD clock auto-tuning: find the fastest reliable SWCLK per target
+ */
+#ifndef SWD_AUTOTUNE_H
+#define SWD_AUTOTUNE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Clock used to connect and to read the target ID before tuning.
+#define SWD_AUTOTUNE_SAFE_CLOCK     1000000U
+
+//! Margin (in percent) subtracted from the highest clean frequency.
+#define SWD_AUTOTUNE_MARGIN         10U
+
+//! Number of RAM pattern passes run at each frequency step.
+#define SWD_AUTOTUNE_PASSES         4U
+
+//! Size of the RAM window used for the read/write pattern check.
+#define SWD_AUTOTUNE_PATTERN_SIZE   64U
+
+//! Number of bisection steps between the last good and first bad frequency.
+#define SWD_AUTOTUNE_BISECT_STEPS   3U
+
+//! Number of target IDs kept in the RAM cache.
+#define SWD_AUTOTUNE_CACHE_SIZE     8U
+
+//! Flags for swd_autotune_clock() and swd_autotune_start().
+#define SWD_AUTOTUNE_FORCE          (1U << 0)   // Ignore cached result and re-tune
+
+//! State of a background tune, swd_autotune_status().
+#define SWD_AUTOTUNE_IDLE           0U          // No tune started on this port
+#define SWD_AUTOTUNE_BUSY           1U          // Tune running
+#define SWD_AUTOTUNE_DONE           2U          // Tuned clock applied
+#define SWD_AUTOTUNE_FAILED         3U          // Tune failed, SWCLK is the safe clock
+
+uint8_t swd_autotune_clock(uint32_t ram_addr, uint32_t max_clock, uint32_t flags, uint32_t *clock);
+uint8_t swd_autotune_start(uint32_t port, uint32_t ram_addr, uint32_t max_clock, uint32_t flags);
+uint8_t swd_autotune_status(uint32_t port, uint32_t *clock);
+uint8_t swd_autotune_lookup(uint32_t idcode, uint32_t *clock);
+void swd_autotune_forget(uint32_t idcode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
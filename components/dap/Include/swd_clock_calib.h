@@ -0,0 +1,34 @@
+/**
+ * @file    swd_clock_calib.h
+ * @brief   Measured SWCLK calibration: requested frequency to delay lookup
+ */
+#ifndef SWD_CLOCK_CALIB_H
+#define SWD_CLOCK_CALIB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Number of SWCLK cycles timed per calibration point.
+#define SWD_CALIB_CYCLES    256U
+
+//! Number of timing runs per point, the fastest run is kept.
+#define SWD_CALIB_RUNS      3U
+
+//! Measure callback: generate cycles SWCLK periods with the given delay.
+//!   delay:  PIN_DELAY_SLOW argument, 0 = fast clock path
+//!   cycles: number of SWCLK periods to generate, 0 = time the fixed cost only
+//!   return: elapsed CPU cycles (CCOUNT on the probe, simulated on the host)
+typedef uint32_t (*swd_calib_measure_t)(uint32_t delay, uint32_t cycles);
+
+uint8_t swd_clock_calibrate(swd_calib_measure_t measure, uint32_t cpu_clock);
+uint8_t swd_clock_calibrated(void);
+uint8_t swd_clock_lookup(uint32_t clock, uint32_t *delay, uint8_t *fast, uint32_t *actual);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file    swd_gang.h
+ * @brief   Gang programming: bit-parallel SWD to several targets sharing SWCLK
+ */
+#ifndef SWD_GANG_H
+#define SWD_GANG_H
+
+#include <stdint.h>
+#include "flash_blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Target masks: bit n = target n (SWD_GANG_SWDIO_PINS[n]).
+// Every operation runs on the active targets and returns the mask of
+// targets still active afterwards; 0 means all of them failed.
+
+uint8_t swd_gang_init(uint8_t count);
+void swd_gang_off(void);
+uint8_t swd_gang_active(void);
+uint8_t swd_gang_failed(void);
+void swd_gang_disable(uint8_t mask);
+void swd_gang_set_reset(uint8_t mask, uint8_t asserted);
+
+uint8_t swd_gang_init_debug(uint32_t *idcode);
+uint8_t swd_gang_reset_program(void);
+uint8_t swd_gang_read_word(uint32_t addr, uint32_t *val);
+uint8_t swd_gang_write_word(uint32_t addr, uint32_t val);
+uint8_t swd_gang_write_memory(uint32_t address, const uint8_t *data, uint32_t size);
+uint8_t swd_gang_verify_memory(uint32_t address, const uint8_t *data, uint32_t size);
+uint8_t swd_gang_flash_syscall_exec(const program_syscall_t *sysCallParam, uint32_t entry, uint32_t arg1,
+                                    uint32_t arg2, uint32_t arg3, uint32_t arg4);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
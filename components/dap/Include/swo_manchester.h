@@ -0,0 +1,47 @@
+/**
+ * @file    swo_manchester.h
+ * @brief   Manchester SWO decoder: edge durations to trace bytes
+ */
+#ifndef SWO_MANCHESTER_H
+#define SWO_MANCHESTER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Input words use the RMT symbol layout (rmt_symbol_word_t.val):
+//   bits  0..14 duration0, bit 15 level0, bits 16..30 duration1, bit 31 level1
+// A duration of 0 marks the idle line at the end of a received frame.
+#define SWO_MANCHESTER_SYMBOL(d0, l0, d1, l1) \
+	(((uint32_t)(d0) & 0x7FFFU) | ((uint32_t)((l0) != 0) << 15) | \
+	 (((uint32_t)(d1) & 0x7FFFU) << 16) | ((uint32_t)((l1) != 0) << 31))
+
+typedef struct
+{
+	uint32_t nominal;               // expected half-bit time in ticks, 0 = accept any start bit
+	uint32_t estimate;              // half-bit time learned from previous packets in 1/16 ticks
+	uint32_t half;                  // half-bit time of the current packet in 1/16 ticks, 0 = idle
+
+	uint8_t slot;                   // 0 = first half of a bit next, 1 = second half
+	uint8_t level;                  // level of the first half of the current bit
+	uint8_t started;                // start bit received
+	uint8_t bits;                   // data bits collected in byte
+	uint8_t byte;
+
+	// Statistics
+	uint32_t packets;               // packets terminated by idle line
+	uint32_t errors;                // packets dropped on a coding error
+	uint32_t dropped;               // bytes lost because the output buffer was full
+} swo_manchester_t;
+
+void swo_manchester_init(swo_manchester_t *dec, uint32_t nominal);
+uint32_t swo_manchester_decode(swo_manchester_t *dec, const uint32_t *symbols, uint32_t count,
+                               uint8_t *out, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file    target_lz4.h
+ * @brief   Target-side expansion of compressed image_store blocks
+ */
+#ifndef TARGET_LZ4_H
+#define TARGET_LZ4_H
+
+#include <stdint.h>
+#include "flash_blob.h"
+#include "image_store.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Target RAM used next to the flash algorithm.
+typedef struct
+{
+	uint32_t code;                  // decompressor load address
+	uint32_t entry;                 // decompressor entry point (Thumb)
+	uint32_t staging;               // expanded block, programmed page by page from here
+	uint32_t input;                 // compressed block as uploaded
+	uint32_t block_size;
+} target_lz4_t;
+
+dap_err_t target_lz4_place(const program_target_t *algo, uint32_t block_size, target_lz4_t *t);
+dap_err_t target_lz4_load(const target_lz4_t *t);
+dap_err_t target_lz4_program(const program_target_t *algo, const target_lz4_t *t,
+                             const image_store_block_t *block, const uint8_t *payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
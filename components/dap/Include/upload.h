@@ -0,0 +1,74 @@
+/**
+ * @file    upload.h
+ * @brief   Pipelined image upload over DAP vendor commands
+ */
+#ifndef UPLOAD_H
+#define UPLOAD_H
+
+#include <stdint.h>
+#include "image_map.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Vendor command IDs (ID_DAP_Vendor3 .. ID_DAP_Vendor6).
+#define UPLOAD_CMD_BEGIN        0x83U
+#define UPLOAD_CMD_DATA         0x84U
+#define UPLOAD_CMD_END          0x85U
+#define UPLOAD_CMD_STATUS       0x86U
+
+//! Command sizes for 64-byte DAP packets.
+#define UPLOAD_PACKET_SIZE      64U
+#define UPLOAD_DATA_HEADER      10U     // command, offset, CRC, length
+#define UPLOAD_CHUNK_MAX        (UPLOAD_PACKET_SIZE - UPLOAD_DATA_HEADER)
+
+//! END response status while the read-back is running, the host sends END again.
+#define UPLOAD_BUSY             0x01U
+
+//! Image bytes read back for the CRC per END command, well within the host timeout.
+#define UPLOAD_VERIFY_STEP      0x8000U
+
+//! STATUS states.
+#define UPLOAD_STATE_IDLE       0U
+#define UPLOAD_STATE_DATA       1U      // receiving DATA
+#define UPLOAD_STATE_VERIFY     2U      // END is reading the partition back
+
+//! Upload destinations.
+#define UPLOAD_TARGET_IMAGE     0U      // image partition
+#define UPLOAD_TARGET_ALGO      1U      // flash algorithm partition (.FLM file)
+#define UPLOAD_TARGETS          2U
+
+//! Default partition labels.
+#define UPLOAD_PART_IMAGE       "image"
+#define UPLOAD_PART_ALGO        "algo"
+
+typedef struct
+{
+	const char *name[UPLOAD_TARGETS];   // partition labels, file paths on a host
+	image_map_writer_t out;
+	uint8_t active;
+	uint8_t verify;                     // END has started the read-back
+	uint8_t target;
+	uint16_t format;
+	uint32_t base;
+	uint32_t size;
+	uint32_t crc;                       // expected CRC-32 of the whole file
+	uint32_t running;                   // CRC-32 of the bytes received so far
+} upload_t;
+
+void upload_init(upload_t *u, const char *image, const char *algo);
+dap_err_t upload_begin(upload_t *u, uint8_t target, uint16_t format, uint32_t base, uint32_t size, uint32_t crc,
+                       uint32_t *offset);
+dap_err_t upload_data(upload_t *u, uint32_t offset, const uint8_t *data, uint32_t size, uint32_t crc,
+                      uint32_t *next);
+dap_err_t upload_end(upload_t *u);
+void upload_abort(upload_t *u);
+uint32_t upload_command(upload_t *u, uint8_t cmd, const uint8_t *request, uint8_t *response);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file    virtual_fs.h
+ * @brief   Virtual FAT16 volume for drag-and-drop programming
+ */
+#ifndef VIRTUAL_FS_H
+#define VIRTUAL_FS_H
+
+#include <stdint.h>
+#include "image_decoder.h"
+#include "error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Volume geometry: 64 MB, 4 KB clusters, FAT16.
+#define VFS_SECTOR_SIZE         512U
+#define VFS_SECTOR_COUNT        131072U
+#define VFS_CLUSTER_SECTORS     8U
+#define VFS_FAT_SECTORS         64U
+#define VFS_ROOT_ENTRIES        512U
+
+#define VFS_FAT_START           1U
+#define VFS_ROOT_START          (VFS_FAT_START + 2U * VFS_FAT_SECTORS)
+#define VFS_DATA_START          (VFS_ROOT_START + VFS_ROOT_ENTRIES * 32U / VFS_SECTOR_SIZE)
+
+//! Destination of the files copied onto the volume.
+typedef struct
+{
+	dap_err_t (*open)(void *ctx, image_format_t format);    // a new file was detected
+	image_record_t record;                                  // decoded data
+	dap_err_t (*close)(void *ctx, dap_err_t status);        // end of file, returns the job result
+	void *ctx;
+} virtual_fs_sink_t;
+
+typedef struct
+{
+	virtual_fs_sink_t sink;
+	image_decoder_t dec;
+	uint8_t state;
+	uint8_t changed;                // a job finished since virtual_fs_changed()
+	uint32_t next_sector;           // expected sector of the file being received
+	uint32_t received;              // bytes decoded in the current or last job
+	uint32_t jobs;
+	dap_err_t result;               // result of the last job
+	image_format_t format;
+} virtual_fs_t;
+
+void virtual_fs_init(virtual_fs_t *vfs, const virtual_fs_sink_t *sink);
+void virtual_fs_read(virtual_fs_t *vfs, uint32_t sector, uint8_t *buf);
+void virtual_fs_write(virtual_fs_t *vfs, uint32_t sector, const uint8_t *buf);
+void virtual_fs_timeout(virtual_fs_t *vfs);
+void virtual_fs_status_copy(virtual_fs_t *view, const virtual_fs_t *vfs);
+uint8_t virtual_fs_changed(virtual_fs_t *vfs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
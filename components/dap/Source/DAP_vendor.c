@@ -1,128 +1,282 @@
-/**************************************************************************/ /**
- * @file     DAP_vendor.c
- * @brief    CMSIS-DAP Vendor Commands
- * @version  V1.10
- * @date     20. May 2015
- *
- * @note
- * Copyright (C) 2012-2015 ARM Limited. All rights reserved.
- *
- * @par
- * ARM Limited (ARM) is supplying this software for use with Cortex-M
- * processor based microcontrollers.
- *
- * @par
- * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
- * OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
- * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
- * ARM SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
- * CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
- *
- ******************************************************************************/
-
-#include "DAP_config.h"
-#include "DAP.h"
-
-//**************************************************************************************************
-/** 
-\defgroup DAP_Vendor_Adapt_gr Adapt Vendor Commands
-\ingroup DAP_Vendor_gr 
-@{
-
-The file DAP_vendor.c provides template source code for extension of a Debug Unit with 
-Vendor Commands. Copy this file to the project folder of the Debug Unit and add the 
-file to the MDK-ARM project under the file group Configuration.
-*/
-
-/** Process DAP Vendor Command and prepare Response Data
-\param request   pointer to request data
-\param response  pointer to response data
-\return          number of bytes in response (lower 16 bits)
-                 number of bytes in request (upper 16 bits)
-*/
-uint32_t DAP_ProcessVendorCommand(const uint8_t *request, uint8_t *response)
-{
-	uint32_t num = (1U << 16) | 1U;
-
-	*response++ = *request; // copy Command ID
-
-	switch (*request++)
-	{ // first byte in request is Command ID
-	case ID_DAP_Vendor0:
-#if 0 // example user command
-      num += 1U << 16;           // increment request count
-      if (*request == 1U) {      // when first command data byte is 1
-        *response++ = 'X';       // send 'X' as response
-        num++;                   // increment response count
-      }
-#endif
-		break;
-
-	case ID_DAP_Vendor1:
-		break;
-	case ID_DAP_Vendor2:
-		break;
-	case ID_DAP_Vendor3:
-		break;
-	case ID_DAP_Vendor4:
-		break;
-	case ID_DAP_Vendor5:
-		break;
-	case ID_DAP_Vendor6:
-		break;
-	case ID_DAP_Vendor7:
-		break;
-	case ID_DAP_Vendor8:
-		break;
-	case ID_DAP_Vendor9:
-		break;
-	case ID_DAP_Vendor10:
-		break;
-	case ID_DAP_Vendor11:
-		break;
-	case ID_DAP_Vendor12:
-		break;
-	case ID_DAP_Vendor13:
-		break;
-	case ID_DAP_Vendor14:
-		break;
-	case ID_DAP_Vendor15:
-		break;
-	case ID_DAP_Vendor16:
-		break;
-	case ID_DAP_Vendor17:
-		break;
-	case ID_DAP_Vendor18:
-		break;
-	case ID_DAP_Vendor19:
-		break;
-	case ID_DAP_Vendor20:
-		break;
-	case ID_DAP_Vendor21:
-		break;
-	case ID_DAP_Vendor22:
-		break;
-	case ID_DAP_Vendor23:
-		break;
-	case ID_DAP_Vendor24:
-		break;
-	case ID_DAP_Vendor25:
-		break;
-	case ID_DAP_Vendor26:
-		break;
-	case ID_DAP_Vendor27:
-		break;
-	case ID_DAP_Vendor28:
-		break;
-	case ID_DAP_Vendor29:
-		break;
-	case ID_DAP_Vendor30:
-		break;
-	case ID_DAP_Vendor31:
-		break;
-	}
-
-	return (num);
-}
-
-///@}
+/**************************************************************************/ /**
+ * @file     DAP_vendor.c
+ * @brief    CMSIS-DAP Vendor Commands
+ * @version  V1.10
+ * @date     20. May 2015
+ *
+ * @note
+ * Copyright (C) 2012-2015 ARM Limited. All rights reserved.
+ *
+ * @par
+ * ARM Limited (ARM) is supplying this software for use with Cortex-M
+ * processor based microcontrollers.
+ *
+ * @par
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ * OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * ARM SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ ******************************************************************************/
+
+#include "DAP_config.h"
+#include "DAP.h"
+#include "swd_autotune.h"
+#include "upload.h"
+#include "rtt.h"
+#include "prog_job.h"
+
+// Vendor Command IDs used by this Debug Unit
+#define ID_DAP_Vendor_SWD_AutoTune ID_DAP_Vendor1  // Tune SWCLK for the connected target
+#define ID_DAP_Vendor_SWJ_ClockInfo ID_DAP_Vendor2 // Report requested and achieved SWCLK
+#define ID_DAP_Vendor_UploadBegin  ID_DAP_Vendor3  // Start or resume an image upload
+#define ID_DAP_Vendor_UploadData   ID_DAP_Vendor4  // Image upload chunk
+#define ID_DAP_Vendor_UploadEnd    ID_DAP_Vendor5  // Check and commit the upload
+#define ID_DAP_Vendor_UploadStatus ID_DAP_Vendor6  // Upload progress
+#define ID_DAP_Vendor_SWO_Filter   ID_DAP_Vendor7  // ITM decoder filter for the SWO trace
+#define ID_DAP_Vendor_RTT_Control  ID_DAP_Vendor8  // RTT control block search range and status
+#define ID_DAP_Vendor_TransferAdaptive ID_DAP_Vendor9 // Host opt-in to adaptive idle cycles after AP writes
+#define ID_DAP_Vendor_Program      ID_DAP_Vendor10 // Program the stored image into a port's target
+
+#define SWD_AutoTune_StatusOnly    0x80U           // AutoTune flag: report the state, start nothing
+#define TransferAdaptive_Query     0xFFU           // TransferAdaptive mode: report, change nothing
+#define Program_StatusOnly         0x80U           // Program flag: report the state, start nothing
+#define Program_ChipErase          0x01U           // Program flag: the image owns the device, chip erase allowed
+
+static upload_t upload[DAP_PORT_COUNT];           // Per port; the image partition owner (image_map.c) arbitrates between them
+
+//**************************************************************************************************
+/** 
+\defgroup DAP_Vendor_Adapt_gr Adapt Vendor Commands
+\ingroup DAP_Vendor_gr 
+@{
+
+The file DAP_vendor.c provides template source code for extension of a Debug Unit with 
+Vendor Commands. Copy this file to the project folder of the Debug Unit and add the 
+file to the MDK-ARM project under the file group Configuration.
+*/
+
+/** Process DAP Vendor Command and prepare Response Data
+\param request   pointer to request data
+\param response  pointer to response data
+\return          number of bytes in response (lower 16 bits)
+                 number of bytes in request (upper 16 bits)
+*/
+uint32_t DAP_ProcessVendorCommand(const uint8_t *request, uint8_t *response)
+{
+	uint32_t num = (1U << 16) | 1U;
+
+	*response++ = *request; // copy Command ID
+
+	switch (*request++)
+	{ // first byte in request is Command ID
+	case ID_DAP_Vendor0:
+#if 0 // example user command
+      num += 1U << 16;           // increment request count
+      if (*request == 1U) {      // when first command data byte is 1
+        *response++ = 'X';       // send 'X' as response
+        num++;                   // increment response count
+      }
+#endif
+		break;
+
+	case ID_DAP_Vendor_SWD_AutoTune:
+	{
+		// request:  flags (bit 0: ignore cached clock, bit 7: status only), max clock [31:0], RAM address [31:0]
+		// response: status, state (0: idle, 1: busy, 2: done, 3: failed), tuned clock [31:0]
+		// The tune runs in the background; poll with bit 7 set until the state is no longer busy.
+		uint32_t max_clock, ram_addr, clock;
+		uint8_t status = DAP_OK, state;
+
+		max_clock = (uint32_t)(*(request+1) <<  0) |
+		            (uint32_t)(*(request+2) <<  8) |
+		            (uint32_t)(*(request+3) << 16) |
+		            (uint32_t)(*(request+4) << 24);
+		ram_addr  = (uint32_t)(*(request+5) <<  0) |
+		            (uint32_t)(*(request+6) <<  8) |
+		            (uint32_t)(*(request+7) << 16) |
+		            (uint32_t)(*(request+8) << 24);
+		num += 9U << 16;
+
+		if (!(*request & SWD_AutoTune_StatusOnly) &&
+		    !swd_autotune_start(DAP_PortIndex(), ram_addr, max_clock, *request & SWD_AUTOTUNE_FORCE))
+		{
+			status = DAP_ERROR;
+		}
+		state = swd_autotune_status(DAP_PortIndex(), &clock);
+
+		*response++ = status;
+		*response++ = state;
+		*response++ = (uint8_t)(clock >>  0);
+		*response++ = (uint8_t)(clock >>  8);
+		*response++ = (uint8_t)(clock >> 16);
+		*response++ = (uint8_t)(clock >> 24);
+		num += 6U;
+	}
+		break;
+	case ID_DAP_Vendor_SWJ_ClockInfo:
+		// response: status, nominal clock [31:0], actual clock [31:0]
+		*response++ = DAP_OK;
+		*response++ = (uint8_t)(DAP_Data.nominal_clock >>  0);
+		*response++ = (uint8_t)(DAP_Data.nominal_clock >>  8);
+		*response++ = (uint8_t)(DAP_Data.nominal_clock >> 16);
+		*response++ = (uint8_t)(DAP_Data.nominal_clock >> 24);
+		*response++ = (uint8_t)(DAP_Data.actual_clock >>  0);
+		*response++ = (uint8_t)(DAP_Data.actual_clock >>  8);
+		*response++ = (uint8_t)(DAP_Data.actual_clock >> 16);
+		*response++ = (uint8_t)(DAP_Data.actual_clock >> 24);
+		num += 9U;
+		break;
+	case ID_DAP_Vendor_UploadBegin:
+	case ID_DAP_Vendor_UploadData:
+	case ID_DAP_Vendor_UploadEnd:
+	case ID_DAP_Vendor_UploadStatus:
+		num += upload_command(&upload[DAP_PortIndex()], *(request-1), request, response);
+		break;
+	case ID_DAP_Vendor_SWO_Filter:
+#if (SWO_ITM != 0)
+		if (DAP_PortIndex() == DAP_TRACE_PORT)
+		{
+			num += SWO_Filter(request, response);
+		}
+		else
+		{
+			*(response-1) = ID_DAP_Invalid;
+		}
+#endif
+		break;
+	case ID_DAP_Vendor_RTT_Control:
+	{
+		// request:  flags (bit 0: set search range), address [31:0], size [31:0] (0: address is the control block)
+		// response: status, control block [31:0] (0: not found), up bytes [31:0], down bytes [31:0]
+		rtt_status_t status;
+		uint32_t addr, size;
+
+		addr = (uint32_t)(*(request+1) <<  0) |
+		       (uint32_t)(*(request+2) <<  8) |
+		       (uint32_t)(*(request+3) << 16) |
+		       (uint32_t)(*(request+4) << 24);
+		size = (uint32_t)(*(request+5) <<  0) |
+		       (uint32_t)(*(request+6) <<  8) |
+		       (uint32_t)(*(request+7) << 16) |
+		       (uint32_t)(*(request+8) << 24);
+		num += 9U << 16;
+
+		if (*request & 0x01U)
+		{
+			rtt_set_search(addr, size);
+		}
+		rtt_get_status(&status);
+		*response++ = DAP_OK;
+		*response++ = (uint8_t)(status.cb >>  0);
+		*response++ = (uint8_t)(status.cb >>  8);
+		*response++ = (uint8_t)(status.cb >> 16);
+		*response++ = (uint8_t)(status.cb >> 24);
+		*response++ = (uint8_t)(status.up_bytes >>  0);
+		*response++ = (uint8_t)(status.up_bytes >>  8);
+		*response++ = (uint8_t)(status.up_bytes >> 16);
+		*response++ = (uint8_t)(status.up_bytes >> 24);
+		*response++ = (uint8_t)(status.down_bytes >>  0);
+		*response++ = (uint8_t)(status.down_bytes >>  8);
+		*response++ = (uint8_t)(status.down_bytes >> 16);
+		*response++ = (uint8_t)(status.down_bytes >> 24);
+		num += 13U;
+	}
+		break;
+	case ID_DAP_Vendor_TransferAdaptive:
+		// request:  mode (0: idle cycles as configured, 1: adaptive, 0xFF: query)
+		// response: status, mode
+		// Sticky for the port: DAP_Connect and DAP_TransferConfigure keep the choice.
+		num += 1U << 16;
+		if (*request != TransferAdaptive_Query)
+		{
+			DAP_Port->adapt_host = (*request != 0U) ? 1U : 0U;
+			DAP_Data.transfer.adaptive = DAP_Port->adapt_host;
+		}
+		*response++ = DAP_OK;
+		*response++ = DAP_Port->adapt_host;
+		num += 2U;
+		break;
+	case ID_DAP_Vendor_Program:
+	{
+		// request:  flags (bit 0: chip erase allowed, bit 7: status only), port,
+		//           gang targets (0: single target, 1..SWD_GANG_MAX: gang on port 0)
+		// response: status, state (0: idle, 1: busy, 2: done, 3: failed), error code,
+		//           programmed bytes [31:0], total bytes [31:0], gang targets still active (bit n = target n)
+		// The job runs in the background; poll with bit 7 set until the state is no longer busy.
+		// Any port's engine may start and poll a job on any port.
+		prog_job_status_t job;
+		uint8_t status = DAP_OK;
+
+		num += 3U << 16;
+		if (!(*request & Program_StatusOnly) &&
+		    !prog_job_start(*(request+1), (*request & Program_ChipErase) ? PROG_JOB_CHIP_ERASE : 0U, *(request+2)))
+		{
+			status = DAP_ERROR;
+		}
+		prog_job_get_status(*(request+1), &job);
+
+		*response++ = status;
+		*response++ = job.state;
+		*response++ = job.result;
+		*response++ = (uint8_t)(job.done >>  0);
+		*response++ = (uint8_t)(job.done >>  8);
+		*response++ = (uint8_t)(job.done >> 16);
+		*response++ = (uint8_t)(job.done >> 24);
+		*response++ = (uint8_t)(job.total >>  0);
+		*response++ = (uint8_t)(job.total >>  8);
+		*response++ = (uint8_t)(job.total >> 16);
+		*response++ = (uint8_t)(job.total >> 24);
+		*response++ = job.gang;
+		num += 12U;
+	}
+		break;
+	case ID_DAP_Vendor11:
+		break;
+	case ID_DAP_Vendor12:
+		break;
+	case ID_DAP_Vendor13:
+		break;
+	case ID_DAP_Vendor14:
+		break;
+	case ID_DAP_Vendor15:
+		break;
+	case ID_DAP_Vendor16:
+		break;
+	case ID_DAP_Vendor17:
+		break;
+	case ID_DAP_Vendor18:
+		break;
+	case ID_DAP_Vendor19:
+		break;
+	case ID_DAP_Vendor20:
+		break;
+	case ID_DAP_Vendor21:
+		break;
+	case ID_DAP_Vendor22:
+		break;
+	case ID_DAP_Vendor23:
+		break;
+	case ID_DAP_Vendor24:
+		break;
+	case ID_DAP_Vendor25:
+		break;
+	case ID_DAP_Vendor26:
+		break;
+	case ID_DAP_Vendor27:
+		break;
+	case ID_DAP_Vendor28:
+		break;
+	case ID_DAP_Vendor29:
+		break;
+	case ID_DAP_Vendor30:
+		break;
+	case ID_DAP_Vendor31:
+		break;
+	}
+
+	return (num);
+}
+
+///@}
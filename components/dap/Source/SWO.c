@@ -1,691 +1,1298 @@
-/******************************************************************************
- * @file     SWO.c
- * @brief    CMSIS-DAP SWO I/O
- * @version  V1.00
- * @date     20. May 2015
- *
- * @note
- * Copyright (C) 2015 ARM Limited. All rights reserved.
- *
- * @par
- * ARM Limited (ARM) is supplying this software for use with Cortex-M
- * processor based microcontrollers.
- *
- * @par
- * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
- * OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
- * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
- * ARM SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
- * CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
- *
- ******************************************************************************/
-
-#include "DAP_config.h"
-#include "DAP.h"
-#if (SWO_UART != 0)
-#include "Driver_USART.h"
-#endif
-
-#if (SWO_UART != 0)
-
-#ifndef USART_PORT
-#define USART_PORT 0 /* USART Port Number */
-#endif
-
-// USART Driver
-#define _USART_Driver_(n) Driver_USART##n
-#define USART_Driver_(n) _USART_Driver_(n)
-extern ARM_DRIVER_USART USART_Driver_(USART_PORT);
-#define pUSART (&USART_Driver_(USART_PORT))
-
-static uint8_t USART_Ready;
-
-#endif /* (SWO_UART != 0) */
-
-#if ((SWO_UART != 0) || (SWO_MANCHESTER != 0))
-
-// Trace State
-static uint8_t TraceTransport = 0U;      /* Trace Transport */
-static uint8_t TraceMode = 0U;           /* Trace Mode */
-static uint8_t TraceStatus = 0U;         /* Trace Status without Errors */
-static uint8_t TraceError[2] = {0U, 0U}; /* Trace Error flags (banked) */
-static uint8_t TraceError_n = 0U;        /* Active Trace Error bank */
-
-// Trace Buffer
-static uint8_t TraceBuf[SWO_BUFFER_SIZE];   /* Trace Buffer (must be 2^n) */
-static volatile uint32_t TraceIn = 0U;      /* Incoming Trace Index */
-static volatile uint32_t TraceOut = 0U;     /* Outgoing Trace Index */
-static volatile uint32_t TracePending = 0U; /* Pending Trace Count */
-
-// Trace Helper functions
-static void ClearTrace(void);
-static uint32_t GetTraceSpace(void);
-static uint32_t GetTraceCount(void);
-static uint8_t GetTraceStatus(void);
-static void SetTraceError(uint8_t flag);
-
-#if (SWO_UART != 0)
-
-// USART Driver Callback function
-//   event: event mask
-static void USART_Callback(uint32_t event)
-{
-  uint32_t count;
-
-  if (event & ARM_USART_EVENT_RECEIVE_COMPLETE)
-  {
-    TracePending = 0U;
-    TraceIn += pUSART->GetRxCount();
-    count = GetTraceSpace();
-    if (count != 0U)
-    {
-      pUSART->Receive(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], count);
-    }
-    else
-    {
-      TraceStatus = DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED;
-    }
-  }
-  if (event & ARM_USART_EVENT_RX_OVERFLOW)
-  {
-    SetTraceError(DAP_SWO_BUFFER_OVERRUN);
-  }
-  if (event & (ARM_USART_EVENT_RX_BREAK |
-               ARM_USART_EVENT_RX_FRAMING_ERROR |
-               ARM_USART_EVENT_RX_PARITY_ERROR))
-  {
-    SetTraceError(DAP_SWO_STREAM_ERROR);
-  }
-}
-
-// Enable or disable UART SWO Mode
-//   enable: enable flag
-//   return: 1 - Success, 0 - Error
-__weak uint32_t UART_SWO_Mode(uint32_t enable)
-{
-  int32_t status;
-
-  USART_Ready = 0U;
-
-  if (enable)
-  {
-    status = pUSART->Initialize(USART_Callback);
-    if (status != ARM_DRIVER_OK)
-    {
-      return (0U);
-    }
-    status = pUSART->PowerControl(ARM_POWER_FULL);
-    if (status != ARM_DRIVER_OK)
-    {
-      pUSART->Uninitialize();
-      return (0U);
-    }
-  }
-  else
-  {
-    pUSART->Control(ARM_USART_ABORT_RECEIVE, 0U);
-    pUSART->PowerControl(ARM_POWER_OFF);
-    pUSART->Uninitialize();
-  }
-  return (1U);
-}
-
-// Configure UART SWO Baudrate
-//   baudrate: requested baudrate
-//   return:   actual baudrate or 0 when not configured
-__weak uint32_t UART_SWO_Baudrate(uint32_t baudrate)
-{
-  int32_t status;
-  uint32_t count;
-
-  if (baudrate > SWO_UART_MAX_BAUDRATE)
-  {
-    baudrate = SWO_UART_MAX_BAUDRATE;
-  }
-
-  if (TraceStatus & DAP_SWO_CAPTURE_ACTIVE)
-  {
-    pUSART->Control(ARM_USART_CONTROL_RX, 0U);
-    if (pUSART->GetStatus().rx_busy)
-    {
-      TracePending = 0U;
-      TraceIn += pUSART->GetRxCount();
-      pUSART->Control(ARM_USART_ABORT_RECEIVE, 0U);
-    }
-  }
-
-  status = pUSART->Control(ARM_USART_MODE_ASYNCHRONOUS |
-                               ARM_USART_DATA_BITS_8 |
-                               ARM_USART_PARITY_NONE |
-                               ARM_USART_STOP_BITS_1,
-                           baudrate);
-
-  if (status == ARM_DRIVER_OK)
-  {
-    USART_Ready = 1U;
-  }
-  else
-  {
-    USART_Ready = 0U;
-    baudrate = 0U;
-  }
-
-  if ((TraceStatus & DAP_SWO_CAPTURE_ACTIVE) && USART_Ready)
-  {
-    pUSART->Control(ARM_USART_CONTROL_RX, 1U);
-    count = GetTraceSpace();
-    if (count != 0U)
-    {
-      pUSART->Receive(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], count);
-    }
-    else
-    {
-      TraceStatus = DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED;
-    }
-  }
-
-  return (baudrate);
-}
-
-// Control UART SWO Capture
-//   active: active flag
-//   return: 1 - Success, 0 - Error
-__weak uint32_t UART_SWO_Control(uint32_t active)
-{
-  int32_t status;
-
-  if (active)
-  {
-    if (!USART_Ready)
-    {
-      return (0U);
-    }
-    status = pUSART->Control(ARM_USART_CONTROL_RX, 1U);
-    if (status != ARM_DRIVER_OK)
-    {
-      return (0U);
-    }
-    status = pUSART->Receive(TraceBuf, SWO_BUFFER_SIZE);
-    if (status != ARM_DRIVER_OK)
-    {
-      return (0U);
-    }
-  }
-  else
-  {
-    pUSART->Control(ARM_USART_CONTROL_RX, 0U);
-    if (pUSART->GetStatus().rx_busy)
-    {
-      TracePending = 0U;
-      TraceIn += pUSART->GetRxCount();
-      pUSART->Control(ARM_USART_ABORT_RECEIVE, 0U);
-    }
-  }
-  return (1U);
-}
-
-// Start UART SWO Capture
-//   buf:   pointer to buffer for capturing
-//   count: number of bytes to capture
-__weak void UART_SWO_Capture(uint8_t *buf, uint32_t count)
-{
-  pUSART->Receive(buf, count);
-}
-
-// Update UART SWO Trace Info
-__weak void UART_SWO_Update(void)
-{
-  TracePending = pUSART->GetRxCount();
-}
-
-#endif /* (SWO_UART != 0) */
-
-#if (SWO_MANCHESTER != 0)
-
-// Enable or disable Manchester SWO Mode
-//   enable: enable flag
-//   return: 1 - Success, 0 - Error
-__weak uint32_t Manchester_SWO_Mode(uint32_t enable)
-{
-  return (0U);
-}
-
-// Configure Manchester SWO Baudrate
-//   baudrate: requested baudrate
-//   return:   actual baudrate or 0 when not configured
-__weak uint32_t Manchester_SWO_Baudrate(uint32_t baudrate)
-{
-  return (0U);
-}
-
-// Control Manchester SWO Capture
-//   active: active flag
-//   return: 1 - Success, 0 - Error
-__weak uint32_t Manchester_SWO_Control(uint32_t active)
-{
-  return (0U);
-}
-
-// Start Manchester SWO Capture
-//   buf:   pointer to buffer for capturing
-//   count: number of bytes to capture
-__weak void Manchester_SWO_Capture(uint8_t *buf, uint32_t count)
-{
-}
-
-// Update Manchester SWO Trace Info
-__weak void Manchester_SWO_Update(void)
-{
-}
-
-#endif /* (SWO_MANCHESTER != 0) */
-
-// Clear Trace Errors and Data
-static void ClearTrace(void)
-{
-  TraceError[0] = 0U;
-  TraceError[1] = 0U;
-  TraceError_n = 0U;
-  TraceIn = 0U;
-  TraceOut = 0U;
-  TracePending = 0U;
-}
-
-// Get Trace Space
-//   return: number of contiguous free bytes in trace buffer
-static uint32_t GetTraceSpace(void)
-{
-  uint32_t index;
-  uint32_t limit;
-  uint32_t count;
-
-  index = TraceIn & (SWO_BUFFER_SIZE - 1U);
-  limit = SWO_BUFFER_SIZE - index;
-  count = SWO_BUFFER_SIZE - (TraceIn - TraceOut);
-  if (count > limit)
-  {
-    count = limit;
-  }
-
-  return (count);
-}
-
-// Get Trace Count
-//   return: number of available data bytes in trace buffer
-static uint32_t GetTraceCount(void)
-{
-  uint32_t count;
-
-  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
-  {
-    count = (TraceIn - TraceOut) + TracePending;
-    if (TracePending == 0U)
-    {
-      count = TraceIn - TraceOut;
-    }
-  }
-  else
-  {
-    count = TraceIn - TraceOut;
-  }
-
-  return (count);
-}
-
-// Get Trace Status (clear Error flags)
-//   return: Trace Status (Active flag and Error flags)
-static uint8_t GetTraceStatus(void)
-{
-  uint8_t status;
-  uint32_t n;
-
-  n = TraceError_n;
-  TraceError_n ^= 1U;
-  status = TraceStatus | TraceError[n];
-  TraceError[n] = 0U;
-
-  return (status);
-}
-
-// Set Trace Error flag(s)
-//   flag:  error flag(s) to set
-static void SetTraceError(uint8_t flag)
-{
-  TraceError[TraceError_n] |= flag;
-}
-
-// Process SWO Transport command and prepare response
-//   request:  pointer to request data
-//   response: pointer to response data
-//   return:   number of bytes in response (lower 16 bits)
-//             number of bytes in request (upper 16 bits)
-uint32_t SWO_Transport(const uint8_t *request, uint8_t *response)
-{
-  uint8_t transport;
-  uint32_t result;
-
-  if (!(TraceStatus & DAP_SWO_CAPTURE_ACTIVE))
-  {
-    transport = *request;
-    switch (transport)
-    {
-    case 0:
-    case 1:
-      TraceTransport = transport;
-      result = 1U;
-      break;
-    default:
-      result = 0U;
-      break;
-    }
-  }
-  else
-  {
-    result = 0U;
-  }
-
-  if (result != 0U)
-  {
-    *response = DAP_OK;
-  }
-  else
-  {
-    *response = DAP_ERROR;
-  }
-
-  return ((1U << 16) | 1U);
-}
-
-// Process SWO Mode command and prepare response
-//   request:  pointer to request data
-//   response: pointer to response data
-//   return:   number of bytes in response (lower 16 bits)
-//             number of bytes in request (upper 16 bits)
-uint32_t SWO_Mode(const uint8_t *request, uint8_t *response)
-{
-  uint8_t mode;
-  uint32_t result;
-
-  mode = *request;
-
-  switch (TraceMode)
-  {
-#if (SWO_UART != 0)
-  case DAP_SWO_UART:
-    UART_SWO_Mode(0U);
-    break;
-#endif
-#if (SWO_MANCHESTER != 0)
-  case DAP_SWO_MANCHESTER:
-    Manchester_SWO_Mode(0U);
-    break;
-#endif
-  default:
-    break;
-  }
-  switch (mode)
-  {
-  case DAP_SWO_OFF:
-    result = 1U;
-    break;
-#if (SWO_UART != 0)
-  case DAP_SWO_UART:
-    result = UART_SWO_Mode(1U);
-    break;
-#endif
-#if (SWO_MANCHESTER != 0)
-  case DAP_SWO_MANCHESTER:
-    result = Manchester_SWO_Mode(1U);
-    break;
-#endif
-  default:
-    result = 0U;
-    break;
-  }
-  if (result != 0U)
-  {
-    TraceMode = mode;
-  }
-  else
-  {
-    TraceMode = DAP_SWO_OFF;
-  }
-  TraceStatus = 0U;
-  ClearTrace();
-
-  if (result != 0U)
-  {
-    *response = DAP_OK;
-  }
-  else
-  {
-    *response = DAP_ERROR;
-  }
-
-  return ((1U << 16) | 1U);
-}
-
-// Process SWO Baudrate command and prepare response
-//   request:  pointer to request data
-//   response: pointer to response data
-//   return:   number of bytes in response (lower 16 bits)
-//             number of bytes in request (upper 16 bits)
-uint32_t SWO_Baudrate(const uint8_t *request, uint8_t *response)
-{
-  uint32_t baudrate;
-
-  baudrate = (*(request + 0) << 0) |
-             (*(request + 1) << 8) |
-             (*(request + 2) << 16) |
-             (*(request + 3) << 24);
-
-  switch (TraceMode)
-  {
-#if (SWO_UART != 0)
-  case DAP_SWO_UART:
-    baudrate = UART_SWO_Baudrate(baudrate);
-    break;
-#endif
-#if (SWO_MANCHESTER != 0)
-  case DAP_SWO_MANCHESTER:
-    baudrate = Manchester_SWO_Baudrate(baudrate);
-    break;
-#endif
-  default:
-    baudrate = 0U;
-    break;
-  }
-
-  if (baudrate == 0U)
-  {
-    TraceStatus = 0U;
-  }
-
-  *response++ = (uint8_t)(baudrate >> 0);
-  *response++ = (uint8_t)(baudrate >> 8);
-  *response++ = (uint8_t)(baudrate >> 16);
-  *response = (uint8_t)(baudrate >> 24);
-
-  return ((4U << 16) | 4U);
-}
-
-// Process SWO Control command and prepare response
-//   request:  pointer to request data
-//   response: pointer to response data
-//   return:   number of bytes in response (lower 16 bits)
-//             number of bytes in request (upper 16 bits)
-uint32_t SWO_Control(const uint8_t *request, uint8_t *response)
-{
-  uint8_t active;
-  uint32_t result;
-
-  active = *request & DAP_SWO_CAPTURE_ACTIVE;
-
-  if (active != (TraceStatus & DAP_SWO_CAPTURE_ACTIVE))
-  {
-    if (active)
-    {
-      ClearTrace();
-    }
-    switch (TraceMode)
-    {
-#if (SWO_UART != 0)
-    case DAP_SWO_UART:
-      result = UART_SWO_Control(active);
-      break;
-#endif
-#if (SWO_MANCHESTER != 0)
-    case DAP_SWO_MANCHESTER:
-      result = Manchester_SWO_Control(active);
-      break;
-#endif
-    default:
-      result = 0U;
-      break;
-    }
-    if (result != 0U)
-    {
-      TraceStatus = active;
-    }
-  }
-  else
-  {
-    result = 1U;
-  }
-
-  if (result != 0U)
-  {
-    *response = DAP_OK;
-  }
-  else
-  {
-    *response = DAP_ERROR;
-  }
-
-  return ((1U << 16) | 1U);
-}
-
-// Process SWO Status command and prepare response
-//   response: pointer to response data
-//   return:   number of bytes in response
-uint32_t SWO_Status(uint8_t *response)
-{
-  uint8_t status;
-  uint32_t count;
-
-  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
-  {
-    switch (TraceMode)
-    {
-#if (SWO_UART != 0)
-    case DAP_SWO_UART:
-      UART_SWO_Update();
-      break;
-#endif
-#if (SWO_MANCHESTER != 0)
-    case DAP_SWO_MANCHESTER:
-      Manchester_SWO_Update();
-      break;
-#endif
-    default:
-      break;
-    }
-  }
-
-  status = GetTraceStatus();
-  count = GetTraceCount();
-
-  *response++ = status;
-  *response++ = (uint8_t)(count >> 0);
-  *response++ = (uint8_t)(count >> 8);
-  *response++ = (uint8_t)(count >> 16);
-  *response = (uint8_t)(count >> 24);
-
-  return (5U);
-}
-
-// Process SWO Data command and prepare response
-//   request:  pointer to request data
-//   response: pointer to response data
-//   return:   number of bytes in response (lower 16 bits)
-//             number of bytes in request (upper 16 bits)
-uint32_t SWO_Data(const uint8_t *request, uint8_t *response)
-{
-  uint8_t status;
-  uint32_t count;
-  uint32_t n;
-
-  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
-  {
-    switch (TraceMode)
-    {
-#if (SWO_UART != 0)
-    case DAP_SWO_UART:
-      UART_SWO_Update();
-      break;
-#endif
-#if (SWO_MANCHESTER != 0)
-    case DAP_SWO_MANCHESTER:
-      Manchester_SWO_Update();
-      break;
-#endif
-    default:
-      break;
-    }
-  }
-
-  status = GetTraceStatus();
-  count = GetTraceCount();
-
-  if (TraceTransport == 1U)
-  {
-    n = (*(request + 0) << 0) |
-        (*(request + 1) << 8);
-  }
-  else
-  {
-    n = 0U;
-  }
-  if (count > n)
-  {
-    count = n;
-  }
-
-  *response++ = status;
-  *response++ = (uint8_t)(count >> 0);
-  *response++ = (uint8_t)(count >> 8);
-
-  for (n = count; n; n--)
-  {
-    *response++ = TraceBuf[TraceOut++ & (SWO_BUFFER_SIZE - 1U)];
-  }
-
-  if (TraceStatus == (DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED))
-  {
-    n = GetTraceSpace();
-    if (n != 0U)
-    {
-      switch (TraceMode)
-      {
-#if (SWO_UART != 0)
-      case DAP_SWO_UART:
-        UART_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
-        TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
-        break;
-#endif
-#if (SWO_MANCHESTER != 0)
-      case DAP_SWO_MANCHESTER:
-        Manchester_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
-        TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
-        break;
-#endif
-      default:
-        break;
-      }
-    }
-  }
-
-  return ((2U << 16) | (3U + count));
-}
-
-#endif /* ((SWO_UART != 0) || (SWO_MANCHESTER != 0)) */
+/******************************************************************************
+ * @file     SWO.c
+ * @brief    CMSIS-DAP SWO I/O
+ * @version  V1.00
+ * @date     20. May 2015
+ *
+ * @note
+ * Copyright (C) 2015 ARM Limited. All rights reserved.
+ *
+ * @par
+ * ARM Limited (ARM) is supplying this software for use with Cortex-M
+ * processor based microcontrollers.
+ *
+ * @par
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ * OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * ARM SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "DAP_config.h"
+#include "DAP.h"
+#if (SWO_UART != 0)
+#include "driver/uart.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#endif
+#if (SWO_MANCHESTER != 0)
+#include "driver/rmt_rx.h"
+#include "esp_heap_caps.h"
+#include "freertos/queue.h"
+#include "swo_manchester.h"
+#endif
+#if (SWO_ITM != 0)
+#include "itm_decoder.h"
+#endif
+
+#if (SWO_UART != 0)
+
+#define UART_RX_BUFFER 4096U   /* UART driver buffer between RX FIFO and TraceBuf */
+#define UART_RX_FULL   100U    /* RX FIFO level that raises the data interrupt */
+#define UART_RX_TOUT   10U     /* RX idle time (symbols) that flushes the FIFO */
+
+static uint8_t USART_Ready;
+static volatile uint8_t USART_Capture;     /* Data is moved into TraceBuf */
+static QueueHandle_t USART_Queue;          /* UART driver event queue */
+static SemaphoreHandle_t USART_Lock;       /* Serializes draining against control */
+static TaskHandle_t USART_ThreadId;
+
+#endif /* (SWO_UART != 0) */
+
+#if (SWO_MANCHESTER != 0)
+
+#define RMT_RESOLUTION 80000000U /* RMT tick rate (12.5 ns) */
+#define RMT_SYMBOLS    1024U     /* Edge pairs per receive buffer */
+#define RMT_BUFFERS    4U        /* Receiving, decoding and queued buffers */
+#define RMT_MIN_BAUD   10000U    /* Idle threshold must fit 15-bit RMT durations */
+#define RMT_MAX_BAUD   10000000U /* At least 4 ticks per half bit */
+
+typedef struct
+{
+  rmt_symbol_word_t *buf;
+  size_t num;
+} RMT_Frame_t;
+
+static rmt_channel_handle_t RMT_Channel;
+static rmt_symbol_word_t *RMT_Buf[RMT_BUFFERS];
+static uint8_t RMT_Index;
+static rmt_receive_config_t RMT_Config;
+static QueueHandle_t RMT_Queue;            /* Received frames for the decoder */
+static TaskHandle_t RMT_ThreadId;
+static volatile uint8_t RMT_Capture;
+static swo_manchester_t Manchester;
+
+#endif /* (SWO_MANCHESTER != 0) */
+
+#if (SWO_ITM != 0)
+
+#define ITM_BLOCK 128U   /* Raw UART bytes per decode step */
+
+static itm_filter_t ITM_Filter;            /* Set by SWO_Filter, applied at capture start */
+static itm_decoder_t ITM_Decoder;
+static uint8_t ITM_Raw[ITM_BLOCK];         /* UART data waiting for the decoder */
+static uint8_t ITM_Out[ITM_DECODER_SPACE(ITM_BLOCK)]; /* Records of one decode step */
+static uint32_t ITM_Count;
+
+#endif /* (SWO_ITM != 0) */
+
+#if ((SWO_UART != 0) || (SWO_MANCHESTER != 0))
+
+#define USB_BLOCK_SIZE     64U   /* USB Block Size (Full-speed bulk packet) */
+#define SWO_STREAM_TIMEOUT 50U   /* Stream timeout in ms */
+
+// Trace State
+static uint8_t TraceTransport = 0U;      /* Trace Transport */
+static uint8_t TraceMode = 0U;           /* Trace Mode */
+static uint8_t TraceStatus = 0U;         /* Trace Status without Errors */
+static uint8_t TraceError[2] = {0U, 0U}; /* Trace Error flags (banked) */
+static uint8_t TraceError_n = 0U;        /* Active Trace Error bank */
+
+// Trace Buffer
+static uint8_t TraceBuf[SWO_BUFFER_SIZE];   /* Trace Buffer (must be 2^n) */
+static volatile uint32_t TraceIn = 0U;      /* Incoming Trace Index */
+static volatile uint32_t TraceOut = 0U;     /* Outgoing Trace Index */
+static volatile uint8_t TraceUpdate;        /* Trace Update Flag */
+
+// Trace Timestamp
+#if (TIMESTAMP_CLOCK != 0U)
+static volatile struct
+{
+  uint32_t index;
+  uint32_t tick;
+} TraceTimestamp;
+#endif
+
+#if (SWO_STREAM != 0)
+static volatile uint8_t TransferBusy = 0U; /* Transfer Busy Flag */
+static uint32_t TransferSize;              /* Current Transfer Size */
+static TaskHandle_t SWO_ThreadId;
+#endif
+
+// Trace Helper functions
+static void ClearTrace(void);
+static void ResumeTrace(void);
+static uint32_t GetTraceSpace(void);
+static uint32_t GetTraceCount(void);
+static uint8_t GetTraceStatus(void);
+static void SetTraceError(uint8_t flag);
+static void TraceReceived(uint32_t num);
+static void TraceStore(const uint8_t *data, uint32_t num);
+#if (SWO_STREAM != 0)
+static void StreamNotify(void);
+#endif
+
+#if (SWO_ITM != 0)
+
+// ITM decoder output: collect the records of one decode step
+static void ITM_Record(void *ctx, const uint8_t *data, uint32_t num)
+{
+  (void)ctx;
+
+  if ((ITM_Count + num) > sizeof(ITM_Out))
+  {
+    TraceStore(ITM_Out, ITM_Count);
+    ITM_Count = 0U;
+  }
+  memcpy(&ITM_Out[ITM_Count], data, num);
+  ITM_Count += num;
+}
+
+// ITM decoder output: characters of the text ports
+static void ITM_Text(void *ctx, const uint8_t *data, uint32_t num)
+{
+  (void)ctx;
+
+  SWO_TextOutput(data, num);
+}
+
+// Decode raw SWO data, the records go to the Trace Buffer
+//   data:  raw SWO bytes
+//   num:   number of bytes
+static void ITM_Store(const uint8_t *data, uint32_t num)
+{
+  itm_decoder_decode(&ITM_Decoder, data, num);
+  if (ITM_Count != 0U)
+  {
+    TraceStore(ITM_Out, ITM_Count);
+    ITM_Count = 0U;
+  }
+}
+
+#endif /* (SWO_ITM != 0) */
+
+#if (SWO_UART != 0)
+
+// Move received UART data into the Trace Buffer
+// Pauses the capture when the Trace Buffer is full, data then waits in the
+// UART driver buffer until it overflows (reported as buffer overrun).
+static void USART_Drain(void)
+{
+  uint32_t count;
+  int num;
+
+  xSemaphoreTake(USART_Lock, portMAX_DELAY);
+  while (USART_Capture && !(TraceStatus & DAP_SWO_CAPTURE_PAUSED))
+  {
+#if (SWO_ITM != 0)
+    if (ITM_Filter.flags & ITM_FILTER_ENABLE)
+    {
+      // Read only as much as the decoded records surely fit in
+      if ((SWO_BUFFER_SIZE - GetTraceCount()) < ITM_DECODER_SPACE(ITM_BLOCK))
+      {
+        TraceStatus = DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED;
+        break;
+      }
+      num = uart_read_bytes(SWO_UART_DRIVER, ITM_Raw, ITM_BLOCK, 0);
+      if (num <= 0)
+      {
+        break;
+      }
+      ITM_Store(ITM_Raw, (uint32_t)num);
+      continue;
+    }
+#endif
+    count = GetTraceSpace();
+    if (count == 0U)
+    {
+      TraceStatus = DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED;
+      break;
+    }
+    num = uart_read_bytes(SWO_UART_DRIVER, &TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], count, 0);
+    if (num <= 0)
+    {
+      break;
+    }
+    TraceReceived((uint32_t)num);
+  }
+  xSemaphoreGive(USART_Lock);
+}
+
+// UART SWO capture thread: handles UART driver events
+static void USART_Thread(void *argument)
+{
+  uart_event_t event;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (xQueueReceive(USART_Queue, &event, portMAX_DELAY) != pdTRUE)
+    {
+      continue;
+    }
+    switch (event.type)
+    {
+    case UART_FIFO_OVF:
+    case UART_BUFFER_FULL:
+      SetTraceError(DAP_SWO_BUFFER_OVERRUN);
+      break;
+    case UART_BREAK:
+    case UART_FRAME_ERR:
+    case UART_PARITY_ERR:
+      SetTraceError(DAP_SWO_STREAM_ERROR);
+      break;
+    default:
+      break;
+    }
+    USART_Drain();
+  }
+}
+
+// Enable or disable UART SWO Mode
+//   enable: enable flag
+//   return: 1 - Success, 0 - Error
+static uint32_t UART_SWO_Mode(uint32_t enable)
+{
+  const uart_config_t config = {
+      .baud_rate = 115200,
+      .data_bits = UART_DATA_8_BITS,
+      .parity = UART_PARITY_DISABLE,
+      .stop_bits = UART_STOP_BITS_1,
+      .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+      .source_clk = UART_SCLK_APB,
+  };
+
+  USART_Ready = 0U;
+  USART_Capture = 0U;
+
+  if (USART_Lock == NULL)
+  {
+    USART_Lock = xSemaphoreCreateMutex();
+    if (USART_Lock == NULL)
+    {
+      return (0U);
+    }
+  }
+
+  if (USART_ThreadId != NULL)
+  {
+    xSemaphoreTake(USART_Lock, portMAX_DELAY);
+    vTaskDelete(USART_ThreadId);
+    USART_ThreadId = NULL;
+    xSemaphoreGive(USART_Lock);
+    uart_driver_delete(SWO_UART_DRIVER);
+  }
+
+  if (enable)
+  {
+    if (uart_driver_install(SWO_UART_DRIVER, UART_RX_BUFFER, 0, 16, &USART_Queue, 0) != ESP_OK)
+    {
+      return (0U);
+    }
+    if ((uart_param_config(SWO_UART_DRIVER, &config) != ESP_OK) ||
+        (uart_set_pin(SWO_UART_DRIVER, UART_PIN_NO_CHANGE, PIN_SWO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) ||
+        (uart_set_rx_full_threshold(SWO_UART_DRIVER, UART_RX_FULL) != ESP_OK) ||
+        (uart_set_rx_timeout(SWO_UART_DRIVER, UART_RX_TOUT) != ESP_OK) ||
+        (xTaskCreate(USART_Thread, "SWO_UART", 3072, NULL, configMAX_PRIORITIES - 2, &USART_ThreadId) != pdPASS))
+    {
+      USART_ThreadId = NULL;
+      uart_driver_delete(SWO_UART_DRIVER);
+      return (0U);
+    }
+  }
+  return (1U);
+}
+
+// Configure UART SWO Baudrate
+//   baudrate: requested baudrate
+//   return:   actual baudrate or 0 when not configured
+static uint32_t UART_SWO_Baudrate(uint32_t baudrate)
+{
+  uint32_t actual;
+
+  if (baudrate > SWO_UART_MAX_BAUDRATE)
+  {
+    baudrate = SWO_UART_MAX_BAUDRATE;
+  }
+
+  xSemaphoreTake(USART_Lock, portMAX_DELAY);
+  if ((uart_set_baudrate(SWO_UART_DRIVER, baudrate) == ESP_OK) &&
+      (uart_get_baudrate(SWO_UART_DRIVER, &actual) == ESP_OK))
+  {
+    USART_Ready = 1U;
+    baudrate = actual;
+  }
+  else
+  {
+    USART_Ready = 0U;
+    USART_Capture = 0U;
+    baudrate = 0U;
+  }
+  xSemaphoreGive(USART_Lock);
+
+  return (baudrate);
+}
+
+// Control UART SWO Capture
+//   active: active flag
+//   return: 1 - Success, 0 - Error
+static uint32_t UART_SWO_Control(uint32_t active)
+{
+  if (active)
+  {
+    if (!USART_Ready)
+    {
+      return (0U);
+    }
+    xSemaphoreTake(USART_Lock, portMAX_DELAY);
+    uart_flush_input(SWO_UART_DRIVER);
+    xQueueReset(USART_Queue);
+    USART_Capture = 1U;
+    xSemaphoreGive(USART_Lock);
+  }
+  else
+  {
+    USART_Drain();
+    USART_Capture = 0U;
+  }
+  return (1U);
+}
+
+// Start UART SWO Capture
+//   buf:   pointer to buffer for capturing
+//   count: number of bytes to capture
+static void UART_SWO_Capture(uint8_t *buf, uint32_t count)
+{
+  uart_event_t event = {.type = UART_EVENT_MAX};
+
+  (void)buf;
+  (void)count;
+
+  // Wake the capture thread, data waiting in the UART driver is drained
+  xQueueSend(USART_Queue, &event, 0);
+}
+
+// Update UART SWO Trace Info
+static void UART_SWO_Update(void)
+{
+  USART_Drain();
+}
+
+#endif /* (SWO_UART != 0) */
+
+#if (SWO_MANCHESTER != 0)
+
+// RMT receive done callback (ISR): hand the frame to the decoder and
+// restart on the next buffer so the gap without capture stays short.
+static bool RMT_RecvDone(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata,
+                         void *user_data)
+{
+  BaseType_t woken = pdFALSE;
+  RMT_Frame_t frame;
+
+  (void)user_data;
+
+  frame.buf = edata->received_symbols;
+  frame.num = edata->num_symbols;
+  if ((frame.num >= RMT_SYMBOLS) || (xQueueSendFromISR(RMT_Queue, &frame, &woken) != pdTRUE))
+  {
+    SetTraceError(DAP_SWO_BUFFER_OVERRUN);
+  }
+
+  if (RMT_Capture)
+  {
+    RMT_Index = (RMT_Index + 1U) % RMT_BUFFERS;
+    rmt_receive(channel, RMT_Buf[RMT_Index], RMT_SYMBOLS * sizeof(rmt_symbol_word_t), &RMT_Config);
+  }
+  return (woken == pdTRUE);
+}
+
+// Store decoded bytes in the Trace Buffer
+//   data:  decoded bytes
+//   num:   number of bytes
+static void Manchester_Store(const uint8_t *data, uint32_t num)
+{
+  if (!RMT_Capture)
+  {
+    return;
+  }
+#if (SWO_ITM != 0)
+  if (ITM_Filter.flags & ITM_FILTER_ENABLE)
+  {
+    ITM_Store(data, num);
+    return;
+  }
+#endif
+  TraceStore(data, num);
+}
+
+// Manchester SWO decoder thread
+static void Manchester_Thread(void *argument)
+{
+  static uint8_t data[RMT_SYMBOLS / 2U];
+  RMT_Frame_t frame;
+  uint32_t errors;
+  uint32_t num;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (xQueueReceive(RMT_Queue, &frame, portMAX_DELAY) != pdTRUE)
+    {
+      continue;
+    }
+    errors = Manchester.errors;
+    num = swo_manchester_decode(&Manchester, (const uint32_t *)frame.buf, frame.num, data, sizeof(data));
+    if (Manchester.errors != errors)
+    {
+      SetTraceError(DAP_SWO_STREAM_ERROR);
+    }
+    if (!(TraceStatus & DAP_SWO_CAPTURE_PAUSED))
+    {
+      Manchester_Store(data, num);
+    }
+    else if (num != 0U)
+    {
+      SetTraceError(DAP_SWO_BUFFER_OVERRUN);
+    }
+  }
+}
+
+// Release RMT channel, buffers and decoder thread
+static void Manchester_Free(void)
+{
+  uint32_t n;
+
+  if (RMT_Channel != NULL)
+  {
+    rmt_disable(RMT_Channel);
+    rmt_del_channel(RMT_Channel);
+    RMT_Channel = NULL;
+  }
+  if (RMT_ThreadId != NULL)
+  {
+    vTaskDelete(RMT_ThreadId);
+    RMT_ThreadId = NULL;
+  }
+  if (RMT_Queue != NULL)
+  {
+    vQueueDelete(RMT_Queue);
+    RMT_Queue = NULL;
+  }
+  for (n = 0U; n < RMT_BUFFERS; n++)
+  {
+    heap_caps_free(RMT_Buf[n]);
+    RMT_Buf[n] = NULL;
+  }
+}
+
+// Enable or disable Manchester SWO Mode
+//   enable: enable flag
+//   return: 1 - Success, 0 - Error
+static uint32_t Manchester_SWO_Mode(uint32_t enable)
+{
+  const rmt_rx_channel_config_t config = {
+      .gpio_num = PIN_SWO,
+      .clk_src = RMT_CLK_SRC_DEFAULT,
+      .resolution_hz = RMT_RESOLUTION,
+      .mem_block_symbols = RMT_SYMBOLS,
+      .flags.with_dma = 1,
+  };
+  const rmt_rx_event_callbacks_t callbacks = {
+      .on_recv_done = RMT_RecvDone,
+  };
+  uint32_t n;
+
+  RMT_Capture = 0U;
+  Manchester_Free();
+
+  if (enable)
+  {
+    for (n = 0U; n < RMT_BUFFERS; n++)
+    {
+      RMT_Buf[n] = heap_caps_calloc(RMT_SYMBOLS, sizeof(rmt_symbol_word_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+      if (RMT_Buf[n] == NULL)
+      {
+        Manchester_Free();
+        return (0U);
+      }
+    }
+    RMT_Queue = xQueueCreate(RMT_BUFFERS - 2U, sizeof(RMT_Frame_t));
+    if ((RMT_Queue == NULL) ||
+        (xTaskCreate(Manchester_Thread, "SWO_MAN", 3072, NULL, configMAX_PRIORITIES - 2, &RMT_ThreadId) != pdPASS))
+    {
+      RMT_ThreadId = NULL;
+      Manchester_Free();
+      return (0U);
+    }
+    if ((rmt_new_rx_channel(&config, &RMT_Channel) != ESP_OK) ||
+        (rmt_rx_register_event_callbacks(RMT_Channel, &callbacks, NULL) != ESP_OK) ||
+        (rmt_enable(RMT_Channel) != ESP_OK))
+    {
+      Manchester_Free();
+      return (0U);
+    }
+  }
+  return (1U);
+}
+
+// Configure Manchester SWO Baudrate
+// The decoder locks to the start bits, the baudrate sets the idle threshold
+// (2 bit times) and the glitch filter (1/4 half bit).
+//   baudrate: requested baudrate
+//   return:   actual baudrate or 0 when not configured
+static uint32_t Manchester_SWO_Baudrate(uint32_t baudrate)
+{
+  uint32_t half_ns;
+
+  if (baudrate < RMT_MIN_BAUD)
+  {
+    return (0U);
+  }
+  if (baudrate > RMT_MAX_BAUD)
+  {
+    baudrate = RMT_MAX_BAUD;
+  }
+
+  half_ns = 500000000U / baudrate;
+  RMT_Config.signal_range_min_ns = (half_ns / 4U < 3000U) ? (half_ns / 4U) : 3000U;
+  RMT_Config.signal_range_max_ns = half_ns * 4U;
+  swo_manchester_init(&Manchester, RMT_RESOLUTION / 2U / baudrate);
+
+  return (baudrate);
+}
+
+// Control Manchester SWO Capture
+//   active: active flag
+//   return: 1 - Success, 0 - Error
+static uint32_t Manchester_SWO_Control(uint32_t active)
+{
+  if (active)
+  {
+    if (RMT_Config.signal_range_max_ns == 0U)
+    {
+      return (0U);
+    }
+    xQueueReset(RMT_Queue);
+    RMT_Index = 0U;
+    RMT_Capture = 1U;
+    if (rmt_receive(RMT_Channel, RMT_Buf[0], RMT_SYMBOLS * sizeof(rmt_symbol_word_t), &RMT_Config) != ESP_OK)
+    {
+      RMT_Capture = 0U;
+      return (0U);
+    }
+  }
+  else
+  {
+    RMT_Capture = 0U;
+    // Stop a pending receive, the channel stays allocated for the next start
+    rmt_disable(RMT_Channel);
+    rmt_enable(RMT_Channel);
+  }
+  return (1U);
+}
+
+// Start Manchester SWO Capture
+//   buf:   pointer to buffer for capturing
+//   count: number of bytes to capture
+static void Manchester_SWO_Capture(uint8_t *buf, uint32_t count)
+{
+  // The decoder thread stores again once the capture is no longer paused
+  (void)buf;
+  (void)count;
+}
+
+// Update Manchester SWO Trace Info
+static void Manchester_SWO_Update(void)
+{
+  // Decoded bytes are stored by the decoder thread as frames complete
+}
+
+#endif /* (SWO_MANCHESTER != 0) */
+
+// Clear Trace Errors and Data
+static void ClearTrace(void)
+{
+#if (SWO_STREAM != 0)
+  if (TraceTransport == 2U)
+  {
+    if (TransferBusy != 0U)
+    {
+      SWO_AbortTransfer();
+      TransferBusy = 0U;
+    }
+  }
+#endif
+
+  TraceError[0] = 0U;
+  TraceError[1] = 0U;
+  TraceError_n = 0U;
+  TraceIn = 0U;
+  TraceOut = 0U;
+
+#if (TIMESTAMP_CLOCK != 0U)
+  TraceTimestamp.index = 0U;
+  TraceTimestamp.tick = 0U;
+#endif
+
+#if (SWO_ITM != 0)
+  itm_decoder_init(&ITM_Decoder, &ITM_Filter, ITM_Record, ITM_Text, NULL);
+  ITM_Count = 0U;
+#endif
+}
+
+// Resume Trace Capture
+static void ResumeTrace(void)
+{
+  uint32_t n;
+
+  if (TraceStatus == (DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED))
+  {
+    n = GetTraceSpace();
+    if (n != 0U)
+    {
+      switch (TraceMode)
+      {
+#if (SWO_UART != 0)
+      case DAP_SWO_UART:
+        TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
+        UART_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
+        break;
+#endif
+#if (SWO_MANCHESTER != 0)
+      case DAP_SWO_MANCHESTER:
+        TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
+        Manchester_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
+        break;
+#endif
+      default:
+        break;
+      }
+    }
+  }
+}
+
+// Account data written to the Trace Buffer by the capture
+//   num:   number of bytes written at TraceIn
+static void TraceReceived(uint32_t num)
+{
+  TraceIn += num;
+
+#if (TIMESTAMP_CLOCK != 0U)
+  TraceUpdate = 1U;
+  TraceTimestamp.index = TraceIn;
+  TraceTimestamp.tick = TIMESTAMP_GET();
+#endif
+
+#if (SWO_STREAM != 0)
+  StreamNotify();
+#endif
+}
+
+// Store bytes in the Trace Buffer
+// Pauses the capture and reports an overrun when the Trace Buffer is full.
+//   data:  bytes to store
+//   num:   number of bytes
+static void TraceStore(const uint8_t *data, uint32_t num)
+{
+  uint32_t count;
+
+  while (num != 0U)
+  {
+    count = GetTraceSpace();
+    if (count == 0U)
+    {
+      TraceStatus = DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED;
+      SetTraceError(DAP_SWO_BUFFER_OVERRUN);
+      break;
+    }
+    if (count > num)
+    {
+      count = num;
+    }
+    memcpy(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], data, count);
+    TraceReceived(count);
+    data += count;
+    num -= count;
+  }
+}
+
+// Get Trace Space
+//   return: number of contiguous free bytes in trace buffer
+static uint32_t GetTraceSpace(void)
+{
+  uint32_t index;
+  uint32_t limit;
+  uint32_t count;
+
+  index = TraceIn & (SWO_BUFFER_SIZE - 1U);
+  limit = SWO_BUFFER_SIZE - index;
+  count = SWO_BUFFER_SIZE - (TraceIn - TraceOut);
+  if (count > limit)
+  {
+    count = limit;
+  }
+
+  return (count);
+}
+
+// Get Trace Count
+//   return: number of available data bytes in trace buffer
+static uint32_t GetTraceCount(void)
+{
+  return (TraceIn - TraceOut);
+}
+
+// Get Trace Status (clear Error flags)
+//   return: Trace Status (Active flag and Error flags)
+static uint8_t GetTraceStatus(void)
+{
+  uint8_t status;
+  uint32_t n;
+
+  n = TraceError_n;
+  TraceError_n ^= 1U;
+  status = TraceStatus | TraceError[n];
+  TraceError[n] = 0U;
+
+  return (status);
+}
+
+// Set Trace Error flag(s)
+//   flag:  error flag(s) to set
+static void SetTraceError(uint8_t flag)
+{
+  TraceError[TraceError_n] |= flag;
+}
+
+// Process SWO Transport command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Transport(const uint8_t *request, uint8_t *response)
+{
+  uint8_t transport;
+  uint32_t result;
+
+  if (!(TraceStatus & DAP_SWO_CAPTURE_ACTIVE))
+  {
+    transport = *request;
+    switch (transport)
+    {
+    case 0:
+    case 1:
+#if (SWO_STREAM != 0)
+    case 2:
+#endif
+      TraceTransport = transport;
+      result = 1U;
+      break;
+    default:
+      result = 0U;
+      break;
+    }
+  }
+  else
+  {
+    result = 0U;
+  }
+
+  if (result != 0U)
+  {
+    *response = DAP_OK;
+  }
+  else
+  {
+    *response = DAP_ERROR;
+  }
+
+  return ((1U << 16) | 1U);
+}
+
+// Process SWO Mode command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Mode(const uint8_t *request, uint8_t *response)
+{
+  uint8_t mode;
+  uint32_t result;
+
+  mode = *request;
+
+  switch (TraceMode)
+  {
+#if (SWO_UART != 0)
+  case DAP_SWO_UART:
+    UART_SWO_Mode(0U);
+    break;
+#endif
+#if (SWO_MANCHESTER != 0)
+  case DAP_SWO_MANCHESTER:
+    Manchester_SWO_Mode(0U);
+    break;
+#endif
+  default:
+    break;
+  }
+  switch (mode)
+  {
+  case DAP_SWO_OFF:
+    result = 1U;
+    break;
+#if (SWO_UART != 0)
+  case DAP_SWO_UART:
+    result = UART_SWO_Mode(1U);
+    break;
+#endif
+#if (SWO_MANCHESTER != 0)
+  case DAP_SWO_MANCHESTER:
+    result = Manchester_SWO_Mode(1U);
+    break;
+#endif
+  default:
+    result = 0U;
+    break;
+  }
+  if (result != 0U)
+  {
+    TraceMode = mode;
+  }
+  else
+  {
+    TraceMode = DAP_SWO_OFF;
+  }
+  TraceStatus = 0U;
+  ClearTrace();
+
+  if (result != 0U)
+  {
+    *response = DAP_OK;
+  }
+  else
+  {
+    *response = DAP_ERROR;
+  }
+
+  return ((1U << 16) | 1U);
+}
+
+// Process SWO Baudrate command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Baudrate(const uint8_t *request, uint8_t *response)
+{
+  uint32_t baudrate;
+
+  baudrate = (*(request + 0) << 0) |
+             (*(request + 1) << 8) |
+             (*(request + 2) << 16) |
+             (*(request + 3) << 24);
+
+  switch (TraceMode)
+  {
+#if (SWO_UART != 0)
+  case DAP_SWO_UART:
+    baudrate = UART_SWO_Baudrate(baudrate);
+    break;
+#endif
+#if (SWO_MANCHESTER != 0)
+  case DAP_SWO_MANCHESTER:
+    baudrate = Manchester_SWO_Baudrate(baudrate);
+    break;
+#endif
+  default:
+    baudrate = 0U;
+    break;
+  }
+
+  if (baudrate == 0U)
+  {
+    TraceStatus = 0U;
+  }
+
+  *response++ = (uint8_t)(baudrate >> 0);
+  *response++ = (uint8_t)(baudrate >> 8);
+  *response++ = (uint8_t)(baudrate >> 16);
+  *response = (uint8_t)(baudrate >> 24);
+
+  return ((4U << 16) | 4U);
+}
+
+// Process SWO Control command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Control(const uint8_t *request, uint8_t *response)
+{
+  uint8_t active;
+  uint32_t result;
+
+  active = *request & DAP_SWO_CAPTURE_ACTIVE;
+
+  if (active != (TraceStatus & DAP_SWO_CAPTURE_ACTIVE))
+  {
+    if (active)
+    {
+      ClearTrace();
+    }
+    switch (TraceMode)
+    {
+#if (SWO_UART != 0)
+    case DAP_SWO_UART:
+      result = UART_SWO_Control(active);
+      break;
+#endif
+#if (SWO_MANCHESTER != 0)
+    case DAP_SWO_MANCHESTER:
+      result = Manchester_SWO_Control(active);
+      break;
+#endif
+    default:
+      result = 0U;
+      break;
+    }
+    if (result != 0U)
+    {
+      TraceStatus = active;
+#if (SWO_STREAM != 0)
+      StreamNotify();
+#endif
+    }
+  }
+  else
+  {
+    result = 1U;
+  }
+
+  if (result != 0U)
+  {
+    *response = DAP_OK;
+  }
+  else
+  {
+    *response = DAP_ERROR;
+  }
+
+  return ((1U << 16) | 1U);
+}
+
+// Process SWO Status command and prepare response
+//   response: pointer to response data
+//   return:   number of bytes in response
+uint32_t SWO_Status(uint8_t *response)
+{
+  uint8_t status;
+  uint32_t count;
+
+  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
+  {
+    switch (TraceMode)
+    {
+#if (SWO_UART != 0)
+    case DAP_SWO_UART:
+      UART_SWO_Update();
+      break;
+#endif
+#if (SWO_MANCHESTER != 0)
+    case DAP_SWO_MANCHESTER:
+      Manchester_SWO_Update();
+      break;
+#endif
+    default:
+      break;
+    }
+  }
+
+  status = GetTraceStatus();
+  count = GetTraceCount();
+
+  *response++ = status;
+  *response++ = (uint8_t)(count >> 0);
+  *response++ = (uint8_t)(count >> 8);
+  *response++ = (uint8_t)(count >> 16);
+  *response = (uint8_t)(count >> 24);
+
+  return (5U);
+}
+
+// Process SWO Extended Status command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_ExtendedStatus(const uint8_t *request, uint8_t *response)
+{
+  uint8_t cmd;
+  uint8_t status;
+  uint32_t count;
+#if (TIMESTAMP_CLOCK != 0U)
+  uint32_t index;
+  uint32_t tick;
+#endif
+  uint32_t num;
+
+  num = 0U;
+  cmd = *request;
+
+  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
+  {
+    switch (TraceMode)
+    {
+#if (SWO_UART != 0)
+    case DAP_SWO_UART:
+      UART_SWO_Update();
+      break;
+#endif
+#if (SWO_MANCHESTER != 0)
+    case DAP_SWO_MANCHESTER:
+      Manchester_SWO_Update();
+      break;
+#endif
+    default:
+      break;
+    }
+  }
+
+  if (cmd & 0x01U)
+  {
+    status = GetTraceStatus();
+    *response++ = status;
+    num += 1U;
+  }
+
+  if (cmd & 0x02U)
+  {
+    count = GetTraceCount();
+    *response++ = (uint8_t)(count >> 0);
+    *response++ = (uint8_t)(count >> 8);
+    *response++ = (uint8_t)(count >> 16);
+    *response++ = (uint8_t)(count >> 24);
+    num += 4U;
+  }
+
+#if (TIMESTAMP_CLOCK != 0U)
+  if (cmd & 0x04U)
+  {
+    do
+    {
+      TraceUpdate = 0U;
+      index = TraceTimestamp.index;
+      tick = TraceTimestamp.tick;
+    } while (TraceUpdate != 0U);
+    *response++ = (uint8_t)(index >> 0);
+    *response++ = (uint8_t)(index >> 8);
+    *response++ = (uint8_t)(index >> 16);
+    *response++ = (uint8_t)(index >> 24);
+    *response++ = (uint8_t)(tick >> 0);
+    *response++ = (uint8_t)(tick >> 8);
+    *response++ = (uint8_t)(tick >> 16);
+    *response++ = (uint8_t)(tick >> 24);
+    num += 8U;
+  }
+#endif
+
+  return ((1U << 16) | num);
+}
+
+// Process SWO Data command and prepare response
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Data(const uint8_t *request, uint8_t *response)
+{
+  uint8_t status;
+  uint32_t count;
+  uint32_t n;
+
+  if (TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
+  {
+    switch (TraceMode)
+    {
+#if (SWO_UART != 0)
+    case DAP_SWO_UART:
+      UART_SWO_Update();
+      break;
+#endif
+#if (SWO_MANCHESTER != 0)
+    case DAP_SWO_MANCHESTER:
+      Manchester_SWO_Update();
+      break;
+#endif
+    default:
+      break;
+    }
+  }
+
+  status = GetTraceStatus();
+  count = GetTraceCount();
+
+  if (TraceTransport == 1U)
+  {
+    n = (*(request + 0) << 0) |
+        (*(request + 1) << 8);
+  }
+  else
+  {
+    n = 0U;
+  }
+  if (count > n)
+  {
+    count = n;
+  }
+
+  *response++ = status;
+  *response++ = (uint8_t)(count >> 0);
+  *response++ = (uint8_t)(count >> 8);
+
+  for (n = count; n; n--)
+  {
+    *response++ = TraceBuf[TraceOut++ & (SWO_BUFFER_SIZE - 1U)];
+  }
+
+  ResumeTrace();
+
+  return ((2U << 16) | (3U + count));
+}
+
+#if (SWO_ITM != 0)
+
+// Process SWO Filter (vendor) command and prepare response
+// Selects what the ITM decoder forwards, accepted while capture is stopped.
+//   request:  flags, stimulus ports [31:0], text ports [31:0], DWT packets [31:0]
+//   response: status
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t SWO_Filter(const uint8_t *request, uint8_t *response)
+{
+  if (!(TraceStatus & DAP_SWO_CAPTURE_ACTIVE))
+  {
+    ITM_Filter.flags = *request;
+    ITM_Filter.ports = (*(request + 1) << 0) |
+                       (*(request + 2) << 8) |
+                       (*(request + 3) << 16) |
+                       (*(request + 4) << 24);
+    ITM_Filter.text = (*(request + 5) << 0) |
+                      (*(request + 6) << 8) |
+                      (*(request + 7) << 16) |
+                      (*(request + 8) << 24);
+    ITM_Filter.hardware = (*(request + 9) << 0) |
+                          (*(request + 10) << 8) |
+                          (*(request + 11) << 16) |
+                          (*(request + 12) << 24);
+    *response = DAP_OK;
+  }
+  else
+  {
+    *response = DAP_ERROR;
+  }
+
+  return ((13U << 16) | 1U);
+}
+
+#endif /* (SWO_ITM != 0) */
+
+#if (SWO_STREAM != 0)
+
+// Wake the SWO Thread when streaming
+static void StreamNotify(void)
+{
+  if ((TraceTransport == 2U) && (SWO_ThreadId != NULL))
+  {
+    xTaskNotifyGive(SWO_ThreadId);
+  }
+}
+
+// SWO Data Transfer complete callback
+void SWO_TransferComplete(void)
+{
+  TraceOut += TransferSize;
+  TransferBusy = 0U;
+  ResumeTrace();
+  StreamNotify();
+}
+
+// SWO Thread: streams the Trace Buffer over the SWO endpoint
+// Sends whole USB blocks while data keeps arriving and flushes the
+// remainder after SWO_STREAM_TIMEOUT without new data.
+void SWO_Thread(void *argument)
+{
+  TickType_t timeout;
+  uint32_t flags;
+  uint32_t count;
+  uint32_t index;
+  uint32_t i, n;
+
+  (void)argument;
+
+  SWO_ThreadId = xTaskGetCurrentTaskHandle();
+  timeout = portMAX_DELAY;
+
+  for (;;)
+  {
+    flags = ulTaskNotifyTake(pdTRUE, timeout);
+    if (TraceStatus & DAP_SWO_CAPTURE_ACTIVE)
+    {
+      timeout = pdMS_TO_TICKS(SWO_STREAM_TIMEOUT);
+    }
+    else
+    {
+      timeout = portMAX_DELAY;
+      flags = 0U;
+    }
+    if ((TraceTransport == 2U) && (TransferBusy == 0U))
+    {
+      count = GetTraceCount();
+      if (count != 0U)
+      {
+        index = TraceOut & (SWO_BUFFER_SIZE - 1U);
+        n = SWO_BUFFER_SIZE - index;
+        if (count > n)
+        {
+          count = n;
+        }
+        if (flags != 0U)
+        {
+          i = index & (USB_BLOCK_SIZE - 1U);
+          if (i == 0U)
+          {
+            count &= ~(USB_BLOCK_SIZE - 1U);
+          }
+          else
+          {
+            n = USB_BLOCK_SIZE - i;
+            if (count >= n)
+            {
+              count = n;
+            }
+            else
+            {
+              count = 0U;
+            }
+          }
+        }
+        if (count != 0U)
+        {
+          TransferSize = count;
+          TransferBusy = 1U;
+          SWO_QueueTransfer(&TraceBuf[index], count);
+        }
+      }
+    }
+  }
+}
+
+#endif /* (SWO_STREAM != 0) */
+
+#endif /* ((SWO_UART != 0) || (SWO_MANCHESTER != 0)) */
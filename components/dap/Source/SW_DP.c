@@ -1,313 +1,560 @@
-/*
- * Copyright (c) 2013-2017 ARM Limited. All rights reserved.
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Licensed under the Apache License, Version 2.0 (the License); you may
- * not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an AS IS BASIS, WITHOUT
- * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- *
- * ----------------------------------------------------------------------
- *
- * $Date:        1. December 2017
- * $Revision:    V2.0.0
- *
- * Project:      CMSIS-DAP Source
- * Title:        SW_DP.c CMSIS-DAP SW DP I/O
- *
- *---------------------------------------------------------------------------*/
-
-#include "DAP_config.h"
-#include "DAP.h"
-
-#if defined(__CC_ARM)
-#pragma push
-#pragma O3
-#pragma Otime
-#elif defined(__GNUC__) && !defined(__ARMCC_VERSION)
-#pragma GCC push_options
-#pragma GCC optimize("O3")
-#endif
-
-#if defined(__GNUC__) && !defined(__WEAK)
-#define __WEAK __attribute__((weak))
-#endif
-
-// SW Macros
-
-#define PIN_SWCLK_SET PIN_SWCLK_TCK_SET
-#define PIN_SWCLK_CLR PIN_SWCLK_TCK_CLR
-
-#define SW_CLOCK_CYCLE()                \
-  PIN_SWCLK_CLR();                      \
-  PIN_DELAY();                          \
-  PIN_SWCLK_SET();                      \
-  PIN_DELAY()
-
-#define SW_WRITE_BIT(bit)               \
-  PIN_SWDIO_OUT(bit);                   \
-  PIN_SWCLK_CLR();                      \
-  PIN_DELAY();                          \
-  PIN_SWCLK_SET();                      \
-  PIN_DELAY()
-
-#define SW_READ_BIT(bit)                \
-  PIN_SWCLK_CLR();                      \
-  PIN_DELAY();                          \
-  bit = PIN_SWDIO_IN();                 \
-  PIN_SWCLK_SET();                      \
-  PIN_DELAY()
-
-#define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
-
-
-// Generate SWJ Sequence
-//   count:  sequence bit count
-//   data:   pointer to sequence bit data
-//   return: none
-#if ((DAP_SWD != 0) || (DAP_JTAG != 0))
-__WEAK void SWJ_Sequence (uint32_t count, const uint8_t *data) {
-  uint32_t val;
-  uint32_t n;
-
-  val = 0U;
-  n = 0U;
-  while (count--) {
-    if (n == 0U) {
-      val = *data++;
-      n = 8U;
-    }
-    if (val & 1U) {
-      PIN_SWDIO_TMS_SET();
-    } else {
-      PIN_SWDIO_TMS_CLR();
-    }
-    SW_CLOCK_CYCLE();
-    val >>= 1;
-    n--;
-  }
-}
-#endif
-
-
-// Generate SWD Sequence
-//   info:   sequence information
-//   swdo:   pointer to SWDIO generated data
-//   swdi:   pointer to SWDIO captured data
-//   return: none
-#if (DAP_SWD != 0)
-__WEAK void SWD_Sequence (uint32_t info, const uint8_t *swdo, uint8_t *swdi) {
-  uint32_t val;
-  uint32_t bit;
-  uint32_t n, k;
-
-  n = info & SWD_SEQUENCE_CLK;
-  if (n == 0U) {
-    n = 64U;
-  }
-
-  if (info & SWD_SEQUENCE_DIN) {
-    while (n) {
-      val = 0U;
-      for (k = 8U; k && n; k--, n--) {
-        SW_READ_BIT(bit);
-        val >>= 1;
-        val  |= bit << 7;
-      }
-      val >>= k;
-      *swdi++ = (uint8_t)val;
-    }
-  } else {
-    while (n) {
-      val = *swdo++;
-      for (k = 8U; k && n; k--, n--) {
-        SW_WRITE_BIT(val);
-        val >>= 1;
-      }
-    }
-  }
-}
-#endif
-
-
-#if (DAP_SWD != 0)
-
-
-// SWD Transfer I/O
-//   request: A[3:2] RnW APnDP
-//   data:    DATA[31:0]
-//   return:  ACK[2:0]
-#define SWD_TransferFunction(speed)     /**/                                    \
-static uint8_t SWD_Transfer##speed (uint32_t request, uint32_t *data) {         \
-  uint32_t ack;                                                                 \
-  uint32_t bit;                                                                 \
-  uint32_t val;                                                                 \
-  uint32_t parity;                                                              \
-                                                                                \
-  uint32_t n;                                                                   \
-                                                                                \
-  /* Packet Request */                                                          \
-  parity = 0U;                                                                  \
-  SW_WRITE_BIT(1U);                     /* Start Bit */                         \
-  bit = request >> 0;                                                           \
-  SW_WRITE_BIT(bit);                    /* APnDP Bit */                         \
-  parity += bit;                                                                \
-  bit = request >> 1;                                                           \
-  SW_WRITE_BIT(bit);                    /* RnW Bit */                           \
-  parity += bit;                                                                \
-  bit = request >> 2;                                                           \
-  SW_WRITE_BIT(bit);                    /* A2 Bit */                            \
-  parity += bit;                                                                \
-  bit = request >> 3;                                                           \
-  SW_WRITE_BIT(bit);                    /* A3 Bit */                            \
-  parity += bit;                                                                \
-  SW_WRITE_BIT(parity);                 /* Parity Bit */                        \
-  SW_WRITE_BIT(0U);                     /* Stop Bit */                          \
-  SW_WRITE_BIT(1U);                     /* Park Bit */                          \
-                                                                                \
-  /* Turnaround */                                                              \
-  PIN_SWDIO_OUT_DISABLE();                                                      \
-  for (n = DAP_Data.swd_conf.turnaround; n; n--) {                              \
-    SW_CLOCK_CYCLE();                                                           \
-  }                                                                             \
-                                                                                \
-  /* Acknowledge response */                                                    \
-  SW_READ_BIT(bit);                                                             \
-  ack  = bit << 0;                                                              \
-  SW_READ_BIT(bit);                                                             \
-  ack |= bit << 1;                                                              \
-  SW_READ_BIT(bit);                                                             \
-  ack |= bit << 2;                                                              \
-                                                                                \
-  if (ack == DAP_TRANSFER_OK) {         /* OK response */                       \
-    /* Data transfer */                                                         \
-    if (request & DAP_TRANSFER_RnW) {                                           \
-      /* Read data */                                                           \
-      val = 0U;                                                                 \
-      parity = 0U;                                                              \
-      for (n = 32U; n; n--) {                                                   \
-        SW_READ_BIT(bit);               /* Read RDATA[0:31] */                  \
-        parity += bit;                                                          \
-        val >>= 1;                                                              \
-        val  |= bit << 31;                                                      \
-      }                                                                         \
-      SW_READ_BIT(bit);                 /* Read Parity */                       \
-      if ((parity ^ bit) & 1U) {                                                \
-        ack = DAP_TRANSFER_ERROR;                                               \
-      }                                                                         \
-      if (data) { *data = val; }                                                \
-      /* Turnaround */                                                          \
-      for (n = DAP_Data.swd_conf.turnaround; n; n--) {                          \
-        SW_CLOCK_CYCLE();                                                       \
-      }                                                                         \
-      PIN_SWDIO_OUT_ENABLE();                                                   \
-    } else {                                                                    \
-      /* Turnaround */                                                          \
-      for (n = DAP_Data.swd_conf.turnaround; n; n--) {                          \
-        SW_CLOCK_CYCLE();                                                       \
-      }                                                                         \
-      PIN_SWDIO_OUT_ENABLE();                                                   \
-      /* Write data */                                                          \
-      val = *data;                                                              \
-      parity = 0U;                                                              \
-      for (n = 32U; n; n--) {                                                   \
-        SW_WRITE_BIT(val);              /* Write WDATA[0:31] */                 \
-        parity += val;                                                          \
-        val >>= 1;                                                              \
-      }                                                                         \
-      SW_WRITE_BIT(parity);             /* Write Parity Bit */                  \
-    }                                                                           \
-    /* Capture Timestamp */                                                     \
-    if (request & DAP_TRANSFER_TIMESTAMP) {                                     \
-      DAP_Data.timestamp = TIMESTAMP_GET();                                     \
-    }                                                                           \
-    /* Idle cycles */                                                           \
-    n = DAP_Data.transfer.idle_cycles;                                          \
-    if (n) {                                                                    \
-      PIN_SWDIO_OUT(0U);                                                        \
-      for (; n; n--) {                                                          \
-        SW_CLOCK_CYCLE();                                                       \
-      }                                                                         \
-    }                                                                           \
-    PIN_SWDIO_OUT(1U);                                                          \
-    return ((uint8_t)ack);                                                      \
-  }                                                                             \
-                                                                                \
-  if ((ack == DAP_TRANSFER_WAIT) || (ack == DAP_TRANSFER_FAULT)) {              \
-    /* WAIT or FAULT response */                                                \
-    if (DAP_Data.swd_conf.data_phase && ((request & DAP_TRANSFER_RnW) != 0U)) { \
-      for (n = 32U+1U; n; n--) {                                                \
-        SW_CLOCK_CYCLE();               /* Dummy Read RDATA[0:31] + Parity */   \
-      }                                                                         \
-    }                                                                           \
-    /* Turnaround */                                                            \
-    for (n = DAP_Data.swd_conf.turnaround; n; n--) {                            \
-      SW_CLOCK_CYCLE();                                                         \
-    }                                                                           \
-    PIN_SWDIO_OUT_ENABLE();                                                     \
-    if (DAP_Data.swd_conf.data_phase && ((request & DAP_TRANSFER_RnW) == 0U)) { \
-      PIN_SWDIO_OUT(0U);                                                        \
-      for (n = 32U+1U; n; n--) {                                                \
-        SW_CLOCK_CYCLE();               /* Dummy Write WDATA[0:31] + Parity */  \
-      }                                                                         \
-    }                                                                           \
-    PIN_SWDIO_OUT(1U);                                                          \
-    return ((uint8_t)ack);                                                      \
-  }                                                                             \
-                                                                                \
-  /* Protocol error */                                                          \
-  for (n = DAP_Data.swd_conf.turnaround + 32U + 1U; n; n--) {                   \
-    SW_CLOCK_CYCLE();                   /* Back off data phase */               \
-  }                                                                             \
-  PIN_SWDIO_OUT_ENABLE();                                                       \
-  PIN_SWDIO_OUT(1U);                                                            \
-  return ((uint8_t)ack);                                                        \
-}
-
-
-#undef  PIN_DELAY
-#define PIN_DELAY() PIN_DELAY_FAST()
-SWD_TransferFunction(Fast)
-
-// #undef  PIN_DELAY
-// #define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
-// SWD_TransferFunction(Slow)
-
-// SWD Transfer I/O
-//   request: A[3:2] RnW APnDP
-//   data:    DATA[31:0]
-//   return:  ACK[2:0]
-__WEAK uint8_t  SWD_Transfer(uint32_t request, uint32_t *data) {
-  // if (DAP_Data.fast_clock) {
-  //   return SWD_TransferFast(request, data);
-  // } else {
-  //   return SWD_TransferSlow(request, data);
-  // }
-
-  uint8_t ret = 0;
-  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
-
-  portENTER_CRITICAL(&lock);
-  ret = SWD_TransferFast(request, data);
-  portEXIT_CRITICAL(&lock);
-
-  return ret;
-}
-
-
-#endif  /* (DAP_SWD != 0) */
-
-
-#if defined(__CC_ARM)
-#pragma pop
-#elif defined(__GNUC__) && !defined(__ARMCC_VERSION)
-#pragma GCC pop_options
-#endif
+/*
+ * Copyright (c) 2013-2017 ARM Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * ----------------------------------------------------------------------
+ *
+ * $Date:        1. December 2017
+ * $Revision:    V2.0.0
+ *
+ * Project:      CMSIS-DAP Source
+ * Title:        SW_DP.c CMSIS-DAP SW DP I/O
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "DAP_config.h"
+#include "DAP.h"
+#include "esp_cpu.h"
+
+#if defined(__CC_ARM)
+#pragma push
+#pragma O3
+#pragma Otime
+#elif defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#pragma GCC push_options
+#pragma GCC optimize("O3")
+#endif
+
+#if defined(__GNUC__) && !defined(__WEAK)
+#define __WEAK __attribute__((weak))
+#endif
+
+// SW Macros
+
+#define PIN_SWCLK_SET PIN_SWCLK_TCK_SET
+#define PIN_SWCLK_CLR PIN_SWCLK_TCK_CLR
+
+#define SW_CLOCK_CYCLE()                \
+  PIN_SWCLK_CLR();                      \
+  PIN_DELAY();                          \
+  PIN_SWCLK_SET();                      \
+  PIN_DELAY()
+
+#define SW_WRITE_BIT(bit)               \
+  PIN_SWDIO_OUT(bit);                   \
+  PIN_SWCLK_CLR();                      \
+  PIN_DELAY();                          \
+  PIN_SWCLK_SET();                      \
+  PIN_DELAY()
+
+#define SW_READ_BIT(bit)                \
+  PIN_SWCLK_CLR();                      \
+  PIN_DELAY();                          \
+  bit = PIN_SWDIO_IN();                 \
+  PIN_SWCLK_SET();                      \
+  PIN_DELAY()
+
+#define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
+
+
+// Generate SWJ Sequence
+//   count:  sequence bit count
+//   data:   pointer to sequence bit data
+//   return: none
+#if ((DAP_SWD != 0) || (DAP_JTAG != 0))
+__WEAK void SWJ_Sequence (uint32_t count, const uint8_t *data) {
+  uint32_t val;
+  uint32_t n;
+
+  val = 0U;
+  n = 0U;
+  while (count--) {
+    if (n == 0U) {
+      val = *data++;
+      n = 8U;
+    }
+    if (val & 1U) {
+      PIN_SWDIO_TMS_SET();
+    } else {
+      PIN_SWDIO_TMS_CLR();
+    }
+    SW_CLOCK_CYCLE();
+    val >>= 1;
+    n--;
+  }
+}
+#endif
+
+
+// Generate SWD Sequence
+//   info:   sequence information
+//   swdo:   pointer to SWDIO generated data
+//   swdi:   pointer to SWDIO captured data
+//   return: none
+#if (DAP_SWD != 0)
+__WEAK void SWD_Sequence (uint32_t info, const uint8_t *swdo, uint8_t *swdi) {
+  uint32_t val;
+  uint32_t bit;
+  uint32_t n, k;
+
+  n = info & SWD_SEQUENCE_CLK;
+  if (n == 0U) {
+    n = 64U;
+  }
+
+  if (info & SWD_SEQUENCE_DIN) {
+    while (n) {
+      val = 0U;
+      for (k = 8U; k && n; k--, n--) {
+        SW_READ_BIT(bit);
+        val >>= 1;
+        val  |= bit << 7;
+      }
+      val >>= k;
+      *swdi++ = (uint8_t)val;
+    }
+  } else {
+    while (n) {
+      val = *swdo++;
+      for (k = 8U; k && n; k--, n--) {
+        SW_WRITE_BIT(val);
+        val >>= 1;
+      }
+    }
+  }
+}
+#endif
+
+
+#if (DAP_SWD != 0)
+
+
+// SWD Packet Request headers indexed by request[3:0] (APnDP, RnW, A2, A3)
+//   bit order (LSB first): Start, APnDP, RnW, A2, A3, Parity, Stop, Park
+static const uint8_t SWD_RequestHeader[16] = {
+  0x81U, 0xA3U, 0xA5U, 0x87U, 0xA9U, 0x8BU, 0x8DU, 0xAFU,
+  0xB1U, 0x93U, 0x95U, 0xB7U, 0x99U, 0xBBU, 0xBDU, 0x9FU
+};
+
+
+// SWD Transfer I/O
+//   request: A[3:2] RnW APnDP
+//   data:    DATA[31:0]
+//   return:  ACK[2:0]
+// The kernel is instantiated once per configuration: turn, phase and idle are
+// either compile-time constants (specialised kernels) or the DAP_Data fields.
+#define SWD_TransferFunction(speed, turn, phase, idle) /**/                     \
+static uint8_t SWD_Transfer##speed (uint32_t request, uint32_t *data) {         \
+  uint32_t ack;                                                                 \
+  uint32_t bit;                                                                 \
+  uint32_t val;                                                                 \
+  uint32_t parity;                                                              \
+                                                                                \
+  uint32_t n;                                                                   \
+                                                                                \
+  /* Packet Request */                                                          \
+  val = SWD_RequestHeader[request & 0x0FU];                                     \
+  for (n = 8U; n; n--) {                                                        \
+    SW_WRITE_BIT(val);                  /* Start..Park Bits */                  \
+    val >>= 1;                                                                  \
+  }                                                                             \
+                                                                                \
+  /* Turnaround */                                                              \
+  PIN_SWDIO_OUT_DISABLE();                                                      \
+  for (n = (turn); n; n--) {                                                    \
+    SW_CLOCK_CYCLE();                                                           \
+  }                                                                             \
+                                                                                \
+  /* Acknowledge response */                                                    \
+  SW_READ_BIT(bit);                                                             \
+  ack  = bit << 0;                                                              \
+  SW_READ_BIT(bit);                                                             \
+  ack |= bit << 1;                                                              \
+  SW_READ_BIT(bit);                                                             \
+  ack |= bit << 2;                                                              \
+                                                                                \
+  if (ack == DAP_TRANSFER_OK) {         /* OK response */                       \
+    /* Data transfer */                                                         \
+    if (request & DAP_TRANSFER_RnW) {                                           \
+      /* Read data */                                                           \
+      val = 0U;                                                                 \
+      parity = 0U;                                                              \
+      for (n = 32U; n; n--) {                                                   \
+        SW_READ_BIT(bit);               /* Read RDATA[0:31] */                  \
+        parity += bit;                                                          \
+        val >>= 1;                                                              \
+        val  |= bit << 31;                                                      \
+      }                                                                         \
+      SW_READ_BIT(bit);                 /* Read Parity */                       \
+      if ((parity ^ bit) & 1U) {                                                \
+        ack = DAP_TRANSFER_ERROR;                                               \
+      }                                                                         \
+      if (data) { *data = val; }                                                \
+      /* Turnaround */                                                          \
+      for (n = (turn); n; n--) {                                                \
+        SW_CLOCK_CYCLE();                                                       \
+      }                                                                         \
+      PIN_SWDIO_OUT_ENABLE();                                                   \
+    } else {                                                                    \
+      /* Turnaround */                                                          \
+      for (n = (turn); n; n--) {                                                \
+        SW_CLOCK_CYCLE();                                                       \
+      }                                                                         \
+      PIN_SWDIO_OUT_ENABLE();                                                   \
+      /* Write data */                                                          \
+      val = *data;                                                              \
+      parity = 0U;                                                              \
+      for (n = 32U; n; n--) {                                                   \
+        SW_WRITE_BIT(val);              /* Write WDATA[0:31] */                 \
+        parity += val;                                                          \
+        val >>= 1;                                                              \
+      }                                                                         \
+      SW_WRITE_BIT(parity);             /* Write Parity Bit */                  \
+    }                                                                           \
+    /* Capture Timestamp */                                                     \
+    if (request & DAP_TRANSFER_TIMESTAMP) {                                     \
+      DAP_Data.timestamp = TIMESTAMP_GET();                                     \
+    }                                                                           \
+    /* Idle cycles */                                                           \
+    n = (idle);                                                                 \
+    if (n) {                                                                    \
+      PIN_SWDIO_OUT(0U);                                                        \
+      for (; n; n--) {                                                          \
+        SW_CLOCK_CYCLE();                                                       \
+      }                                                                         \
+    }                                                                           \
+    PIN_SWDIO_OUT(1U);                                                          \
+    return ((uint8_t)ack);                                                      \
+  }                                                                             \
+                                                                                \
+  if ((ack == DAP_TRANSFER_WAIT) || (ack == DAP_TRANSFER_FAULT)) {              \
+    /* WAIT or FAULT response */                                                \
+    if ((phase) && ((request & DAP_TRANSFER_RnW) != 0U)) {                      \
+      for (n = 32U+1U; n; n--) {                                                \
+        SW_CLOCK_CYCLE();               /* Dummy Read RDATA[0:31] + Parity */   \
+      }                                                                         \
+    }                                                                           \
+    /* Turnaround */                                                            \
+    for (n = (turn); n; n--) {                                                  \
+      SW_CLOCK_CYCLE();                                                         \
+    }                                                                           \
+    PIN_SWDIO_OUT_ENABLE();                                                     \
+    if ((phase) && ((request & DAP_TRANSFER_RnW) == 0U)) {                      \
+      PIN_SWDIO_OUT(0U);                                                        \
+      for (n = 32U+1U; n; n--) {                                                \
+        SW_CLOCK_CYCLE();               /* Dummy Write WDATA[0:31] + Parity */  \
+      }                                                                         \
+    }                                                                           \
+    PIN_SWDIO_OUT(1U);                                                          \
+    return ((uint8_t)ack);                                                      \
+  }                                                                             \
+                                                                                \
+  /* Protocol error */                                                          \
+  for (n = (turn) + 32U + 1U; n; n--) {                                         \
+    SW_CLOCK_CYCLE();                   /* Back off data phase */               \
+  }                                                                             \
+  PIN_SWDIO_OUT_ENABLE();                                                       \
+  PIN_SWDIO_OUT(1U);                                                            \
+  return ((uint8_t)ack);                                                        \
+}
+
+
+// SWD TARGETSEL write (DPv2 multi-drop)
+// Only valid directly after a line reset. No target drives the ACK phase, so it
+// is clocked with SWDIO released and the data phase always follows.
+//   request: A[3:2] RnW APnDP (DP_TARGETSEL write, optional timestamp)
+//   data:    TARGETSEL value
+//   return:  DAP_TRANSFER_OK
+// Instantiated per clock speed like the transfer kernels.
+#define SWD_TargetSelFunction(speed) /**/                                       \
+static uint8_t SWD_TargetSel##speed (uint32_t request, uint32_t data) {         \
+  uint32_t header;                                                              \
+  uint32_t parity;                                                              \
+  uint32_t n;                                                                   \
+                                                                                \
+  header = SWD_RequestHeader[DP_TARGETSEL];                                     \
+  for (n = 8U; n; n--) {                                                        \
+    SW_WRITE_BIT(header);                                                       \
+    header >>= 1;                                                               \
+  }                                                                             \
+                                                                                \
+  /* Turnaround, ACK (not driven), turnaround */                                \
+  PIN_SWDIO_OUT_DISABLE();                                                      \
+  for (n = (DAP_Data.swd_conf.turnaround << 1) + 3U; n; n--) {                  \
+    SW_CLOCK_CYCLE();                                                           \
+  }                                                                             \
+  PIN_SWDIO_OUT_ENABLE();                                                       \
+                                                                                \
+  parity = 0U;                                                                  \
+  for (n = 32U; n; n--) {                                                       \
+    SW_WRITE_BIT(data);                                                         \
+    parity += data;                                                             \
+    data >>= 1;                                                                 \
+  }                                                                             \
+  SW_WRITE_BIT(parity);                                                         \
+                                                                                \
+  if (request & DAP_TRANSFER_TIMESTAMP) {                                       \
+    DAP_Data.timestamp = TIMESTAMP_GET();                                       \
+  }                                                                             \
+  n = DAP_Data.transfer.idle_cycles;                                            \
+  if (n) {                                                                      \
+    PIN_SWDIO_OUT(0U);                                                          \
+    for (; n; n--) {                                                            \
+      SW_CLOCK_CYCLE();                                                         \
+    }                                                                           \
+  }                                                                             \
+  PIN_SWDIO_OUT(1U);                                                            \
+  return (DAP_TRANSFER_OK);                                                     \
+}
+
+
+// Generic kernels follow DAP_SWD_Configure / DAP_TransferConfigure at run time,
+// the T1 kernels are specialised for turnaround 1, no data phase, no idle cycles.
+#undef  PIN_DELAY
+#define PIN_DELAY() PIN_DELAY_FAST()
+SWD_TransferFunction(Fast,   DAP_Data.swd_conf.turnaround,
+                             DAP_Data.swd_conf.data_phase,
+                             DAP_Data.transfer.idle_cycles)
+SWD_TransferFunction(FastT1, 1U, 0U, 0U)
+SWD_TargetSelFunction(Fast)
+
+#undef  PIN_DELAY
+#define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
+SWD_TransferFunction(Slow,   DAP_Data.swd_conf.turnaround,
+                             DAP_Data.swd_conf.data_phase,
+                             DAP_Data.transfer.idle_cycles)
+SWD_TransferFunction(SlowT1, 1U, 0U, 0U)
+SWD_TargetSelFunction(Slow)
+
+
+// Generate SWCLK cycles the way the transfer kernels write data bits
+//   cycles: number of SWCLK cycles
+//   bit:    SWDIO level driven during the cycles
+//   return: none
+#undef  PIN_DELAY
+#define PIN_DELAY() PIN_DELAY_FAST()
+static void SWJ_ClockRunFast (uint32_t cycles, uint32_t bit) {
+  for (; cycles; cycles--) {
+    SW_WRITE_BIT(bit);
+  }
+}
+
+#undef  PIN_DELAY
+#define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
+static void SWJ_ClockRunSlow (uint32_t cycles, uint32_t bit) {
+  for (; cycles; cycles--) {
+    SW_WRITE_BIT(bit);
+  }
+}
+
+
+// Time SWCLK generation with the CPU cycle counter (for swd_clock_calibrate)
+//   delay:  PIN_DELAY_SLOW argument, 0 = fast clock path
+//   cycles: number of SWCLK cycles
+//   return: elapsed CPU cycles
+uint32_t SWJ_ClockMeasure (uint32_t delay, uint32_t cycles) {
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+  uint32_t saved;
+  uint32_t start;
+  uint32_t stop;
+
+  saved = DAP_Data.clock_delay;
+  DAP_Data.clock_delay = delay;
+  PIN_SWDIO_OUT_ENABLE();
+
+  portENTER_CRITICAL(&lock);
+  start = esp_cpu_get_cycle_count();
+  if (delay == 0U) {
+    SWJ_ClockRunFast(cycles, 1U);
+  } else {
+    SWJ_ClockRunSlow(cycles, 1U);
+  }
+  stop = esp_cpu_get_cycle_count();
+  portEXIT_CRITICAL(&lock);
+
+  DAP_Data.clock_delay = saved;
+  return (stop - start);
+}
+
+
+// Select SWD Transfer kernel matching the current clock and transfer configuration
+// Called whenever DAP_Data.fast_clock, swd_conf or transfer.idle_cycles change.
+// The kernels are kept per Debug Port (DAP_Port->transfer, DAP_Port->targetsel_write).
+//   return: none
+void SWD_TransferSelect (void) {
+  uint32_t simple;
+
+  simple = (DAP_Data.swd_conf.turnaround    == 1U) &&
+           (DAP_Data.swd_conf.data_phase    == 0U) &&
+           (DAP_Data.transfer.idle_cycles   == 0U);
+
+  if (DAP_Data.fast_clock) {
+    DAP_Port->transfer = simple ? SWD_TransferFastT1 : SWD_TransferFast;
+    DAP_Port->targetsel_write = SWD_TargetSelFast;
+  } else {
+    DAP_Port->transfer = simple ? SWD_TransferSlowT1 : SWD_TransferSlow;
+    DAP_Port->targetsel_write = SWD_TargetSelSlow;
+  }
+}
+
+
+// Adaptive idle cycles after AP writes
+// WAIT responses are counted per AP (APSEL of the last DP SELECT write). Every
+// SWD_ADAPT_WINDOW successful AP writes the cost in SWCLK cycles per write is
+// evaluated and the idle cycles inserted after AP writes are moved by a hill
+// climb towards the minimum. Active while DAP_Data.transfer.adaptive is set,
+// which swd_init() does for the probe's own transfers; host sessions adapt only
+// after opting in with the TransferAdaptive vendor command (DAP_Port->adapt_host).
+// Statistics are kept per Debug Port (DAP_Port->adapt, SWD_AdaptAP_t in DAP.h).
+
+#define SWD_ADAPT_WINDOW    64U     // AP writes per evaluation window
+#define SWD_ADAPT_IDLE_MAX  64U     // Upper limit for adaptive idle cycles
+
+
+// Get statistics slot of the currently selected AP
+//   return: pointer to slot
+static SWD_AdaptAP_t *SWD_AdaptSlot (void) {
+  SWD_AdaptAP_t *ap;
+
+  ap = &DAP_Port->adapt[DAP_Port->adapt_apsel & (SWD_ADAPT_AP_SLOTS - 1U)];
+  if ((ap->dir == 0) || (ap->apsel != DAP_Port->adapt_apsel)) {
+    memset(ap, 0, sizeof(*ap));
+    ap->apsel = DAP_Port->adapt_apsel;
+    ap->dir   = 1;
+  }
+  return (ap);
+}
+
+
+// Evaluate a finished window and move the idle cycles
+//   ap:     statistics slot
+//   return: none
+static void SWD_AdaptWindow (SWD_AdaptAP_t *ap) {
+  uint32_t header;
+  uint32_t cost;
+  uint32_t step;
+
+  // Request + turnaround + ACK, then turnaround + data + parity for a write
+  header = 8U + DAP_Data.swd_conf.turnaround + 3U;
+  cost   = ap->writes * (header + DAP_Data.swd_conf.turnaround + 33U + ap->idle) +
+           ap->waits  * (header + DAP_Data.swd_conf.turnaround +
+                         (DAP_Data.swd_conf.data_phase ? 33U : 0U));
+  cost   = (cost << 4) / ap->writes;
+
+  if ((ap->waits != 0U) || (ap->idle != 0U)) {
+    if ((ap->cost != 0U) && (cost > ap->cost)) {
+      ap->dir = -ap->dir;
+    }
+    if (ap->idle == 0U) {
+      ap->dir = 1;
+    } else if (ap->idle >= SWD_ADAPT_IDLE_MAX) {
+      ap->dir = -1;
+    }
+    step = 1U + (ap->idle >> 2);
+    if (ap->dir > 0) {
+      ap->idle = (uint8_t)(((ap->idle + step) < SWD_ADAPT_IDLE_MAX) ? (ap->idle + step) : SWD_ADAPT_IDLE_MAX);
+    } else {
+      ap->idle = (uint8_t)((ap->idle > step) ? (ap->idle - step) : 0U);
+    }
+  }
+
+  ap->cost   = cost;
+  ap->writes = 0U;
+  ap->waits  = 0U;
+}
+
+
+// Update WAIT statistics after a transfer
+//   request: A[3:2] RnW APnDP
+//   data:    DATA[31:0]
+//   ack:     ACK[2:0]
+//   return:  none
+static void SWD_AdaptUpdate (uint32_t request, const uint32_t *data, uint32_t ack) {
+  SWD_AdaptAP_t *ap;
+
+  if ((request & DAP_TRANSFER_APnDP) == 0U) {
+    // Track APSEL of DP SELECT writes
+    if ((ack == DAP_TRANSFER_OK) &&
+        ((request & (DAP_TRANSFER_RnW | DAP_TRANSFER_A2 | DAP_TRANSFER_A3)) == DP_SELECT)) {
+      DAP_Port->adapt_apsel = (uint8_t)(*data >> 24);
+    }
+    return;
+  }
+
+  ap = SWD_AdaptSlot();
+  if (ack == DAP_TRANSFER_WAIT) {
+    if (ap->waits != 0xFFFFU) {
+      ap->waits++;
+    }
+  } else if ((ack == DAP_TRANSFER_OK) && ((request & DAP_TRANSFER_RnW) == 0U)) {
+    if (++ap->writes >= SWD_ADAPT_WINDOW) {
+      SWD_AdaptWindow(ap);
+    }
+  }
+}
+
+
+// SWD Transfer I/O
+//   request: A[3:2] RnW APnDP
+//   data:    DATA[31:0]
+//   return:  ACK[2:0]
+__WEAK uint8_t  SWD_Transfer(uint32_t request, uint32_t *data) {
+  uint8_t ret = 0;
+  uint32_t idle = 0U;
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+  if ((request & (DAP_TRANSFER_APnDP | DAP_TRANSFER_RnW | DAP_TRANSFER_A2 | DAP_TRANSFER_A3)) == DP_TARGETSEL) {
+    portENTER_CRITICAL(&lock);
+    ret = DAP_Port->targetsel_write(request, *data);
+    portEXIT_CRITICAL(&lock);
+    return ret;
+  }
+
+  if (DAP_Data.transfer.adaptive &&
+      ((request & (DAP_TRANSFER_APnDP | DAP_TRANSFER_RnW)) == DAP_TRANSFER_APnDP)) {
+    idle = SWD_AdaptSlot()->idle;
+  }
+
+  portENTER_CRITICAL(&lock);
+  ret = DAP_Port->transfer(request, data);
+  if ((ret == DAP_TRANSFER_OK) && (idle != 0U)) {
+    // Adaptive idle cycles after AP write
+    if (DAP_Data.fast_clock) {
+      SWJ_ClockRunFast(idle, 0U);
+    } else {
+      SWJ_ClockRunSlow(idle, 0U);
+    }
+    PIN_SWDIO_OUT(1U);
+  }
+  portEXIT_CRITICAL(&lock);
+
+  if (DAP_Data.transfer.adaptive) {
+    SWD_AdaptUpdate(request, data, ret);
+  }
+
+  return ret;
+}
+
+
+#endif  /* (DAP_SWD != 0) */
+
+
+#if defined(__CC_ARM)
+#pragma pop
+#elif defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#pragma GCC pop_options
+#endif
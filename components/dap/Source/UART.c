@@ -0,0 +1,711 @@
+/******************************************************************************
+ * @file     UART.c
+ * @brief    CMSIS-DAP UART Communication Port
+ *
+ * @note
+ * Target UART bridge on an ESP32-S3 UART (DAP_UART_DRIVER). Received data
+ * goes into UartRxBuf and data to send into UartTxBuf, both single producer /
+ * single consumer rings with free running indexes, so the UART threads and
+ * their peers never take a lock on the data path:
+ *
+ *   UART RX FIFO -> driver (ISR) -> UART_RxThread -> UartRxBuf
+ *     -> USB COM port (UART_RxThread) or DAP_UART_Transfer (DAP thread)
+ *   USB COM port (UART_TxThread) or DAP_UART_Transfer (DAP thread)
+ *     -> UartTxBuf -> UART_TxThread -> driver (ISR) -> UART TX FIFO
+ *
+ * The transport selects the peer: USB_COM_PORT_Read/Write of the USB device
+ * layer (CDC interface, default) or the DAP_UART_* commands. Data is only
+ * taken from a source when the next ring has room, so a slow USB host holds
+ * the UART back instead of losing data, down to the UART driver buffer; an
+ * RX FIFO overflow is reported as DAP_UART_STATUS_RX_DATA_LOST.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "DAP_config.h"
+#include "DAP.h"
+
+#if (DAP_UART != 0)
+
+#include "driver/uart.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+#define UART_DRV_RX_BUFFER 4096U   /* UART driver buffer between RX FIFO and UartRxBuf */
+#define UART_RX_FULL       100U    /* RX FIFO level that raises the data interrupt */
+#define UART_RX_TOUT       4U      /* RX idle time (symbols) that flushes the FIFO */
+#define UART_RX_BLOCK      512U    /* Bytes moved to the USB COM port at once */
+
+#define UART_CONTROL_DATA_BITS(control) (((control) >> 0) & 0x07U)
+#define UART_CONTROL_PARITY(control)    (((control) >> 3) & 0x07U)
+#define UART_CONTROL_STOP_BITS(control) (((control) >> 6) & 0x03U)
+
+static volatile uint8_t UartTransport;
+static volatile uint8_t UartReceiveEnabled;
+static volatile uint8_t UartTransmitEnabled;
+static volatile uint32_t UartReceiveFlush;   /* Flush requested, done by UART_RxThread */
+static volatile uint32_t UartTransmitFlush;  /* Flush requested, done by UART_TxThread */
+static volatile uint8_t UartErrors;          /* DAP_UART_STATUS_* error flags */
+
+static uint8_t UartRxBuf[DAP_UART_RX_BUFFER_SIZE];
+static volatile uint32_t UartRxIndexI;
+static volatile uint32_t UartRxIndexO;
+
+static uint8_t UartTxBuf[DAP_UART_TX_BUFFER_SIZE];
+static volatile uint32_t UartTxIndexI;
+static volatile uint32_t UartTxIndexO;
+
+static QueueHandle_t UartQueue;              /* UART driver event queue */
+static SemaphoreHandle_t UartLock;           /* Serializes configuration changes */
+static TaskHandle_t UartRxThreadId;
+static TaskHandle_t UartTxThreadId;
+
+// Ring indexes and flush flags are read and written by different cores: the
+// consumer must see the data before the index that publishes it, the
+// producer must not reuse space before the consumer is done with it.
+static inline uint32_t AtomicGet(volatile uint32_t *var)
+{
+  return (__atomic_load_n(var, __ATOMIC_ACQUIRE));
+}
+
+static inline void AtomicSet(volatile uint32_t *var, uint32_t value)
+{
+  __atomic_store_n(var, value, __ATOMIC_RELEASE);
+}
+
+// Wake the RX thread (space freed in UartRxBuf, USB COM port ready)
+static void UART_RxWake(void)
+{
+  uart_event_t event = {.type = UART_EVENT_MAX};
+
+  if (UartQueue != NULL)
+  {
+    xQueueSend(UartQueue, &event, 0);
+  }
+}
+
+// Wake the TX thread (data in UartTxBuf or at the USB COM port)
+static void UART_TxWake(void)
+{
+  if (UartTxThreadId != NULL)
+  {
+    xTaskNotifyGive(UartTxThreadId);
+  }
+}
+
+// Move data from the UART driver into UartRxBuf
+//   return: 1 - data left in the driver (UartRxBuf full), 0 - driver empty
+static uint32_t UART_Receive(void)
+{
+  uint32_t index, count;
+  size_t pending;
+  int num;
+
+  if (!UartReceiveEnabled)
+  {
+    uart_flush_input(DAP_UART_DRIVER);
+    return (0U);
+  }
+
+  for (;;)
+  {
+    index = UartRxIndexI;
+    count = DAP_UART_RX_BUFFER_SIZE - (index - AtomicGet(&UartRxIndexO));
+    if (count > (DAP_UART_RX_BUFFER_SIZE - (index & (DAP_UART_RX_BUFFER_SIZE - 1U))))
+    {
+      count = DAP_UART_RX_BUFFER_SIZE - (index & (DAP_UART_RX_BUFFER_SIZE - 1U));
+    }
+    if (count == 0U)
+    {
+      return ((uart_get_buffered_data_len(DAP_UART_DRIVER, &pending) == ESP_OK) && (pending != 0U));
+    }
+    num = uart_read_bytes(DAP_UART_DRIVER, &UartRxBuf[index & (DAP_UART_RX_BUFFER_SIZE - 1U)], count, 0);
+    if (num <= 0)
+    {
+      return (0U);
+    }
+    AtomicSet(&UartRxIndexI, index + (uint32_t)num);
+  }
+}
+
+#if (DAP_UART_USB_COM_PORT != 0)
+
+// Move data from UartRxBuf to the USB COM port
+//   return: 1 - data left (USB COM port busy), 0 - UartRxBuf empty
+static uint32_t UART_ComPortSend(void)
+{
+  uint32_t index, count, num;
+
+  for (;;)
+  {
+    index = UartRxIndexO;
+    count = AtomicGet(&UartRxIndexI) - index;
+    if (count == 0U)
+    {
+      return (0U);
+    }
+    if (count > (DAP_UART_RX_BUFFER_SIZE - (index & (DAP_UART_RX_BUFFER_SIZE - 1U))))
+    {
+      count = DAP_UART_RX_BUFFER_SIZE - (index & (DAP_UART_RX_BUFFER_SIZE - 1U));
+    }
+    if (count > UART_RX_BLOCK)
+    {
+      count = UART_RX_BLOCK;
+    }
+    num = USB_COM_PORT_Write(&UartRxBuf[index & (DAP_UART_RX_BUFFER_SIZE - 1U)], count);
+    if (num == 0U)
+    {
+      return (1U);
+    }
+    AtomicSet(&UartRxIndexO, index + num);
+  }
+}
+
+// Move data from the USB COM port into UartTxBuf
+static void UART_ComPortReceive(void)
+{
+  uint32_t index, count, num;
+
+  for (;;)
+  {
+    index = UartTxIndexI;
+    count = DAP_UART_TX_BUFFER_SIZE - (index - AtomicGet(&UartTxIndexO));
+    if (count > (DAP_UART_TX_BUFFER_SIZE - (index & (DAP_UART_TX_BUFFER_SIZE - 1U))))
+    {
+      count = DAP_UART_TX_BUFFER_SIZE - (index & (DAP_UART_TX_BUFFER_SIZE - 1U));
+    }
+    if (count == 0U)
+    {
+      return;
+    }
+    num = USB_COM_PORT_Read(&UartTxBuf[index & (DAP_UART_TX_BUFFER_SIZE - 1U)], count);
+    if (num == 0U)
+    {
+      return;
+    }
+    AtomicSet(&UartTxIndexI, index + num);
+  }
+}
+
+#endif /* (DAP_UART_USB_COM_PORT != 0) */
+
+// UART receive thread: handles UART driver events
+// Polls every tick while data waits for room in UartRxBuf or at the USB COM port.
+static void UART_RxThread(void *argument)
+{
+  uart_event_t event;
+  uint32_t pending = 0U;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (xQueueReceive(UartQueue, &event, pending ? 1U : portMAX_DELAY) == pdTRUE)
+    {
+      switch (event.type)
+      {
+      case UART_FIFO_OVF:
+        UartErrors |= DAP_UART_STATUS_RX_DATA_LOST;
+        break;
+      case UART_FRAME_ERR:
+        UartErrors |= DAP_UART_STATUS_FRAMING_ERROR;
+        break;
+      case UART_PARITY_ERR:
+        UartErrors |= DAP_UART_STATUS_PARITY_ERROR;
+        break;
+      default:
+        break;
+      }
+    }
+    if (AtomicGet(&UartReceiveFlush))
+    {
+      uart_flush_input(DAP_UART_DRIVER);
+      AtomicSet(&UartRxIndexO, AtomicGet(&UartRxIndexI));
+      AtomicSet(&UartReceiveFlush, 0U);
+    }
+    for (;;)
+    {
+      pending = UART_Receive();
+#if (DAP_UART_USB_COM_PORT != 0)
+      if (UartTransport == DAP_UART_TRANSPORT_USB_COM_PORT)
+      {
+        if (UART_ComPortSend())
+        {
+          pending = 1U;
+          break;
+        }
+        if (pending)
+        {
+          continue;   // UartRxBuf was full, room again after sending
+        }
+      }
+#endif
+      break;
+    }
+  }
+}
+
+// UART transmit thread: sends UartTxBuf
+// uart_write_bytes returns once the data is in the TX FIFO (no driver TX
+// buffer), the ring space is released only then. While transmit is
+// disabled the data is held in UartTxBuf.
+static void UART_TxThread(void *argument)
+{
+  uint32_t index, count;
+
+  (void)argument;
+
+  for (;;)
+  {
+    if (AtomicGet(&UartTransmitFlush))
+    {
+      AtomicSet(&UartTxIndexO, AtomicGet(&UartTxIndexI));
+      AtomicSet(&UartTransmitFlush, 0U);
+    }
+#if (DAP_UART_USB_COM_PORT != 0)
+    if (UartTransport == DAP_UART_TRANSPORT_USB_COM_PORT)
+    {
+      UART_ComPortReceive();
+    }
+#endif
+    index = UartTxIndexO;
+    count = AtomicGet(&UartTxIndexI) - index;
+    if ((count == 0U) || !UartTransmitEnabled)
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    if (count > (DAP_UART_TX_BUFFER_SIZE - (index & (DAP_UART_TX_BUFFER_SIZE - 1U))))
+    {
+      count = DAP_UART_TX_BUFFER_SIZE - (index & (DAP_UART_TX_BUFFER_SIZE - 1U));
+    }
+    uart_write_bytes(DAP_UART_DRIVER, &UartTxBuf[index & (DAP_UART_TX_BUFFER_SIZE - 1U)], count);
+    if (!AtomicGet(&UartTransmitFlush))
+    {
+      AtomicSet(&UartTxIndexO, index + count);
+    }
+  }
+}
+
+// Apply UART settings
+//   control:  data bits, parity and stop bits (as in DAP_UART_Configure)
+//   baudrate: requested baudrate, in/out actual baudrate (0 when not configured)
+//   return:   DAP_UART_CFG_ERROR_* of the settings not supported
+static uint32_t UART_Config(uint32_t control, uint32_t *baudrate)
+{
+  uart_word_length_t data_bits;
+  uart_parity_t parity;
+  uart_stop_bits_t stop_bits;
+  uint32_t status = 0U;
+  uint32_t actual;
+
+  switch (UART_CONTROL_DATA_BITS(control))
+  {
+  case 0U:
+    data_bits = UART_DATA_8_BITS;
+    break;
+  case 5U:
+    data_bits = UART_DATA_5_BITS;
+    break;
+  case 6U:
+    data_bits = UART_DATA_6_BITS;
+    break;
+  case 7U:
+    data_bits = UART_DATA_7_BITS;
+    break;
+  default:
+    status |= DAP_UART_CFG_ERROR_DATA_BITS;
+    break;
+  }
+
+  // Mark and space parity are not supported by the UART
+  switch (UART_CONTROL_PARITY(control))
+  {
+  case 0U:
+    parity = UART_PARITY_DISABLE;
+    break;
+  case 1U:
+    parity = UART_PARITY_ODD;
+    break;
+  case 2U:
+    parity = UART_PARITY_EVEN;
+    break;
+  default:
+    status |= DAP_UART_CFG_ERROR_PARITY;
+    break;
+  }
+
+  switch (UART_CONTROL_STOP_BITS(control))
+  {
+  case 0U:
+    stop_bits = UART_STOP_BITS_1;
+    break;
+  case 1U:
+    stop_bits = UART_STOP_BITS_1_5;
+    break;
+  case 2U:
+    stop_bits = UART_STOP_BITS_2;
+    break;
+  default:
+    status |= DAP_UART_CFG_ERROR_STOP_BITS;
+    break;
+  }
+
+  if ((status != 0U) || (*baudrate == 0U) || (UartLock == NULL))
+  {
+    *baudrate = 0U;
+    return (status);
+  }
+  if (*baudrate > DAP_UART_MAX_BAUDRATE)
+  {
+    *baudrate = DAP_UART_MAX_BAUDRATE;
+  }
+
+  // Applied while running, the threads keep going
+  xSemaphoreTake(UartLock, portMAX_DELAY);
+  if ((uart_set_word_length(DAP_UART_DRIVER, data_bits) == ESP_OK) &&
+      (uart_set_parity(DAP_UART_DRIVER, parity) == ESP_OK) &&
+      (uart_set_stop_bits(DAP_UART_DRIVER, stop_bits) == ESP_OK) &&
+      (uart_set_baudrate(DAP_UART_DRIVER, *baudrate) == ESP_OK) &&
+      (uart_get_baudrate(DAP_UART_DRIVER, &actual) == ESP_OK))
+  {
+    *baudrate = actual;
+  }
+  else
+  {
+    *baudrate = 0U;
+  }
+  xSemaphoreGive(UartLock);
+
+  return (status);
+}
+
+// Discard received data
+// Done by the threads that own the ring indexes, UART_Transfer leaves the
+// rings alone until then.
+static void UART_FlushReceive(void)
+{
+  AtomicSet(&UartReceiveFlush, 1U);
+  UART_RxWake();
+}
+
+// Discard data not sent yet
+static void UART_FlushTransmit(void)
+{
+  AtomicSet(&UartTransmitFlush, 1U);
+  UART_TxWake();
+}
+
+// Setup UART Communication Port: UART driver and threads, USB COM port transport
+//   return: 1 - Success, 0 - Error
+uint32_t UART_Setup(void)
+{
+  const uart_config_t config = {
+      .baud_rate = 115200,
+      .data_bits = UART_DATA_8_BITS,
+      .parity = UART_PARITY_DISABLE,
+      .stop_bits = UART_STOP_BITS_1,
+      .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+      .source_clk = UART_SCLK_APB,
+  };
+
+  UartLock = xSemaphoreCreateMutex();
+  if (UartLock == NULL)
+  {
+    return (0U);
+  }
+  if (uart_driver_install(DAP_UART_DRIVER, UART_DRV_RX_BUFFER, 0, 16, &UartQueue, 0) != ESP_OK)
+  {
+    return (0U);
+  }
+  if ((uart_param_config(DAP_UART_DRIVER, &config) != ESP_OK) ||
+      (uart_set_pin(DAP_UART_DRIVER, PIN_UART_TX, PIN_UART_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) ||
+      (uart_set_rx_full_threshold(DAP_UART_DRIVER, UART_RX_FULL) != ESP_OK) ||
+      (uart_set_rx_timeout(DAP_UART_DRIVER, UART_RX_TOUT) != ESP_OK) ||
+      (xTaskCreate(UART_RxThread, "DAP_UART_RX", 3072, NULL, configMAX_PRIORITIES - 3, &UartRxThreadId) != pdPASS) ||
+      (xTaskCreate(UART_TxThread, "DAP_UART_TX", 3072, NULL, configMAX_PRIORITIES - 3, &UartTxThreadId) != pdPASS))
+  {
+    return (0U);
+  }
+
+#if (DAP_UART_USB_COM_PORT != 0)
+  if (USB_COM_PORT_Activate(1U) == 0U)
+  {
+    UartReceiveEnabled = 1U;
+    UartTransmitEnabled = 1U;
+    UartTransport = DAP_UART_TRANSPORT_USB_COM_PORT;
+  }
+#endif
+  return (1U);
+}
+
+#if (DAP_UART_USB_COM_PORT != 0)
+
+// Apply the line coding of the USB COM port
+// Called by the USB device layer while the USB COM port is active
+// (USB_COM_PORT_Activate), on activation and when the host changes it.
+//   control:  data bits, parity and stop bits (as in DAP_UART_Configure)
+//   baudrate: requested baudrate
+void UART_COM_PORT_Configure(uint32_t control, uint32_t baudrate)
+{
+  UART_Config(control, &baudrate);
+}
+
+// USB COM port event: data received from the host, data sent to the host, port opened or closed
+void UART_COM_PORT_Event(void)
+{
+  if (UartTransport == DAP_UART_TRANSPORT_USB_COM_PORT)
+  {
+    UART_TxWake();
+    UART_RxWake();
+  }
+}
+
+#endif /* (DAP_UART_USB_COM_PORT != 0) */
+
+// Select transport for the UART data
+// Leaving a transport discards the data buffered for it.
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t UART_Transport(const uint8_t *request, uint8_t *response)
+{
+  uint8_t transport = *request;
+  uint8_t result = DAP_OK;
+
+  if ((UartLock == NULL) || (transport > DAP_UART_TRANSPORT_DAP_COMMAND))
+  {
+    *response = DAP_ERROR;
+    return ((1U << 16) | 1U);
+  }
+#if (DAP_UART_USB_COM_PORT == 0)
+  if (transport == DAP_UART_TRANSPORT_USB_COM_PORT)
+  {
+    *response = DAP_ERROR;
+    return ((1U << 16) | 1U);
+  }
+#endif
+
+  if (transport != UartTransport)
+  {
+#if (DAP_UART_USB_COM_PORT != 0)
+    if (UartTransport == DAP_UART_TRANSPORT_USB_COM_PORT)
+    {
+      USB_COM_PORT_Activate(0U);
+    }
+#endif
+    UartTransport = DAP_UART_TRANSPORT_NONE;
+    UartReceiveEnabled = 0U;
+    UartTransmitEnabled = 0U;
+    UartErrors = 0U;
+    UART_FlushReceive();
+    UART_FlushTransmit();
+
+    switch (transport)
+    {
+#if (DAP_UART_USB_COM_PORT != 0)
+    case DAP_UART_TRANSPORT_USB_COM_PORT:
+      if (USB_COM_PORT_Activate(1U) == 0U)
+      {
+        UartReceiveEnabled = 1U;
+        UartTransmitEnabled = 1U;
+        UartTransport = transport;
+        UART_COM_PORT_Event();
+      }
+      else
+      {
+        result = DAP_ERROR;
+      }
+      break;
+#endif
+    case DAP_UART_TRANSPORT_DAP_COMMAND:
+      // Receive and transmit enabled with DAP_UART_Control
+      UartTransport = transport;
+      break;
+    default:
+      break;
+    }
+  }
+
+  *response = result;
+  return ((1U << 16) | 1U);
+}
+
+// Configure UART data bits, parity, stop bits and baudrate
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t UART_Configure(const uint8_t *request, uint8_t *response)
+{
+  uint32_t baudrate;
+  uint32_t status;
+
+  baudrate = (uint32_t)(*(request+1) <<  0) |
+             (uint32_t)(*(request+2) <<  8) |
+             (uint32_t)(*(request+3) << 16) |
+             (uint32_t)(*(request+4) << 24);
+
+  status = UART_Config(*request, &baudrate);
+
+  *response++ = (uint8_t)status;
+  *response++ = (uint8_t)(baudrate >>  0);
+  *response++ = (uint8_t)(baudrate >>  8);
+  *response++ = (uint8_t)(baudrate >> 16);
+  *response   = (uint8_t)(baudrate >> 24);
+
+  return ((5U << 16) | 5U);
+}
+
+// Control UART receive and transmit (DAP command transport)
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t UART_Control(const uint8_t *request, uint8_t *response)
+{
+  uint8_t control = *request;
+
+  if (UartTransport != DAP_UART_TRANSPORT_DAP_COMMAND)
+  {
+    *response = DAP_ERROR;
+    return ((1U << 16) | 1U);
+  }
+
+  if (control & DAP_UART_CONTROL_RX_DISABLE)
+  {
+    UartReceiveEnabled = 0U;
+  }
+  if (control & DAP_UART_CONTROL_RX_BUF_FLUSH)
+  {
+    UartErrors = 0U;
+    UART_FlushReceive();
+  }
+  if (control & DAP_UART_CONTROL_RX_ENABLE)
+  {
+    UartReceiveEnabled = 1U;
+    UART_RxWake();
+  }
+  if (control & DAP_UART_CONTROL_TX_DISABLE)
+  {
+    UartTransmitEnabled = 0U;
+  }
+  if (control & DAP_UART_CONTROL_TX_BUF_FLUSH)
+  {
+    UART_FlushTransmit();
+  }
+  if (control & DAP_UART_CONTROL_TX_ENABLE)
+  {
+    UartTransmitEnabled = 1U;
+    UART_TxWake();
+  }
+
+  *response = DAP_OK;
+  return ((1U << 16) | 1U);
+}
+
+// Get UART status, error flags are cleared
+//   response: pointer to response data
+//   return:   number of bytes in response
+uint32_t UART_Status(uint8_t *response)
+{
+  uint32_t rx_count, tx_count;
+  uint8_t status = 0U;
+
+  if (UartReceiveEnabled)
+  {
+    status |= DAP_UART_STATUS_RX_ENABLED;
+  }
+  if (UartTransmitEnabled)
+  {
+    status |= DAP_UART_STATUS_TX_ENABLED;
+  }
+  status |= UartErrors;
+  UartErrors = 0U;
+
+  rx_count = AtomicGet(&UartRxIndexI) - AtomicGet(&UartRxIndexO);
+  tx_count = AtomicGet(&UartTxIndexI) - AtomicGet(&UartTxIndexO);
+
+  *response++ = status;
+  *response++ = (uint8_t)(rx_count >>  0);
+  *response++ = (uint8_t)(rx_count >>  8);
+  *response++ = (uint8_t)(rx_count >> 16);
+  *response++ = (uint8_t)(rx_count >> 24);
+  *response++ = (uint8_t)(tx_count >>  0);
+  *response++ = (uint8_t)(tx_count >>  8);
+  *response++ = (uint8_t)(tx_count >> 16);
+  *response   = (uint8_t)(tx_count >> 24);
+
+  return (9U);
+}
+
+// Transfer UART data (DAP command transport)
+// Takes as much transmit data as UartTxBuf has room for and returns the
+// received data that fits into the response.
+//   request:  pointer to request data
+//   response: pointer to response data
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits)
+uint32_t UART_Transfer(const uint8_t *request, uint8_t *response)
+{
+  uint32_t tx_num, tx_cnt, rx_cnt;
+  uint32_t index, count, n;
+  uint8_t status = DAP_ERROR;
+
+  tx_num = (uint32_t)(*(request+0) << 0) |
+           (uint32_t)(*(request+1) << 8);
+  if (tx_num > (DAP_PACKET_SIZE - 3U))
+  {
+    tx_num = DAP_PACKET_SIZE - 3U;
+  }
+  request += 2;
+
+  tx_cnt = 0U;
+  rx_cnt = 0U;
+  if (UartTransport == DAP_UART_TRANSPORT_DAP_COMMAND)
+  {
+    status = DAP_OK;
+
+    // Transmit data into UartTxBuf
+    if (UartTransmitEnabled && !AtomicGet(&UartTransmitFlush))
+    {
+      index = UartTxIndexI;
+      count = DAP_UART_TX_BUFFER_SIZE - (index - AtomicGet(&UartTxIndexO));
+      tx_cnt = (tx_num < count) ? tx_num : count;
+      for (n = 0U; n < tx_cnt; n++)
+      {
+        UartTxBuf[(index + n) & (DAP_UART_TX_BUFFER_SIZE - 1U)] = request[n];
+      }
+      if (tx_cnt != 0U)
+      {
+        AtomicSet(&UartTxIndexI, index + tx_cnt);
+        UART_TxWake();
+      }
+    }
+
+    // Received data from UartRxBuf
+    index = UartRxIndexO;
+    count = AtomicGet(&UartReceiveFlush) ? 0U : (AtomicGet(&UartRxIndexI) - index);
+    rx_cnt = (count < (DAP_PACKET_SIZE - 6U)) ? count : (DAP_PACKET_SIZE - 6U);
+    for (n = 0U; n < rx_cnt; n++)
+    {
+      response[5U + n] = UartRxBuf[(index + n) & (DAP_UART_RX_BUFFER_SIZE - 1U)];
+    }
+    if (rx_cnt != 0U)
+    {
+      AtomicSet(&UartRxIndexO, index + rx_cnt);
+      UART_RxWake();
+    }
+  }
+
+  *response++ = status;
+  *response++ = (uint8_t)(tx_cnt >> 0);
+  *response++ = (uint8_t)(tx_cnt >> 8);
+  *response++ = (uint8_t)(rx_cnt >> 0);
+  *response   = (uint8_t)(rx_cnt >> 8);
+
+  return (((2U + tx_num) << 16) | (5U + rx_cnt));
+}
+
+#endif /* (DAP_UART != 0) */
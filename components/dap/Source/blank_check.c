@@ -0,0 +1,387 @@
+/**
+ * @file    blank_check.c
+ * @brief   Blank check of flash sectors and erase/skip planning
+ *
+ * New boards arrive with erased flash, and erasing a sector takes orders of
+ * magnitude longer than reading it. blank_check_plan() takes the erase plan
+ * from sector_map_plan(), reads every sector that is cheaper to check than
+ * to erase and drops the blank ones, so only sectors holding data are
+ * erased. A dirty sector usually differs in its first word, so checking it
+ * costs almost nothing; the full read is only paid on blank sectors, where
+ * it replaces an erase.
+ *
+ * Sectors are read either by a small ARMv6-M scanner loaded next to the
+ * flash algorithm (one syscall per batch of sectors, the flash is read at
+ * core speed) or, if target RAM is short, by SWD block reads compared on the
+ * probe. The scanner uses the same RAM as target_lz4; load it again before
+ * programming compressed blocks.
+ *
+ * The cost model compares three choices, all in microseconds:
+ *
+ *   - chip erase without checking, if it is cheaper than even the checks
+ *   - sector erase of the dirty sectors only
+ *   - chip erase, if it is cheaper than erasing the dirty sectors
+ *
+ * Erase times start from a conservative default and are refined with
+ * blank_check_learn() as sectors are erased. A sector whose check fails
+ * (SWD error, scanner timeout) is treated as dirty, so errors only cost time.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "blank_check.h"
+#include "swd_host.h"
+
+// Default cost model
+#define BLANK_PROBE_KBPS        512U    // SWD block reads
+#define BLANK_TARGET_KBPS       16384U  // scanner on a slow core
+#define BLANK_CALL_US           1000U
+#define BLANK_ERASE_US_PER_KB   10000U  // typical of on-chip NOR flash
+#define BLANK_CHIP_SPEEDUP      4U      // chip erase works on several blocks at once
+
+// First probe read of a sector, enough to reject programmed sectors early
+#define BLANK_PROBE_FIRST       64U
+
+// FlashDevice DevType of memory mapped on-chip flash
+#define BLANK_DEVTYPE_ONCHIP    1U
+
+/*
+ * uint32_t blank_scan(uint32_t *table, uint32_t count, uint32_t value)
+ * table holds count pairs {address, bytes}; bytes is replaced by 0 if all
+ * words equal value, 1 otherwise. Returns 0, 16 bytes of stack.
+ *
+ *	blank_scan:	push	{r4-r6, lr}
+ *	next:		cmp	r1, #0
+ *			beq	done
+ *			ldr	r3, [r0]		@ address
+ *			ldr	r4, [r0, #4]		@ bytes
+ *			movs	r6, #0
+ *			cmp	r4, #0
+ *			beq	store
+ *	loop:		ldr	r5, [r3]
+ *			cmp	r5, r2
+ *			bne	dirty
+ *			adds	r3, #4
+ *			subs	r4, #4
+ *			bne	loop
+ *			b	store
+ *	dirty:		movs	r6, #1
+ *	store:		str	r6, [r0, #4]
+ *			adds	r0, #8
+ *			subs	r1, #1
+ *			b	next
+ *	done:		movs	r0, #0
+ *			pop	{r4-r6, pc}
+ */
+static const uint32_t blank_scan_blob[] = {
+	0x2900B570, 0x6803D010, 0x26006844, 0xD0072C00, 0x4295681D, 0x3304D103, 0xD1F93C04, 0x2601E000,
+	0x30086046, 0xE7EC3901, 0xBD702000,
+};
+
+static uint32_t check_us(const blank_check_t *bc, uint32_t size)
+{
+	return bc->call_us + (uint32_t)(((uint64_t)size * 1000U) / ((uint64_t)bc->check_kbps * 1024U));
+}
+
+static uint32_t erase_us(const blank_check_t *bc, uint32_t size)
+{
+	return bc->call_us + (uint32_t)(((uint64_t)size * bc->erase_us_per_kb) / 1024U);
+}
+
+static uint8_t worth_checking(const blank_check_t *bc, uint32_t size)
+{
+	return (bc->method != BLANK_CHECK_NONE) && (check_us(bc, size) < erase_us(bc, size));
+}
+
+// Prepare the planner for a loaded flash algorithm.
+//   allow_chip: the whole device may be erased (the image owns all of it)
+void blank_check_init(blank_check_t *bc, const flash_algo_t *algo, uint8_t allow_chip)
+{
+	memset(bc, 0, sizeof(*bc));
+
+	bc->method          = (algo->device.type == BLANK_DEVTYPE_ONCHIP) ? BLANK_CHECK_PROBE : BLANK_CHECK_NONE;
+	bc->value           = (algo->device.erased_value & 0xFFU) * 0x01010101U;
+	bc->sys             = &algo->target.sys_call_s;
+	bc->check_kbps      = BLANK_PROBE_KBPS;
+	bc->call_us         = BLANK_CALL_US;
+	bc->erase_us_per_kb = BLANK_ERASE_US_PER_KB;
+	if (allow_chip && (algo->target.erase_chip != 0))
+	{
+		bc->chip_us = (uint32_t)(((uint64_t)algo->device.size * BLANK_ERASE_US_PER_KB) /
+		                         (1024U * BLANK_CHIP_SPEEDUP));
+	}
+}
+
+// Reserve target RAM for the scanner, after the flash algorithm and its program buffer.
+//   return: ERROR_SUCCESS, or ERROR_ALGO_RAM and the probe reads the sectors itself
+dap_err_t blank_check_place(blank_check_t *bc, const program_target_t *target)
+{
+	uint32_t start, end;
+
+	if (bc->method == BLANK_CHECK_NONE)
+	{
+		return ERROR_SUCCESS;
+	}
+
+	start = target->algo_start + target->algo_size;
+	if (target->program_buffer + target->program_buffer_size > start)
+	{
+		start = target->program_buffer + target->program_buffer_size;
+	}
+	start = (start + 7U) & ~7U;
+	end   = target->sys_call_s.stack_pointer - FLASH_ALGO_STACK_SIZE;
+
+	if ((target->sys_call_s.stack_pointer < FLASH_ALGO_STACK_SIZE) ||
+	    (start + sizeof(blank_scan_blob) + BLANK_CHECK_BATCH * 8U > end))
+	{
+		return ERROR_ALGO_RAM;
+	}
+
+	bc->method     = BLANK_CHECK_TARGET;
+	bc->code       = start;
+	bc->entry      = start | 1U;
+	bc->table      = start + sizeof(blank_scan_blob);
+	bc->check_kbps = BLANK_TARGET_KBPS;
+	return ERROR_SUCCESS;
+}
+
+// Download the scanner, after the flash algorithm has been downloaded.
+dap_err_t blank_check_load(const blank_check_t *bc)
+{
+	if ((bc->method == BLANK_CHECK_TARGET) &&
+	    !swd_write_memory(bc->code, (uint8_t *)blank_scan_blob, sizeof(blank_scan_blob)))
+	{
+		return ERROR_ALGO_DL;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Feed a measured erase into the cost model.
+//   bytes: bytes erased
+//   us:    time taken, including the syscall
+void blank_check_learn(blank_check_t *bc, uint32_t bytes, uint32_t us)
+{
+	uint32_t rate;
+
+	if ((bytes == 0) || (us <= bc->call_us))
+	{
+		return;
+	}
+	rate = (uint32_t)(((uint64_t)(us - bc->call_us) * 1024U) / bytes);
+	bc->erase_us_per_kb = (3U * bc->erase_us_per_kb + rate) / 4U;
+}
+
+// Compare one sector on the probe, reading a short head first
+static uint8_t probe_blank(blank_check_t *bc, uint32_t addr, uint32_t size)
+{
+	uint32_t offset, chunk, diff, i, n;
+
+	for (offset = 0; offset < size; offset += chunk)
+	{
+		chunk = (offset == 0) ? BLANK_PROBE_FIRST : sizeof(bc->probe_buf);
+		if (chunk > size - offset)
+		{
+			chunk = size - offset;
+		}
+		if (!swd_read_memory(addr + offset, (uint8_t *)bc->probe_buf, chunk))
+		{
+			return 0;
+		}
+
+		// Word compares folded four at a time, one branch per chunk
+		diff = 0;
+		n = chunk / 4U;
+		for (i = 0; i + 4U <= n; i += 4U)
+		{
+			diff |= (bc->probe_buf[i] ^ bc->value) | (bc->probe_buf[i + 1] ^ bc->value) |
+			        (bc->probe_buf[i + 2] ^ bc->value) | (bc->probe_buf[i + 3] ^ bc->value);
+		}
+		for (; i < n; i++)
+		{
+			diff |= bc->probe_buf[i] ^ bc->value;
+		}
+		if (diff != 0)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Scan the checked sectors of the batch with one syscall
+static void target_scan(blank_check_t *bc)
+{
+	uint32_t table[BLANK_CHECK_BATCH * 2];
+	uint32_t i, n = 0;
+
+	for (i = 0; i < bc->batch.count; i++)
+	{
+		if (bc->batch.check[i])
+		{
+			table[n * 2]     = bc->batch.sector[i].start;
+			table[n * 2 + 1] = bc->batch.sector[i].size;
+			n++;
+		}
+	}
+	if ((n == 0) || !swd_write_memory(bc->table, (uint8_t *)table, n * 8U) ||
+	    !swd_flash_syscall_exec(bc->sys, bc->entry, bc->table, n, bc->value, 0) ||
+	    !swd_read_memory(bc->table, (uint8_t *)table, n * 8U))
+	{
+		return;
+	}
+
+	for (i = 0, n = 0; i < bc->batch.count; i++)
+	{
+		if (bc->batch.check[i])
+		{
+			bc->batch.blank[i] = (table[n * 2 + 1] == 0);
+			n++;
+		}
+	}
+}
+
+// Append a dirty sector to the erase list, merging contiguous sectors
+static dap_err_t emit(sector_extent_t *erase, uint32_t erase_size, uint32_t *erase_count,
+                      const sector_info_t *sector, uint32_t index)
+{
+	sector_extent_t *prev = (*erase_count > 0) ? &erase[*erase_count - 1] : NULL;
+
+	if ((prev != NULL) && (prev->start + prev->size == sector->start) && (prev->first + prev->count == index))
+	{
+		prev->size += sector->size;
+		prev->count++;
+		return ERROR_SUCCESS;
+	}
+	if (*erase_count >= erase_size)
+	{
+		return ERROR_SECTOR_MAP;
+	}
+	prev = &erase[(*erase_count)++];
+	prev->start = sector->start;
+	prev->size  = sector->size;
+	prev->first = index;
+	prev->count = 1;
+	return ERROR_SUCCESS;
+}
+
+// Check the batched sectors and emit the dirty ones
+static dap_err_t batch_flush(blank_check_t *bc, sector_extent_t *erase, uint32_t erase_size,
+                             uint32_t *erase_count, uint64_t *dirty_us)
+{
+	uint32_t i;
+	dap_err_t status;
+
+	memset(bc->batch.blank, 0, sizeof(bc->batch.blank));
+	if (bc->method == BLANK_CHECK_TARGET)
+	{
+		target_scan(bc);
+	}
+
+	for (i = 0; i < bc->batch.count; i++)
+	{
+		if (bc->batch.check[i])
+		{
+			bc->checked++;
+			if (bc->method == BLANK_CHECK_PROBE)
+			{
+				bc->batch.blank[i] = probe_blank(bc, bc->batch.sector[i].start, bc->batch.sector[i].size);
+			}
+		}
+		if (bc->batch.blank[i])
+		{
+			bc->skipped++;
+			continue;
+		}
+		*dirty_us += erase_us(bc, bc->batch.sector[i].size);
+		status = emit(erase, erase_size, erase_count, &bc->batch.sector[i], bc->batch.index[i]);
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+	}
+
+	bc->batch.count = 0;
+	bc->batch.bytes = 0;
+	return ERROR_SUCCESS;
+}
+
+// Decide per sector between erase and skip, and between sector and chip erase.
+//   map:         sector map of the device
+//   plan:        erase plan from sector_map_plan
+//   erase:       sector extents still to be erased, ascending
+//   erase_size:  capacity of erase
+//   erase_count: number of extents in erase
+//   chip:        1 = chip erase instead of the erase list
+//   return:      ERROR_SUCCESS, ERROR_ALGO_MISSING or ERROR_SECTOR_MAP (erase too small)
+dap_err_t blank_check_plan(blank_check_t *bc, sector_map_t *map, const sector_extent_t *plan, uint32_t plan_count,
+                           sector_extent_t *erase, uint32_t erase_size, uint32_t *erase_count, uint8_t *chip)
+{
+	sector_info_t sector;
+	uint64_t check_total = 0, dirty_us = 0;
+	uint32_t i, k, addr, index;
+	uint8_t check;
+	dap_err_t status;
+
+	*erase_count    = 0;
+	*chip           = 0;
+	bc->checked     = 0;
+	bc->skipped     = 0;
+	bc->batch.count = 0;
+	bc->batch.bytes = 0;
+
+	// Cheapest case with checks: everything blank
+	for (i = 0; i < plan_count; i++)
+	{
+		for (k = 0, addr = plan[i].start; k < plan[i].count; k++, addr += sector.size)
+		{
+			if (!sector_map_lookup(map, addr, &sector, NULL))
+			{
+				return ERROR_ALGO_MISSING;
+			}
+			check_total += worth_checking(bc, sector.size) ? check_us(bc, sector.size) :
+			                                                 erase_us(bc, sector.size);
+		}
+	}
+	if ((bc->chip_us != 0) && (bc->chip_us <= check_total))
+	{
+		*chip = 1;
+		return ERROR_SUCCESS;
+	}
+
+	for (i = 0; i < plan_count; i++)
+	{
+		for (k = 0, addr = plan[i].start; k < plan[i].count; k++, addr += sector.size)
+		{
+			sector_map_lookup(map, addr, &sector, &index);
+			check = worth_checking(bc, sector.size);
+
+			if ((bc->batch.count == BLANK_CHECK_BATCH) ||
+			    (check && (bc->batch.bytes != 0) && (bc->batch.bytes + sector.size > BLANK_CHECK_BATCH_BYTES)))
+			{
+				status = batch_flush(bc, erase, erase_size, erase_count, &dirty_us);
+				if (status != ERROR_SUCCESS)
+				{
+					return status;
+				}
+			}
+
+			bc->batch.sector[bc->batch.count] = sector;
+			bc->batch.index[bc->batch.count]  = index;
+			bc->batch.check[bc->batch.count]  = check;
+			bc->batch.count++;
+			bc->batch.bytes += check ? sector.size : 0;
+		}
+	}
+
+	status = batch_flush(bc, erase, erase_size, erase_count, &dirty_us);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+
+	if ((bc->chip_us != 0) && (bc->chip_us < dirty_us))
+	{
+		*chip = 1;
+	}
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file    crc.c
+ * @brief   CRC-32 (IEEE 802.3, reflected) used by the image and algorithm caches
+ *
+ * Nibble-wise table: 64 bytes of constants, two lookups per byte. Results
+ * match zlib crc32() and esp_rom_crc32_le(0, ...), so images can be checked
+ * with standard host tools.
+ */
+
+#include "crc.h"
+
+static const uint32_t crc_table[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t crc32(const void *data, uint32_t size)
+{
+	return crc32_continue(0, data, size);
+}
+
+uint32_t crc32_continue(uint32_t prev_crc, const void *data, uint32_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t crc = ~prev_crc;
+
+	while (size--)
+	{
+		crc ^= *p++;
+		crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+		crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+	}
+	return ~crc;
+}
@@ -0,0 +1,499 @@
+/**
+ * @file    flash_algo.c
+ * @brief   CMSIS-Pack flash algorithm (.FLM) loader and cache image
+ *
+ * A .FLM file is an ARM ELF linked at address 0 with the sections PrgCode
+ * (code), PrgData (RW and ZI data) and DevDscr (the FlashDevice descriptor).
+ * flash_algo_build() extracts them through a read callback, relocates the
+ * entry points to the target RAM and writes a self-contained cache image:
+ *
+ *   flash_algo_cache_t | sector_info_t[sector_count] | algorithm blob
+ *
+ * The blob uses the DAPLink layout: a 32-byte breakpoint/helper header
+ * followed by the PrgCode/PrgData image, so it can be written to the target
+ * RAM unchanged. flash_algo_load() validates an image and fills a
+ * flash_algo_t that points into it, so a job only has to read the image.
+ *
+ * Target RAM layout (ram_start .. ram_start + ram_size):
+ *
+ *   algorithm blob | program buffer (page size) | ... | stack (top of RAM)
+ *
+ * This file has no hardware dependencies and builds on the host as well.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "flash_algo.h"
+#include "crc.h"
+
+// ELF32 definitions used by the loader
+#define ELF_EHDR_SIZE       52U
+#define ELF_SHDR_SIZE       40U
+#define ELF_SYM_SIZE        16U
+#define ELF_EM_ARM          40U
+#define ELF_SHT_PROGBITS    1U
+#define ELF_SHT_SYMTAB      2U
+#define ELF_SHT_NOBITS      8U
+#define ELF_SHF_ALLOC       2U
+#define ELF_SHN_UNDEF       0U
+
+// FlashDevice field offsets (FlashOS.h)
+#define FD_VERS             0U
+#define FD_DEVNAME          2U
+#define FD_DEVNAME_LEN      128U
+#define FD_DEVTYPE          130U
+#define FD_DEVADR           132U
+#define FD_SZDEV            136U
+#define FD_SZPAGE           140U
+#define FD_VALEMPTY         148U
+#define FD_TOPROG           152U
+#define FD_TOERASE          156U
+#define FD_SECTORS          160U
+#define FD_SECTOR_END       0xFFFFFFFFU
+
+// Size of the DAPLink blob header and its contents: BKPT #0 followed by the
+// helper routine DAPLink uses for RAM-resident checksums.
+#define ALGO_HEADER_SIZE    32U
+static const uint32_t algo_header[ALGO_HEADER_SIZE / 4] = {
+	0xE00ABE00, 0x062D780D, 0x24084068, 0xD3000040,
+	0x1E644058, 0x1C49D1FA, 0x2A001E52, 0x4770D1F2,
+};
+
+// Loaded sections: PrgCode, PrgData (RW), PrgData (ZI)
+#define ALGO_SECTIONS       3U
+
+typedef struct
+{
+	uint32_t name;
+	uint32_t type;
+	uint32_t flags;
+	uint32_t addr;
+	uint32_t offset;
+	uint32_t size;
+	uint32_t link;
+} ELF_SECTION;
+
+typedef struct
+{
+	flash_algo_read_t read;
+	void *ctx;
+	uint32_t shoff;
+	uint32_t shnum;
+	uint32_t shstrtab;              // file offset of the section name table
+} ELF_FILE;
+
+typedef struct
+{
+	const char *name;
+	uint8_t required;
+} ALGO_SYMBOL;
+
+// Symbols looked up in the symbol table
+enum { SYM_INIT, SYM_UNINIT, SYM_ERASE_CHIP, SYM_ERASE_SECTOR, SYM_PROGRAM_PAGE, SYM_VERIFY, SYM_DEVICE, SYM_COUNT };
+static const ALGO_SYMBOL algo_symbols[SYM_COUNT] = {
+	{ "Init",        1 },
+	{ "UnInit",      0 },
+	{ "EraseChip",   0 },
+	{ "EraseSector", 1 },
+	{ "ProgramPage", 1 },
+	{ "Verify",      0 },
+	{ "FlashDevice", 1 },
+};
+
+#define SYM_NAME_MAX        12U     // longest name above including terminator
+
+static uint32_t get16(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t elf_section(const ELF_FILE *elf, uint32_t index, ELF_SECTION *sec)
+{
+	uint8_t buf[ELF_SHDR_SIZE];
+
+	if ((index >= elf->shnum) ||
+	    !elf->read(elf->ctx, elf->shoff + index * ELF_SHDR_SIZE, buf, sizeof(buf)))
+	{
+		return 0;
+	}
+
+	sec->name   = get32(&buf[0]);
+	sec->type   = get32(&buf[4]);
+	sec->flags  = get32(&buf[8]);
+	sec->addr   = get32(&buf[12]);
+	sec->offset = get32(&buf[16]);
+	sec->size   = get32(&buf[20]);
+	sec->link   = get32(&buf[24]);
+	return 1;
+}
+
+// Read a name of at most SYM_NAME_MAX - 1 characters from a string table.
+// Longer names are returned as empty string.
+static void elf_name(const ELF_FILE *elf, const ELF_SECTION *strtab, uint32_t index, char *name)
+{
+	uint32_t len = SYM_NAME_MAX;
+
+	name[0] = '\0';
+	if (index >= strtab->size)
+	{
+		return;
+	}
+	if (len > strtab->size - index)
+	{
+		len = strtab->size - index;
+	}
+	if (!elf->read(elf->ctx, strtab->offset + index, name, len) || (memchr(name, '\0', len) == NULL))
+	{
+		name[0] = '\0';
+	}
+}
+
+static dap_err_t elf_open(ELF_FILE *elf, flash_algo_read_t read, void *ctx)
+{
+	uint8_t ehdr[ELF_EHDR_SIZE];
+	ELF_SECTION shstr;
+	uint32_t shstrndx;
+
+	elf->read = read;
+	elf->ctx = ctx;
+
+	if (!read(ctx, 0, ehdr, sizeof(ehdr)))
+	{
+		return ERROR_ALGO_ELF;
+	}
+
+	// 32-bit little endian ARM ELF with standard section headers
+	if ((get32(&ehdr[0]) != 0x464C457FU) || (ehdr[4] != 1U) || (ehdr[5] != 1U) ||
+	    (get16(&ehdr[18]) != ELF_EM_ARM) || (get16(&ehdr[46]) != ELF_SHDR_SIZE))
+	{
+		return ERROR_ALGO_ELF;
+	}
+
+	elf->shoff = get32(&ehdr[32]);
+	elf->shnum = get16(&ehdr[48]);
+	shstrndx   = get16(&ehdr[50]);
+
+	if (!elf_section(elf, shstrndx, &shstr))
+	{
+		return ERROR_ALGO_ELF;
+	}
+	elf->shstrtab = shstr.offset;
+	return ERROR_SUCCESS;
+}
+
+static uint8_t elf_section_is(const ELF_FILE *elf, const ELF_SECTION *sec, const char *name)
+{
+	char buf[SYM_NAME_MAX];
+	uint32_t len = (uint32_t)strlen(name) + 1;
+
+	if ((len > sizeof(buf)) || !elf->read(elf->ctx, elf->shstrtab + sec->name, buf, len))
+	{
+		return 0;
+	}
+	return (memcmp(buf, name, len) == 0);
+}
+
+// Build a cache image from a .FLM file.
+//   read, ctx:  .FLM file access
+//   ram_start:  target RAM address the algorithm is loaded to
+//   ram_size:   target RAM available to the algorithm, buffer and stack
+//   cache:      output buffer, 4-byte aligned
+//   cache_size: size of the output buffer
+//   cache_used: number of bytes written to the output buffer
+//   return:     ERROR_SUCCESS or the reason the image could not be built
+dap_err_t flash_algo_build(flash_algo_read_t read, void *ctx, uint32_t ram_start, uint32_t ram_size,
+                           void *cache, uint32_t cache_size, uint32_t *cache_used)
+{
+	ELF_FILE elf;
+	ELF_SECTION sec, symtab, strtab, load[ALGO_SECTIONS];
+	flash_algo_cache_t *hdr = (flash_algo_cache_t *)cache;
+	sector_info_t *sectors;
+	uint8_t *blob;
+	uint8_t buf[FD_SECTORS];
+	uint8_t sym[ELF_SYM_SIZE];
+	char name[SYM_NAME_MAX];
+	uint32_t values[SYM_COUNT];
+	uint32_t *entries[SYM_DEVICE];
+	uint16_t shndx[SYM_COUNT];
+	uint32_t i, j, nload = 0, nsym;
+	uint32_t base = UINT32_MAX, end = 0, data = UINT32_MAX;
+	uint32_t algo_size, count, size, offset, ram_end;
+	dap_err_t status;
+
+	if ((read == NULL) || (cache == NULL) || (cache_used == NULL) || (((uintptr_t)cache & 3U) != 0) ||
+	    (cache_size < sizeof(flash_algo_cache_t)))
+	{
+		return ERROR_ALGO_CACHE;
+	}
+	*cache_used = 0;
+
+	status = elf_open(&elf, read, ctx);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+
+	// Locate the loaded sections and the symbol table
+	memset(&symtab, 0, sizeof(symtab));
+	for (i = 0; i < elf.shnum; i++)
+	{
+		if (!elf_section(&elf, i, &sec))
+		{
+			return ERROR_ALGO_ELF;
+		}
+
+		if (sec.type == ELF_SHT_SYMTAB)
+		{
+			symtab = sec;
+		}
+		else if ((sec.flags & ELF_SHF_ALLOC) && (sec.size != 0) &&
+		         ((sec.type == ELF_SHT_PROGBITS) || (sec.type == ELF_SHT_NOBITS)) &&
+		         (elf_section_is(&elf, &sec, "PrgCode") || elf_section_is(&elf, &sec, "PrgData")))
+		{
+			// A section running past the 4 GB address space would wrap 'end'
+			if ((nload >= ALGO_SECTIONS) || (sec.size > UINT32_MAX - sec.addr))
+			{
+				return ERROR_ALGO_ELF;
+			}
+			load[nload++] = sec;
+			if (sec.addr < base)
+			{
+				base = sec.addr;
+			}
+			if (sec.addr + sec.size > end)
+			{
+				end = sec.addr + sec.size;
+			}
+			if (elf_section_is(&elf, &sec, "PrgData") && (sec.addr < data))
+			{
+				data = sec.addr;
+			}
+		}
+	}
+
+	if ((nload == 0) || (symtab.size == 0) || !elf_section(&elf, symtab.link, &strtab))
+	{
+		return ERROR_ALGO_ELF;
+	}
+	if (data == UINT32_MAX)
+	{
+		data = end;
+	}
+
+	// Resolve entry points and the FlashDevice descriptor
+	memset(values, 0, sizeof(values));
+	memset(shndx, 0, sizeof(shndx));
+	nsym = symtab.size / ELF_SYM_SIZE;
+	for (i = 0; i < nsym; i++)
+	{
+		if (!read(ctx, symtab.offset + i * ELF_SYM_SIZE, sym, sizeof(sym)))
+		{
+			return ERROR_ALGO_ELF;
+		}
+		if (get16(&sym[14]) == ELF_SHN_UNDEF)
+		{
+			continue;
+		}
+		elf_name(&elf, &strtab, get32(&sym[0]), name);
+		for (j = 0; j < SYM_COUNT; j++)
+		{
+			if ((shndx[j] == ELF_SHN_UNDEF) && (strcmp(name, algo_symbols[j].name) == 0))
+			{
+				values[j] = get32(&sym[4]);
+				shndx[j]  = (uint16_t)get16(&sym[14]);
+			}
+		}
+	}
+
+	for (j = 0; j < SYM_COUNT; j++)
+	{
+		if (algo_symbols[j].required && (shndx[j] == ELF_SHN_UNDEF))
+		{
+			return ERROR_ALGO_SYMBOL;
+		}
+	}
+
+	// FlashDevice: fixed part, then sector runs up to the terminator
+	if (!elf_section(&elf, shndx[SYM_DEVICE], &sec) || (values[SYM_DEVICE] < sec.addr))
+	{
+		return ERROR_ALGO_SYMBOL;
+	}
+	offset = sec.offset + (values[SYM_DEVICE] - sec.addr);
+	if (!read(ctx, offset, buf, FD_SECTORS))
+	{
+		return ERROR_ALGO_ELF;
+	}
+
+	memset(hdr, 0, sizeof(*hdr));
+	memcpy(hdr->device.name, &buf[FD_DEVNAME], FLASH_ALGO_NAME_LEN - 1);
+	hdr->device.name[FLASH_ALGO_NAME_LEN - 1] = '\0';
+	hdr->device.version         = (uint16_t)get16(&buf[FD_VERS]);
+	hdr->device.type            = (uint16_t)get16(&buf[FD_DEVTYPE]);
+	hdr->device.start           = get32(&buf[FD_DEVADR]);
+	hdr->device.size            = get32(&buf[FD_SZDEV]);
+	hdr->device.page_size       = get32(&buf[FD_SZPAGE]);
+	hdr->device.erased_value    = buf[FD_VALEMPTY];
+	hdr->device.program_timeout = get32(&buf[FD_TOPROG]);
+	hdr->device.erase_timeout   = get32(&buf[FD_TOERASE]);
+
+	if ((hdr->device.page_size == 0) || (hdr->device.size == 0))
+	{
+		return ERROR_ALGO_SYMBOL;
+	}
+
+	sectors = (sector_info_t *)(hdr + 1);
+	for (count = 0; ; count++)
+	{
+		if (!read(ctx, offset + FD_SECTORS + count * 8U, buf, 8))
+		{
+			return ERROR_ALGO_ELF;
+		}
+		if ((get32(&buf[0]) == FD_SECTOR_END) && (get32(&buf[4]) == FD_SECTOR_END))
+		{
+			break;
+		}
+		if ((count >= FLASH_ALGO_MAX_SECTORS) || (get32(&buf[0]) == 0))
+		{
+			return ERROR_ALGO_SYMBOL;
+		}
+		if (sizeof(*hdr) + (count + 1) * sizeof(sector_info_t) > cache_size)
+		{
+			return ERROR_ALGO_CACHE;
+		}
+		sectors[count].size  = get32(&buf[0]);
+		sectors[count].start = hdr->device.start + get32(&buf[4]);
+	}
+	if (count == 0)
+	{
+		return ERROR_ALGO_SYMBOL;
+	}
+
+	// Blob: DAPLink header followed by the section image, zero filled.
+	// Bound the image span first so the size arithmetic cannot wrap.
+	if ((end - base) > cache_size)
+	{
+		return ERROR_ALGO_CACHE;
+	}
+	algo_size = (ALGO_HEADER_SIZE + (end - base) + 3U) & ~3U;
+	size = sizeof(*hdr) + count * sizeof(sector_info_t) + algo_size;
+	if (size > cache_size)
+	{
+		return ERROR_ALGO_CACHE;
+	}
+
+	blob = (uint8_t *)&sectors[count];
+	memset(blob, 0, algo_size);
+	memcpy(blob, algo_header, ALGO_HEADER_SIZE);
+	for (i = 0; i < nload; i++)
+	{
+		if ((load[i].addr - base > algo_size - ALGO_HEADER_SIZE) ||
+		    (load[i].size > algo_size - ALGO_HEADER_SIZE - (load[i].addr - base)))
+		{
+			return ERROR_ALGO_ELF;
+		}
+		if ((load[i].type == ELF_SHT_PROGBITS) &&
+		    !read(ctx, load[i].offset, blob + ALGO_HEADER_SIZE + (load[i].addr - base), load[i].size))
+		{
+			return ERROR_ALGO_ELF;
+		}
+	}
+
+	// Target RAM layout
+	hdr->algo_start          = ram_start;
+	hdr->algo_size           = algo_size;
+	hdr->program_buffer      = (ram_start + algo_size + 7U) & ~7U;
+	hdr->program_buffer_size = hdr->device.page_size;
+	ram_end                  = (ram_start + ram_size) & ~7U;
+	hdr->stack_pointer       = ram_end;
+	hdr->breakpoint          = ram_start + 1U;
+	hdr->static_base         = ram_start + ALGO_HEADER_SIZE + (data - base);
+
+	if ((ram_size < algo_size) ||
+	    (hdr->program_buffer + hdr->program_buffer_size + FLASH_ALGO_STACK_SIZE > ram_end))
+	{
+		return ERROR_ALGO_RAM;
+	}
+
+	// Entry points, Thumb bit set. Optional functions that are missing stay 0.
+	entries[SYM_INIT]         = &hdr->init;
+	entries[SYM_UNINIT]       = &hdr->uninit;
+	entries[SYM_ERASE_CHIP]   = &hdr->erase_chip;
+	entries[SYM_ERASE_SECTOR] = &hdr->erase_sector;
+	entries[SYM_PROGRAM_PAGE] = &hdr->program_page;
+	entries[SYM_VERIFY]       = &hdr->verify;
+	for (j = 0; j < SYM_DEVICE; j++)
+	{
+		*entries[j] = (shndx[j] == ELF_SHN_UNDEF) ? 0U :
+		              ((ram_start + ALGO_HEADER_SIZE + (values[j] - base)) | 1U);
+	}
+
+	hdr->magic        = FLASH_ALGO_CACHE_MAGIC;
+	hdr->version      = FLASH_ALGO_CACHE_VERSION;
+	hdr->sector_count = (uint16_t)count;
+	hdr->size         = size;
+	hdr->crc          = crc32(&hdr->device, size - offsetof(flash_algo_cache_t, device));
+
+	*cache_used = size;
+	return ERROR_SUCCESS;
+}
+
+// Validate a cache image and map it to a flash_algo_t.
+//   cache:      cache image, 4-byte aligned, must stay valid while algo is used
+//   cache_size: number of bytes available at cache
+//   algo:       loaded algorithm
+//   return:     ERROR_SUCCESS or ERROR_ALGO_CACHE
+dap_err_t flash_algo_load(const void *cache, uint32_t cache_size, flash_algo_t *algo)
+{
+	const flash_algo_cache_t *hdr = (const flash_algo_cache_t *)cache;
+	const sector_info_t *sectors;
+
+	if ((cache == NULL) || (algo == NULL) || (((uintptr_t)cache & 3U) != 0) ||
+	    (cache_size < sizeof(*hdr)) ||
+	    (hdr->magic != FLASH_ALGO_CACHE_MAGIC) || (hdr->version != FLASH_ALGO_CACHE_VERSION) ||
+	    (hdr->size > cache_size) ||
+	    (hdr->size != sizeof(*hdr) + hdr->sector_count * sizeof(sector_info_t) + hdr->algo_size) ||
+	    (hdr->crc != crc32(&hdr->device, hdr->size - offsetof(flash_algo_cache_t, device))))
+	{
+		return ERROR_ALGO_CACHE;
+	}
+
+	sectors = (const sector_info_t *)(hdr + 1);
+
+	memset(algo, 0, sizeof(*algo));
+	algo->target.init                     = hdr->init;
+	algo->target.uninit                   = hdr->uninit;
+	algo->target.erase_chip               = hdr->erase_chip;
+	algo->target.erase_sector             = hdr->erase_sector;
+	algo->target.program_page             = hdr->program_page;
+	algo->target.verify                   = hdr->verify;
+	algo->target.sys_call_s.breakpoint    = hdr->breakpoint;
+	algo->target.sys_call_s.static_base   = hdr->static_base;
+	algo->target.sys_call_s.stack_pointer = hdr->stack_pointer;
+	algo->target.program_buffer           = hdr->program_buffer;
+	algo->target.program_buffer_size      = hdr->program_buffer_size;
+	algo->target.algo_start               = hdr->algo_start;
+	algo->target.algo_size                = hdr->algo_size;
+	algo->target.algo_blob                = (uint32_t *)&sectors[hdr->sector_count];
+	algo->device                          = hdr->device;
+	algo->sectors                         = sectors;
+	algo->sector_count                    = hdr->sector_count;
+	return ERROR_SUCCESS;
+}
+
+// flash_algo_read_t for a stdio FILE (FAT partition on the probe, file on the host).
+uint8_t flash_algo_read_file(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+	FILE *file = (FILE *)ctx;
+
+	if ((file == NULL) || (fseek(file, (long)offset, SEEK_SET) != 0))
+	{
+		return 0;
+	}
+	return (fread(buf, 1, len, file) == len);
+}
@@ -0,0 +1,1216 @@
+/**
+ * @file    gdb_rsp.c
+ * @brief   GDB remote serial protocol server for a Cortex-M target
+ *
+ * Lets GDB debug the target through the probe itself, without OpenOCD or
+ * pyOCD on the host. Bytes from GDB are fed in whatever chunks the
+ * transport delivers; replies go out through the output callback, and all
+ * target access goes through the register and memory functions of
+ * gdb_rsp_target_t, so the same code runs against swd_host on the probe
+ * and against a simulated target on the host.
+ *
+ * Run control uses DHCSR: a step is one C_STEP with interrupts masked, a
+ * continue clears DFSR and C_HALT, and gdb_rsp_poll() watches S_HALT until
+ * the target stops and sends the stop reply. Z1 breakpoints use the FPB
+ * code comparators (revision 1 and 2), Z2..Z4 watchpoints the DWT
+ * comparators; Z0 is refused so GDB writes BKPT instructions to RAM itself
+ * and asks for hardware breakpoints in the flash regions of the memory map.
+ *
+ * Registers follow the org.gnu.gdb.arm.m-profile and m-system features of
+ * the target description: r0..pc, xpsr, msp, psp, and the special
+ * registers as 8-bit fields of DCRSR selector 20.
+ *
+ * Pure C without SDK dependencies.
+ */
+
+#include <string.h>
+#include "gdb_rsp.h"
+
+#define NVIC_Addr       (0xe000e000)
+#define DBG_Addr        (0xe000edf0)
+#include "debug_cm.h"
+
+// Parser states
+#define RSP_IDLE        0U
+#define RSP_DATA        1U
+#define RSP_CHECKSUM1   2U
+#define RSP_CHECKSUM2   3U
+
+// Breakpoint and watchpoint units
+#define FP_CTRL         0xE0002000U
+#define FP_COMP(n)      (0xE0002008U + 4U * (n))
+#define FP_KEY_ENABLE   0x00000003U
+#define DWT_CTRL        0xE0001000U
+#define DWT_COMP(n)     (0xE0001020U + 16U * (n))
+#define DWT_MASK(n)     (0xE0001024U + 16U * (n))
+#define DWT_FUNCTION(n) (0xE0001028U + 16U * (n))
+#define DWT_MATCHED     0x01000000U
+#define DWT_MASK_MAX    15U
+
+// DFSR bits are write one to clear
+#define DFSR_ALL        (HALTED | BKPT | DWTTRAP | VCATCH | EXTERNAL)
+
+// Polls for S_HALT after a halt request or a reset
+#define HALT_RETRIES    100U
+
+// GDB registers: DCRSR selector, bit position and size in bytes
+static const struct
+{
+	uint8_t sel;
+	uint8_t shift;
+	uint8_t size;
+} rsp_regs[] = {
+	{ 0, 0, 4}, { 1, 0, 4}, { 2, 0, 4}, { 3, 0, 4}, { 4, 0, 4}, { 5, 0, 4}, { 6, 0, 4}, { 7, 0, 4},
+	{ 8, 0, 4}, { 9, 0, 4}, {10, 0, 4}, {11, 0, 4}, {12, 0, 4}, {13, 0, 4}, {14, 0, 4}, {15, 0, 4},
+	{16, 0, 4},                                     // xpsr
+	{17, 0, 4}, {18, 0, 4},                         // msp, psp
+	{20, 0, 1}, {20, 8, 1}, {20, 16, 1}, {20, 24, 1}, // primask, basepri, faultmask, control
+};
+#define RSP_REG_COUNT   (sizeof(rsp_regs) / sizeof(rsp_regs[0]))
+
+static const char target_xml[] =
+	"<?xml version=\"1.0\"?>"
+	"<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+	"<target version=\"1.0\">"
+	"<architecture>arm</architecture>"
+	"<feature name=\"org.gnu.gdb.arm.m-profile\">"
+	"<reg name=\"r0\" bitsize=\"32\"/><reg name=\"r1\" bitsize=\"32\"/>"
+	"<reg name=\"r2\" bitsize=\"32\"/><reg name=\"r3\" bitsize=\"32\"/>"
+	"<reg name=\"r4\" bitsize=\"32\"/><reg name=\"r5\" bitsize=\"32\"/>"
+	"<reg name=\"r6\" bitsize=\"32\"/><reg name=\"r7\" bitsize=\"32\"/>"
+	"<reg name=\"r8\" bitsize=\"32\"/><reg name=\"r9\" bitsize=\"32\"/>"
+	"<reg name=\"r10\" bitsize=\"32\"/><reg name=\"r11\" bitsize=\"32\"/>"
+	"<reg name=\"r12\" bitsize=\"32\"/>"
+	"<reg name=\"sp\" bitsize=\"32\" type=\"data_ptr\"/>"
+	"<reg name=\"lr\" bitsize=\"32\"/>"
+	"<reg name=\"pc\" bitsize=\"32\" type=\"code_ptr\"/>"
+	"<reg name=\"xpsr\" bitsize=\"32\"/>"
+	"</feature>"
+	"<feature name=\"org.gnu.gdb.arm.m-system\">"
+	"<reg name=\"msp\" bitsize=\"32\" type=\"data_ptr\"/>"
+	"<reg name=\"psp\" bitsize=\"32\" type=\"data_ptr\"/>"
+	"<reg name=\"primask\" bitsize=\"8\" group=\"system\"/>"
+	"<reg name=\"basepri\" bitsize=\"8\" group=\"system\"/>"
+	"<reg name=\"faultmask\" bitsize=\"8\" group=\"system\"/>"
+	"<reg name=\"control\" bitsize=\"8\" group=\"system\"/>"
+	"</feature>"
+	"</target>";
+
+static const char hex_digits[] = "0123456789abcdef";
+
+//--------------------------------------------------------------------------------------------------
+// Reply buffer: '$' data '#' checksum
+
+static void put_begin(gdb_rsp_t *rsp)
+{
+	rsp->reply[0] = '$';
+	rsp->reply_length = 1U;
+}
+
+static void put_char(gdb_rsp_t *rsp, char c)
+{
+	// Room for the checksum is kept, replies are sized by their callers
+	if (rsp->reply_length < sizeof(rsp->reply) - 3U)
+	{
+		rsp->reply[rsp->reply_length++] = (uint8_t)c;
+	}
+}
+
+static void put_str(gdb_rsp_t *rsp, const char *s)
+{
+	while (*s)
+	{
+		put_char(rsp, *s++);
+	}
+}
+
+static void put_hex8(gdb_rsp_t *rsp, uint8_t b)
+{
+	put_char(rsp, hex_digits[b >> 4]);
+	put_char(rsp, hex_digits[b & 0x0FU]);
+}
+
+// Hex number without leading zeros
+static void put_hex(gdb_rsp_t *rsp, uint32_t value)
+{
+	int shift = 28;
+
+	while ((shift > 0) && ((value >> shift) == 0U))
+	{
+		shift -= 4;
+	}
+	for (; shift >= 0; shift -= 4)
+	{
+		put_char(rsp, hex_digits[(value >> shift) & 0x0FU]);
+	}
+}
+
+// Register value in target byte order
+static void put_value(gdb_rsp_t *rsp, uint32_t value, uint32_t size)
+{
+	while (size--)
+	{
+		put_hex8(rsp, (uint8_t)value);
+		value >>= 8;
+	}
+}
+
+// Binary data of a qXfer reply
+static void put_binary(gdb_rsp_t *rsp, const uint8_t *data, uint32_t size)
+{
+	uint8_t c;
+
+	while (size--)
+	{
+		c = *data++;
+		if ((c == '#') || (c == '$') || (c == '}') || (c == '*'))
+		{
+			put_char(rsp, '}');
+			c ^= 0x20U;
+		}
+		put_char(rsp, (char)c);
+	}
+}
+
+static void put_end(gdb_rsp_t *rsp)
+{
+	uint8_t sum = 0U;
+	uint32_t n;
+
+	for (n = 1U; n < rsp->reply_length; n++)
+	{
+		sum += rsp->reply[n];
+	}
+	rsp->reply[rsp->reply_length++] = '#';
+	rsp->reply[rsp->reply_length++] = (uint8_t)hex_digits[sum >> 4];
+	rsp->reply[rsp->reply_length++] = (uint8_t)hex_digits[sum & 0x0FU];
+	rsp->target->output(rsp->target->ctx, rsp->reply, rsp->reply_length);
+}
+
+static void reply(gdb_rsp_t *rsp, const char *s)
+{
+	put_begin(rsp);
+	put_str(rsp, s);
+	put_end(rsp);
+}
+
+// Console output of a monitor command
+static void reply_console(gdb_rsp_t *rsp, const char *s)
+{
+	put_begin(rsp);
+	put_char(rsp, 'O');
+	while (*s)
+	{
+		put_hex8(rsp, (uint8_t)*s++);
+	}
+	put_end(rsp);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Packet fields
+
+static int hex_value(char c)
+{
+	if ((c >= '0') && (c <= '9'))
+	{
+		return c - '0';
+	}
+	if ((c >= 'a') && (c <= 'f'))
+	{
+		return c - 'a' + 10;
+	}
+	if ((c >= 'A') && (c <= 'F'))
+	{
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+// Parse a hex number, returns the number of digits
+static uint32_t get_hex(const char **p, uint32_t *value)
+{
+	uint32_t n = 0U;
+	int d;
+
+	*value = 0U;
+	while ((d = hex_value(**p)) >= 0)
+	{
+		*value = (*value << 4) | (uint32_t)d;
+		(*p)++;
+		n++;
+	}
+	return n;
+}
+
+// Parse "addr,length" followed by the separator sep
+static uint8_t get_range(const char **p, uint32_t *addr, uint32_t *size, char sep)
+{
+	if (!get_hex(p, addr) || (*(*p)++ != ','))
+	{
+		return 0U;
+	}
+	if (!get_hex(p, size) || (**p != sep))
+	{
+		return 0U;
+	}
+	if (sep != '\0')
+	{
+		(*p)++;
+	}
+	return 1U;
+}
+
+// Decode hex bytes, returns the number of bytes
+static uint32_t get_bytes(const char *p, uint8_t *data, uint32_t size)
+{
+	uint32_t n;
+	int hi, lo;
+
+	for (n = 0U; n < size; n++)
+	{
+		hi = hex_value(p[2U * n]);
+		lo = (hi < 0) ? -1 : hex_value(p[2U * n + 1U]);
+		if (lo < 0)
+		{
+			break;
+		}
+		data[n] = (uint8_t)((hi << 4) | lo);
+	}
+	return n;
+}
+
+// Register value in target byte order
+static uint8_t get_value(const char *p, uint32_t size, uint32_t *value)
+{
+	uint8_t b[4];
+	uint32_t n;
+
+	if (get_bytes(p, b, size) != size)
+	{
+		return 0U;
+	}
+	*value = 0U;
+	for (n = size; n-- > 0U;)
+	{
+		*value = (*value << 8) | b[n];
+	}
+	return 1U;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Target access
+
+static uint8_t read_word(gdb_rsp_t *rsp, uint32_t addr, uint32_t *val)
+{
+	return rsp->target->read_mem(rsp->target->ctx, addr, (uint8_t *)val, 4U);
+}
+
+static uint8_t write_word(gdb_rsp_t *rsp, uint32_t addr, uint32_t val)
+{
+	return rsp->target->write_mem(rsp->target->ctx, addr, (const uint8_t *)&val, 4U);
+}
+
+static uint8_t wait_halted(gdb_rsp_t *rsp)
+{
+	uint32_t dhcsr, n;
+
+	for (n = 0U; n < HALT_RETRIES; n++)
+	{
+		// Reads fail for a moment while the target resets
+		if (read_word(rsp, DBG_HCSR, &dhcsr) && (dhcsr & S_HALT))
+		{
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static uint8_t read_reg(gdb_rsp_t *rsp, uint32_t n, uint32_t *val)
+{
+	if (!rsp->target->read_reg(rsp->target->ctx, rsp_regs[n].sel, val))
+	{
+		return 0U;
+	}
+	*val >>= rsp_regs[n].shift;
+	return 1U;
+}
+
+static uint8_t write_reg(gdb_rsp_t *rsp, uint32_t n, uint32_t val)
+{
+	uint32_t old, mask;
+
+	if (rsp_regs[n].size != 4U)
+	{
+		// Special registers share one selector
+		if (!rsp->target->read_reg(rsp->target->ctx, rsp_regs[n].sel, &old))
+		{
+			return 0U;
+		}
+		mask = 0xFFUL << rsp_regs[n].shift;
+		val = (old & ~mask) | ((val << rsp_regs[n].shift) & mask);
+	}
+	return rsp->target->write_reg(rsp->target->ctx, rsp_regs[n].sel, val);
+}
+
+static uint8_t halt(gdb_rsp_t *rsp)
+{
+	return write_word(rsp, DBG_HCSR, DBGKEY | C_DEBUGEN | C_HALT);
+}
+
+static uint8_t resume(gdb_rsp_t *rsp, uint8_t step)
+{
+	// C_MASKINTS only changes together with C_HALT
+	uint32_t mask = step ? C_MASKINTS : 0U;
+
+	if (!write_word(rsp, NVIC_DFSR, DFSR_ALL) ||
+	    !write_word(rsp, DBG_HCSR, DBGKEY | C_DEBUGEN | C_HALT | mask) ||
+	    !write_word(rsp, DBG_HCSR, DBGKEY | C_DEBUGEN | mask | (step ? C_STEP : 0U)))
+	{
+		return 0U;
+	}
+	rsp->running = 1U;
+	rsp->stepping = step;
+	rsp->interrupted = 0U;
+	return 1U;
+}
+
+// Reset the target and halt it at the reset vector
+static uint8_t reset_halt(gdb_rsp_t *rsp)
+{
+	uint32_t demcr;
+
+	if (!read_word(rsp, DBG_EMCR, &demcr) ||
+	    !write_word(rsp, DBG_EMCR, demcr | VC_CORERESET | TRCENA) ||
+	    !halt(rsp))
+	{
+		return 0U;
+	}
+	// The write may not be acknowledged when the reset is quick
+	write_word(rsp, NVIC_AIRCR, VECTKEY | SYSRESETREQ);
+	if (!wait_halted(rsp))
+	{
+		return 0U;
+	}
+	return write_word(rsp, DBG_EMCR, (demcr | TRCENA) & ~VC_CORERESET) &&
+	       write_word(rsp, NVIC_DFSR, DFSR_ALL);
+}
+
+static void clear_comparators(gdb_rsp_t *rsp)
+{
+	uint32_t n;
+
+	for (n = 0U; n < rsp->fpb_count; n++)
+	{
+		if (rsp->fpb[n] != 0U)
+		{
+			write_word(rsp, FP_COMP(n), 0U);
+			rsp->fpb[n] = 0U;
+		}
+	}
+	for (n = 0U; n < rsp->dwt_count; n++)
+	{
+		if (rsp->dwt[n].type != 0U)
+		{
+			write_word(rsp, DWT_FUNCTION(n), 0U);
+			rsp->dwt[n].type = 0U;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Breakpoints and watchpoints
+
+static uint8_t set_breakpoint(gdb_rsp_t *rsp, uint32_t addr)
+{
+	uint32_t n, comp;
+
+	addr &= ~1U;
+	for (n = 0U; n < rsp->fpb_count; n++)
+	{
+		if (rsp->fpb[n] == (addr | 1U))
+		{
+			return 1U;
+		}
+	}
+	if (rsp->fpb_rev == 0U)
+	{
+		// Revision 1 only covers the code region, bits 31:30 select the halfword
+		if (addr >= 0x20000000U)
+		{
+			return 0U;
+		}
+		comp = (addr & 0x1FFFFFFCU) | ((addr & 2U) ? 0x80000000U : 0x40000000U) | 1U;
+	}
+	else
+	{
+		comp = addr | 1U;
+	}
+	for (n = 0U; n < rsp->fpb_count; n++)
+	{
+		if (rsp->fpb[n] == 0U)
+		{
+			if (!write_word(rsp, FP_COMP(n), comp))
+			{
+				return 0U;
+			}
+			rsp->fpb[n] = addr | 1U;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static uint8_t clear_breakpoint(gdb_rsp_t *rsp, uint32_t addr)
+{
+	uint32_t n;
+
+	addr &= ~1U;
+	for (n = 0U; n < rsp->fpb_count; n++)
+	{
+		if (rsp->fpb[n] == (addr | 1U))
+		{
+			rsp->fpb[n] = 0U;
+			return write_word(rsp, FP_COMP(n), 0U);
+		}
+	}
+	return 1U;
+}
+
+static uint8_t set_watchpoint(gdb_rsp_t *rsp, uint8_t type, uint32_t addr, uint32_t size)
+{
+	// DWT_FUNCTION: 5 = read, 6 = write, 7 = access (ARMv7-M)
+	static const uint8_t function[] = {6U, 5U, 7U};
+	uint32_t n, mask = 0U;
+
+	if (size == 0U)
+	{
+		return 0U;
+	}
+	// Smallest aligned power of two block that covers the range
+	while ((mask < DWT_MASK_MAX) && ((addr >> mask) != ((addr + size - 1U) >> mask)))
+	{
+		mask++;
+	}
+	if ((addr >> mask) != ((addr + size - 1U) >> mask))
+	{
+		return 0U;
+	}
+	for (n = 0U; n < rsp->dwt_count; n++)
+	{
+		if (rsp->dwt[n].type == 0U)
+		{
+			if (!write_word(rsp, DWT_COMP(n), addr & ~((1UL << mask) - 1U)) ||
+			    !write_word(rsp, DWT_MASK(n), mask) ||
+			    !write_word(rsp, DWT_FUNCTION(n), function[type - 2U]))
+			{
+				return 0U;
+			}
+			rsp->dwt[n].addr = addr;
+			rsp->dwt[n].size = size;
+			rsp->dwt[n].type = type;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static uint8_t clear_watchpoint(gdb_rsp_t *rsp, uint8_t type, uint32_t addr, uint32_t size)
+{
+	uint32_t n;
+
+	for (n = 0U; n < rsp->dwt_count; n++)
+	{
+		if ((rsp->dwt[n].type == type) && (rsp->dwt[n].addr == addr) && (rsp->dwt[n].size == size))
+		{
+			rsp->dwt[n].type = 0U;
+			return write_word(rsp, DWT_FUNCTION(n), 0U);
+		}
+	}
+	return 1U;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Packets
+
+// Stop reply, with the watchpoint that triggered
+static void stop_reply(gdb_rsp_t *rsp)
+{
+	static const char *const watch[] = {"watch", "rwatch", "awatch"};
+	uint32_t dfsr = 0U, function, n;
+
+	put_begin(rsp);
+	if (rsp->interrupted)
+	{
+		put_str(rsp, "T02");
+		put_end(rsp);
+		return;
+	}
+	put_str(rsp, "T05");
+	if (read_word(rsp, NVIC_DFSR, &dfsr) && (dfsr & DWTTRAP))
+	{
+		for (n = 0U; n < rsp->dwt_count; n++)
+		{
+			// Reading FUNCTION clears MATCHED
+			if ((rsp->dwt[n].type != 0U) && read_word(rsp, DWT_FUNCTION(n), &function) &&
+			    (function & DWT_MATCHED))
+			{
+				put_str(rsp, watch[rsp->dwt[n].type - 2U]);
+				put_char(rsp, ':');
+				put_hex(rsp, rsp->dwt[n].addr);
+				put_char(rsp, ';');
+				break;
+			}
+		}
+	}
+	put_end(rsp);
+}
+
+static void read_registers(gdb_rsp_t *rsp)
+{
+	uint32_t n, val, raw = 0U;
+	uint32_t sel = 0xFFFFFFFFU;
+
+	put_begin(rsp);
+	for (n = 0U; n < RSP_REG_COUNT; n++)
+	{
+		// The special registers are read once
+		if (rsp_regs[n].sel != sel)
+		{
+			sel = rsp_regs[n].sel;
+			if (!rsp->target->read_reg(rsp->target->ctx, sel, &raw))
+			{
+				reply(rsp, "E01");
+				return;
+			}
+		}
+		val = raw >> rsp_regs[n].shift;
+		put_value(rsp, val, rsp_regs[n].size);
+	}
+	put_end(rsp);
+}
+
+static void write_registers(gdb_rsp_t *rsp, const char *p)
+{
+	uint32_t n, val;
+
+	for (n = 0U; n < RSP_REG_COUNT; n++)
+	{
+		if (!get_value(p, rsp_regs[n].size, &val))
+		{
+			break;
+		}
+		p += 2U * rsp_regs[n].size;
+		if (!write_reg(rsp, n, val))
+		{
+			reply(rsp, "E01");
+			return;
+		}
+	}
+	reply(rsp, "OK");
+}
+
+static void read_register(gdb_rsp_t *rsp, const char *p)
+{
+	uint32_t n, val;
+
+	if (!get_hex(&p, &n) || (n >= RSP_REG_COUNT))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	if (!read_reg(rsp, n, &val))
+	{
+		reply(rsp, "E01");
+		return;
+	}
+	put_begin(rsp);
+	put_value(rsp, val, rsp_regs[n].size);
+	put_end(rsp);
+}
+
+static void write_register(gdb_rsp_t *rsp, const char *p)
+{
+	uint32_t n, val;
+
+	if (!get_hex(&p, &n) || (n >= RSP_REG_COUNT) || (*p++ != '=') ||
+	    !get_value(p, rsp_regs[n].size, &val))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	reply(rsp, write_reg(rsp, n, val) ? "OK" : "E01");
+}
+
+static void read_memory(gdb_rsp_t *rsp, const char *p)
+{
+	uint32_t addr, size, n;
+
+	if (!get_range(&p, &addr, &size, '\0'))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	if (size > (GDB_RSP_PACKET_SIZE - 4U) / 2U)
+	{
+		size = (GDB_RSP_PACKET_SIZE - 4U) / 2U;
+	}
+	if (!rsp->target->read_mem(rsp->target->ctx, addr, rsp->mem, size))
+	{
+		reply(rsp, "E01");
+		return;
+	}
+	put_begin(rsp);
+	for (n = 0U; n < size; n++)
+	{
+		put_hex8(rsp, rsp->mem[n]);
+	}
+	put_end(rsp);
+}
+
+// M addr,length:hex and X addr,length:binary
+static void write_memory(gdb_rsp_t *rsp, const char *p, uint8_t binary)
+{
+	uint32_t addr, size;
+	const uint8_t *data = rsp->mem;
+
+	if (!get_range(&p, &addr, &size, ':'))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	if (binary)
+	{
+		data = (const uint8_t *)p;
+		if (size > rsp->length - (uint32_t)(p - rsp->packet))
+		{
+			reply(rsp, "E00");
+			return;
+		}
+	}
+	else if ((size > sizeof(rsp->mem)) || (get_bytes(p, rsp->mem, size) != size))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	if ((size != 0U) && !rsp->target->write_mem(rsp->target->ctx, addr, data, size))
+	{
+		reply(rsp, "E01");
+		return;
+	}
+	reply(rsp, "OK");
+}
+
+static void breakpoint(gdb_rsp_t *rsp, const char *p, uint8_t insert)
+{
+	uint32_t addr, kind;
+	uint8_t type = (uint8_t)(*p - '0');
+	uint8_t ok;
+
+	p++;
+	if ((*p++ != ',') || !get_range(&p, &addr, &kind, '\0'))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	switch (type)
+	{
+	case 1U:
+		ok = insert ? set_breakpoint(rsp, addr) : clear_breakpoint(rsp, addr);
+		break;
+	case 2U:
+	case 3U:
+	case 4U:
+		ok = insert ? set_watchpoint(rsp, type, addr, kind) : clear_watchpoint(rsp, type, addr, kind);
+		break;
+	default:
+		// Software breakpoints are written to memory by GDB
+		reply(rsp, "");
+		return;
+	}
+	reply(rsp, ok ? "OK" : "E01");
+}
+
+// c [addr] and s [addr]
+static void resume_packet(gdb_rsp_t *rsp, const char *p, uint8_t step)
+{
+	uint32_t addr;
+
+	if (get_hex(&p, &addr) && !rsp->target->write_reg(rsp->target->ctx, 15U, addr))
+	{
+		reply(rsp, "E01");
+		return;
+	}
+	if (!resume(rsp, step))
+	{
+		reply(rsp, "E01");
+		return;
+	}
+	if (step)
+	{
+		// A step is over before the next poll, answer in the same round trip
+		gdb_rsp_poll(rsp);
+	}
+}
+
+// qXfer:object:read:annex:offset,length
+static void transfer(gdb_rsp_t *rsp, const char *p)
+{
+	const char *doc = NULL;
+	uint32_t offset, size, total;
+
+	if (strncmp(p, "features:read:target.xml:", 25) == 0)
+	{
+		doc = target_xml;
+		p += 25;
+	}
+	else if ((strncmp(p, "memory-map:read::", 17) == 0) && (rsp->target->memory_map != NULL))
+	{
+		doc = rsp->target->memory_map(rsp->target->ctx);
+		p += 17;
+	}
+	if (doc == NULL)
+	{
+		reply(rsp, "");
+		return;
+	}
+	if (!get_range(&p, &offset, &size, '\0'))
+	{
+		reply(rsp, "E00");
+		return;
+	}
+	total = (uint32_t)strlen(doc);
+	offset = (offset > total) ? total : offset;
+	// Escaped bytes may double in size
+	if (size > (GDB_RSP_PACKET_SIZE - 8U) / 2U)
+	{
+		size = (GDB_RSP_PACKET_SIZE - 8U) / 2U;
+	}
+	if (size > total - offset)
+	{
+		size = total - offset;
+	}
+	put_begin(rsp);
+	put_char(rsp, (offset + size < total) ? 'm' : 'l');
+	put_binary(rsp, (const uint8_t *)doc + offset, size);
+	put_end(rsp);
+}
+
+static void monitor(gdb_rsp_t *rsp, const char *p)
+{
+	char cmd[32];
+	uint32_t n = get_bytes(p, (uint8_t *)cmd, sizeof(cmd) - 1U);
+
+	cmd[n] = '\0';
+	if (strcmp(cmd, "reset") == 0 || strcmp(cmd, "reset halt") == 0)
+	{
+		if (!reset_halt(rsp))
+		{
+			reply(rsp, "E01");
+			return;
+		}
+		reply_console(rsp, "Target reset and halted\n");
+	}
+	else if (strcmp(cmd, "halt") == 0)
+	{
+		if (!halt(rsp) || !wait_halted(rsp))
+		{
+			reply(rsp, "E01");
+			return;
+		}
+	}
+	else
+	{
+		reply_console(rsp, "Commands: reset, halt\n");
+	}
+	reply(rsp, "OK");
+}
+
+static void flash_packet(gdb_rsp_t *rsp, const char *p)
+{
+	const gdb_rsp_target_t *t = rsp->target;
+	uint32_t addr, size;
+	uint8_t ok = 0U;
+
+	if (t->flash_erase == NULL)
+	{
+		reply(rsp, "");
+		return;
+	}
+	if (strncmp(p, "Erase:", 6) == 0)
+	{
+		p += 6;
+		ok = get_range(&p, &addr, &size, '\0') && t->flash_erase(t->ctx, addr, size);
+	}
+	else if (strncmp(p, "Write:", 6) == 0)
+	{
+		p += 6;
+		if (get_hex(&p, &addr) && (*p++ == ':'))
+		{
+			size = rsp->length - (uint32_t)(p - rsp->packet);
+			ok = t->flash_write(t->ctx, addr, (const uint8_t *)p, size);
+		}
+	}
+	else if (strcmp(p, "Done") == 0)
+	{
+		ok = t->flash_done(t->ctx);
+	}
+	else
+	{
+		reply(rsp, "");
+		return;
+	}
+	reply(rsp, ok ? "OK" : "E01");
+}
+
+static void query(gdb_rsp_t *rsp, const char *p)
+{
+	if (strncmp(p, "Supported", 9) == 0)
+	{
+		put_begin(rsp);
+		put_str(rsp, "PacketSize=");
+		put_hex(rsp, GDB_RSP_PACKET_SIZE);
+		put_str(rsp, ";qXfer:features:read+;QStartNoAckMode+");
+		if (rsp->target->memory_map != NULL)
+		{
+			put_str(rsp, ";qXfer:memory-map:read+");
+		}
+		put_end(rsp);
+	}
+	else if (strncmp(p, "Xfer:", 5) == 0)
+	{
+		transfer(rsp, p + 5);
+	}
+	else if (strncmp(p, "Rcmd,", 5) == 0)
+	{
+		monitor(rsp, p + 5);
+	}
+	else if (strcmp(p, "Attached") == 0)
+	{
+		reply(rsp, "1");
+	}
+	else if (strcmp(p, "C") == 0)
+	{
+		reply(rsp, "QC1");
+	}
+	else if (strcmp(p, "fThreadInfo") == 0)
+	{
+		reply(rsp, "m1");
+	}
+	else if (strcmp(p, "sThreadInfo") == 0)
+	{
+		reply(rsp, "l");
+	}
+	else if (strncmp(p, "Symbol", 6) == 0)
+	{
+		reply(rsp, "OK");
+	}
+	else
+	{
+		reply(rsp, "");
+	}
+}
+
+static void handle_packet(gdb_rsp_t *rsp)
+{
+	const char *p = rsp->packet;
+
+	rsp->packets++;
+	switch (*p++)
+	{
+	case '?':
+		stop_reply(rsp);
+		break;
+	case 'g':
+		read_registers(rsp);
+		break;
+	case 'G':
+		write_registers(rsp, p);
+		break;
+	case 'p':
+		read_register(rsp, p);
+		break;
+	case 'P':
+		write_register(rsp, p);
+		break;
+	case 'm':
+		read_memory(rsp, p);
+		break;
+	case 'M':
+		write_memory(rsp, p, 0U);
+		break;
+	case 'X':
+		write_memory(rsp, p, 1U);
+		break;
+	case 'c':
+		resume_packet(rsp, p, 0U);
+		break;
+	case 's':
+		resume_packet(rsp, p, 1U);
+		break;
+	case 'C':
+	case 'S':
+		// Signals are not delivered to a bare metal target
+		while ((*p != '\0') && (*p != ';'))
+		{
+			p++;
+		}
+		resume_packet(rsp, (*p == ';') ? p + 1 : p, rsp->packet[0] == 'S');
+		break;
+	case 'Z':
+		breakpoint(rsp, p, 1U);
+		break;
+	case 'z':
+		breakpoint(rsp, p, 0U);
+		break;
+	case 'H':
+	case 'T':
+		reply(rsp, "OK");
+		break;
+	case 'q':
+		query(rsp, p);
+		break;
+	case 'Q':
+		if (strcmp(p, "StartNoAckMode") == 0)
+		{
+			reply(rsp, "OK");
+			rsp->noack = 1U;
+		}
+		else
+		{
+			reply(rsp, "");
+		}
+		break;
+	case 'v':
+		if (strncmp(p, "Flash", 5) == 0)
+		{
+			flash_packet(rsp, p + 5);
+		}
+		else
+		{
+			reply(rsp, "");
+		}
+		break;
+	case 'D':
+		reply(rsp, "OK");
+		gdb_rsp_detach(rsp);
+		break;
+	case 'k':
+		// No reply, the target restarts without the debugger
+		clear_comparators(rsp);
+		write_word(rsp, DBG_HCSR, DBGKEY);
+		write_word(rsp, NVIC_AIRCR, VECTKEY | SYSRESETREQ);
+		rsp->running = 0U;
+		rsp->attached = 0U;
+		break;
+	default:
+		reply(rsp, "");
+		break;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+// Initialize the server
+//   target: target access and output, must stay valid
+void gdb_rsp_init(gdb_rsp_t *rsp, const gdb_rsp_target_t *target)
+{
+	memset(rsp, 0, sizeof(*rsp));
+	rsp->target = target;
+}
+
+// Start a session: halt the target and find the breakpoint units
+//   return: 1 = target halted, 0 = target access failed
+uint8_t gdb_rsp_attach(gdb_rsp_t *rsp)
+{
+	uint32_t ctrl, demcr, n;
+
+	rsp->state = RSP_IDLE;
+	rsp->attached = 0U;
+	rsp->noack = 0U;
+	rsp->running = 0U;
+	rsp->interrupted = 0U;
+	rsp->reply_length = 0U;
+	memset(rsp->fpb, 0, sizeof(rsp->fpb));
+	memset(rsp->dwt, 0, sizeof(rsp->dwt));
+
+	if (!halt(rsp) || !wait_halted(rsp))
+	{
+		return 0U;
+	}
+
+	// FP_CTRL.NUM_CODE is split into bits 14:12 and 7:4
+	if (!read_word(rsp, FP_CTRL, &ctrl))
+	{
+		return 0U;
+	}
+	rsp->fpb_count = (uint8_t)((((ctrl >> 8) & 0x70U) | ((ctrl >> 4) & 0x0FU)));
+	rsp->fpb_count = (rsp->fpb_count > GDB_RSP_FPB_MAX) ? GDB_RSP_FPB_MAX : rsp->fpb_count;
+	rsp->fpb_rev = (uint8_t)(ctrl >> 28);
+	if ((rsp->fpb_count != 0U) && !write_word(rsp, FP_CTRL, FP_KEY_ENABLE))
+	{
+		return 0U;
+	}
+
+	// The DWT needs DEMCR.TRCENA
+	if (!read_word(rsp, DBG_EMCR, &demcr) || !write_word(rsp, DBG_EMCR, demcr | TRCENA) ||
+	    !read_word(rsp, DWT_CTRL, &ctrl))
+	{
+		return 0U;
+	}
+	rsp->dwt_count = (uint8_t)(ctrl >> 28);
+	rsp->dwt_count = (rsp->dwt_count > GDB_RSP_DWT_MAX) ? GDB_RSP_DWT_MAX : rsp->dwt_count;
+
+	// Comparators left behind by an earlier session
+	for (n = 0U; n < rsp->fpb_count; n++)
+	{
+		if (!write_word(rsp, FP_COMP(n), 0U))
+		{
+			return 0U;
+		}
+	}
+	for (n = 0U; n < rsp->dwt_count; n++)
+	{
+		if (!write_word(rsp, DWT_FUNCTION(n), 0U))
+		{
+			return 0U;
+		}
+	}
+	rsp->attached = 1U;
+	return 1U;
+}
+
+// Feed bytes received from GDB
+// Packets may span chunks, each complete packet is acknowledged and
+// answered before the next one is parsed.
+//   data: bytes from GDB
+//   num:  number of bytes
+void gdb_rsp_input(gdb_rsp_t *rsp, const uint8_t *data, uint32_t num)
+{
+	static const uint8_t ack = '+', nak = '-';
+	const gdb_rsp_target_t *t = rsp->target;
+	uint8_t c;
+	int d;
+
+	while (num--)
+	{
+		c = *data++;
+		switch (rsp->state)
+		{
+		case RSP_IDLE:
+			if (c == '$')
+			{
+				rsp->state = RSP_DATA;
+				rsp->length = 0U;
+				rsp->checksum = 0U;
+				rsp->escape = 0U;
+				rsp->overflow = 0U;
+			}
+			else if (c == 0x03U)
+			{
+				// ^C: halt, the stop reply follows from gdb_rsp_poll()
+				if (rsp->running && halt(rsp))
+				{
+					rsp->interrupted = 1U;
+				}
+			}
+			else if ((c == '-') && !rsp->noack && (rsp->reply_length != 0U))
+			{
+				t->output(t->ctx, rsp->reply, rsp->reply_length);
+			}
+			// '+' and noise between packets are ignored
+			break;
+
+		case RSP_DATA:
+			if (c == '#')
+			{
+				rsp->state = RSP_CHECKSUM1;
+				break;
+			}
+			rsp->checksum += c;
+			if (rsp->escape)
+			{
+				rsp->escape = 0U;
+				c ^= 0x20U;
+			}
+			else if (c == '}')
+			{
+				rsp->escape = 1U;
+				break;
+			}
+			if (rsp->length < GDB_RSP_PACKET_SIZE)
+			{
+				rsp->packet[rsp->length++] = (char)c;
+			}
+			else
+			{
+				rsp->overflow = 1U;
+			}
+			break;
+
+		case RSP_CHECKSUM1:
+			d = hex_value((char)c);
+			rsp->received = (uint8_t)((d < 0 ? 0 : d) << 4);
+			rsp->state = RSP_CHECKSUM2;
+			break;
+
+		default:
+			d = hex_value((char)c);
+			rsp->received |= (uint8_t)(d < 0 ? 0 : d);
+			rsp->state = RSP_IDLE;
+			if (rsp->overflow || (!rsp->noack && (rsp->received != rsp->checksum)))
+			{
+				rsp->errors++;
+				if (!rsp->noack)
+				{
+					t->output(t->ctx, &nak, 1U);
+				}
+				break;
+			}
+			if (!rsp->noack)
+			{
+				t->output(t->ctx, &ack, 1U);
+			}
+			rsp->packet[rsp->length] = '\0';
+			handle_packet(rsp);
+			break;
+		}
+	}
+}
+
+// Check a running target
+// Sends the stop reply once the target has halted.
+//   return: 1 = target still running
+uint8_t gdb_rsp_poll(gdb_rsp_t *rsp)
+{
+	uint32_t dhcsr;
+
+	if (!rsp->running)
+	{
+		return 0U;
+	}
+	if (!read_word(rsp, DBG_HCSR, &dhcsr) || !(dhcsr & S_HALT))
+	{
+		return 1U;
+	}
+	rsp->running = 0U;
+	if (rsp->stepping)
+	{
+		// Leave C_MASKINTS set by the step
+		rsp->stepping = 0U;
+		write_word(rsp, DBG_HCSR, DBGKEY | C_DEBUGEN | C_HALT);
+	}
+	stop_reply(rsp);
+	return 0U;
+}
+
+// End the session: remove breakpoints and watchpoints, let the target run
+void gdb_rsp_detach(gdb_rsp_t *rsp)
+{
+	clear_comparators(rsp);
+	write_word(rsp, NVIC_DFSR, DFSR_ALL);
+	write_word(rsp, DBG_HCSR, DBGKEY | C_DEBUGEN | C_HALT);
+	write_word(rsp, DBG_HCSR, DBGKEY);
+	rsp->running = 0U;
+	rsp->attached = 0U;
+	rsp->state = RSP_IDLE;
+}
@@ -0,0 +1,425 @@
+/**
+ * @file    image_cache.c
+ * @brief   RAM cache of decoded images with LRU eviction
+ *
+ * Decoding a HEX or ELF file and assembling its pages costs flash reads and
+ * parser time on every job, although production runs program the same image
+ * again and again. The cache keeps the assembled pages of recent images,
+ * together with a CRC-32 per page, keyed by a hash of the source file. A
+ * repeated job finds the entry and replays its pages straight to the
+ * programming callback.
+ *
+ * Pages are stored in chunks of about IMAGE_CACHE_CHUNK_SIZE bytes, so an
+ * image of unknown size grows without reallocation. When the capacity or the
+ * allocator runs out, the least recently used complete entries that are not
+ * in use are evicted. If nothing can be evicted the build fails with
+ * ERROR_IMAGE_CACHE and the job continues uncached.
+ *
+ * On the probe the default allocator takes memory from PSRAM only, so the
+ * cache never competes with DMA buffers in internal RAM. Any other build uses
+ * malloc, which allows benchmarking hit rates and eviction on a host.
+ *
+ * The cache is not locked; calls must come from one task.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "image_cache.h"
+#include "crc.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#else
+#include <stdlib.h>
+#endif
+
+#define FNV_OFFSET  2166136261U
+#define FNV_PRIME   16777619U
+
+struct image_cache_chunk
+{
+	image_cache_chunk_t *next;
+	uint32_t count;
+	uint32_t capacity;
+	image_cache_page_t page[];      // capacity entries, page data follows
+};
+
+static void *default_alloc(void *ctx, uint32_t size)
+{
+	(void)ctx;
+#ifdef ESP_PLATFORM
+	return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+	return malloc(size);
+#endif
+}
+
+static void default_free(void *ctx, void *ptr)
+{
+	(void)ctx;
+#ifdef ESP_PLATFORM
+	heap_caps_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+static uint8_t *chunk_data(const image_cache_chunk_t *chunk, uint32_t page_size, uint32_t index)
+{
+	return (uint8_t *)&chunk->page[chunk->capacity] + index * page_size;
+}
+
+static uint8_t key_equal(const image_cache_key_t *a, const image_cache_key_t *b)
+{
+	return (a->size == b->size) && (a->crc == b->crc) && (a->fnv == b->fnv);
+}
+
+static void lru_unlink(image_cache_t *c, image_cache_entry_t *e)
+{
+	if (e->prev != NULL)
+	{
+		e->prev->next = e->next;
+	}
+	else
+	{
+		c->head = e->next;
+	}
+	if (e->next != NULL)
+	{
+		e->next->prev = e->prev;
+	}
+	else
+	{
+		c->tail = e->prev;
+	}
+	e->prev = NULL;
+	e->next = NULL;
+}
+
+static void lru_push(image_cache_t *c, image_cache_entry_t *e)
+{
+	e->prev = NULL;
+	e->next = c->head;
+	if (c->head != NULL)
+	{
+		c->head->prev = e;
+	}
+	else
+	{
+		c->tail = e;
+	}
+	c->head = e;
+}
+
+// Free an entry that is not linked into the LRU list
+static void entry_free(image_cache_t *c, image_cache_entry_t *e)
+{
+	image_cache_chunk_t *chunk, *next;
+
+	for (chunk = e->first; chunk != NULL; chunk = next)
+	{
+		next = chunk->next;
+		c->alloc.free(c->alloc.ctx, chunk);
+	}
+	c->used -= e->bytes;
+	c->alloc.free(c->alloc.ctx, e);
+}
+
+// Evict the least recently used entry that is complete and unused
+static uint8_t evict_one(image_cache_t *c)
+{
+	image_cache_entry_t *e;
+
+	for (e = c->tail; e != NULL; e = e->prev)
+	{
+		if (e->complete && (e->users == 0))
+		{
+			lru_unlink(c, e);
+			c->entry_count--;
+			c->evictions++;
+			entry_free(c, e);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Allocate size bytes within the capacity, evicting as needed
+static void *cache_alloc(image_cache_t *c, uint32_t size)
+{
+	void *ptr;
+
+	if (size > c->capacity)
+	{
+		return NULL;
+	}
+	while (size > c->capacity - c->used)
+	{
+		if (!evict_one(c))
+		{
+			return NULL;
+		}
+	}
+	while ((ptr = c->alloc.alloc(c->alloc.ctx, size)) == NULL)
+	{
+		if (!evict_one(c))
+		{
+			return NULL;
+		}
+	}
+	c->used += size;
+	return ptr;
+}
+
+// Prepare an empty cache.
+//   capacity: upper bound of memory used for entries, in bytes
+//   alloc:    memory provider, NULL for the default
+void image_cache_init(image_cache_t *c, uint32_t capacity, const image_cache_alloc_t *alloc)
+{
+	memset(c, 0, sizeof(*c));
+	c->capacity = capacity;
+	if (alloc != NULL)
+	{
+		c->alloc = *alloc;
+	}
+	else
+	{
+		c->alloc.alloc = default_alloc;
+		c->alloc.free  = default_free;
+	}
+}
+
+// Free all entries. No entry may be in use or under construction.
+void image_cache_deinit(image_cache_t *c)
+{
+	image_cache_entry_t *e;
+
+	while ((e = c->head) != NULL)
+	{
+		lru_unlink(c, e);
+		entry_free(c, e);
+	}
+	c->entry_count = 0;
+}
+
+void image_cache_key_init(image_cache_key_t *key)
+{
+	key->size = 0;
+	key->crc  = 0;
+	key->fnv  = FNV_OFFSET;
+}
+
+// Hash the next part of the source file.
+void image_cache_key_update(image_cache_key_t *key, const uint8_t *data, uint32_t size)
+{
+	uint32_t i, h = key->fnv;
+
+	for (i = 0; i < size; i++)
+	{
+		h = (h ^ data[i]) * FNV_PRIME;
+	}
+	key->fnv   = h;
+	key->crc   = crc32_continue(key->crc, data, size);
+	key->size += size;
+}
+
+// Look up a complete entry and pin it.
+//   return: entry (release with image_cache_release) or NULL on a miss
+image_cache_entry_t *image_cache_find(image_cache_t *c, const image_cache_key_t *key)
+{
+	image_cache_entry_t *e;
+
+	for (e = c->head; e != NULL; e = e->next)
+	{
+		if (e->complete && key_equal(&e->key, key))
+		{
+			lru_unlink(c, e);
+			lru_push(c, e);
+			e->users++;
+			c->hits++;
+			return e;
+		}
+	}
+	c->misses++;
+	return NULL;
+}
+
+void image_cache_release(image_cache_t *c, image_cache_entry_t *entry)
+{
+	(void)c;
+	if ((entry != NULL) && (entry->users != 0))
+	{
+		entry->users--;
+	}
+}
+
+// Start a new entry.
+//   key:       hash of the source file
+//   page_size: size of the pages that will be added, normally the sector size
+//   b:         builder, page_write_t context for image_cache_page
+//   return:    ERROR_SUCCESS or ERROR_IMAGE_CACHE
+dap_err_t image_cache_begin(image_cache_t *c, const image_cache_key_t *key, uint32_t page_size,
+                            image_cache_builder_t *b)
+{
+	image_cache_entry_t *e;
+
+	b->cache = c;
+	b->entry = NULL;
+	if ((page_size == 0) || ((page_size & (page_size - 1)) != 0) || (page_size > IMAGE_CACHE_CHUNK_SIZE))
+	{
+		return ERROR_INTERNAL;
+	}
+
+	e = (image_cache_entry_t *)cache_alloc(c, sizeof(*e));
+	if (e == NULL)
+	{
+		return ERROR_IMAGE_CACHE;
+	}
+	memset(e, 0, sizeof(*e));
+	e->key       = *key;
+	e->page_size = page_size;
+	e->bytes     = sizeof(*e);
+	e->users     = 1;
+	lru_push(c, e);
+	c->entry_count++;
+	b->entry = e;
+	return ERROR_SUCCESS;
+}
+
+// Add one page, page_write_t compatible.
+//   b:          image_cache_builder_t
+//   addr, size: page_size aligned page from page_asm
+//   return:     ERROR_SUCCESS or ERROR_IMAGE_CACHE (the entry is then dropped)
+dap_err_t image_cache_page(void *b, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	image_cache_builder_t *cb = (image_cache_builder_t *)b;
+	image_cache_entry_t *e = cb->entry;
+	image_cache_chunk_t *chunk;
+	uint32_t capacity, bytes;
+
+	if (e == NULL)
+	{
+		return ERROR_IMAGE_CACHE;
+	}
+	if (size != e->page_size)
+	{
+		image_cache_abort(cb);
+		return ERROR_INTERNAL;
+	}
+
+	chunk = e->last;
+	if ((chunk == NULL) || (chunk->count == chunk->capacity))
+	{
+		capacity = IMAGE_CACHE_CHUNK_SIZE / e->page_size;
+		bytes    = sizeof(*chunk) + capacity * (sizeof(image_cache_page_t) + e->page_size);
+		chunk    = (image_cache_chunk_t *)cache_alloc(cb->cache, bytes);
+		if (chunk == NULL)
+		{
+			image_cache_abort(cb);
+			return ERROR_IMAGE_CACHE;
+		}
+		chunk->next     = NULL;
+		chunk->count    = 0;
+		chunk->capacity = capacity;
+		if (e->last != NULL)
+		{
+			e->last->next = chunk;
+		}
+		else
+		{
+			e->first = chunk;
+		}
+		e->last   = chunk;
+		e->bytes += bytes;
+	}
+
+	chunk->page[chunk->count].addr = addr;
+	chunk->page[chunk->count].crc  = crc32(data, size);
+	memcpy(chunk_data(chunk, e->page_size, chunk->count), data, size);
+	chunk->count++;
+	e->page_count++;
+	return ERROR_SUCCESS;
+}
+
+// Finish an entry. An older entry with the same key is replaced if unused.
+//   return: the entry, still pinned, or NULL if the build failed
+image_cache_entry_t *image_cache_commit(image_cache_builder_t *b)
+{
+	image_cache_t *c = b->cache;
+	image_cache_entry_t *e = b->entry, *old, *next;
+
+	if (e == NULL)
+	{
+		return NULL;
+	}
+
+	for (old = c->head; old != NULL; old = next)
+	{
+		next = old->next;
+		if ((old != e) && old->complete && (old->users == 0) && key_equal(&old->key, &e->key))
+		{
+			lru_unlink(c, old);
+			c->entry_count--;
+			entry_free(c, old);
+		}
+	}
+
+	e->complete = 1;
+	b->entry = NULL;
+	return e;
+}
+
+// Drop an entry under construction.
+void image_cache_abort(image_cache_builder_t *b)
+{
+	if (b->entry != NULL)
+	{
+		lru_unlink(b->cache, b->entry);
+		b->cache->entry_count--;
+		entry_free(b->cache, b->entry);
+		b->entry = NULL;
+	}
+}
+
+// Hand all pages of an entry to a page callback in the order they were added.
+dap_err_t image_cache_replay(const image_cache_entry_t *entry, page_write_t write, void *ctx)
+{
+	const image_cache_chunk_t *chunk;
+	uint32_t i;
+	dap_err_t status;
+
+	for (chunk = entry->first; chunk != NULL; chunk = chunk->next)
+	{
+		for (i = 0; i < chunk->count; i++)
+		{
+			status = write(ctx, chunk->page[i].addr, chunk_data(chunk, entry->page_size, i), entry->page_size);
+			if (status != ERROR_SUCCESS)
+			{
+				return status;
+			}
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+// CRC-32 of the cached page at addr.
+//   return: 1 if the page is part of the image, else 0
+uint8_t image_cache_page_crc(const image_cache_entry_t *entry, uint32_t addr, uint32_t *crc)
+{
+	const image_cache_chunk_t *chunk;
+	uint32_t i;
+
+	addr &= ~(entry->page_size - 1);
+	for (chunk = entry->first; chunk != NULL; chunk = chunk->next)
+	{
+		for (i = 0; i < chunk->count; i++)
+		{
+			if (chunk->page[i].addr == addr)
+			{
+				*crc = chunk->page[i].crc;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
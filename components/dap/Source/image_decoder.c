@@ -0,0 +1,639 @@
+/**
+ * @file    image_decoder.c
+ * @brief   Streaming Intel HEX / S-record / ELF / UF2 / binary image decoder
+ *
+ * All decoders accept input in chunks of any size, keep their state in
+ * image_decoder_t and never buffer more than one text line, one ELF header
+ * or one UF2 block header. Decoded data is passed on as (address, bytes)
+ * records, normally to page_asm_record().
+ *
+ * ELF images are decoded in a single pass: the program header table has to
+ * precede the segment contents (true for all common linkers), PT_LOAD
+ * segments are emitted at their physical (load) address in file order.
+ *
+ * image_decoder_write() returns ERROR_SUCCESS while more input is expected
+ * and ERROR_SUCCESS_DONE once the end of the image has been decoded.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "image_decoder.h"
+
+#define UF2_MAGIC_START0        0x0A324655U
+#define UF2_MAGIC_START1        0x9E5D5157U
+#define UF2_MAGIC_END           0x0AB16F30U
+#define UF2_FLAG_NOT_MAIN_FLASH 0x00000001U
+#define UF2_FLAG_FAMILY_ID      0x00002000U
+
+#define ELF_EHDR_SIZE           52U
+#define ELF_PHDR_SIZE           32U
+#define ELF_PT_LOAD             1U
+
+// Text decoder states
+#define TEXT_IDLE               0U      // waiting for ':' or 'S'
+#define TEXT_TYPE               1U      // S-record type digit
+#define TEXT_DATA               2U      // hex digit pairs up to the end of line
+#define TEXT_NIBBLE             0x80U   // flag in high: no high nibble pending
+
+// ELF decoder states
+#define ELF_HEADER              0U
+#define ELF_PHDRS               1U
+#define ELF_DATA                2U
+
+static uint32_t get16(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int32_t hex_digit(uint8_t c)
+{
+	if ((c >= '0') && (c <= '9'))
+	{
+		return c - '0';
+	}
+	c |= 0x20;
+	if ((c >= 'a') && (c <= 'f'))
+	{
+		return c - 'a' + 10;
+	}
+	return -1;
+}
+
+static const uint8_t utf8_bom[3] = { 0xEF, 0xBB, 0xBF };
+
+static uint8_t is_blank(uint8_t c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+// Format of an image from its first bytes (at least 4 for ELF and UF2). Text
+// images may start with a UTF-8 byte order mark and blank space.
+image_format_t image_detect(const uint8_t *data, uint32_t size)
+{
+	if (size >= 4)
+	{
+		if (get32(data) == 0x464C457FU)
+		{
+			return IMAGE_FORMAT_ELF;
+		}
+		if (get32(data) == UF2_MAGIC_START0)
+		{
+			return IMAGE_FORMAT_UF2;
+		}
+	}
+	if ((size >= sizeof(utf8_bom)) && (memcmp(data, utf8_bom, sizeof(utf8_bom)) == 0))
+	{
+		data += sizeof(utf8_bom);
+		size -= sizeof(utf8_bom);
+	}
+	while ((size != 0) && is_blank(data[0]))
+	{
+		data++;
+		size--;
+	}
+	if (size >= 1)
+	{
+		if (data[0] == ':')
+		{
+			return IMAGE_FORMAT_HEX;
+		}
+		if (data[0] == 'S')
+		{
+			return IMAGE_FORMAT_SREC;
+		}
+	}
+	return IMAGE_FORMAT_UNKNOWN;
+}
+
+// Prepare a decoder.
+//   format:      image format, IMAGE_FORMAT_UNKNOWN to detect from the data
+//   base:        load address of IMAGE_FORMAT_BIN images
+//   record, ctx: record callback, e.g. page_asm_record with a page_asm_t
+void image_decoder_init(image_decoder_t *dec, image_format_t format, uint32_t base,
+                        image_record_t record, void *ctx)
+{
+	memset(dec, 0, sizeof(*dec));
+	dec->format = format;
+	dec->base   = (format == IMAGE_FORMAT_BIN) ? base : 0;
+	dec->record = record;
+	dec->ctx    = ctx;
+}
+
+/*
+ * Intel HEX and Motorola S-record
+ */
+
+static dap_err_t hex_line(image_decoder_t *dec)
+{
+	const uint8_t *line = dec->u.text.line;
+	uint32_t i, n, addr;
+	uint8_t sum = 0;
+
+	n = line[0];
+	if ((dec->u.text.len < 5) || (dec->u.text.len != n + 5))
+	{
+		return ERROR_HEX_PARSER;
+	}
+	for (i = 0; i < dec->u.text.len; i++)
+	{
+		sum += line[i];
+	}
+	if (sum != 0)
+	{
+		return ERROR_HEX_CKSUM;
+	}
+
+	addr = ((uint32_t)line[1] << 8) | line[2];
+	switch (line[3])
+	{
+		case 0x00:      // data
+			return dec->record(dec->ctx, dec->base + addr, &line[4], n);
+
+		case 0x01:      // end of file
+			dec->done = 1;
+			return ERROR_SUCCESS_DONE;
+
+		case 0x02:      // extended segment address
+		case 0x04:      // extended linear address
+			if (n != 2)
+			{
+				return ERROR_HEX_PARSER;
+			}
+			dec->base = (((uint32_t)line[4] << 8) | line[5]) << ((line[3] == 0x02) ? 4 : 16);
+			return ERROR_SUCCESS;
+
+		case 0x03:      // start segment address
+		case 0x05:      // start linear address
+			return ERROR_SUCCESS;
+
+		default:
+			return ERROR_HEX_PARSER;
+	}
+}
+
+static dap_err_t srec_line(image_decoder_t *dec)
+{
+	// Address length by record type S0..S9, 0 = invalid
+	static const uint8_t addr_len[10] = { 2, 2, 3, 4, 0, 2, 3, 4, 3, 2 };
+	const uint8_t *line = dec->u.text.line;
+	uint32_t i, n, alen, addr = 0;
+	uint8_t sum = 0;
+
+	n = line[0];
+	alen = addr_len[dec->u.text.type];
+	if ((alen == 0) || (dec->u.text.len != n + 1) || (n < alen + 1))
+	{
+		return ERROR_HEX_PARSER;
+	}
+	for (i = 0; i < dec->u.text.len; i++)
+	{
+		sum += line[i];
+	}
+	if (sum != 0xFF)
+	{
+		return ERROR_HEX_CKSUM;
+	}
+
+	for (i = 0; i < alen; i++)
+	{
+		addr = (addr << 8) | line[1 + i];
+	}
+
+	switch (dec->u.text.type)
+	{
+		case 1:
+		case 2:
+		case 3:
+			return dec->record(dec->ctx, addr, &line[1 + alen], n - 1 - alen);
+
+		case 7:
+		case 8:
+		case 9:
+			dec->done = 1;
+			return ERROR_SUCCESS_DONE;
+
+		default:        // header, record count
+			return ERROR_SUCCESS;
+	}
+}
+
+static dap_err_t text_write(image_decoder_t *dec, const uint8_t *data, uint32_t size)
+{
+	uint8_t start = (dec->format == IMAGE_FORMAT_HEX) ? ':' : 'S';
+	int32_t digit;
+	dap_err_t status;
+	uint8_t c;
+
+	for (; size != 0; data++, size--, dec->position++)
+	{
+		c = *data;
+
+		if (dec->state == TEXT_IDLE)
+		{
+			if (c == start)
+			{
+				dec->u.text.len  = 0;
+				dec->u.text.high = TEXT_NIBBLE;
+				dec->state = (dec->format == IMAGE_FORMAT_HEX) ? TEXT_DATA : TEXT_TYPE;
+			}
+			else if (!is_blank(c) &&
+			         ((dec->position >= sizeof(utf8_bom)) || (c != utf8_bom[dec->position])))
+			{
+				return ERROR_HEX_PARSER;
+			}
+		}
+		else if (dec->state == TEXT_TYPE)
+		{
+			if ((c < '0') || (c > '9'))
+			{
+				return ERROR_HEX_PARSER;
+			}
+			dec->u.text.type = c - '0';
+			dec->state = TEXT_DATA;
+		}
+		else if ((digit = hex_digit(c)) >= 0)
+		{
+			if (dec->u.text.high == TEXT_NIBBLE)
+			{
+				dec->u.text.high = (uint8_t)digit;
+			}
+			else
+			{
+				if (dec->u.text.len >= IMAGE_LINE_MAX)
+				{
+					return ERROR_HEX_PARSER;
+				}
+				dec->u.text.line[dec->u.text.len++] = (uint8_t)((dec->u.text.high << 4) | digit);
+				dec->u.text.high = TEXT_NIBBLE;
+			}
+		}
+		else if ((c == '\r') || (c == '\n'))
+		{
+			if (dec->u.text.high != TEXT_NIBBLE)
+			{
+				return ERROR_HEX_PARSER;
+			}
+			dec->state = TEXT_IDLE;
+			status = (dec->format == IMAGE_FORMAT_HEX) ? hex_line(dec) : srec_line(dec);
+			if (status != ERROR_SUCCESS)
+			{
+				dec->position++;
+				return status;
+			}
+		}
+		else
+		{
+			return ERROR_HEX_PARSER;
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+/*
+ * ELF (PT_LOAD segments)
+ */
+
+static dap_err_t elf_phdr(image_decoder_t *dec)
+{
+	const uint8_t *ph = dec->u.elf.hdr;
+	image_segment_t seg, *s = dec->u.elf.seg;
+	uint32_t i;
+
+	if ((get32(&ph[0]) != ELF_PT_LOAD) || (get32(&ph[16]) == 0))
+	{
+		return ERROR_SUCCESS;
+	}
+	if (dec->u.elf.seg_count >= IMAGE_ELF_MAX_SEGMENTS)
+	{
+		return ERROR_FD_UNSUPPORTED_UPDATE;
+	}
+
+	seg.offset = get32(&ph[4]);
+	seg.addr   = get32(&ph[12]);
+	seg.size   = get32(&ph[16]);
+	if (seg.offset < dec->u.elf.phoff + dec->u.elf.phnum * ELF_PHDR_SIZE)
+	{
+		// Contents ahead of the program header table cannot be streamed
+		return ERROR_FD_UNSUPPORTED_UPDATE;
+	}
+
+	// Keep segments sorted by file offset
+	for (i = dec->u.elf.seg_count; (i > 0) && (s[i - 1].offset > seg.offset); i--)
+	{
+		s[i] = s[i - 1];
+	}
+	s[i] = seg;
+	dec->u.elf.seg_count++;
+	return ERROR_SUCCESS;
+}
+
+static dap_err_t elf_write(image_decoder_t *dec, const uint8_t *data, uint32_t size)
+{
+	const uint8_t *hdr = dec->u.elf.hdr;
+	image_segment_t *seg;
+	uint32_t n, i;
+	dap_err_t status;
+
+	while (size != 0)
+	{
+		if (dec->state == ELF_HEADER)
+		{
+			n = ELF_EHDR_SIZE - dec->u.elf.hdr_len;
+			n = (n < size) ? n : size;
+			memcpy(&dec->u.elf.hdr[dec->u.elf.hdr_len], data, n);
+			dec->u.elf.hdr_len += n;
+			if (dec->u.elf.hdr_len == ELF_EHDR_SIZE)
+			{
+				// 32-bit little endian with standard program headers
+				if ((hdr[4] != 1U) || (hdr[5] != 1U) || (get16(&hdr[42]) != ELF_PHDR_SIZE) ||
+				    (get32(&hdr[28]) < ELF_EHDR_SIZE) || (get16(&hdr[44]) == 0))
+				{
+					return ERROR_FD_UNSUPPORTED_UPDATE;
+				}
+				dec->u.elf.phoff   = get32(&hdr[28]);
+				dec->u.elf.phnum   = get16(&hdr[44]);
+				dec->u.elf.hdr_len = 0;
+				dec->state = ELF_PHDRS;
+			}
+		}
+		else if (dec->state == ELF_PHDRS)
+		{
+			if (dec->position < dec->u.elf.phoff)
+			{
+				n = dec->u.elf.phoff - dec->position;
+				n = (n < size) ? n : size;
+			}
+			else
+			{
+				n = ELF_PHDR_SIZE - dec->u.elf.hdr_len;
+				n = (n < size) ? n : size;
+				memcpy(&dec->u.elf.hdr[dec->u.elf.hdr_len], data, n);
+				dec->u.elf.hdr_len += n;
+				if (dec->u.elf.hdr_len == ELF_PHDR_SIZE)
+				{
+					dec->u.elf.hdr_len = 0;
+					status = elf_phdr(dec);
+					if (status != ERROR_SUCCESS)
+					{
+						return status;
+					}
+					if (++dec->u.elf.ph_index == dec->u.elf.phnum)
+					{
+						// Segments must not share file contents
+						for (i = 1; i < dec->u.elf.seg_count; i++)
+						{
+							if (dec->u.elf.seg[i].offset < dec->u.elf.seg[i - 1].offset + dec->u.elf.seg[i - 1].size)
+							{
+								return ERROR_FD_UNSUPPORTED_UPDATE;
+							}
+						}
+						dec->state = ELF_DATA;
+						if (dec->u.elf.seg_count == 0)
+						{
+							dec->done = 1;
+							dec->position += n;
+							return ERROR_SUCCESS_DONE;
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			seg = &dec->u.elf.seg[dec->u.elf.seg_index];
+			if (dec->position < seg->offset)
+			{
+				n = seg->offset - dec->position;
+				n = (n < size) ? n : size;
+			}
+			else
+			{
+				n = seg->offset + seg->size - dec->position;
+				n = (n < size) ? n : size;
+				status = dec->record(dec->ctx, seg->addr + (dec->position - seg->offset), data, n);
+				if (status != ERROR_SUCCESS)
+				{
+					return status;
+				}
+				if ((dec->position + n == seg->offset + seg->size) &&
+				    (++dec->u.elf.seg_index == dec->u.elf.seg_count))
+				{
+					dec->done = 1;
+					dec->position += n;
+					return ERROR_SUCCESS_DONE;
+				}
+			}
+		}
+
+		data += n;
+		size -= n;
+		dec->position += n;
+	}
+	return ERROR_SUCCESS;
+}
+
+/*
+ * UF2
+ */
+
+// Family of a UF2 block, 0 when the block carries none. numBlocks and blockNo
+// count the blocks of one family, a file may hold several families back to back.
+static uint32_t uf2_block_family(const uint8_t *hdr)
+{
+	return (get32(&hdr[8]) & UF2_FLAG_FAMILY_ID) ? get32(&hdr[28]) : 0;
+}
+
+static dap_err_t uf2_write(image_decoder_t *dec, const uint8_t *data, uint32_t size)
+{
+	const uint8_t *hdr = dec->u.uf2.hdr;
+	uint32_t n, pos, flags, payload;
+	dap_err_t status;
+
+	while (size != 0)
+	{
+		pos = dec->u.uf2.pos;
+		flags = get32(&hdr[8]);
+		payload = get32(&hdr[16]);
+
+		if (pos < IMAGE_UF2_HEADER_SIZE)
+		{
+			n = IMAGE_UF2_HEADER_SIZE - pos;
+			n = (n < size) ? n : size;
+			memcpy(&dec->u.uf2.hdr[pos], data, n);
+			if (pos + n == IMAGE_UF2_HEADER_SIZE)
+			{
+				if ((get32(&hdr[0]) != UF2_MAGIC_START0) || (get32(&hdr[4]) != UF2_MAGIC_START1) ||
+				    (get32(&hdr[16]) > IMAGE_UF2_PAYLOAD_MAX) || (get32(&hdr[24]) == 0) ||
+				    (get32(&hdr[20]) >= get32(&hdr[24])))
+				{
+					return ERROR_IMAGE_PARSER;
+				}
+
+				// The first block of the wanted family (any family without a
+				// filter, untagged blocks pass a filter) selects what is counted
+				if (!dec->u.uf2.selected &&
+				    ((dec->uf2_family == 0) || (uf2_block_family(hdr) == 0) || (uf2_block_family(hdr) == dec->uf2_family)))
+				{
+					dec->u.uf2.selected = 1;
+					dec->u.uf2.family = uf2_block_family(hdr);
+					dec->u.uf2.num_blocks = get32(&hdr[24]);
+				}
+				dec->u.uf2.match = dec->u.uf2.selected && (uf2_block_family(hdr) == dec->u.uf2.family);
+			}
+		}
+		else if (pos < IMAGE_UF2_HEADER_SIZE + payload)
+		{
+			n = IMAGE_UF2_HEADER_SIZE + payload - pos;
+			n = (n < size) ? n : size;
+			if (dec->u.uf2.match && ((flags & UF2_FLAG_NOT_MAIN_FLASH) == 0))
+			{
+				status = dec->record(dec->ctx, get32(&hdr[12]) + (pos - IMAGE_UF2_HEADER_SIZE), data, n);
+				if (status != ERROR_SUCCESS)
+				{
+					return status;
+				}
+			}
+		}
+		else if (pos < IMAGE_UF2_BLOCK_SIZE - 4)
+		{
+			n = IMAGE_UF2_BLOCK_SIZE - 4 - pos;
+			n = (n < size) ? n : size;
+		}
+		else
+		{
+			n = IMAGE_UF2_BLOCK_SIZE - pos;
+			n = (n < size) ? n : size;
+			memcpy(&dec->u.uf2.tail[pos - (IMAGE_UF2_BLOCK_SIZE - 4)], data, n);
+		}
+
+		data += n;
+		size -= n;
+		dec->position += n;
+		dec->u.uf2.pos += n;
+
+		if (dec->u.uf2.pos == IMAGE_UF2_BLOCK_SIZE)
+		{
+			if (get32(dec->u.uf2.tail) != UF2_MAGIC_END)
+			{
+				return ERROR_IMAGE_PARSER;
+			}
+			dec->u.uf2.pos = 0;
+			if (dec->u.uf2.match && (++dec->u.uf2.blocks >= dec->u.uf2.num_blocks))
+			{
+				dec->done = 1;
+				return ERROR_SUCCESS_DONE;
+			}
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+// Decode the next chunk of an image.
+//   data, size: next input bytes, any length
+//   return:     ERROR_SUCCESS (more input expected), ERROR_SUCCESS_DONE (end of
+//               image, remaining input is ignored) or a decoder / record error
+dap_err_t image_decoder_write(image_decoder_t *dec, const uint8_t *data, uint32_t size)
+{
+	dap_err_t status;
+	uint32_t n;
+
+	if (dec->done)
+	{
+		return ERROR_SUCCESS_DONE;
+	}
+
+	if (dec->format == IMAGE_FORMAT_UNKNOWN)
+	{
+		// Drop a UTF-8 byte order mark and blank space ahead of a text image,
+		// dec->state counts the BOM bytes matched so far
+		while ((size != 0) && (dec->detect_len == 0))
+		{
+			if ((dec->state < sizeof(utf8_bom)) && (data[0] == utf8_bom[dec->state]))
+			{
+				dec->state++;
+			}
+			else if (!is_blank(data[0]))
+			{
+				break;
+			}
+			data++;
+			size--;
+			dec->position++;
+		}
+
+		n = sizeof(dec->detect) - dec->detect_len;
+		n = (n < size) ? n : size;
+		memcpy(&dec->detect[dec->detect_len], data, n);
+		dec->detect_len += n;
+		data += n;
+		size -= n;
+
+		dec->format = image_detect(dec->detect, dec->detect_len);
+		if (dec->format == IMAGE_FORMAT_UNKNOWN)
+		{
+			return (dec->detect_len < sizeof(dec->detect)) ? ERROR_SUCCESS : ERROR_FD_UNSUPPORTED_UPDATE;
+		}
+
+		// Replay the bytes used for detection
+		dec->state = 0;
+		status = image_decoder_write(dec, dec->detect, dec->detect_len);
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+	}
+
+	switch (dec->format)
+	{
+		case IMAGE_FORMAT_HEX:
+		case IMAGE_FORMAT_SREC:
+			return text_write(dec, data, size);
+
+		case IMAGE_FORMAT_ELF:
+			return elf_write(dec, data, size);
+
+		case IMAGE_FORMAT_UF2:
+			return uf2_write(dec, data, size);
+
+		case IMAGE_FORMAT_BIN:
+			if (size == 0)
+			{
+				return ERROR_SUCCESS;
+			}
+			status = dec->record(dec->ctx, dec->base + dec->position, data, size);
+			dec->position += size;
+			return status;
+
+		default:
+			return ERROR_FD_UNSUPPORTED_UPDATE;
+	}
+}
+
+// End of input: decode a last line without line ending and check completeness.
+//   return: ERROR_SUCCESS or ERROR_FILE_BOUNDS for a truncated image
+dap_err_t image_decoder_finish(image_decoder_t *dec)
+{
+	static const uint8_t eol = '\n';
+	dap_err_t status;
+
+	if (!dec->done && ((dec->format == IMAGE_FORMAT_HEX) || (dec->format == IMAGE_FORMAT_SREC)) &&
+	    (dec->state == TEXT_DATA))
+	{
+		status = text_write(dec, &eol, 1);
+		if ((status != ERROR_SUCCESS) && (status != ERROR_SUCCESS_DONE))
+		{
+			return status;
+		}
+	}
+
+	if (dec->format == IMAGE_FORMAT_BIN)
+	{
+		return ERROR_SUCCESS;
+	}
+	return dec->done ? ERROR_SUCCESS : ERROR_FILE_BOUNDS;
+}
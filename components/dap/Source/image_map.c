@@ -0,0 +1,574 @@
+/**
+ * @file    image_map.c
+ * @brief   Read-only mapped image partition
+ *
+ * An image partition holds one image_map_header_t followed by the image file
+ * as uploaded. The header is read once and only header + image are mapped,
+ * with esp_partition_mmap on the probe and mmap(2) on a host, where the
+ * partition name is a file path. Callers get pointers into the mapping:
+ *
+ *  - raw binaries go through image_map_program(), which passes every full
+ *    page straight to the page callback (and from there to
+ *    swd_write_memory); only partial first and last pages are copied
+ *  - HEX / S-record / ELF / UF2 files are handed to image_decoder_write()
+ *    in one call, without a read buffer
+ *  - image_store containers are decoded block by block in place
+ *
+ * RAM use is therefore independent of the image size.
+ *
+ * image_map_writer_t stores a new image sequentially, erasing sectors just
+ * ahead of the data. The header is written last, after a read-back pass for
+ * the CRC, so an interrupted upload never leaves a valid looking image. The
+ * read-back can be split into bounded steps with image_map_writer_verify()
+ * when the caller has to answer within a deadline. Mapped flash must not
+ * be read while the flash cache is disabled, so nothing may write to the
+ * probe flash while a mapping is in use.
+ *
+ * Several sources store images (the USB drive, the upload commands) and
+ * several users map them, from different tasks. Every partition therefore
+ * has an owner record: a writer holds it alone, mappings share it. A
+ * writer or a mapping that cannot get it fails with ERROR_IMAGE_BUSY
+ * instead of waiting, so a long transfer never blocks the other side.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "image_map.h"
+#include "crc.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#endif
+
+#ifndef ESP_PLATFORM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Partition owners, by label (file path on a host)
+typedef struct
+{
+	const char *name;
+	uint8_t writer;
+	uint8_t readers;
+} owner_t;
+
+static owner_t owners[IMAGE_MAP_OWNERS];
+
+#ifdef ESP_PLATFORM
+static portMUX_TYPE owners_lock = portMUX_INITIALIZER_UNLOCKED;
+#define OWNERS_LOCK()   portENTER_CRITICAL(&owners_lock)
+#define OWNERS_UNLOCK() portEXIT_CRITICAL(&owners_lock)
+#else
+#define OWNERS_LOCK()
+#define OWNERS_UNLOCK()
+#endif
+
+// Take a partition as its writer or as one more reader.
+//   return: 1 = taken, 0 = held by a writer, by readers (for a writer) or no free record
+static uint8_t owner_take(const char *name, uint8_t writer)
+{
+	owner_t *o = NULL;
+	uint32_t i;
+	uint8_t ok = 0;
+
+	OWNERS_LOCK();
+	for (i = 0; i < IMAGE_MAP_OWNERS; i++)
+	{
+		if ((owners[i].name != NULL) && (strcmp(owners[i].name, name) == 0))
+		{
+			o = &owners[i];
+			break;
+		}
+		if ((owners[i].name == NULL) && (o == NULL))
+		{
+			o = &owners[i];
+		}
+	}
+	if ((o != NULL) && !o->writer && (!writer || (o->readers == 0)))
+	{
+		o->name = name;
+		if (writer)
+		{
+			o->writer = 1;
+		}
+		else
+		{
+			o->readers++;
+		}
+		ok = 1;
+	}
+	OWNERS_UNLOCK();
+	return ok;
+}
+
+static void owner_give(const char *name, uint8_t writer)
+{
+	uint32_t i;
+
+	OWNERS_LOCK();
+	for (i = 0; i < IMAGE_MAP_OWNERS; i++)
+	{
+		if ((owners[i].name != NULL) && (strcmp(owners[i].name, name) == 0))
+		{
+			if (writer)
+			{
+				owners[i].writer = 0;
+			}
+			else if (owners[i].readers != 0)
+			{
+				owners[i].readers--;
+			}
+			if (!owners[i].writer && (owners[i].readers == 0))
+			{
+				owners[i].name = NULL;
+			}
+			break;
+		}
+	}
+	OWNERS_UNLOCK();
+}
+
+static dap_err_t check_header(const image_map_header_t *h, uint32_t part_size)
+{
+	if ((h->magic != IMAGE_MAP_MAGIC) || (h->version != IMAGE_MAP_VERSION) ||
+	    (part_size < sizeof(*h)) || (h->size > part_size - sizeof(*h)))
+	{
+		return ERROR_IMAGE_STORE;
+	}
+	return ERROR_SUCCESS;
+}
+
+#ifdef ESP_PLATFORM
+
+static dap_err_t map_open(image_map_t *m, const char *name)
+{
+	const esp_partition_t *part;
+	const void *ptr;
+	dap_err_t status;
+
+	part = esp_partition_find_first((esp_partition_type_t)IMAGE_MAP_PART_TYPE,
+	                                (esp_partition_subtype_t)IMAGE_MAP_PART_SUBTYPE, name);
+	if ((part == NULL) || (esp_partition_read(part, 0, &m->header, sizeof(m->header)) != ESP_OK))
+	{
+		return ERROR_FAILURE;
+	}
+	status = check_header(&m->header, part->size);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+
+	if (esp_partition_mmap(part, 0, sizeof(m->header) + m->header.size, ESP_PARTITION_MMAP_DATA,
+	                       &ptr, &m->handle) != ESP_OK)
+	{
+		return ERROR_FAILURE;
+	}
+	m->data = (const uint8_t *)ptr + sizeof(m->header);
+	return ERROR_SUCCESS;
+}
+
+static void map_close(image_map_t *m)
+{
+	if (m->data != NULL)
+	{
+		esp_partition_munmap(m->handle);
+	}
+	m->data = NULL;
+}
+
+
+static dap_err_t writer_open(image_map_writer_t *w, const char *name)
+{
+	w->part = esp_partition_find_first((esp_partition_type_t)IMAGE_MAP_PART_TYPE,
+	                                   (esp_partition_subtype_t)IMAGE_MAP_PART_SUBTYPE, name);
+	if (w->part == NULL)
+	{
+		return ERROR_FAILURE;
+	}
+	w->part_size = w->part->size;
+	return ERROR_SUCCESS;
+}
+
+static uint8_t writer_erase(image_map_writer_t *w, uint32_t offset, uint32_t size)
+{
+	return esp_partition_erase_range(w->part, offset, size) == ESP_OK;
+}
+
+static uint8_t writer_pwrite(image_map_writer_t *w, uint32_t offset, const void *data, uint32_t size)
+{
+	return esp_partition_write(w->part, offset, data, size) == ESP_OK;
+}
+
+static uint8_t writer_pread(image_map_writer_t *w, uint32_t offset, void *data, uint32_t size)
+{
+	return esp_partition_read(w->part, offset, data, size) == ESP_OK;
+}
+
+static void writer_release(image_map_writer_t *w)
+{
+	w->part = NULL;
+}
+
+#else
+
+static dap_err_t map_open(image_map_t *m, const char *name)
+{
+	struct stat st;
+	void *base;
+	int fd;
+	dap_err_t status;
+
+	fd = open(name, O_RDONLY);
+	if (fd < 0)
+	{
+		return ERROR_FAILURE;
+	}
+	if ((fstat(fd, &st) != 0) || (st.st_size > UINT32_MAX) ||
+	    (pread(fd, &m->header, sizeof(m->header), 0) != (ssize_t)sizeof(m->header)))
+	{
+		close(fd);
+		return ERROR_FAILURE;
+	}
+	status = check_header(&m->header, (uint32_t)st.st_size);
+	if (status != ERROR_SUCCESS)
+	{
+		close(fd);
+		return status;
+	}
+
+	m->map_size = sizeof(m->header) + m->header.size;
+	base = mmap(NULL, m->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+	{
+		return ERROR_FAILURE;
+	}
+	m->base = base;
+	m->data = (const uint8_t *)base + sizeof(m->header);
+	return ERROR_SUCCESS;
+}
+
+static void map_close(image_map_t *m)
+{
+	if (m->base != NULL)
+	{
+		munmap(m->base, m->map_size);
+	}
+	m->base = NULL;
+	m->data = NULL;
+}
+
+
+// On a host the partition is a file without a size limit
+static dap_err_t writer_open(image_map_writer_t *w, const char *name)
+{
+	w->fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (w->fd < 0)
+	{
+		return ERROR_FAILURE;
+	}
+	w->part_size = UINT32_MAX;
+	return ERROR_SUCCESS;
+}
+
+static uint8_t writer_erase(image_map_writer_t *w, uint32_t offset, uint32_t size)
+{
+	(void)w;
+	(void)offset;
+	(void)size;
+	return 1;
+}
+
+static uint8_t writer_pwrite(image_map_writer_t *w, uint32_t offset, const void *data, uint32_t size)
+{
+	return pwrite(w->fd, data, size, offset) == (ssize_t)size;
+}
+
+static uint8_t writer_pread(image_map_writer_t *w, uint32_t offset, void *data, uint32_t size)
+{
+	return pread(w->fd, data, size, offset) == (ssize_t)size;
+}
+
+static void writer_release(image_map_writer_t *w)
+{
+	close(w->fd);
+	w->fd = -1;
+}
+
+#endif
+
+// Map an image partition.
+//   name:   partition label on the probe, file path on a host
+//   return: ERROR_SUCCESS, ERROR_FAILURE (no such partition or mapping failed),
+//           ERROR_IMAGE_STORE (no valid image) or ERROR_IMAGE_BUSY (being written)
+dap_err_t image_map_open(image_map_t *m, const char *name)
+{
+	dap_err_t status;
+
+	memset(m, 0, sizeof(*m));
+	if (!owner_take(name, 0))
+	{
+		return ERROR_IMAGE_BUSY;
+	}
+	status = map_open(m, name);
+	if (status == ERROR_SUCCESS)
+	{
+		m->owner = name;
+	}
+	else
+	{
+		map_close(m);
+		owner_give(name, 0);
+	}
+	return status;
+}
+
+// Unmap, also after a failed image_map_open
+void image_map_close(image_map_t *m)
+{
+	map_close(m);
+	if (m->owner != NULL)
+	{
+		owner_give(m->owner, 0);
+		m->owner = NULL;
+	}
+}
+
+// Verify the image CRC. This reads the whole image once.
+dap_err_t image_map_check(const image_map_t *m)
+{
+	return (crc32(m->data, m->header.size) == m->header.crc) ? ERROR_SUCCESS : ERROR_IMAGE_STORE;
+}
+
+// Pointer to size bytes at offset in the image, NULL if out of bounds.
+const uint8_t *image_map_view(const image_map_t *m, uint32_t offset, uint32_t size)
+{
+	if ((m->data == NULL) || (offset > m->header.size) || (size > m->header.size - offset))
+	{
+		return NULL;
+	}
+	return &m->data[offset];
+}
+
+// Hand a raw binary image to a page callback at header.base.
+//   page_size: flash page size, power of 2
+//   fill:      erased value for the unused part of the first and last page
+//   buf:       page_size bytes, used only for partial pages
+//   write:     page callback, called with pointers into the mapping
+dap_err_t image_map_program(const image_map_t *m, uint32_t page_size, uint8_t fill, uint8_t *buf,
+                            page_write_t write, void *ctx)
+{
+	uint32_t offset = 0, addr = m->header.base, page, skip, chunk;
+	dap_err_t status;
+
+	if ((m->data == NULL) || (page_size == 0) || ((page_size & (page_size - 1)) != 0))
+	{
+		return ERROR_INTERNAL;
+	}
+
+	while (offset < m->header.size)
+	{
+		page  = addr & ~(page_size - 1);
+		skip  = addr - page;
+		chunk = page_size - skip;
+		if (chunk > m->header.size - offset)
+		{
+			chunk = m->header.size - offset;
+		}
+
+		if (chunk == page_size)
+		{
+			status = write(ctx, page, &m->data[offset], page_size);
+		}
+		else
+		{
+			memset(buf, fill, page_size);
+			memcpy(&buf[skip], &m->data[offset], chunk);
+			status = write(ctx, page, buf, page_size);
+		}
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+
+		addr   += chunk;
+		offset += chunk;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Erase the partition up to end (partition offset), in blocks where possible
+static dap_err_t writer_reserve(image_map_writer_t *w, uint32_t end)
+{
+	uint32_t size;
+
+	if (end > w->part_size)
+	{
+		return ERROR_FILE_BOUNDS;
+	}
+	while (w->erased < end)
+	{
+		size = IMAGE_MAP_SECTOR_SIZE;
+		if (((w->erased & (IMAGE_MAP_BLOCK_SIZE - 1)) == 0) && (end - w->erased >= IMAGE_MAP_BLOCK_SIZE))
+		{
+			size = IMAGE_MAP_BLOCK_SIZE;
+		}
+		if (!writer_erase(w, w->erased, size))
+		{
+			return ERROR_FAILURE;
+		}
+		w->erased += size;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Close the partition and give it up
+static void writer_done(image_map_writer_t *w)
+{
+	if (w->owner != NULL)
+	{
+		writer_release(w);
+		owner_give(w->owner, 1);
+		w->owner = NULL;
+	}
+}
+
+// Start writing a new image. The old image is invalidated immediately.
+// The partition is held until image_map_writer_close or _abort.
+//   name:   partition label on the probe, file path on a host
+//   return: ERROR_SUCCESS, ERROR_FAILURE (nothing left open) or
+//           ERROR_IMAGE_BUSY (another writer or a mapping holds the
+//           partition, nothing was changed)
+dap_err_t image_map_writer_open(image_map_writer_t *w, const char *name)
+{
+	dap_err_t status;
+
+	memset(w, 0, sizeof(*w));
+	if (!owner_take(name, 1))
+	{
+		return ERROR_IMAGE_BUSY;
+	}
+	status = writer_open(w, name);
+	if (status != ERROR_SUCCESS)
+	{
+		owner_give(name, 1);
+		return status;
+	}
+	w->owner = name;
+	status = writer_reserve(w, sizeof(w->header));
+	if (status != ERROR_SUCCESS)
+	{
+		image_map_writer_abort(w);
+	}
+	return status;
+}
+
+// Append image bytes, image_store_out_t compatible.
+//   data:   NULL reserves size bytes for image_map_writer_patch
+//   return: ERROR_SUCCESS, ERROR_FILE_BOUNDS (partition full) or ERROR_FAILURE
+dap_err_t image_map_writer_write(void *w, const void *data, uint32_t size)
+{
+	image_map_writer_t *mw = (image_map_writer_t *)w;
+	uint32_t pos = sizeof(mw->header) + mw->offset;
+	dap_err_t status;
+
+	if (size > UINT32_MAX - pos)
+	{
+		return ERROR_FILE_BOUNDS;
+	}
+	status = writer_reserve(mw, pos + size);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+	if ((data != NULL) && !writer_pwrite(mw, pos, data, size))
+	{
+		return ERROR_FAILURE;
+	}
+	mw->offset += size;
+	return ERROR_SUCCESS;
+}
+
+// Fill a range that was skipped with image_map_writer_write, e.g. a
+// container header reserved at the start. Each byte may be written once.
+dap_err_t image_map_writer_patch(image_map_writer_t *w, uint32_t offset, const void *data, uint32_t size)
+{
+	if ((offset > w->offset) || (size > w->offset - offset))
+	{
+		return ERROR_INTERNAL;
+	}
+	return writer_pwrite(w, sizeof(w->header) + offset, data, size) ? ERROR_SUCCESS : ERROR_FAILURE;
+}
+
+// Read back up to max more image bytes for the CRC. Nothing may be written
+// or patched once the read-back has started.
+//   return: ERROR_SUCCESS_DONE when the whole image has been read,
+//           ERROR_SUCCESS if bytes remain, or ERROR_FAILURE
+dap_err_t image_map_writer_verify(image_map_writer_t *w, uint32_t max)
+{
+	uint8_t buf[256];
+	uint32_t chunk;
+
+	while ((w->checked < w->offset) && (max != 0))
+	{
+		chunk = w->offset - w->checked;
+		if (chunk > sizeof(buf))
+		{
+			chunk = sizeof(buf);
+		}
+		if (chunk > max)
+		{
+			chunk = max;
+		}
+		if (!writer_pread(w, sizeof(w->header) + w->checked, buf, chunk))
+		{
+			return ERROR_FAILURE;
+		}
+		w->crc      = crc32_continue(w->crc, buf, chunk);
+		w->checked += chunk;
+		max        -= chunk;
+	}
+	return (w->checked == w->offset) ? ERROR_SUCCESS_DONE : ERROR_SUCCESS;
+}
+
+// Finish the read-back for the CRC and write the header, which makes the image valid.
+//   format: image_format_t or IMAGE_MAP_FORMAT_STORE
+//   base:   load address of IMAGE_FORMAT_BIN images
+//   crc_expected: CRC-32 the image must have, NULL if not known
+//   return: ERROR_SUCCESS, ERROR_IMAGE_STORE (CRC mismatch, no header written)
+//           or ERROR_FAILURE
+dap_err_t image_map_writer_close(image_map_writer_t *w, uint16_t format, uint32_t base, const uint32_t *crc_expected)
+{
+	dap_err_t status;
+
+	status = image_map_writer_verify(w, UINT32_MAX);
+	if (status == ERROR_SUCCESS_DONE)
+	{
+		status = ((crc_expected == NULL) || (w->crc == *crc_expected)) ? ERROR_SUCCESS : ERROR_IMAGE_STORE;
+	}
+	if (status == ERROR_SUCCESS)
+	{
+		w->header.magic   = IMAGE_MAP_MAGIC;
+		w->header.version = IMAGE_MAP_VERSION;
+		w->header.format  = format;
+		w->header.base    = base;
+		w->header.size    = w->offset;
+		w->header.crc     = w->crc;
+		if (!writer_pwrite(w, 0, &w->header, sizeof(w->header)))
+		{
+			status = ERROR_FAILURE;
+		}
+	}
+
+	writer_done(w);
+	return status;
+}
+
+// Give up a partially written image; the partition stays without a valid header.
+void image_map_writer_abort(image_map_writer_t *w)
+{
+	writer_done(w);
+}
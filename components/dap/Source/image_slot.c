@@ -0,0 +1,130 @@
+/**
+ * @file    image_slot.c
+ * @brief   Store decoded images as compressed containers on the image partition
+ *
+ * Records from an image decoder are assembled into IMAGE_SLOT_BLOCK_SIZE
+ * pages, compressed block by block with image_store and written to the
+ * image partition while the file is still arriving. The container header
+ * and the partition header are written when the image is complete, so an
+ * aborted transfer leaves no valid image behind.
+ *
+ * open / record / close match virtual_fs_sink_t, so a slot can be used
+ * directly as the destination of the USB drive. Buffers (about 40 KB) are
+ * allocated in open and freed in close.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "image_slot.h"
+
+static void slot_free(image_slot_t *s)
+{
+	free(s->pool);
+	free(s->hash);
+	free(s->comp);
+	s->pool = NULL;
+	s->hash = NULL;
+	s->comp = NULL;
+	s->open = 0;
+}
+
+void image_slot_init(image_slot_t *slot, const char *name)
+{
+	memset(slot, 0, sizeof(*slot));
+	slot->name = (name != NULL) ? name : IMAGE_SLOT_PARTITION;
+}
+
+// Start a new image, replacing the stored one.
+//   format: source format, only informative
+dap_err_t image_slot_open(void *slot, image_format_t format)
+{
+	image_slot_t *s = (image_slot_t *)slot;
+	dap_err_t status;
+
+	(void)format;
+	if (s->open)
+	{
+		image_slot_close(s, ERROR_INTERNAL);
+	}
+
+	s->pool = (uint8_t *)malloc(IMAGE_SLOT_PAGES * IMAGE_SLOT_BLOCK_SIZE);
+	s->hash = (uint16_t *)malloc(IMAGE_STORE_HASH_SIZE * sizeof(uint16_t));
+	s->comp = (uint8_t *)malloc(IMAGE_STORE_BOUND(IMAGE_SLOT_BLOCK_SIZE));
+	if ((s->pool == NULL) || (s->hash == NULL) || (s->comp == NULL))
+	{
+		slot_free(s);
+		return ERROR_IMAGE_CACHE;
+	}
+
+	status = image_map_writer_open(&s->out, s->name);
+	if (status != ERROR_SUCCESS)
+	{
+		slot_free(s);
+		return status;
+	}
+	s->open = 1;
+
+	// Container header is written at the end
+	status = image_map_writer_write(&s->out, NULL, sizeof(image_store_header_t));
+	if (status == ERROR_SUCCESS)
+	{
+		status = image_store_writer_init(&s->store, IMAGE_SLOT_BLOCK_SIZE, image_map_writer_write, &s->out,
+		                                 s->hash, s->comp);
+	}
+	if (status == ERROR_SUCCESS)
+	{
+		status = page_asm_init(&s->pages, s->pool, IMAGE_SLOT_PAGES * IMAGE_SLOT_BLOCK_SIZE,
+		                       IMAGE_SLOT_BLOCK_SIZE, 0xFF, image_store_writer_block, &s->store);
+	}
+	if (status != ERROR_SUCCESS)
+	{
+		image_map_writer_abort(&s->out);
+		slot_free(s);
+	}
+	return status;
+}
+
+// Decoded data, image_record_t compatible.
+dap_err_t image_slot_record(void *slot, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	image_slot_t *s = (image_slot_t *)slot;
+
+	return s->open ? page_asm_record(&s->pages, addr, data, size) : ERROR_INTERNAL;
+}
+
+// Finish the image.
+//   status: result of decoding, the image is only kept on ERROR_SUCCESS
+//   return: final result
+dap_err_t image_slot_close(void *slot, dap_err_t status)
+{
+	image_slot_t *s = (image_slot_t *)slot;
+
+	if (!s->open)
+	{
+		return (status != ERROR_SUCCESS) ? status : ERROR_INTERNAL;
+	}
+
+	if (status == ERROR_SUCCESS)
+	{
+		status = page_asm_flush(&s->pages);
+	}
+	if ((status == ERROR_SUCCESS) && (s->pages.page_count == 0))
+	{
+		status = ERROR_FILE_BOUNDS;     // no data in the image
+	}
+	if (status == ERROR_SUCCESS)
+	{
+		status = image_map_writer_patch(&s->out, 0, &s->store.header, sizeof(s->store.header));
+	}
+
+	if (status == ERROR_SUCCESS)
+	{
+		status = image_map_writer_close(&s->out, IMAGE_MAP_FORMAT_STORE, 0, NULL);
+	}
+	else
+	{
+		image_map_writer_abort(&s->out);
+	}
+	slot_free(s);
+	return status;
+}
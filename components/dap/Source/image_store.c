@@ -0,0 +1,362 @@
+/**
+ * @file    image_store.c
+ * @brief   Compressed image container with per-sector blocks
+ *
+ * An image is stored as a header followed by independent blocks. Each block
+ * covers at most block_size bytes of target address space and never crosses
+ * a block_size boundary, so with block_size equal to the target sector (or
+ * page) size every block decompresses into exactly one upload buffer.
+ *
+ * Blocks are compressed in the LZ4 block format (greedy parser, 4 KB hash
+ * table). Blocks that do not shrink are stored raw. The format is decoded
+ * with bounds checks on every copy, so a corrupt file cannot overrun the
+ * output buffer; the per-block CRC catches everything else.
+ *
+ * Writing: feed the decoded image through a page_asm_t with page_size ==
+ * block_size and image_store_writer_block as page callback. The caller
+ * reserves sizeof(image_store_header_t) bytes at the start of the output and
+ * writes the writer's header there once the image is complete.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "image_store.h"
+#include "crc.h"
+
+#define LZ4_MINMATCH        4U
+#define LZ4_LASTLITERALS    5U      // last bytes of a block are always literals
+#define LZ4_MFLIMIT         12U     // no match may start in the last 12 bytes
+#define LZ4_MAX_OFFSET      0xFFFFU
+
+static uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static uint32_t lz4_hash(uint32_t seq)
+{
+	return (seq * 2654435761U) >> (32U - IMAGE_STORE_HASH_BITS);
+}
+
+// Append a length continuation (bytes of 255 plus remainder)
+static uint8_t *lz4_length(uint8_t *op, const uint8_t *end, uint32_t len)
+{
+	for (; len >= 255U; len -= 255U)
+	{
+		if (op >= end)
+		{
+			return NULL;
+		}
+		*op++ = 255U;
+	}
+	if (op >= end)
+	{
+		return NULL;
+	}
+	*op++ = (uint8_t)len;
+	return op;
+}
+
+// Append one sequence: literals, then a match unless match_len is 0
+static uint8_t *lz4_sequence(uint8_t *op, const uint8_t *end, const uint8_t *lit, uint32_t lit_len,
+                             uint32_t offset, uint32_t match_len)
+{
+	uint8_t *token;
+	uint32_t ml = (match_len != 0) ? (match_len - LZ4_MINMATCH) : 0;
+
+	if (op >= end)
+	{
+		return NULL;
+	}
+	token = op++;
+	*token = (uint8_t)(((lit_len < 15U) ? lit_len : 15U) << 4);
+	if ((lit_len >= 15U) && ((op = lz4_length(op, end, lit_len - 15U)) == NULL))
+	{
+		return NULL;
+	}
+	if ((uint32_t)(end - op) < lit_len)
+	{
+		return NULL;
+	}
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	if (match_len == 0)
+	{
+		return op;
+	}
+
+	if ((end - op) < 2)
+	{
+		return NULL;
+	}
+	*op++ = (uint8_t)offset;
+	*op++ = (uint8_t)(offset >> 8);
+	*token |= (uint8_t)((ml < 15U) ? ml : 15U);
+	if ((ml >= 15U) && ((op = lz4_length(op, end, ml - 15U)) == NULL))
+	{
+		return NULL;
+	}
+	return op;
+}
+
+// Compress one block (LZ4 block format).
+//   src, size:     raw data, size <= IMAGE_STORE_BLOCK_MAX
+//   dst, dst_size: output buffer
+//   hash:          scratch table of IMAGE_STORE_HASH_SIZE entries
+//   return:        compressed size, 0 if the output does not fit (store raw)
+uint32_t image_store_compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size, uint16_t *hash)
+{
+	const uint8_t *end = dst + dst_size;
+	uint8_t *op = dst;
+	uint32_t ip = 0, anchor = 0, ref, len, h, seq;
+
+	if (size > IMAGE_STORE_BLOCK_MAX)
+	{
+		return 0;
+	}
+	memset(hash, 0, IMAGE_STORE_HASH_SIZE * sizeof(uint16_t));
+
+	while ((size > LZ4_MFLIMIT) && (ip + LZ4_MFLIMIT <= size))
+	{
+		seq = read32(&src[ip]);
+		h = lz4_hash(seq);
+		ref = hash[h];
+		hash[h] = (uint16_t)ip;
+
+		if ((ref >= ip) || (ip - ref > LZ4_MAX_OFFSET) || (read32(&src[ref]) != seq))
+		{
+			ip++;
+			continue;
+		}
+
+		len = LZ4_MINMATCH;
+		while ((ip + len < size - LZ4_LASTLITERALS) && (src[ref + len] == src[ip + len]))
+		{
+			len++;
+		}
+
+		op = lz4_sequence(op, end, &src[anchor], ip - anchor, ip - ref, len);
+		if (op == NULL)
+		{
+			return 0;
+		}
+		ip += len;
+		anchor = ip;
+	}
+
+	op = lz4_sequence(op, end, &src[anchor], size - anchor, 0, 0);
+	return (op == NULL) ? 0 : (uint32_t)(op - dst);
+}
+
+// Decompress one block (LZ4 block format).
+//   src, src_size: compressed data
+//   dst, dst_size: output buffer
+//   size:          number of bytes written to dst
+//   return:        ERROR_SUCCESS or ERROR_IMAGE_STORE on malformed input
+dap_err_t image_store_decompress(const uint8_t *src, uint32_t src_size, uint8_t *dst, uint32_t dst_size,
+                                 uint32_t *size)
+{
+	const uint8_t *ip = src, *iend = src + src_size;
+	uint32_t op = 0, len, offset;
+	uint8_t token, b;
+
+	while (ip < iend)
+	{
+		token = *ip++;
+
+		// Literals
+		len = token >> 4;
+		if (len == 15U)
+		{
+			do
+			{
+				if (ip >= iend)
+				{
+					return ERROR_IMAGE_STORE;
+				}
+				b = *ip++;
+				len += b;
+			} while (b == 255U);
+		}
+		if (((uint32_t)(iend - ip) < len) || (dst_size - op < len))
+		{
+			return ERROR_IMAGE_STORE;
+		}
+		memcpy(&dst[op], ip, len);
+		ip += len;
+		op += len;
+
+		// The last sequence has no match
+		if (ip == iend)
+		{
+			break;
+		}
+
+		if ((iend - ip) < 2)
+		{
+			return ERROR_IMAGE_STORE;
+		}
+		offset = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+		ip += 2;
+		if ((offset == 0) || (offset > op))
+		{
+			return ERROR_IMAGE_STORE;
+		}
+
+		len = token & 0x0FU;
+		if (len == 15U)
+		{
+			do
+			{
+				if (ip >= iend)
+				{
+					return ERROR_IMAGE_STORE;
+				}
+				b = *ip++;
+				len += b;
+			} while (b == 255U);
+		}
+		len += LZ4_MINMATCH;
+		if (dst_size - op < len)
+		{
+			return ERROR_IMAGE_STORE;
+		}
+
+		// Byte copy, source and destination may overlap
+		for (; len != 0; len--, op++)
+		{
+			dst[op] = dst[op - offset];
+		}
+	}
+
+	*size = op;
+	return ERROR_SUCCESS;
+}
+
+// Prepare a writer.
+//   block_size: power of 2 up to IMAGE_STORE_BLOCK_MAX, normally the sector size
+//   out, ctx:   sequential output, starting after the reserved header
+//   hash:       IMAGE_STORE_HASH_SIZE entries of scratch
+//   comp:       IMAGE_STORE_BOUND(block_size) bytes of scratch
+dap_err_t image_store_writer_init(image_store_writer_t *w, uint32_t block_size, image_store_out_t out, void *ctx,
+                                  uint16_t *hash, uint8_t *comp)
+{
+	memset(w, 0, sizeof(*w));
+
+	if ((out == NULL) || (hash == NULL) || (comp == NULL) || (block_size == 0) ||
+	    (block_size > IMAGE_STORE_BLOCK_MAX) || ((block_size & (block_size - 1)) != 0))
+	{
+		return ERROR_INTERNAL;
+	}
+
+	w->header.magic      = IMAGE_STORE_MAGIC;
+	w->header.version    = IMAGE_STORE_VERSION;
+	w->header.block_size = block_size;
+	w->out  = out;
+	w->ctx  = ctx;
+	w->hash = hash;
+	w->comp = comp;
+	return ERROR_SUCCESS;
+}
+
+// Compress and append one block, page_write_t compatible.
+//   w:          image_store_writer_t
+//   addr, size: block_size aligned block from page_asm
+dap_err_t image_store_writer_block(void *w, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	image_store_writer_t *sw = (image_store_writer_t *)w;
+	image_store_block_t block;
+	const uint8_t *payload = sw->comp;
+	dap_err_t status;
+
+	if ((size == 0) || (size > sw->header.block_size) ||
+	    ((addr & (sw->header.block_size - 1)) + size > sw->header.block_size))
+	{
+		return ERROR_INTERNAL;
+	}
+
+	block.addr      = addr;
+	block.raw_size  = size;
+	block.crc       = crc32(data, size);
+	block.comp_size = image_store_compress(data, size, sw->comp, size - 1, sw->hash);
+	if (block.comp_size == 0)
+	{
+		block.comp_size = size | IMAGE_STORE_STORED;
+		payload = data;
+	}
+
+	status = sw->out(sw->ctx, &block, sizeof(block));
+	if (status == ERROR_SUCCESS)
+	{
+		status = sw->out(sw->ctx, payload, block.comp_size & ~IMAGE_STORE_STORED);
+	}
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+
+	sw->header.block_count++;
+	sw->header.raw_size  += size;
+	sw->header.data_size += sizeof(block) + (block.comp_size & ~IMAGE_STORE_STORED);
+	sw->header.crc        = crc32_continue(sw->header.crc, data, size);
+	return ERROR_SUCCESS;
+}
+
+// Validate a container header.
+dap_err_t image_store_check_header(const image_store_header_t *header)
+{
+	if ((header->magic != IMAGE_STORE_MAGIC) || (header->version != IMAGE_STORE_VERSION) ||
+	    (header->block_size == 0) || (header->block_size > IMAGE_STORE_BLOCK_MAX) ||
+	    ((header->block_size & (header->block_size - 1)) != 0))
+	{
+		return ERROR_IMAGE_STORE;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Validate a block header before its payload is read.
+dap_err_t image_store_check_block(const image_store_header_t *header, const image_store_block_t *block)
+{
+	uint32_t comp = block->comp_size & ~IMAGE_STORE_STORED;
+
+	if ((block->raw_size == 0) || (block->raw_size > header->block_size) ||
+	    ((block->addr & (header->block_size - 1)) + block->raw_size > header->block_size) ||
+	    ((block->comp_size & IMAGE_STORE_STORED) ? (comp != block->raw_size) :
+	                                               (comp > IMAGE_STORE_BOUND(header->block_size))))
+	{
+		return ERROR_IMAGE_STORE;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Decode a block payload and verify its CRC.
+//   block:    validated block header
+//   src:      payload (comp_size bytes)
+//   dst:      output buffer of dst_size >= raw_size bytes
+//   return:   ERROR_SUCCESS or ERROR_IMAGE_STORE
+dap_err_t image_store_decode_block(const image_store_block_t *block, const uint8_t *src, uint8_t *dst,
+                                   uint32_t dst_size)
+{
+	uint32_t size;
+
+	if (dst_size < block->raw_size)
+	{
+		return ERROR_IMAGE_STORE;
+	}
+
+	if (block->comp_size & IMAGE_STORE_STORED)
+	{
+		memcpy(dst, src, block->raw_size);
+	}
+	else if ((image_store_decompress(src, block->comp_size, dst, block->raw_size, &size) != ERROR_SUCCESS) ||
+	         (size != block->raw_size))
+	{
+		return ERROR_IMAGE_STORE;
+	}
+
+	return (crc32(dst, block->raw_size) == block->crc) ? ERROR_SUCCESS : ERROR_IMAGE_STORE;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file    itm_decoder.c
+ * @brief   Streaming ITM/DWT packet decoder with port and packet filtering
+ *
+ * Parses the ITM packet stream (ARMv7-M ARM, appendix D4) byte by byte, so
+ * SWO data can be fed in whatever chunks the capture delivers. Source
+ * packets of the selected stimulus ports and DWT discriminators become
+ * compact records, everything else (sync, unselected ports, extension and
+ * reserved packets) is dropped on the probe. Payload of the text ports is
+ * handed out as plain characters, for the target's printf channel.
+ *
+ * A local timestamp packet follows the packets it applies to and carries
+ * the time since the previous one. Once the target sends them, records are
+ * held back until the next local timestamp so they are stamped with the
+ * right time; a full queue or an overflow releases them early. Global
+ * timestamps are merged from GTS1 (bits 25:0) and GTS2 (bits 63:26).
+ *
+ * Pure C without SDK dependencies, so recorded SWO captures can be fed to
+ * it on the host.
+ */
+
+#include <string.h>
+#include "itm_decoder.h"
+
+// Parser states
+#define ITM_HEADER      0U
+#define ITM_PAYLOAD     1U
+#define ITM_LOCAL       2U
+#define ITM_GLOBAL1     3U
+#define ITM_GLOBAL2     4U
+#define ITM_EXTENSION   5U
+
+#define GLOBAL1_MASK    0x03FFFFFFU
+
+static uint32_t put_leb128(uint8_t *p, uint64_t value)
+{
+	uint32_t n = 0U;
+
+	while (value >= 0x80U)
+	{
+		p[n++] = (uint8_t)(value | 0x80U);
+		value >>= 7;
+	}
+	p[n++] = (uint8_t)value;
+	return n;
+}
+
+// Encode and output one record
+//   value: payload, or the global timestamp for ITM_RECORD_GLOBAL
+static void emit(itm_decoder_t *dec, uint8_t header, uint64_t value)
+{
+	uint8_t rec[ITM_RECORD_MAX];
+	uint32_t n = 1U;
+	uint64_t delta;
+	uint32_t size;
+
+	rec[0] = header;
+	if (dec->filter.flags & ITM_FILTER_TIMESTAMP)
+	{
+		delta = dec->local - dec->emitted;
+		n += put_leb128(&rec[n], (delta > 0xFFFFFFFFU) ? 0xFFFFFFFFU : delta);
+		dec->emitted = dec->local;
+	}
+	if (header == ITM_RECORD_GLOBAL)
+	{
+		n += put_leb128(&rec[n], value);
+	}
+	else
+	{
+		size = header >> 6;
+		size = (size == 3U) ? 4U : size;
+		while (size--)
+		{
+			rec[n++] = (uint8_t)value;
+			value >>= 8;
+		}
+	}
+	dec->record(dec->ctx, rec, n);
+}
+
+static void release(itm_decoder_t *dec)
+{
+	uint32_t n;
+
+	for (n = 0U; n < dec->pending; n++)
+	{
+		emit(dec, dec->queue[n].header, dec->queue[n].value);
+	}
+	dec->pending = 0U;
+}
+
+// Queue a record until its local timestamp arrives
+static void submit(itm_decoder_t *dec, uint8_t header, uint32_t value)
+{
+	if (!dec->timed)
+	{
+		emit(dec, header, value);
+		return;
+	}
+	if (dec->pending == ITM_DECODER_PENDING)
+	{
+		release(dec);
+	}
+	dec->queue[dec->pending].header = header;
+	dec->queue[dec->pending].value = value;
+	dec->pending++;
+}
+
+static void put_text(itm_decoder_t *dec, uint32_t value, uint32_t size)
+{
+	uint8_t c;
+
+	while (size--)
+	{
+		c = (uint8_t)value;
+		value >>= 8;
+		if (c == 0U)
+		{
+			continue;
+		}
+		dec->line[dec->length++] = c;
+		if ((c == '\n') || (dec->length == sizeof(dec->line)))
+		{
+			dec->text(dec->ctx, dec->line, dec->length);
+			dec->length = 0U;
+		}
+	}
+}
+
+static void source_packet(itm_decoder_t *dec)
+{
+	uint32_t id = dec->header >> 3;
+	uint32_t bit = 1UL << id;
+	uint8_t hw = dec->header & 0x04U;
+	uint8_t used = 0U;
+
+	dec->packets++;
+	if (hw)
+	{
+		if (dec->filter.hardware & bit)
+		{
+			submit(dec, ITM_RECORD_HEADER(dec->need, hw, id), dec->value);
+			used = 1U;
+		}
+	}
+	else if (dec->page == 0U)
+	{
+		if ((dec->filter.text & bit) && (dec->text != NULL))
+		{
+			put_text(dec, dec->value, dec->need);
+			used = 1U;
+		}
+		if (dec->filter.ports & bit)
+		{
+			submit(dec, ITM_RECORD_HEADER(dec->need, hw, id), dec->value);
+			used = 1U;
+		}
+	}
+	if (!used)
+	{
+		dec->filtered++;
+	}
+}
+
+static void local_timestamp(itm_decoder_t *dec, uint32_t delta)
+{
+	dec->timed = 1U;
+	dec->local += delta;
+	release(dec);
+}
+
+static void global_timestamp(itm_decoder_t *dec, uint8_t high)
+{
+	uint64_t mask;
+
+	if (high)
+	{
+		dec->global = (dec->global & GLOBAL1_MASK) | ((uint64_t)dec->value << 26);
+		return;
+	}
+	// Only the low order bits that changed are sent
+	mask = (dec->count < 4U) ? ((1UL << (7U * dec->count)) - 1U) : GLOBAL1_MASK;
+	dec->global = (dec->global & ~mask) | (dec->value & mask);
+	if (dec->filter.flags & ITM_FILTER_GLOBAL)
+	{
+		release(dec);
+		emit(dec, ITM_RECORD_GLOBAL, dec->global);
+	}
+}
+
+static void header_byte(itm_decoder_t *dec, uint8_t b)
+{
+	if (b == 0x00U)
+	{
+		if (dec->zeros < 5U)
+		{
+			dec->zeros++;
+		}
+		return;
+	}
+	if ((b == 0x80U) && (dec->zeros == 5U))
+	{
+		// Synchronization packet
+		dec->zeros = 0U;
+		dec->page = 0U;
+		return;
+	}
+	dec->zeros = 0U;
+
+	dec->header = b;
+	dec->value = 0U;
+	dec->count = 0U;
+	if (b & 0x03U)
+	{
+		// Instrumentation (bit 2 clear) or hardware source packet
+		dec->need = ((b & 0x03U) == 3U) ? 4U : (b & 0x03U);
+		dec->state = ITM_PAYLOAD;
+	}
+	else if (b == 0x70U)
+	{
+		dec->overflows++;
+		release(dec);
+		if (dec->filter.flags & ITM_FILTER_OVERFLOW)
+		{
+			emit(dec, ITM_RECORD_OVERFLOW, 0U);
+		}
+	}
+	else if ((b & 0x0FU) == 0x00U)
+	{
+		if ((b & 0xC0U) == 0xC0U)
+		{
+			dec->state = ITM_LOCAL;                 // LTS1, delta in continuation bytes
+		}
+		else if (!(b & 0x80U))
+		{
+			local_timestamp(dec, (b >> 4) & 0x07U); // LTS2, delta in the header
+		}
+	}
+	else if (b == 0x94U)
+	{
+		dec->state = ITM_GLOBAL1;
+	}
+	else if (b == 0xB4U)
+	{
+		dec->state = ITM_GLOBAL2;
+	}
+	else if ((b & 0x0BU) == 0x08U)
+	{
+		dec->value = (b >> 4) & 0x07U;
+		if (b & 0x80U)
+		{
+			dec->state = ITM_EXTENSION;
+		}
+		else if (!(b & 0x04U))
+		{
+			dec->page = (uint8_t)dec->value;        // stimulus port page
+		}
+	}
+	// Reserved headers are skipped
+}
+
+static void payload_byte(itm_decoder_t *dec, uint8_t b)
+{
+	switch (dec->state)
+	{
+	case ITM_PAYLOAD:
+		dec->value |= (uint32_t)b << (8U * dec->count);
+		if (++dec->count == dec->need)
+		{
+			dec->state = ITM_HEADER;
+			source_packet(dec);
+		}
+		break;
+
+	case ITM_EXTENSION:
+		// Extension value continues above the 3 header bits
+		if (dec->count < 4U)
+		{
+			dec->value |= (uint32_t)(b & 0x7FU) << (3U + 7U * dec->count);
+		}
+		dec->count++;
+		if (!(b & 0x80U))
+		{
+			dec->state = ITM_HEADER;
+			if (!(dec->header & 0x04U))
+			{
+				dec->page = (uint8_t)dec->value;
+			}
+		}
+		break;
+
+	default:
+		// LTS1 and GTS: 7 bits per byte, bit 7 set on all but the last
+		if (dec->count < 4U)
+		{
+			dec->value |= (uint32_t)(b & 0x7FU) << (7U * dec->count);
+		}
+		dec->count++;
+		if (!(b & 0x80U) || (dec->count == 6U))
+		{
+			if (dec->state == ITM_LOCAL)
+			{
+				local_timestamp(dec, dec->value);
+			}
+			else
+			{
+				global_timestamp(dec, dec->state == ITM_GLOBAL2);
+			}
+			dec->state = ITM_HEADER;
+		}
+		break;
+	}
+}
+
+// Initialize the decoder
+//   filter: packets to forward
+//   record: receives compact records, may be called several times per decode
+//   text:   receives the characters of the text ports, NULL to drop them
+//   ctx:    passed to record and text
+void itm_decoder_init(itm_decoder_t *dec, const itm_filter_t *filter, itm_output_t record,
+                      itm_output_t text, void *ctx)
+{
+	memset(dec, 0, sizeof(*dec));
+	dec->filter = *filter;
+	dec->record = record;
+	dec->text = text;
+	dec->ctx = ctx;
+}
+
+// Decode a chunk of the SWO stream
+// Packets may span chunks. Pending text is output at the end of the chunk,
+// records waiting for their timestamp are kept.
+//   data: raw SWO bytes
+//   num:  number of bytes
+void itm_decoder_decode(itm_decoder_t *dec, const uint8_t *data, uint32_t num)
+{
+	uint8_t b;
+
+	while (num--)
+	{
+		b = *data++;
+		if (dec->state == ITM_HEADER)
+		{
+			header_byte(dec, b);
+		}
+		else
+		{
+			payload_byte(dec, b);
+		}
+	}
+
+	if (dec->length != 0U)
+	{
+		dec->text(dec->ctx, dec->line, dec->length);
+		dec->length = 0U;
+	}
+}
+
+// Output the records still waiting for a local timestamp
+void itm_decoder_flush(itm_decoder_t *dec)
+{
+	release(dec);
+}
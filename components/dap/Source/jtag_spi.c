@@ -0,0 +1,254 @@
+/**
+ * @file    jtag_spi.c
+ * @brief   JTAG shift engine on the SPI peripheral
+ *
+ * Runs of TCK cycles with constant TMS (the bodies of Shift-IR and Shift-DR,
+ * DAP_JTAG_Sequence) are clocked by a GPSPI host in mode 0, LSB first: MOSI
+ * sets TDI before each rising TCK edge and MISO samples TDO on it, the same
+ * timing as JTAG_CYCLE_TDIO. TMS stays a GPIO and is set by the caller.
+ *
+ * The bus is initialised without pins. For every shift TCK, TDI and TDO of
+ * the debug port bound to the calling task are routed to the SPI signals
+ * through the GPIO matrix and handed back to GPIO afterwards, so the
+ * bit-banged code and the engine share the pins and every port with JTAG
+ * pins can use the engine, one at a time.
+ *
+ * SCLK idles low. Taking TCK over from GPIO (high) gives a falling edge and
+ * TCK is handed back with its GPIO level cleared; the TAP only acts on
+ * rising edges, so neither transition moves it.
+ *
+ * A shift has a fixed cost (routing, the polling transaction) that
+ * bit-banging does not pay, so it only wins on long enough runs at a JTAG
+ * clock the GPIO loop cannot reach. jtag_spi_worth() compares both; the
+ * fixed cost is measured on every shift and starts from a dry transaction
+ * at init.
+ */
+
+#include <string.h>
+#include "driver/spi_master.h"
+#include "soc/spi_periph.h"
+#include "soc/gpio_sig_map.h"
+#include "esp_rom_gpio.h"
+#include "esp_cpu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "jtag_spi.h"
+#include "DAP_config.h"
+#include "DAP.h"
+
+#if (DAP_JTAG != 0) && (JTAG_SPI != 0)
+
+static SemaphoreHandle_t jtag_spi_lock;
+static spi_device_handle_t jtag_spi_dev;
+static uint32_t jtag_spi_clock;             // clock of jtag_spi_dev in Hz
+static uint32_t jtag_spi_cost = JTAG_SPI_SHIFT_US * (CPU_CLOCK / 1000000U);  // fixed CPU cycles of a shift
+
+// Fixed part of a shift that took cycles CPU cycles for bits TCK cycles.
+// Called with jtag_spi_lock held.
+static uint32_t jtag_spi_fixed(uint32_t cycles, uint32_t bits)
+{
+	uint32_t clocked = bits * (CPU_CLOCK / jtag_spi_clock);
+
+	return (cycles > clocked) ? (cycles - clocked) : 0;
+}
+
+// Create the device for a clock, replacing the one for another clock.
+// Called with jtag_spi_lock held.
+static uint8_t jtag_spi_device(uint32_t clock)
+{
+	spi_device_interface_config_t dev = {
+		.mode = 0,
+		.clock_speed_hz = (int)clock,
+		.spics_io_num = -1,
+		.queue_size = 1,
+		.flags = SPI_DEVICE_BIT_LSBFIRST,
+	};
+
+	if (jtag_spi_dev != NULL)
+	{
+		if (clock == jtag_spi_clock)
+		{
+			return 1;
+		}
+		spi_device_release_bus(jtag_spi_dev);
+		spi_bus_remove_device(jtag_spi_dev);
+		jtag_spi_dev = NULL;
+	}
+
+	if (spi_bus_add_device(JTAG_SPI_HOST, &dev, &jtag_spi_dev) != ESP_OK)
+	{
+		jtag_spi_dev = NULL;
+		return 0;
+	}
+	// Polling transactions only, keep the bus for the lifetime of the device
+	spi_device_acquire_bus(jtag_spi_dev, portMAX_DELAY);
+	jtag_spi_clock = clock;
+	return 1;
+}
+
+// Initialise the SPI bus. Without it every scan is bit-banged.
+void jtag_spi_init(void)
+{
+	spi_bus_config_t bus = {
+		.mosi_io_num = -1,
+		.miso_io_num = -1,
+		.sclk_io_num = -1,
+		.quadwp_io_num = -1,
+		.quadhd_io_num = -1,
+		.max_transfer_sz = JTAG_SPI_MAX_BITS / 8U,
+	};
+
+	if (jtag_spi_lock != NULL)
+	{
+		return;
+	}
+	if (spi_bus_initialize(JTAG_SPI_HOST, &bus, SPI_DMA_DISABLED) != ESP_OK)
+	{
+		return;
+	}
+	jtag_spi_lock = xSemaphoreCreateMutex();
+	if (jtag_spi_lock == NULL)
+	{
+		spi_bus_free(JTAG_SPI_HOST);
+		return;
+	}
+
+	// Dry transaction, nothing routed to the pins yet: a first measure of the fixed cost
+	if (jtag_spi_device(JTAG_SPI_MAX_CLOCK))
+	{
+		spi_transaction_t t;
+		uint8_t dummy = 0;
+		uint32_t start;
+
+		memset(&t, 0, sizeof(t));
+		t.length = 8;
+		t.tx_buffer = &dummy;
+		start = esp_cpu_get_cycle_count();
+		if (spi_device_polling_transmit(jtag_spi_dev, &t) == ESP_OK)
+		{
+			jtag_spi_cost = jtag_spi_fixed(esp_cpu_get_cycle_count() - start, 8);
+		}
+	}
+}
+
+// Engine usable on the debug port bound to the calling task
+uint8_t jtag_spi_available(void)
+{
+	return (jtag_spi_lock != NULL) && PORT_JTAG_AVAILABLE();
+}
+
+// Whether shifting bits TCK cycles through the engine beats bit-banging them
+// at the current clock of the calling port.
+//   bits:   run length
+//   return: 1 = use jtag_spi_shift, 0 = bit-bang
+uint8_t jtag_spi_worth(uint32_t bits)
+{
+	uint32_t gpio_clock;
+	uint32_t spi_clock;
+	uint32_t saved;
+
+	if ((bits == 0) || (bits > JTAG_SPI_MAX_BITS) || !jtag_spi_available())
+	{
+		return 0;
+	}
+
+	gpio_clock = (DAP_Data.actual_clock != 0) ? DAP_Data.actual_clock : DAP_Data.nominal_clock;
+	spi_clock = (DAP_Data.nominal_clock < JTAG_SPI_MAX_CLOCK) ? DAP_Data.nominal_clock : JTAG_SPI_MAX_CLOCK;
+	if ((gpio_clock == 0) || (spi_clock <= gpio_clock))
+	{
+		return 0;
+	}
+
+	// CPU cycles saved per bit against the fixed cost of one shift
+	saved = (CPU_CLOCK / gpio_clock) - (CPU_CLOCK / spi_clock);
+	return (bits * saved) > jtag_spi_cost;
+}
+
+// Clock bits TCK cycles with the current TMS level.
+//   tdi:    TDI bits, LSB first
+//   tdo:    captured TDO bits, LSB first, (bits + 7) / 8 bytes; NULL = not captured
+//   bits:   1 .. JTAG_SPI_MAX_BITS
+//   return: 1 when shifted, 0 if nothing was clocked (bit-bang instead)
+uint8_t jtag_spi_shift(const uint8_t *tdi, uint8_t *tdo, uint32_t bits)
+{
+	const spi_signal_conn_t *sig = &spi_periph_signal[JTAG_SPI_HOST];
+	spi_transaction_t t;
+	uint32_t clock;
+	uint32_t start;
+	uint8_t ok;
+
+	if ((bits == 0) || (bits > JTAG_SPI_MAX_BITS) || !jtag_spi_available())
+	{
+		return 0;
+	}
+
+	clock = DAP_Data.nominal_clock;
+	if (clock > JTAG_SPI_MAX_CLOCK)
+	{
+		clock = JTAG_SPI_MAX_CLOCK;
+	}
+
+	xSemaphoreTake(jtag_spi_lock, portMAX_DELAY);
+	if (!jtag_spi_device(clock))
+	{
+		xSemaphoreGive(jtag_spi_lock);
+		return 0;
+	}
+
+	memset(&t, 0, sizeof(t));
+	t.length = bits;
+	t.rxlength = (tdo != NULL) ? bits : 0;
+	t.tx_buffer = tdi;
+	t.rx_buffer = tdo;
+
+	start = esp_cpu_get_cycle_count();
+	esp_rom_gpio_connect_out_signal(DAP_Pins->swclk, sig->spiclk_out, false, false);
+	esp_rom_gpio_connect_out_signal(DAP_Pins->tdi, sig->spid_out, false, false);
+	esp_rom_gpio_connect_in_signal(DAP_Pins->tdo, sig->spiq_in, false);
+
+	ok = (spi_device_polling_transmit(jtag_spi_dev, &t) == ESP_OK);
+
+	WRITE_PERI_REG(GPIO_OUT_W1TC_REG, DAP_Pins->swclk_mask);
+	esp_rom_gpio_connect_out_signal(DAP_Pins->swclk, SIG_GPIO_OUT_IDX, false, false);
+	esp_rom_gpio_connect_out_signal(DAP_Pins->tdi, SIG_GPIO_OUT_IDX, false, false);
+	if (ok)
+	{
+		// Moving average over 8 shifts
+		jtag_spi_cost -= jtag_spi_cost >> 3;
+		jtag_spi_cost += jtag_spi_fixed(esp_cpu_get_cycle_count() - start, bits) >> 3;
+	}
+	xSemaphoreGive(jtag_spi_lock);
+
+	if (ok && (tdo != NULL) && (bits & 7U))
+	{
+		tdo[bits >> 3] &= (uint8_t)((1U << (bits & 7U)) - 1U);
+	}
+	return ok;
+}
+
+#else
+
+void jtag_spi_init(void)
+{
+}
+
+uint8_t jtag_spi_available(void)
+{
+	return 0;
+}
+
+uint8_t jtag_spi_worth(uint32_t bits)
+{
+	(void)bits;
+	return 0;
+}
+
+uint8_t jtag_spi_shift(const uint8_t *tdi, uint8_t *tdo, uint32_t bits)
+{
+	(void)tdi;
+	(void)tdo;
+	(void)bits;
+	return 0;
+}
+
+#endif
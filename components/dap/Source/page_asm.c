@@ -0,0 +1,177 @@
+/**
+ * @file    page_asm.c
+ * @brief   Zero-allocation flash page assembler
+ *
+ * Records from the image decoders arrive in file order with arbitrary
+ * addresses and lengths. The assembler collects them in a small pool of
+ * page-aligned buffers supplied by the caller, fills uncovered bytes with
+ * the erased value and hands out complete pages in ascending address order.
+ *
+ * When all buffers are in use the lowest page is written. Records that fall
+ * into a page that has already been written cannot be merged any more and
+ * are rejected with ERROR_OOO_SECTOR; a pool of a few pages absorbs the
+ * usual reordering (vector table or version block at the end of a HEX file,
+ * ELF segments slightly out of address order).
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "page_asm.h"
+
+// Prepare an assembler.
+//   pool, pool_size: page buffers, at least one page
+//   page_size:       flash page size, power of 2
+//   fill:            erased value for gaps
+//   write, ctx:      page callback
+//   return:          ERROR_SUCCESS or ERROR_INTERNAL on bad parameters
+dap_err_t page_asm_init(page_asm_t *pa, uint8_t *pool, uint32_t pool_size, uint32_t page_size,
+                        uint8_t fill, page_write_t write, void *ctx)
+{
+	memset(pa, 0, sizeof(*pa));
+
+	if ((pool == NULL) || (write == NULL) || (page_size == 0) ||
+	    ((page_size & (page_size - 1)) != 0) || (pool_size < page_size))
+	{
+		return ERROR_INTERNAL;
+	}
+
+	pa->pool       = pool;
+	pa->page_size  = page_size;
+	pa->slot_count = pool_size / page_size;
+	if (pa->slot_count > PAGE_ASM_MAX_SLOTS)
+	{
+		pa->slot_count = PAGE_ASM_MAX_SLOTS;
+	}
+	pa->fill  = fill;
+	pa->write = write;
+	pa->ctx   = ctx;
+	return ERROR_SUCCESS;
+}
+
+// Write the lowest buffered page and release its slot
+static dap_err_t page_asm_flush_lowest(page_asm_t *pa, uint32_t *slot)
+{
+	uint32_t i, low = PAGE_ASM_MAX_SLOTS;
+	dap_err_t status;
+
+	for (i = 0; i < pa->slot_count; i++)
+	{
+		if (pa->slot_used[i] && ((low == PAGE_ASM_MAX_SLOTS) || (pa->slot_addr[i] < pa->slot_addr[low])))
+		{
+			low = i;
+		}
+	}
+	if (low == PAGE_ASM_MAX_SLOTS)
+	{
+		return ERROR_SUCCESS_DONE;
+	}
+
+	status = pa->write(pa->ctx, pa->slot_addr[low], &pa->pool[low * pa->page_size], pa->page_size);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+
+	pa->slot_used[low] = 0;
+	pa->flushed = pa->slot_addr[low] + pa->page_size;
+	pa->page_count++;
+	*slot = low;
+	return ERROR_SUCCESS;
+}
+
+// Buffer holding the page at addr, allocated and filled on first use
+static dap_err_t page_asm_slot(page_asm_t *pa, uint32_t page, uint8_t **buf)
+{
+	uint32_t i, slot = PAGE_ASM_MAX_SLOTS;
+	dap_err_t status;
+
+	for (i = 0; i < pa->slot_count; i++)
+	{
+		if (pa->slot_used[i])
+		{
+			if (pa->slot_addr[i] == page)
+			{
+				*buf = &pa->pool[i * pa->page_size];
+				return ERROR_SUCCESS;
+			}
+		}
+		else if (slot == PAGE_ASM_MAX_SLOTS)
+		{
+			slot = i;
+		}
+	}
+
+	if ((pa->page_count != 0) && (page < pa->flushed))
+	{
+		return ERROR_OOO_SECTOR;
+	}
+
+	if (slot == PAGE_ASM_MAX_SLOTS)
+	{
+		status = page_asm_flush_lowest(pa, &slot);
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+		if (page < pa->flushed)
+		{
+			return ERROR_OOO_SECTOR;
+		}
+	}
+
+	pa->slot_used[slot] = 1;
+	pa->slot_addr[slot] = page;
+	*buf = &pa->pool[slot * pa->page_size];
+	memset(*buf, pa->fill, pa->page_size);
+	return ERROR_SUCCESS;
+}
+
+// Add a record, image_record_t compatible.
+//   pa:         page_asm_t
+//   addr, size: target address range of the record
+//   data:       record contents
+//   return:     ERROR_SUCCESS, ERROR_OOO_SECTOR or the page callback error
+dap_err_t page_asm_record(void *pa, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	page_asm_t *p = (page_asm_t *)pa;
+	uint32_t page, offset, chunk;
+	uint8_t *buf;
+	dap_err_t status;
+
+	while (size != 0)
+	{
+		page   = addr & ~(p->page_size - 1);
+		offset = addr - page;
+		chunk  = p->page_size - offset;
+		if (chunk > size)
+		{
+			chunk = size;
+		}
+
+		status = page_asm_slot(p, page, &buf);
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+		memcpy(&buf[offset], data, chunk);
+
+		addr += chunk;
+		data += chunk;
+		size -= chunk;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Write all buffered pages in ascending address order.
+dap_err_t page_asm_flush(page_asm_t *pa)
+{
+	uint32_t slot;
+	dap_err_t status;
+
+	do
+	{
+		status = page_asm_flush_lowest(pa, &slot);
+	} while (status == ERROR_SUCCESS);
+
+	return (status == ERROR_SUCCESS_DONE) ? ERROR_SUCCESS : status;
+}
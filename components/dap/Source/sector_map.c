@@ -0,0 +1,286 @@
+/**
+ * @file    sector_map.c
+ * @brief   Mixed-geometry flash sector map and erase planning
+ *
+ * The FlashDevice sector table is run-length encoded: each entry gives a
+ * sector size and the address where sectors of that size start, the run
+ * extends to the next entry or the end of the device. The map keeps these
+ * runs sorted by address, merges neighbouring runs of equal sector size and
+ * numbers all sectors map-wide. Several devices (main flash, OTP, EEPROM, ...)
+ * can be added to one map as long as they do not overlap.
+ *
+ * Address lookup is a binary search over the runs plus one division, with a
+ * hint for the common case of sequential addresses in the same run. Erase
+ * planning turns the address ranges of an image into the minimal list of
+ * contiguous sector extents.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "sector_map.h"
+
+// Index of the last run starting at or below addr, -1 if there is none
+static int32_t run_find(const sector_map_t *map, uint32_t addr)
+{
+	int32_t lo = 0, hi = (int32_t)map->run_count - 1, mid;
+
+	while (lo <= hi)
+	{
+		mid = (lo + hi) / 2;
+		if (map->runs[mid].start <= addr)
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid - 1;
+		}
+	}
+	return hi;
+}
+
+// Run containing addr, NULL if addr is not mapped
+static const sector_run_t *run_lookup(sector_map_t *map, uint32_t addr)
+{
+	const sector_run_t *run;
+	int32_t i;
+
+	if (map->hint < map->run_count)
+	{
+		run = &map->runs[map->hint];
+		if ((addr >= run->start) && (addr < run->end))
+		{
+			return run;
+		}
+	}
+
+	i = run_find(map, addr);
+	if ((i < 0) || (addr >= map->runs[i].end))
+	{
+		return NULL;
+	}
+	map->hint = (uint32_t)i;
+	return &map->runs[i];
+}
+
+// Merge neighbouring runs of equal sector size and renumber the sectors
+static void run_normalize(sector_map_t *map)
+{
+	uint32_t i, n = 0, first = 0;
+
+	for (i = 0; i < map->run_count; i++)
+	{
+		if ((n > 0) && (map->runs[n - 1].end == map->runs[i].start) &&
+		    (map->runs[n - 1].size == map->runs[i].size))
+		{
+			map->runs[n - 1].end = map->runs[i].end;
+			continue;
+		}
+		map->runs[n++] = map->runs[i];
+	}
+	map->run_count = n;
+
+	for (i = 0; i < map->run_count; i++)
+	{
+		map->runs[i].first = first;
+		first += (map->runs[i].end - map->runs[i].start) / map->runs[i].size;
+	}
+	map->sector_count = first;
+	map->hint = 0;
+}
+
+// Run i of a FlashDevice sector table
+static uint8_t table_run(const sector_info_t *sectors, uint32_t count, uint32_t i,
+                         uint32_t dev_start, uint32_t dev_size, sector_run_t *run)
+{
+	run->start = sectors[i].start;
+	run->end   = (i + 1 < count) ? sectors[i + 1].start : dev_start + dev_size;
+	run->size  = sectors[i].size;
+	run->first = 0;
+
+	return ((run->size != 0) && (run->start >= dev_start) && (run->start < run->end) &&
+	        (((run->end - run->start) % run->size) == 0));
+}
+
+void sector_map_init(sector_map_t *map)
+{
+	memset(map, 0, sizeof(*map));
+}
+
+// Add the sector table of one flash device.
+//   sectors:   FlashDevice runs (absolute start address, sector size), ascending
+//   count:     number of runs
+//   dev_start: device start address (DevAdr)
+//   dev_size:  device size (szDev)
+//   return:    ERROR_SUCCESS, or ERROR_SECTOR_MAP with the map unchanged
+dap_err_t sector_map_add(sector_map_t *map, const sector_info_t *sectors, uint32_t count,
+                         uint32_t dev_start, uint32_t dev_size)
+{
+	sector_run_t run;
+	int32_t k;
+	uint32_t i;
+
+	if ((sectors == NULL) || (count == 0) || (dev_size == 0) ||
+	    (map->run_count + count > SECTOR_MAP_MAX_RUNS))
+	{
+		return ERROR_SECTOR_MAP;
+	}
+
+	// Validate all runs first so a bad table leaves the map untouched
+	for (i = 0; i < count; i++)
+	{
+		if (!table_run(sectors, count, i, dev_start, dev_size, &run))
+		{
+			return ERROR_SECTOR_MAP;
+		}
+		k = run_find(map, run.start);
+		if (((k >= 0) && (map->runs[k].end > run.start)) ||
+		    (((uint32_t)(k + 1) < map->run_count) && (map->runs[k + 1].start < run.end)))
+		{
+			return ERROR_SECTOR_MAP;
+		}
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		table_run(sectors, count, i, dev_start, dev_size, &run);
+		k = run_find(map, run.start) + 1;
+		memmove(&map->runs[k + 1], &map->runs[k], (map->run_count - (uint32_t)k) * sizeof(sector_run_t));
+		map->runs[k] = run;
+		map->run_count++;
+	}
+
+	run_normalize(map);
+	return ERROR_SUCCESS;
+}
+
+// Add the sector table of a loaded flash algorithm.
+dap_err_t sector_map_add_algo(sector_map_t *map, const flash_algo_t *algo)
+{
+	return sector_map_add(map, algo->sectors, algo->sector_count, algo->device.start, algo->device.size);
+}
+
+// Find the sector containing an address.
+//   addr:   address to look up
+//   sector: sector start and size (optional)
+//   index:  map-wide sector index (optional)
+//   return: 1 = found, 0 = address not mapped
+uint8_t sector_map_lookup(sector_map_t *map, uint32_t addr, sector_info_t *sector, uint32_t *index)
+{
+	const sector_run_t *run = run_lookup(map, addr);
+	uint32_t n;
+
+	if (run == NULL)
+	{
+		return 0;
+	}
+
+	n = (addr - run->start) / run->size;
+	if (sector != NULL)
+	{
+		sector->start = run->start + n * run->size;
+		sector->size  = run->size;
+	}
+	if (index != NULL)
+	{
+		*index = run->first + n;
+	}
+	return 1;
+}
+
+// Sectors covering an address range.
+//   addr, size: address range, size > 0
+//   extent:     covering sectors
+//   return:     ERROR_SUCCESS, or ERROR_ALGO_MISSING if part of the range is not mapped
+dap_err_t sector_map_range(sector_map_t *map, uint32_t addr, uint32_t size, sector_extent_t *extent)
+{
+	sector_info_t first, last;
+	uint32_t first_index, last_index;
+	int32_t r, r_last;
+
+	if ((size == 0) || (addr + (size - 1) < addr) ||
+	    !sector_map_lookup(map, addr, &first, &first_index) ||
+	    !sector_map_lookup(map, addr + (size - 1), &last, &last_index))
+	{
+		return ERROR_ALGO_MISSING;
+	}
+
+	// Runs in between must be contiguous, a gap has no flash algorithm
+	r_last = run_find(map, last.start);
+	for (r = run_find(map, first.start); r < r_last; r++)
+	{
+		if (map->runs[r].end != map->runs[r + 1].start)
+		{
+			return ERROR_ALGO_MISSING;
+		}
+	}
+
+	extent->start = first.start;
+	extent->size  = (last.start + last.size) - first.start;
+	extent->first = first_index;
+	extent->count = last_index - first_index + 1;
+	return ERROR_SUCCESS;
+}
+
+// Minimal erase plan for a set of address ranges.
+//   ranges:      ranges to be programmed, sorted in place by address
+//   range_count: number of ranges, empty ranges are ignored
+//   plan:        contiguous sector extents in ascending order
+//   plan_size:   capacity of plan
+//   plan_count:  number of extents in plan
+//   return:      ERROR_SUCCESS, ERROR_ALGO_MISSING or ERROR_SECTOR_MAP (plan too small)
+dap_err_t sector_map_plan(sector_map_t *map, sector_range_t *ranges, uint32_t range_count,
+                          sector_extent_t *plan, uint32_t plan_size, uint32_t *plan_count)
+{
+	sector_extent_t extent, *prev;
+	sector_range_t range;
+	uint32_t i, j, n = 0;
+	dap_err_t status;
+
+	*plan_count = 0;
+
+	// Images have few ranges, insertion sort is sufficient
+	for (i = 1; i < range_count; i++)
+	{
+		range = ranges[i];
+		for (j = i; (j > 0) && (ranges[j - 1].start > range.start); j--)
+		{
+			ranges[j] = ranges[j - 1];
+		}
+		ranges[j] = range;
+	}
+
+	for (i = 0; i < range_count; i++)
+	{
+		if (ranges[i].size == 0)
+		{
+			continue;
+		}
+		status = sector_map_range(map, ranges[i].start, ranges[i].size, &extent);
+		if (status != ERROR_SUCCESS)
+		{
+			return status;
+		}
+
+		// Overlapping or adjacent extents are merged
+		prev = (n > 0) ? &plan[n - 1] : NULL;
+		if ((prev != NULL) && (extent.start <= prev->start + prev->size))
+		{
+			if (extent.first + extent.count > prev->first + prev->count)
+			{
+				prev->count = extent.first + extent.count - prev->first;
+				prev->size  = extent.start + extent.size - prev->start;
+			}
+			continue;
+		}
+
+		if (n >= plan_size)
+		{
+			return ERROR_SECTOR_MAP;
+		}
+		plan[n++] = extent;
+	}
+
+	*plan_count = n;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,526 @@
+/**
+ * @file    swd_autotune.c
+ * @brief   SWD clock auto-tuning: find the fastest reliable SWCLK per target
+ *
+ * The target is identified at SWD_AUTOTUNE_SAFE_CLOCK, then SWCLK is ramped
+ * through swd_autotune_steps[]. At each step the debug port is re-initialised,
+ * IDCODE is compared with the value read at the safe clock and a RAM pattern is
+ * written and read back. The first step with a parity, protocol or data error
+ * ends the ramp, the gap to the last clean step is bisected and the result minus
+ * SWD_AUTOTUNE_MARGIN is cached per IDCODE in RAM and NVS.
+ *
+ * A tune takes far longer than one DAP command may, so the vendor command runs it
+ * in a task (swd_autotune_start) that holds the port for one frequency check at a
+ * time; swd_autotune_clock is the blocking form for callers that own the port.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "nvs.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "swd_autotune.h"
+#include "swd_host.h"
+#include "dap_handle.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "debug_cm.h"
+
+#define SWD_AUTOTUNE_NVS_NAMESPACE "swd_clk"
+#define SWD_AUTOTUNE_TASK_PRIORITY 3
+
+// Tune phases, one swd_autotune_step() each (ramp and bisection: per frequency)
+#define TUNE_IDENTIFY   0U
+#define TUNE_RAMP       1U
+#define TUNE_BISECT     2U
+#define TUNE_FINISH     3U
+
+typedef struct
+{
+	uint32_t idcode;
+	uint32_t clock;
+} TUNE_ENTRY;
+
+typedef struct
+{
+	uint8_t phase;
+	uint8_t tuned;                  // clock found by tuning, not taken from the cache
+	uint32_t ram_addr;
+	uint32_t max_clock;
+	uint32_t flags;
+	uint32_t idcode;
+	uint32_t good;                  // highest clean clock
+	uint32_t bad;                   // lowest failing clock, 0 = none yet
+	uint32_t step;                  // ramp index or bisection count
+	uint32_t clock;                 // result
+	uint8_t saved[SWD_AUTOTUNE_PATTERN_SIZE];
+} TUNE_CONTEXT;
+
+// Background tune of one debug port
+typedef struct
+{
+	volatile uint8_t state;         // SWD_AUTOTUNE_IDLE ..
+	volatile uint32_t clock;
+	uint32_t port;
+	TUNE_CONTEXT ctx;
+} TUNE_JOB;
+
+static const char *TAG = "SWD_TUNE";
+
+// Frequency ramp in Hz, ascending
+static const uint32_t swd_autotune_steps[] = {
+	1000000, 2000000, 4000000, 6000000, 8000000, 10000000,
+	12000000, 15000000, 20000000, 24000000, 30000000, 40000000,
+};
+
+#define TUNE_STEP_COUNT (sizeof(swd_autotune_steps) / sizeof(swd_autotune_steps[0]))
+
+// Both port engines tune and look up, the cache is locked (NVS locks itself)
+static TUNE_ENTRY tune_cache[SWD_AUTOTUNE_CACHE_SIZE];
+static uint32_t tune_cache_next;
+static portMUX_TYPE tune_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+static TUNE_JOB tune_jobs[DAP_PORT_COUNT];
+
+static void swd_autotune_set_clock(uint32_t clock)
+{
+	DAP_Data.nominal_clock = clock;
+	Set_DAP_Clock_Delay(clock);
+}
+
+static void swd_autotune_key(char *key, size_t len, uint32_t idcode)
+{
+	snprintf(key, len, "%08" PRIx32, idcode);
+}
+
+static void swd_autotune_cache_put(uint32_t idcode, uint32_t clock)
+{
+	uint32_t i;
+
+	portENTER_CRITICAL(&tune_cache_lock);
+	for (i = 0; i < SWD_AUTOTUNE_CACHE_SIZE; i++)
+	{
+		if ((tune_cache[i].clock != 0) && (tune_cache[i].idcode == idcode))
+		{
+			tune_cache[i].clock = clock;
+			portEXIT_CRITICAL(&tune_cache_lock);
+			return;
+		}
+	}
+
+	tune_cache[tune_cache_next].idcode = idcode;
+	tune_cache[tune_cache_next].clock = clock;
+	tune_cache_next = (tune_cache_next + 1) % SWD_AUTOTUNE_CACHE_SIZE;
+	portEXIT_CRITICAL(&tune_cache_lock);
+}
+
+static void swd_autotune_store(uint32_t idcode, uint32_t clock)
+{
+	nvs_handle_t nvs;
+	char key[16];
+
+	swd_autotune_cache_put(idcode, clock);
+
+	if (nvs_open(SWD_AUTOTUNE_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK)
+	{
+		return;
+	}
+
+	swd_autotune_key(key, sizeof(key), idcode);
+	if (nvs_set_u32(nvs, key, clock) == ESP_OK)
+	{
+		nvs_commit(nvs);
+	}
+	nvs_close(nvs);
+}
+
+// Look up a previously tuned clock for the target with this IDCODE.
+uint8_t swd_autotune_lookup(uint32_t idcode, uint32_t *clock)
+{
+	nvs_handle_t nvs;
+	char key[16];
+	esp_err_t err;
+	uint32_t i, cached = 0;
+
+	portENTER_CRITICAL(&tune_cache_lock);
+	for (i = 0; i < SWD_AUTOTUNE_CACHE_SIZE; i++)
+	{
+		if ((tune_cache[i].clock != 0) && (tune_cache[i].idcode == idcode))
+		{
+			cached = tune_cache[i].clock;
+			break;
+		}
+	}
+	portEXIT_CRITICAL(&tune_cache_lock);
+
+	if (cached != 0)
+	{
+		*clock = cached;
+		return 1;
+	}
+
+	if (nvs_open(SWD_AUTOTUNE_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK)
+	{
+		return 0;
+	}
+
+	swd_autotune_key(key, sizeof(key), idcode);
+	err = nvs_get_u32(nvs, key, clock);
+	nvs_close(nvs);
+
+	if ((err != ESP_OK) || (*clock == 0))
+	{
+		return 0;
+	}
+
+	swd_autotune_cache_put(idcode, *clock);
+	return 1;
+}
+
+// Drop the cached clock for this IDCODE, e.g. after a cable change.
+void swd_autotune_forget(uint32_t idcode)
+{
+	nvs_handle_t nvs;
+	char key[16];
+	uint32_t i;
+
+	portENTER_CRITICAL(&tune_cache_lock);
+	for (i = 0; i < SWD_AUTOTUNE_CACHE_SIZE; i++)
+	{
+		if (tune_cache[i].idcode == idcode)
+		{
+			tune_cache[i].clock = 0;
+		}
+	}
+	portEXIT_CRITICAL(&tune_cache_lock);
+
+	if (nvs_open(SWD_AUTOTUNE_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK)
+	{
+		return;
+	}
+
+	swd_autotune_key(key, sizeof(key), idcode);
+	if (nvs_erase_key(nvs, key) == ESP_OK)
+	{
+		nvs_commit(nvs);
+	}
+	nvs_close(nvs);
+}
+
+static uint32_t swd_autotune_pattern(uint32_t pass, uint32_t i, uint32_t addr)
+{
+	switch (pass & 3)
+	{
+	case 0:
+		return (i & 1) ? 0xAAAAAAAA : 0x55555555;  // alternating bits
+
+	case 1:
+		return 1U << (i & 31);                     // walking one
+
+	case 2:
+		return ~(1U << (i & 31));                  // walking zero
+
+	default:
+		return addr + (i * 4);                     // address as data
+	}
+}
+
+// Check the link at the current clock: IDCODE, RAM pattern and sticky errors.
+static uint8_t swd_autotune_check(uint32_t idcode, uint32_t ram_addr)
+{
+	uint32_t pattern[SWD_AUTOTUNE_PATTERN_SIZE / 4];
+	uint32_t readback[SWD_AUTOTUNE_PATTERN_SIZE / 4];
+	uint32_t id, status, pass, i;
+
+	if (!swd_init_debug())
+	{
+		return 0;
+	}
+
+	if (!swd_read_dp(DP_IDCODE, &id) || (id != idcode))
+	{
+		return 0;
+	}
+
+	for (pass = 0; pass < SWD_AUTOTUNE_PASSES; pass++)
+	{
+		for (i = 0; i < (SWD_AUTOTUNE_PATTERN_SIZE / 4); i++)
+		{
+			pattern[i] = swd_autotune_pattern(pass, i, ram_addr);
+		}
+
+		if (!swd_write_memory(ram_addr, (uint8_t *)pattern, sizeof(pattern)))
+		{
+			return 0;
+		}
+
+		if (!swd_read_memory(ram_addr, (uint8_t *)readback, sizeof(readback)))
+		{
+			return 0;
+		}
+
+		if (memcmp(pattern, readback, sizeof(pattern)) != 0)
+		{
+			return 0;
+		}
+	}
+
+	if (!swd_read_dp(DP_CTRL_STAT, &status))
+	{
+		return 0;
+	}
+
+	return (status & (STICKYORUN | STICKYERR | WDATAERR)) ? 0 : 1;
+}
+
+// Set up a tune, swd_autotune_step() then runs it.
+static void swd_autotune_begin(TUNE_CONTEXT *ctx, uint32_t ram_addr, uint32_t max_clock, uint32_t flags)
+{
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->phase = TUNE_IDENTIFY;
+	ctx->ram_addr = ram_addr;
+	ctx->max_clock = max_clock;
+	ctx->flags = flags;
+}
+
+// Run one step of a tune: the identification, one frequency check or the final
+// re-sync. A step is a few SWD transfers, the caller owns the port.
+//   return: SWD_AUTOTUNE_BUSY until the tune ends, then SWD_AUTOTUNE_DONE with
+//           ctx->clock applied or SWD_AUTOTUNE_FAILED
+static uint8_t swd_autotune_step(TUNE_CONTEXT *ctx)
+{
+	uint32_t mid;
+
+	switch (ctx->phase)
+	{
+	case TUNE_IDENTIFY:
+		// Identify the target at the safe clock
+		swd_autotune_set_clock(SWD_AUTOTUNE_SAFE_CLOCK);
+
+		if (!swd_init_debug() || !swd_read_dp(DP_IDCODE, &ctx->idcode))
+		{
+			return SWD_AUTOTUNE_FAILED;
+		}
+
+		if (!(ctx->flags & SWD_AUTOTUNE_FORCE) && swd_autotune_lookup(ctx->idcode, &ctx->clock))
+		{
+			swd_autotune_set_clock(ctx->clock);
+			return swd_init_debug() ? SWD_AUTOTUNE_DONE : SWD_AUTOTUNE_FAILED;
+		}
+
+		if (!swd_read_memory(ctx->ram_addr, ctx->saved, sizeof(ctx->saved)))
+		{
+			return SWD_AUTOTUNE_FAILED;
+		}
+
+		if (!swd_autotune_check(ctx->idcode, ctx->ram_addr))
+		{
+			swd_autotune_set_clock(SWD_AUTOTUNE_SAFE_CLOCK);
+			if (swd_init_debug())
+			{
+				swd_write_memory(ctx->ram_addr, ctx->saved, sizeof(ctx->saved));
+			}
+			return SWD_AUTOTUNE_FAILED;
+		}
+
+		ctx->good = SWD_AUTOTUNE_SAFE_CLOCK;
+		ctx->bad = 0;
+		ctx->step = 0;
+		ctx->phase = TUNE_RAMP;
+		return SWD_AUTOTUNE_BUSY;
+
+	case TUNE_RAMP:
+		// Ramp until the first error
+		while ((ctx->step < TUNE_STEP_COUNT) && (swd_autotune_steps[ctx->step] <= ctx->good))
+		{
+			ctx->step++;
+		}
+
+		if ((ctx->step == TUNE_STEP_COUNT) ||
+		    ((ctx->max_clock != 0) && (swd_autotune_steps[ctx->step] > ctx->max_clock)))
+		{
+			ctx->step = 0;
+			ctx->phase = TUNE_BISECT;
+			return SWD_AUTOTUNE_BUSY;
+		}
+
+		swd_autotune_set_clock(swd_autotune_steps[ctx->step]);
+
+		if (swd_autotune_check(ctx->idcode, ctx->ram_addr))
+		{
+			ctx->good = swd_autotune_steps[ctx->step++];
+		}
+		else
+		{
+			ctx->bad = swd_autotune_steps[ctx->step];
+			ctx->step = 0;
+			ctx->phase = TUNE_BISECT;
+		}
+		return SWD_AUTOTUNE_BUSY;
+
+	case TUNE_BISECT:
+		// Back off: bisect between the last clean and the first failing step
+		if ((ctx->bad == 0) || (ctx->step == SWD_AUTOTUNE_BISECT_STEPS))
+		{
+			ctx->phase = TUNE_FINISH;
+			return SWD_AUTOTUNE_BUSY;
+		}
+
+		mid = ctx->good + ((ctx->bad - ctx->good) / 2);
+		swd_autotune_set_clock(mid);
+
+		if (swd_autotune_check(ctx->idcode, ctx->ram_addr))
+		{
+			ctx->good = mid;
+		}
+		else
+		{
+			ctx->bad = mid;
+		}
+		ctx->step++;
+		return SWD_AUTOTUNE_BUSY;
+
+	default:
+		ctx->clock = (ctx->good / 100) * (100 - SWD_AUTOTUNE_MARGIN);
+
+		if (ctx->clock < SWD_AUTOTUNE_SAFE_CLOCK)
+		{
+			ctx->clock = SWD_AUTOTUNE_SAFE_CLOCK;
+		}
+
+		// Re-sync at the tuned clock and restore the RAM window
+		swd_autotune_set_clock(ctx->clock);
+
+		if (!swd_init_debug() || !swd_write_memory(ctx->ram_addr, ctx->saved, sizeof(ctx->saved)))
+		{
+			swd_autotune_set_clock(SWD_AUTOTUNE_SAFE_CLOCK);
+			if (swd_init_debug())
+			{
+				swd_write_memory(ctx->ram_addr, ctx->saved, sizeof(ctx->saved));
+			}
+			return SWD_AUTOTUNE_FAILED;
+		}
+
+		ctx->tuned = 1;
+		ESP_LOGI(TAG, "target %08" PRIx32 ": SWCLK %" PRIu32 " Hz (clean up to %" PRIu32 " Hz)",
+		         ctx->idcode, ctx->clock, ctx->good);
+		return SWD_AUTOTUNE_DONE;
+	}
+}
+
+// Find the fastest reliable SWCLK for the connected target and apply it.
+// Blocks for the whole tune, the caller owns the port (offline programming).
+//   ram_addr:  target RAM window (SWD_AUTOTUNE_PATTERN_SIZE bytes) used for the
+//              pattern check, its content is restored afterwards
+//   max_clock: upper bound in Hz, 0 = no limit
+//   flags:     SWD_AUTOTUNE_FORCE to ignore a cached result
+//   clock:     tuned clock in Hz
+uint8_t swd_autotune_clock(uint32_t ram_addr, uint32_t max_clock, uint32_t flags, uint32_t *clock)
+{
+	TUNE_CONTEXT ctx;
+	uint8_t state;
+
+	swd_autotune_begin(&ctx, ram_addr, max_clock, flags);
+
+	do
+	{
+		state = swd_autotune_step(&ctx);
+	} while (state == SWD_AUTOTUNE_BUSY);
+
+	if (state != SWD_AUTOTUNE_DONE)
+	{
+		return 0;
+	}
+
+	if (ctx.tuned)
+	{
+		swd_autotune_store(ctx.idcode, ctx.clock);
+	}
+
+	*clock = ctx.clock;
+	return 1;
+}
+
+static void swd_autotune_task(void *arg)
+{
+	TUNE_JOB *job = (TUNE_JOB *)arg;
+	uint8_t state = SWD_AUTOTUNE_BUSY;
+
+	// The port is held for one step at a time, the DAP task answers status
+	// polls in between
+	while (state == SWD_AUTOTUNE_BUSY)
+	{
+		if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK)
+		{
+			state = SWD_AUTOTUNE_FAILED;
+			break;
+		}
+		state = swd_autotune_step(&job->ctx);
+		dap_handle_port_give(job->port);
+	}
+
+	// The NVS commit does not need the port
+	if ((state == SWD_AUTOTUNE_DONE) && job->ctx.tuned)
+	{
+		swd_autotune_store(job->ctx.idcode, job->ctx.clock);
+	}
+
+	job->clock = (state == SWD_AUTOTUNE_DONE) ? job->ctx.clock : 0;
+	job->state = state;
+	vTaskDelete(NULL);
+}
+
+// Start tuning the target on a debug port in a background task.
+// Same parameters as swd_autotune_clock(), poll swd_autotune_status() for the
+// result. Called from the port's DAP task; the tune changes the port's SWCLK, so
+// the host must not use the port until the tune has ended.
+//   return: 1 = started, 0 = a tune is already running or no task
+uint8_t swd_autotune_start(uint32_t port, uint32_t ram_addr, uint32_t max_clock, uint32_t flags)
+{
+	TUNE_JOB *job;
+
+	if (port >= DAP_PORT_COUNT)
+	{
+		return 0;
+	}
+
+	job = &tune_jobs[port];
+	if (job->state == SWD_AUTOTUNE_BUSY)
+	{
+		return 0;
+	}
+
+	swd_autotune_begin(&job->ctx, ram_addr, max_clock, flags);
+	job->port = port;
+	job->clock = 0;
+	job->state = SWD_AUTOTUNE_BUSY;
+
+	if (xTaskCreatePinnedToCore(swd_autotune_task, "SWD_TUNE", 4096, job, SWD_AUTOTUNE_TASK_PRIORITY, NULL,
+	                            dap_handle_port_core(port)) != pdPASS)
+	{
+		job->state = SWD_AUTOTUNE_FAILED;
+		return 0;
+	}
+
+	return 1;
+}
+
+// State of the last tune started on a debug port.
+//   clock:  tuned clock in Hz when SWD_AUTOTUNE_DONE, else 0
+//   return: SWD_AUTOTUNE_IDLE, _BUSY, _DONE or _FAILED
+uint8_t swd_autotune_status(uint32_t port, uint32_t *clock)
+{
+	uint8_t state;
+
+	if (port >= DAP_PORT_COUNT)
+	{
+		*clock = 0;
+		return SWD_AUTOTUNE_IDLE;
+	}
+
+	state = tune_jobs[port].state;
+	*clock = tune_jobs[port].clock;
+	return state;
+}
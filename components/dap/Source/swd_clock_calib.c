@@ -0,0 +1,175 @@
+/**
+ * @file    swd_clock_calib.c
+ * @brief   Measured SWCLK calibration: requested frequency to delay lookup
+ *
+ * The SWCLK period produced by each PIN_DELAY_SLOW argument is timed with the
+ * CPU cycle counter at boot instead of being derived from CPU_CLOCK and the
+ * DELAY_SLOW_CYCLES / IO_PORT_WRITE_CYCLES estimates. The period is linear in
+ * the delay, so a requested frequency is mapped to a delay by interpolating
+ * between the two neighbouring measured points. The fixed cost of a measurement
+ * (call, pin setup, cycle counter reads) is timed with zero cycles and removed.
+ *
+ * This file has no hardware dependencies: the probe passes a CCOUNT based
+ * measure callback, a host build can pass a simulated cycle counter.
+ */
+
+#include <stddef.h>
+#include "swd_clock_calib.h"
+
+typedef struct
+{
+	uint32_t delay;     // PIN_DELAY_SLOW argument, 0 = fast clock path
+	uint32_t period;    // SWCLK period in 1/256 CPU cycles
+} CALIB_POINT;
+
+// Calibrated delays. Index 0 is the fast clock path, the rest use PIN_DELAY_SLOW.
+static const uint32_t calib_delays[] = {
+	0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128,
+	192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096,
+};
+
+#define CALIB_POINTS (sizeof(calib_delays) / sizeof(calib_delays[0]))
+
+static CALIB_POINT calib_table[CALIB_POINTS];
+static uint32_t calib_cpu_clock;
+
+static uint32_t calib_frequency(uint32_t period)
+{
+	return (uint32_t)(((uint64_t)calib_cpu_clock * 256) / period);
+}
+
+// Time all calibration points and build the lookup table.
+//   measure:   callback generating SWCLK cycles and returning elapsed CPU cycles
+//   cpu_clock: CPU cycle counter frequency in Hz
+//   return:    1 = table valid, 0 = measurement not monotonic (table unchanged)
+uint8_t swd_clock_calibrate(swd_calib_measure_t measure, uint32_t cpu_clock)
+{
+	CALIB_POINT table[CALIB_POINTS];
+	uint32_t i, run, elapsed, best, overhead;
+
+	if ((measure == NULL) || (cpu_clock == 0))
+	{
+		return 0;
+	}
+
+	// Fixed cost of one measurement, without any SWCLK cycle
+	overhead = UINT32_MAX;
+	for (run = 0; run < SWD_CALIB_RUNS; run++)
+	{
+		elapsed = measure(0, 0);
+
+		if (elapsed < overhead)
+		{
+			overhead = elapsed;
+		}
+	}
+
+	for (i = 0; i < CALIB_POINTS; i++)
+	{
+		best = UINT32_MAX;
+
+		for (run = 0; run < SWD_CALIB_RUNS; run++)
+		{
+			elapsed = measure(calib_delays[i], SWD_CALIB_CYCLES);
+
+			if (elapsed < best)
+			{
+				best = elapsed;
+			}
+		}
+
+		if (best <= overhead)
+		{
+			return 0;
+		}
+
+		table[i].delay = calib_delays[i];
+		table[i].period = (uint32_t)(((uint64_t)(best - overhead) * 256) / SWD_CALIB_CYCLES);
+
+		if (table[i].period == 0)
+		{
+			return 0;
+		}
+
+		// Slow periods must grow strictly with the delay for interpolation
+		if ((i > 1) && (table[i].period <= table[i - 1].period))
+		{
+			return 0;
+		}
+	}
+
+	for (i = 0; i < CALIB_POINTS; i++)
+	{
+		calib_table[i] = table[i];
+	}
+	calib_cpu_clock = cpu_clock;
+
+	return 1;
+}
+
+uint8_t swd_clock_calibrated(void)
+{
+	return (calib_cpu_clock != 0) ? 1 : 0;
+}
+
+// Map a requested SWCLK frequency to a delay.
+// The selected delay never produces a clock above the requested one, except
+// below the slowest point where the last segment is extrapolated.
+//   clock:  requested frequency in Hz
+//   delay:  PIN_DELAY_SLOW argument
+//   fast:   1 = use the fast clock path
+//   actual: achieved frequency in Hz
+//   return: 1 = ok, 0 = not calibrated
+uint8_t swd_clock_lookup(uint32_t clock, uint32_t *delay, uint8_t *fast, uint32_t *actual)
+{
+	const CALIB_POINT *lo, *hi;
+	uint64_t target, span, period;
+	uint32_t i, d;
+
+	if (!swd_clock_calibrated() || (clock == 0))
+	{
+		return 0;
+	}
+
+	target = ((uint64_t)calib_cpu_clock * 256) / clock;
+
+	// Fast path reaches the requested clock
+	if (target <= calib_table[0].period)
+	{
+		*fast = 1;
+		*delay = 1;
+		*actual = calib_frequency(calib_table[0].period);
+		return 1;
+	}
+
+	*fast = 0;
+
+	// Faster than the shortest slow delay can go
+	if (target <= calib_table[1].period)
+	{
+		*delay = calib_table[1].delay;
+		*actual = calib_frequency(calib_table[1].period);
+		return 1;
+	}
+
+	// Find the segment lo < target <= hi, or extrapolate the last one
+	for (i = 2; i < (CALIB_POINTS - 1); i++)
+	{
+		if (target <= calib_table[i].period)
+		{
+			break;
+		}
+	}
+
+	lo = &calib_table[i - 1];
+	hi = &calib_table[i];
+	span = hi->period - lo->period;
+
+	d = lo->delay + (uint32_t)(((target - lo->period) * (hi->delay - lo->delay) + span - 1) / span);
+	period = lo->period + ((uint64_t)(d - lo->delay) * span) / (hi->delay - lo->delay);
+
+	*delay = d;
+	*actual = calib_frequency((uint32_t)period);
+
+	return 1;
+}
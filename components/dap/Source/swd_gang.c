@@ -0,0 +1,783 @@
+/**
+ * @file    swd_gang.c
+ * @brief   Gang programming: bit-parallel SWD to several targets sharing SWCLK
+ *
+ * Up to SWD_GANG_MAX identical boards share SWCLK, each has its own SWDIO
+ * and nRESET. All SWDIO pins are in GPIO0..31, so one write to
+ * GPIO_OUT_W1TS_REG / GPIO_OUT_W1TC_REG drives a bit on every line, one
+ * write to GPIO_ENABLE_W1TS_REG / GPIO_ENABLE_W1TC_REG turns them all
+ * around and one read of GPIO_IN_REG samples all of them. Requests and
+ * write data are broadcast; ACK, read data and parity are checked per
+ * target, so N boards are programmed in the time of one.
+ *
+ * The targets see identical packets and stay in lock step, so the DP SELECT
+ * and AP CSW caches are shared. A target answering WAIT is retried alone;
+ * the others see the retries as idle cycles (SWDIO low while SWCLK runs).
+ * A target that answers FAULT, fails parity, times out or returns a bad
+ * result is dropped from the active mask, its line idles low from then on
+ * and the remaining targets carry on.
+ *
+ * The kernel assumes turnaround 1 and no data phase after WAIT/FAULT (the
+ * SWD defaults): the lines of WAIT targets are driven low during the data
+ * phase of the others, which they see as idle cycles.
+ */
+
+#include <string.h>
+#include "swd_gang.h"
+#include "swd_host.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "debug_cm.h"
+
+#define DBG_Addr (0xe000edf0)
+
+// SWD register access
+#define SWD_REG_AP (1)
+#define SWD_REG_DP (0)
+#define SWD_REG_R (1 << 1)
+#define SWD_REG_W (0 << 1)
+#define SWD_REG_ADR(a) (a & 0x0c)
+
+// AP CSW register, base value
+#define CSW_VALUE (CSW_RESERVED | CSW_MSTRDBG | CSW_HPROT | CSW_DBGSTAT | CSW_SADDRINC)
+
+#define DCRDR 0xE000EDF8
+#define DCRSR 0xE000EDF4
+#define DHCSR 0xE000EDF0
+#define REGWnR (1 << 16)
+
+#define MAX_SWD_RETRY 100
+#define MAX_TIMEOUT 100000 // Timeout for syscalls on target
+
+#define TARGET_AUTO_INCREMENT_PAGE_SIZE    (1024)
+
+typedef struct
+{
+	uint8_t count;
+	uint8_t active;
+	uint8_t failed;
+	uint32_t clk;                   // SWCLK bit
+	uint32_t all;                   // SWDIO bits of all targets
+	uint32_t io[SWD_GANG_MAX];      // SWDIO bit of each target
+	uint32_t delay;                 // PIN_DELAY_SLOW count, 0 = fast clock
+	uint32_t select;
+	uint32_t csw;
+} GANG_STATE;
+
+typedef struct
+{
+	uint32_t r[16];
+	uint32_t xpsr;
+} DEBUG_STATE;
+
+static const uint8_t gang_swdio_pins[SWD_GANG_MAX] = SWD_GANG_SWDIO_PINS;
+static const uint8_t gang_nreset_pins[SWD_GANG_MAX] = SWD_GANG_nRESET_PINS;
+
+// SWD Packet Request headers indexed by request[3:0] (APnDP, RnW, A2, A3)
+static const uint8_t gang_request_header[16] = {
+	0x81U, 0xA3U, 0xA5U, 0x87U, 0xA9U, 0x8BU, 0x8DU, 0xAFU,
+	0xB1U, 0x93U, 0x95U, 0xB7U, 0x99U, 0xBBU, 0xBDU, 0x9FU
+};
+
+static GANG_STATE gang;
+
+static inline void gang_delay(void)
+{
+	if (gang.delay)
+	{
+		PIN_DELAY_SLOW(gang.delay);
+	}
+	else
+	{
+		PIN_DELAY_FAST();
+	}
+}
+
+// One SWCLK cycle: 'ones' high, all other SWDIO outputs low
+static inline void gang_write_bit(uint32_t ones)
+{
+	WRITE_PERI_REG(GPIO_OUT_W1TS_REG, ones);
+	WRITE_PERI_REG(GPIO_OUT_W1TC_REG, (gang.all & ~ones) | gang.clk);
+	gang_delay();
+	WRITE_PERI_REG(GPIO_OUT_W1TS_REG, gang.clk);
+	gang_delay();
+}
+
+// One SWCLK cycle sampling all SWDIO lines before the rising edge
+static inline uint32_t gang_read_bit(void)
+{
+	uint32_t in;
+
+	WRITE_PERI_REG(GPIO_OUT_W1TC_REG, gang.clk);
+	gang_delay();
+	in = READ_PERI_REG(GPIO_IN_REG);
+	WRITE_PERI_REG(GPIO_OUT_W1TS_REG, gang.clk);
+	gang_delay();
+	return in;
+}
+
+static uint32_t gang_lines(uint8_t mask)
+{
+	uint32_t lines = 0;
+	uint8_t t;
+
+	for (t = 0; t < gang.count; t++)
+	{
+		if (mask & (1U << t))
+		{
+			lines |= gang.io[t];
+		}
+	}
+	return lines;
+}
+
+static void gang_drop(uint8_t mask)
+{
+	gang.active &= ~mask;
+	gang.failed |= mask;
+}
+
+// One packet to the targets in mask.
+//   request: A[3:2] RnW APnDP
+//   wdata:   write data, broadcast
+//   rdata:   read data per target (optional)
+//   wait:    targets that answered WAIT
+//   return:  targets that answered OK (with good parity on reads)
+static uint8_t gang_kernel(uint8_t mask, uint32_t request, uint32_t wdata, uint32_t *rdata, uint8_t *wait)
+{
+	uint32_t in[3 + 33], lines, okio, val, bit, parity, n;
+	uint8_t ok = 0, ack, t;
+
+	lines = gang_lines(mask);
+
+	// Packet request
+	val = gang_request_header[request & 0x0FU];
+	for (n = 8U; n; n--)
+	{
+		gang_write_bit((val & 1U) ? lines : 0U);
+		val >>= 1;
+	}
+
+	// Turnaround, acknowledge
+	WRITE_PERI_REG(GPIO_ENABLE_W1TC_REG, lines);
+	gang_read_bit();
+	for (n = 0; n < 3U; n++)
+	{
+		in[n] = gang_read_bit();
+	}
+
+	for (t = 0; t < gang.count; t++)
+	{
+		if ((mask & (1U << t)) == 0)
+		{
+			continue;
+		}
+		n = gang_swdio_pins[t];
+		ack = (uint8_t)(((in[0] >> n) & 1U) | (((in[1] >> n) & 1U) << 1) | (((in[2] >> n) & 1U) << 2));
+		if (ack == DAP_TRANSFER_OK)
+		{
+			ok |= (uint8_t)(1U << t);
+		}
+		else if (ack == DAP_TRANSFER_WAIT)
+		{
+			*wait |= (uint8_t)(1U << t);
+		}
+	}
+	okio = gang_lines(ok);
+
+	if (request & DAP_TRANSFER_RnW)
+	{
+		if (ok)
+		{
+			// Lines without data are driven low once their turnaround has passed
+			in[3] = gang_read_bit();
+			WRITE_PERI_REG(GPIO_OUT_W1TC_REG, lines & ~okio);
+			WRITE_PERI_REG(GPIO_ENABLE_W1TS_REG, lines & ~okio);
+			for (n = 4U; n < 3U + 33U; n++)
+			{
+				in[n] = gang_read_bit();
+			}
+		}
+		gang_read_bit();
+		WRITE_PERI_REG(GPIO_ENABLE_W1TS_REG, lines);
+	}
+	else
+	{
+		gang_read_bit();
+		WRITE_PERI_REG(GPIO_ENABLE_W1TS_REG, lines);
+		if (ok)
+		{
+			// Write data to the OK targets, idle cycles for the others
+			val = wdata;
+			parity = 0U;
+			for (n = 32U; n; n--)
+			{
+				gang_write_bit((val & 1U) ? okio : 0U);
+				parity += val;
+				val >>= 1;
+			}
+			gang_write_bit((parity & 1U) ? okio : 0U);
+		}
+	}
+
+	for (n = DAP_Data.transfer.idle_cycles; n; n--)
+	{
+		gang_write_bit(0U);
+	}
+
+	if ((request & DAP_TRANSFER_RnW) && ok)
+	{
+		for (t = 0; t < gang.count; t++)
+		{
+			if ((ok & (1U << t)) == 0)
+			{
+				continue;
+			}
+			val = 0U;
+			parity = 0U;
+			for (n = 0; n < 32U; n++)
+			{
+				bit = (in[3 + n] >> gang_swdio_pins[t]) & 1U;
+				val |= bit << n;
+				parity += bit;
+			}
+			if ((parity ^ (in[3 + 32] >> gang_swdio_pins[t])) & 1U)
+			{
+				ok &= (uint8_t)~(1U << t);
+			}
+			else if (rdata)
+			{
+				rdata[t] = val;
+			}
+		}
+	}
+
+	return ok;
+}
+
+// Transfer with WAIT retries, failing targets are dropped
+static uint8_t gang_transfer(uint32_t request, uint32_t wdata, uint32_t *rdata)
+{
+	portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+	uint8_t pending = gang.active, ok, wait;
+	uint32_t i;
+
+	gang.delay = DAP_Data.fast_clock ? 0U : DAP_Data.clock_delay;
+
+	for (i = 0; (pending != 0) && (i < MAX_SWD_RETRY); i++)
+	{
+		wait = 0;
+		portENTER_CRITICAL(&lock);
+		ok = gang_kernel(pending, request, wdata, rdata, &wait);
+		portEXIT_CRITICAL(&lock);
+
+		gang_drop(pending & ~(ok | wait));
+		pending = wait;
+	}
+	gang_drop(pending);
+
+	return gang.active;
+}
+
+// Clock a bit sequence on the lines of the active targets
+static void gang_sequence(uint32_t count, const uint8_t *data)
+{
+	uint32_t lines = gang_lines(gang.active), val = 0, n = 0;
+
+	gang.delay = DAP_Data.fast_clock ? 0U : DAP_Data.clock_delay;
+
+	while (count--)
+	{
+		if (n == 0U)
+		{
+			val = *data++;
+			n = 8U;
+		}
+		gang_write_bit((val & 1U) ? lines : 0U);
+		val >>= 1;
+		n--;
+	}
+}
+
+static uint8_t gang_read_dp(uint8_t adr, uint32_t *val)
+{
+	return gang_transfer(SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(adr), 0, val);
+}
+
+static uint8_t gang_write_dp(uint8_t adr, uint32_t val)
+{
+	if (adr == DP_SELECT)
+	{
+		if (gang.select == val)
+		{
+			return gang.active;
+		}
+		gang.select = val;
+	}
+
+	return gang_transfer(SWD_REG_DP | SWD_REG_W | SWD_REG_ADR(adr), val, NULL);
+}
+
+static uint8_t gang_write_ap(uint32_t adr, uint32_t val)
+{
+	if (!gang_write_dp(DP_SELECT, (adr & 0xff000000) | (adr & APBANKSEL)))
+	{
+		return 0;
+	}
+
+	if (adr == AP_CSW)
+	{
+		if (gang.csw == val)
+		{
+			return gang.active;
+		}
+		gang.csw = val;
+	}
+
+	if (!gang_transfer(SWD_REG_AP | SWD_REG_W | SWD_REG_ADR(adr), val, NULL))
+	{
+		return 0;
+	}
+
+	return gang_transfer(SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(DP_RDBUFF), 0, NULL);
+}
+
+// Drop the active targets whose value differs from expected
+static uint8_t gang_expect(const uint32_t *val, uint32_t expected)
+{
+	uint8_t t, bad = 0;
+
+	for (t = 0; t < gang.count; t++)
+	{
+		if ((gang.active & (1U << t)) && (val[t] != expected))
+		{
+			bad |= (uint8_t)(1U << t);
+		}
+	}
+	gang_drop(bad);
+	return gang.active;
+}
+
+// Broadcast 32-bit words using address auto-increment, size in bytes
+static uint8_t gang_write_block(uint32_t address, const uint8_t *data, uint32_t size)
+{
+	uint32_t i, word;
+
+	if (!gang_write_ap(AP_CSW, CSW_VALUE | CSW_SIZE32) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_W | AP_TAR, address, NULL))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < size; i += 4)
+	{
+		memcpy(&word, &data[i], sizeof(word));
+		if (!gang_transfer(SWD_REG_AP | SWD_REG_W | AP_DRW, word, NULL))
+		{
+			return 0;
+		}
+	}
+
+	return gang_transfer(SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(DP_RDBUFF), 0, NULL);
+}
+
+// Read 32-bit words from every target and compare with data, size in bytes
+static uint8_t gang_verify_block(uint32_t address, const uint8_t *data, uint32_t size)
+{
+	uint32_t val[SWD_GANG_MAX], i, word;
+
+	if (!gang_write_ap(AP_CSW, CSW_VALUE | CSW_SIZE32) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_W | AP_TAR, address, NULL) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_R | AP_DRW, 0, NULL))
+	{
+		return 0;
+	}
+
+	// Posted reads: each DRW read returns the previous word, RDBUFF the last one
+	for (i = 0; i < size; i += 4)
+	{
+		if (!gang_transfer((i + 4 < size) ? (SWD_REG_AP | SWD_REG_R | AP_DRW) :
+		                                    (SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(DP_RDBUFF)), 0, val))
+		{
+			return 0;
+		}
+		memcpy(&word, &data[i], sizeof(word));
+		if (!gang_expect(val, word))
+		{
+			return 0;
+		}
+	}
+	return gang.active;
+}
+
+static uint8_t gang_write_core_register(uint32_t n, uint32_t val);
+static uint8_t gang_read_core_register(uint32_t n, uint32_t *val);
+
+// Poll a word on all active targets until (value & flag) is set on each
+static uint8_t gang_wait_flag(uint32_t addr, uint32_t flag, uint32_t timeout)
+{
+	uint32_t val[SWD_GANG_MAX], i;
+	uint8_t t, done = 0;
+
+	for (i = 0; i < timeout; i++)
+	{
+		if (!swd_gang_read_word(addr, val))
+		{
+			return 0;
+		}
+		for (t = 0; t < gang.count; t++)
+		{
+			if ((gang.active & (1U << t)) && (val[t] & flag))
+			{
+				done |= (uint8_t)(1U << t);
+			}
+		}
+		if ((gang.active & ~done) == 0)
+		{
+			return gang.active;
+		}
+	}
+
+	gang_drop(gang.active & ~done);
+	return gang.active;
+}
+
+static uint8_t gang_write_core_register(uint32_t n, uint32_t val)
+{
+	if (!swd_gang_write_word(DCRDR, val) || !swd_gang_write_word(DCRSR, n | REGWnR))
+	{
+		return 0;
+	}
+	return gang_wait_flag(DHCSR, S_REGRDY, 100);
+}
+
+static uint8_t gang_read_core_register(uint32_t n, uint32_t *val)
+{
+	if (!swd_gang_write_word(DCRSR, n) || !gang_wait_flag(DHCSR, S_REGRDY, 100))
+	{
+		return 0;
+	}
+	return swd_gang_read_word(DCRDR, val);
+}
+
+// Configure the pins of count targets, all of them active.
+//   return: active mask, 0 if a SWDIO pin is outside GPIO0..31
+uint8_t swd_gang_init(uint8_t count)
+{
+	uint8_t t;
+
+	memset(&gang, 0, sizeof(gang));
+	if ((count == 0) || (count > SWD_GANG_MAX) || (PIN_SWCLK >= 32))
+	{
+		return 0;
+	}
+
+	gang.count  = count;
+	gang.clk    = 1U << PIN_SWCLK;
+	gang.select = 0xffffffff;
+	gang.csw    = 0xffffffff;
+
+	gpio_pad_select_gpio(PIN_SWCLK);
+	gpio_set_direction(PIN_SWCLK, GPIO_MODE_INPUT_OUTPUT);
+	gpio_set_level(PIN_SWCLK, 1);
+
+	for (t = 0; t < count; t++)
+	{
+		if (gang_swdio_pins[t] >= 32)
+		{
+			return 0;
+		}
+		gang.io[t] = 1U << gang_swdio_pins[t];
+		gang.all  |= gang.io[t];
+
+		gpio_pad_select_gpio(gang_swdio_pins[t]);
+		gpio_set_direction(gang_swdio_pins[t], GPIO_MODE_INPUT_OUTPUT);
+		gpio_set_level(gang_swdio_pins[t], 1);
+
+		gpio_pad_select_gpio(gang_nreset_pins[t]);
+		gpio_set_direction(gang_nreset_pins[t], GPIO_MODE_INPUT_OUTPUT);
+		gpio_set_level(gang_nreset_pins[t], 1);
+	}
+
+	gang.active = (uint8_t)((1U << count) - 1U);
+	return gang.active;
+}
+
+// Release all pins.
+void swd_gang_off(void)
+{
+	uint8_t t;
+
+	gpio_set_direction(PIN_SWCLK, GPIO_MODE_INPUT);
+	for (t = 0; t < gang.count; t++)
+	{
+		gpio_set_direction(gang_swdio_pins[t], GPIO_MODE_INPUT);
+		gpio_set_direction(gang_nreset_pins[t], GPIO_MODE_INPUT);
+	}
+	gang.active = 0;
+}
+
+uint8_t swd_gang_active(void)
+{
+	return gang.active;
+}
+
+uint8_t swd_gang_failed(void)
+{
+	return gang.failed;
+}
+
+// Leave targets out, e.g. empty sockets. They are not counted as failed.
+void swd_gang_disable(uint8_t mask)
+{
+	gang.active &= ~mask;
+}
+
+void swd_gang_set_reset(uint8_t mask, uint8_t asserted)
+{
+	uint8_t t;
+
+	for (t = 0; t < gang.count; t++)
+	{
+		if (mask & (1U << t))
+		{
+			gpio_set_level(gang_nreset_pins[t], asserted ? 0 : 1);
+		}
+	}
+}
+
+// Switch all active targets to SWD and power up their debug ports.
+//   idcode: SWD_GANG_MAX entries, IDCODE of each active target
+uint8_t swd_gang_init_debug(uint32_t *idcode)
+{
+	static const uint8_t line_reset[7] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	static const uint8_t jtag_to_swd[2] = {0x9e, 0xe7};
+	static const uint8_t idle[1] = {0x00};
+	uint32_t val[SWD_GANG_MAX];
+	int i;
+
+	gang.select = 0xffffffff;
+	gang.csw    = 0xffffffff;
+
+	gang_sequence(51, line_reset);
+	gang_sequence(16, jtag_to_swd);
+	gang_sequence(51, line_reset);
+	gang_sequence(8, idle);
+
+	if (!gang_read_dp(DP_IDCODE, idcode) ||
+	    !gang_write_dp(DP_ABORT, STKCMPCLR | STKERRCLR | WDERRCLR | ORUNERRCLR) ||
+	    !gang_write_dp(DP_SELECT, 0) ||
+	    !gang_write_dp(DP_CTRL_STAT, CSYSPWRUPREQ | CDBGPWRUPREQ))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 100; i++)
+	{
+		uint8_t t, done = 0;
+
+		if (!gang_read_dp(DP_CTRL_STAT, val))
+		{
+			return 0;
+		}
+		for (t = 0; t < gang.count; t++)
+		{
+			if ((val[t] & (CDBGPWRUPACK | CSYSPWRUPACK)) == (CDBGPWRUPACK | CSYSPWRUPACK))
+			{
+				done |= (uint8_t)(1U << t);
+			}
+		}
+		if ((gang.active & ~done) == 0)
+		{
+			break;
+		}
+		if (i == 99)
+		{
+			// Unable to power up these debug ports
+			gang_drop(gang.active & ~done);
+		}
+	}
+
+	if (!gang_write_dp(DP_CTRL_STAT, CSYSPWRUPREQ | CDBGPWRUPREQ | TRNNORMAL | MASKLANE))
+	{
+		return 0;
+	}
+
+	return gang_write_dp(DP_SELECT, 0);
+}
+
+// Reset all active targets and halt them on the reset vector.
+uint8_t swd_gang_reset_program(void)
+{
+	uint32_t idcode[SWD_GANG_MAX];
+
+	if (!swd_gang_init_debug(idcode) ||
+	    !swd_gang_write_word(DBG_HCSR, DBGKEY | C_DEBUGEN) ||
+	    !swd_gang_write_word(DBG_EMCR, VC_CORERESET))
+	{
+		return 0;
+	}
+
+	swd_gang_set_reset(gang.active, 1);
+	delaymS(20);
+	swd_gang_set_reset(gang.active, 0);
+	delaymS(20);
+
+	if (!gang_wait_flag(DBG_HCSR, S_HALT, MAX_TIMEOUT))
+	{
+		return 0;
+	}
+
+	return swd_gang_write_word(DBG_EMCR, 0);
+}
+
+// Read a 32-bit word from every active target.
+//   val: SWD_GANG_MAX entries
+uint8_t swd_gang_read_word(uint32_t addr, uint32_t *val)
+{
+	if (!gang_write_ap(AP_CSW, CSW_VALUE | CSW_SIZE32) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_W | AP_TAR, addr, NULL) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_R | AP_DRW, 0, NULL))
+	{
+		return 0;
+	}
+
+	return gang_transfer(SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(DP_RDBUFF), 0, val);
+}
+
+// Write a 32-bit word to every active target.
+uint8_t swd_gang_write_word(uint32_t addr, uint32_t val)
+{
+	if (!gang_write_ap(AP_CSW, CSW_VALUE | CSW_SIZE32) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_W | AP_TAR, addr, NULL) ||
+	    !gang_transfer(SWD_REG_AP | SWD_REG_W | AP_DRW, val, NULL))
+	{
+		return 0;
+	}
+
+	return gang_transfer(SWD_REG_DP | SWD_REG_R | SWD_REG_ADR(DP_RDBUFF), 0, NULL);
+}
+
+// Broadcast data to the memory of all active targets.
+// address and size must be word aligned.
+uint8_t swd_gang_write_memory(uint32_t address, const uint8_t *data, uint32_t size)
+{
+	uint32_t n;
+
+	if ((address & 0x3) || (size & 0x3))
+	{
+		return 0;
+	}
+
+	while (size > 0)
+	{
+		// Limit to auto increment page size
+		n = TARGET_AUTO_INCREMENT_PAGE_SIZE - (address & (TARGET_AUTO_INCREMENT_PAGE_SIZE - 1));
+		if (size < n)
+		{
+			n = size;
+		}
+
+		if (!gang_write_block(address, data, n))
+		{
+			return 0;
+		}
+
+		address += n;
+		data += n;
+		size -= n;
+	}
+
+	return gang.active;
+}
+
+// Compare the memory of all active targets with data, mismatching targets are dropped.
+// address and size must be word aligned.
+uint8_t swd_gang_verify_memory(uint32_t address, const uint8_t *data, uint32_t size)
+{
+	uint32_t n;
+
+	if ((address & 0x3) || (size & 0x3))
+	{
+		return 0;
+	}
+
+	while (size > 0)
+	{
+		n = TARGET_AUTO_INCREMENT_PAGE_SIZE - (address & (TARGET_AUTO_INCREMENT_PAGE_SIZE - 1));
+		if (size < n)
+		{
+			n = size;
+		}
+
+		if (!gang_verify_block(address, data, n))
+		{
+			return 0;
+		}
+
+		address += n;
+		data += n;
+		size -= n;
+	}
+
+	return gang.active;
+}
+
+// Call a flash algorithm function on all active targets.
+// Targets whose function does not return 0 are dropped.
+uint8_t swd_gang_flash_syscall_exec(const program_syscall_t *sysCallParam, uint32_t entry, uint32_t arg1,
+                                    uint32_t arg2, uint32_t arg3, uint32_t arg4)
+{
+	DEBUG_STATE state = {{0}, 0};
+	uint32_t val[SWD_GANG_MAX];
+	uint8_t t, bad = 0;
+	uint32_t i;
+
+	state.r[0] = arg1;						   // R0: Argument 1
+	state.r[1] = arg2;						   // R1: Argument 2
+	state.r[2] = arg3;						   // R2: Argument 3
+	state.r[3] = arg4;						   // R3: Argument 4
+	state.r[9] = sysCallParam->static_base;	   // SB: Static Base
+	state.r[13] = sysCallParam->stack_pointer; // SP: Stack Pointer
+	state.r[14] = sysCallParam->breakpoint;	   // LR: Exit Point
+	state.r[15] = entry;					   // PC: Entry Point
+	state.xpsr = 0x01000000;				   // xPSR: T = 1, ISR = 0
+
+	if (!gang_write_dp(DP_SELECT, 0))
+	{
+		return 0;
+	}
+
+	// R0..R3, R9, R13..R15
+	for (i = 0; i < 16; i++)
+	{
+		if (((i < 4) || (i == 9) || (i >= 13)) && !gang_write_core_register(i, state.r[i]))
+		{
+			return 0;
+		}
+	}
+
+	if (!gang_write_core_register(16, state.xpsr) ||
+	    !swd_gang_write_word(DBG_HCSR, DBGKEY | C_DEBUGEN) ||
+	    !gang_read_dp(DP_CTRL_STAT, val))
+	{
+		return 0;
+	}
+
+	for (t = 0; t < gang.count; t++)
+	{
+		if ((gang.active & (1U << t)) && (val[t] & (STICKYERR | WDATAERR)))
+		{
+			bad |= (uint8_t)(1U << t);
+		}
+	}
+	gang_drop(bad);
+
+	if (!gang_wait_flag(DBG_HCSR, S_HALT, MAX_TIMEOUT) || !gang_read_core_register(0, val))
+	{
+		return 0;
+	}
+
+	// Flash functions return 0 if successful.
+	return gang_expect(val, 0);
+}
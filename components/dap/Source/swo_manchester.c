@@ -0,0 +1,205 @@
+/**
+ * @file    swo_manchester.c
+ * @brief   Manchester SWO decoder: edge durations to trace bytes
+ *
+ * SWO Manchester idles low. A packet starts with a start bit (1), carries
+ * data bits LSB first and ends with the line low for at least 1.5 bit
+ * times. A 1 is high then low, a 0 low then high.
+ *
+ * The high half of the start bit measures the half-bit time, so the bit
+ * rate is detected from the signal and needs no prescaler setup. Start bits
+ * close to the running estimate are averaged into it to filter edge jitter,
+ * one far off replaces it (bit rate changed). Every following run is
+ * rounded to one or two half bits and the estimate tracks slow drift. A low
+ * run of three or more half bits ends the packet and drops a partial byte.
+ *
+ * Pure C without SDK dependencies so it can be built and fed recorded edge
+ * streams on the host.
+ */
+
+#include "swo_manchester.h"
+
+// Half-bit time fixed point (1/16 tick)
+#define HALF_SHIFT      4U
+
+static void packet_idle(swo_manchester_t *dec)
+{
+	if (dec->half != 0U)
+	{
+		dec->estimate = dec->half;
+	}
+	dec->half = 0U;
+	dec->slot = 0U;
+	dec->started = 0U;
+	dec->bits = 0U;
+	dec->byte = 0U;
+}
+
+static void packet_error(swo_manchester_t *dec)
+{
+	dec->errors++;
+	packet_idle(dec);
+}
+
+// One half-bit slot at the given level
+//   return: 0 on a coding error (no transition in the middle of the bit)
+static uint8_t put_half(swo_manchester_t *dec, uint8_t level, uint8_t *out, uint32_t size, uint32_t *num)
+{
+	if (dec->slot == 0U)
+	{
+		dec->level = level;
+		dec->slot = 1U;
+		return 1U;
+	}
+	dec->slot = 0U;
+	if (level == dec->level)
+	{
+		return 0U;
+	}
+
+	if (!dec->started)
+	{
+		dec->started = 1U;              // the start bit, high half checked on entry
+		return 1U;
+	}
+
+	dec->byte |= (uint8_t)(dec->level << dec->bits);
+	if (++dec->bits == 8U)
+	{
+		if (*num < size)
+		{
+			out[(*num)++] = dec->byte;
+		}
+		else
+		{
+			dec->dropped++;
+		}
+		dec->bits = 0U;
+		dec->byte = 0U;
+	}
+	return 1U;
+}
+
+// One run of constant level
+static void put_run(swo_manchester_t *dec, uint8_t level, uint32_t duration, uint8_t *out, uint32_t size,
+                    uint32_t *num)
+{
+	uint32_t n;
+	int32_t delta;
+
+	if (duration == 0U)
+	{
+		// End of frame: idle line
+		if ((dec->half != 0U) && (dec->slot == 1U))
+		{
+			put_half(dec, 0U, out, size, num);
+		}
+		if (dec->half != 0U)
+		{
+			dec->packets++;
+		}
+		packet_idle(dec);
+		return;
+	}
+
+	if (dec->half == 0U)
+	{
+		// Idle: wait for the high half of a start bit
+		if (!level)
+		{
+			return;
+		}
+		if ((dec->nominal != 0U) && ((duration * 4U < dec->nominal) || (duration > dec->nominal * 4U)))
+		{
+			return;
+		}
+		delta = (int32_t)(duration << HALF_SHIFT) - (int32_t)dec->estimate;
+		if ((dec->estimate == 0U) || ((uint32_t)(delta < 0 ? -delta : delta) > (dec->estimate >> 2)))
+		{
+			dec->estimate = duration << HALF_SHIFT;
+		}
+		else
+		{
+			dec->estimate = (uint32_t)((int32_t)dec->estimate + delta / 4);
+		}
+		dec->half = dec->estimate;
+		put_half(dec, 1U, out, size, num);
+		return;
+	}
+
+	n = ((duration << HALF_SHIFT) + (dec->half >> 1)) / dec->half;
+	if (n == 0U)
+	{
+		packet_error(dec);
+		return;
+	}
+	if (n > 2U)
+	{
+		if (level)
+		{
+			packet_error(dec);
+			return;
+		}
+		// Line low for 1.5 bit times or more: end of packet
+		if ((dec->slot == 1U) && !put_half(dec, 0U, out, size, num))
+		{
+			packet_error(dec);
+			return;
+		}
+		dec->packets++;
+		packet_idle(dec);
+		return;
+	}
+
+	// Track the half-bit time
+	delta = (int32_t)((duration << HALF_SHIFT) / n) - (int32_t)dec->half;
+	dec->half = (uint32_t)((int32_t)dec->half + delta / 8);
+
+	while (n--)
+	{
+		if (!put_half(dec, level, out, size, num))
+		{
+			packet_error(dec);
+			return;
+		}
+	}
+}
+
+// Initialize the decoder
+//   nominal: expected half-bit time in ticks, start bits outside 1/4..4x
+//            of it are ignored as noise; 0 accepts any start bit
+void swo_manchester_init(swo_manchester_t *dec, uint32_t nominal)
+{
+	dec->nominal = nominal;
+	dec->packets = 0U;
+	dec->errors = 0U;
+	dec->dropped = 0U;
+	dec->half = 0U;
+	dec->estimate = 0U;
+	packet_idle(dec);
+}
+
+// Decode received edges
+//   symbols: RMT symbols, runs alternate levels and start with the first edge
+//   count:   number of symbols
+//   out:     decoded bytes
+//   size:    capacity of out, further bytes are counted in dropped
+//   return:  number of bytes written to out
+uint32_t swo_manchester_decode(swo_manchester_t *dec, const uint32_t *symbols, uint32_t count,
+                               uint8_t *out, uint32_t size)
+{
+	uint32_t num = 0U;
+	uint32_t sym;
+
+	while (count--)
+	{
+		sym = *symbols++;
+		put_run(dec, (uint8_t)((sym >> 15) & 1U), sym & 0x7FFFU, out, size, &num);
+		if ((sym & 0x7FFFU) == 0U)
+		{
+			continue;
+		}
+		put_run(dec, (uint8_t)(sym >> 31), (sym >> 16) & 0x7FFFU, out, size, &num);
+	}
+	return num;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file    target_lz4.c
+ * @brief   Target-side expansion of compressed image_store blocks
+ *
+ * Instead of expanding a block on the probe and sending the raw bytes, the
+ * compressed payload is written to target RAM and expanded there by a small
+ * ARMv6-M routine loaded next to the flash algorithm. The expanded block
+ * stays in a staging buffer and ProgramPage is called once per page with a
+ * pointer into it, so each byte crosses the SWD wire only in compressed form.
+ *
+ * Target RAM layout after flash_algo_build():
+ *
+ *   algorithm | program buffer | decompressor | staging (block_size) | input | ... | stack
+ *
+ * target_lz4_place() fails with ERROR_ALGO_RAM if the target RAM is too
+ * small; the caller then programs expanded blocks as usual.
+ *
+ * The probe never sees the raw data in this mode, so the per-block CRC is
+ * not checked here; the expander only guarantees the exact output size and
+ * bounded copies. Program with verify enabled to cover payload corruption.
+ */
+
+#include <stddef.h>
+#include "target_lz4.h"
+#include "flash_algo.h"
+#include "swd_host.h"
+
+/*
+ * uint32_t lz4_expand(const uint8_t *src, uint32_t src_size, uint8_t *dst, uint32_t dst_size)
+ * Returns 0 if exactly dst_size bytes were produced, 1 on malformed input.
+ * Position independent, no literal pool, 20 bytes of stack.
+ *
+ *	lz4_expand:	push	{r4-r7, lr}
+ *			adds	r1, r0, r1		@ r1 = input end
+ *			adds	r3, r2, r3		@ r3 = output end
+ *			mov	r12, r2			@ r12 = output start
+ *	seq:		cmp	r0, r1
+ *			bhs	done
+ *			ldrb	r4, [r0]		@ token
+ *			adds	r0, #1
+ *			lsrs	r5, r4, #4		@ literal length
+ *			cmp	r5, #15
+ *			bne	lit_copy
+ *	lit_ext:	cmp	r0, r1
+ *			bhs	fail
+ *			ldrb	r6, [r0]
+ *			adds	r0, #1
+ *			adds	r5, r5, r6
+ *			cmp	r6, #255
+ *			beq	lit_ext
+ *	lit_copy:	subs	r6, r1, r0
+ *			cmp	r5, r6
+ *			bhi	fail
+ *			subs	r6, r3, r2
+ *			cmp	r5, r6
+ *			bhi	fail
+ *			cmp	r5, #0
+ *			beq	lit_done
+ *	lit_loop:	ldrb	r6, [r0]
+ *			strb	r6, [r2]
+ *			adds	r0, #1
+ *			adds	r2, #1
+ *			subs	r5, #1
+ *			bne	lit_loop
+ *	lit_done:	cmp	r0, r1			@ last sequence has no match
+ *			bhs	done
+ *			subs	r6, r1, r0
+ *			cmp	r6, #2
+ *			blo	fail
+ *			ldrb	r6, [r0]		@ match offset
+ *			ldrb	r7, [r0, #1]
+ *			lsls	r7, r7, #8
+ *			orrs	r6, r7
+ *			adds	r0, #2
+ *			cmp	r6, #0
+ *			beq	fail
+ *			mov	r7, r12
+ *			subs	r7, r2, r7
+ *			cmp	r6, r7
+ *			bhi	fail
+ *			movs	r5, #15			@ match length
+ *			ands	r5, r4
+ *			cmp	r5, #15
+ *			bne	m_len
+ *	m_ext:		cmp	r0, r1
+ *			bhs	fail
+ *			ldrb	r7, [r0]
+ *			adds	r0, #1
+ *			adds	r5, r5, r7
+ *			cmp	r7, #255
+ *			beq	m_ext
+ *	m_len:		adds	r5, #4
+ *			subs	r7, r3, r2
+ *			cmp	r5, r7
+ *			bhi	fail
+ *			subs	r6, r2, r6
+ *	m_loop:		ldrb	r7, [r6]
+ *			strb	r7, [r2]
+ *			adds	r6, #1
+ *			adds	r2, #1
+ *			subs	r5, #1
+ *			bne	m_loop
+ *			b	seq
+ *	done:		movs	r0, #0
+ *			cmp	r2, r3
+ *			beq	out
+ *	fail:		movs	r0, #1
+ *	out:		pop	{r4-r7, pc}
+ */
+static const uint32_t lz4_expand_blob[] = {
+	0x1841B5F0, 0x469418D3, 0xD2404288, 0x30017804, 0x2D0F0925, 0x4288D106, 0x7806D23C, 0x19AD3001,
+	0xD0F82EFF, 0x42B51A0E, 0x1A9ED834, 0xD83142B5, 0xD0052D00, 0x70167806, 0x32013001, 0xD1F93D01,
+	0xD2244288, 0x2E021A0E, 0x7806D324, 0x023F7847, 0x3002433E, 0xD01D2E00, 0x1BD74667, 0xD81942BE,
+	0x4025250F, 0xD1062D0F, 0xD2134288, 0x30017807, 0x2FFF19ED, 0x3504D0F8, 0x42BD1A9F, 0x1B96D80A,
+	0x70177837, 0x32013601, 0xD1F93D01, 0x2000E7BC, 0xD000429A, 0xBDF02001,
+};
+
+// Reserve target RAM for the decompressor, the staging and the input buffer.
+//   algo:       relocated flash algorithm
+//   block_size: image_store block size
+//   t:          resulting layout
+//   return:     ERROR_SUCCESS or ERROR_ALGO_RAM (use probe-side expansion)
+dap_err_t target_lz4_place(const program_target_t *algo, uint32_t block_size, target_lz4_t *t)
+{
+	uint32_t start, end;
+
+	start = algo->algo_start + algo->algo_size;
+	if (algo->program_buffer + algo->program_buffer_size > start)
+	{
+		start = algo->program_buffer + algo->program_buffer_size;
+	}
+	start = (start + 7U) & ~7U;
+	end   = algo->sys_call_s.stack_pointer - FLASH_ALGO_STACK_SIZE;
+
+	t->code       = start;
+	t->entry      = start | 1U;
+	t->staging    = (start + sizeof(lz4_expand_blob) + 7U) & ~7U;
+	t->input      = t->staging + block_size;
+	t->block_size = block_size;
+
+	if ((block_size == 0) || (algo->program_buffer_size == 0) ||
+	    (algo->sys_call_s.stack_pointer < FLASH_ALGO_STACK_SIZE) ||
+	    (t->input + IMAGE_STORE_BOUND(block_size) > end))
+	{
+		return ERROR_ALGO_RAM;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Download the decompressor, after the flash algorithm has been downloaded.
+dap_err_t target_lz4_load(const target_lz4_t *t)
+{
+	if (!swd_write_memory(t->code, (uint8_t *)lz4_expand_blob, sizeof(lz4_expand_blob)))
+	{
+		return ERROR_ALGO_DL;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Upload one block, expand it on the target and program it page by page.
+//   algo:    relocated flash algorithm, initialised for programming
+//   t:       layout from target_lz4_place, decompressor loaded
+//   block:   validated block header
+//   payload: block payload as stored (compressed or raw)
+dap_err_t target_lz4_program(const program_target_t *algo, const target_lz4_t *t,
+                             const image_store_block_t *block, const uint8_t *payload)
+{
+	uint32_t comp = block->comp_size & ~IMAGE_STORE_STORED;
+	uint32_t offset, size;
+
+	if (block->raw_size > t->block_size)
+	{
+		return ERROR_IMAGE_STORE;
+	}
+
+	if (block->comp_size & IMAGE_STORE_STORED)
+	{
+		if (!swd_write_memory(t->staging, (uint8_t *)payload, comp))
+		{
+			return ERROR_ALGO_DATA_SEQ;
+		}
+	}
+	else
+	{
+		if (!swd_write_memory(t->input, (uint8_t *)payload, comp))
+		{
+			return ERROR_ALGO_DATA_SEQ;
+		}
+		if (!swd_flash_syscall_exec(&algo->sys_call_s, t->entry, t->input, comp, t->staging, block->raw_size))
+		{
+			return ERROR_IMAGE_STORE;
+		}
+	}
+
+	for (offset = 0; offset < block->raw_size; offset += size)
+	{
+		size = block->raw_size - offset;
+		if (size > algo->program_buffer_size)
+		{
+			size = algo->program_buffer_size;
+		}
+		if (!swd_flash_syscall_exec(&algo->sys_call_s, algo->program_page, block->addr + offset, size,
+		                            t->staging + offset, 0))
+		{
+			return ERROR_WRITE;
+		}
+	}
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file    upload.c
+ * @brief   Pipelined image upload over DAP vendor commands
+ *
+ * The host writes a file to the image or algorithm partition with four
+ * vendor commands (little endian, after the command ID):
+ *
+ *   BEGIN   target, format [15:0], base [31:0], size [31:0], CRC [31:0]
+ *           -> status, error, offset [31:0], chunk size
+ *   DATA    offset [31:0], CRC [31:0], length, data
+ *           -> status, next [31:0]
+ *   END     -> status, error
+ *   STATUS  -> state, offset [31:0], size [31:0]
+ *
+ * BEGIN with the parameters of the upload in progress resumes it and
+ * returns the number of bytes already stored, anything else starts over.
+ * The progress is kept in RAM only: a host that lost the connection or was
+ * restarted can resume, a probe that was reset or unplugged starts over.
+ * The partition is held from BEGIN to the end of the upload (or the next
+ * BEGIN that starts over), and the USB drive reports it busy meanwhile;
+ * BEGIN fails with ERROR_IMAGE_BUSY while the drive is storing a file.
+ * BEGIN only checks that the file fits. DATA erases each sector just ahead
+ * of the bytes it programs, so no command waits for more than one sector
+ * erase.
+ *
+ * DATA commands are not acknowledged one by one: the host keeps a window
+ * of them in flight and reads the responses as they come. A chunk is
+ * stored if its CRC-32 matches and it starts exactly at the next offset.
+ * Chunks below it (retransmissions) are acknowledged without writing, a
+ * chunk beyond it means an earlier one was lost and is answered with
+ * DAP_ERROR. In both cases the response carries the next expected offset
+ * and the host goes back to it (go-back-N).
+ *
+ * END compares the CRC of all received bytes with the CRC from BEGIN and
+ * then reads the partition back, UPLOAD_VERIFY_STEP bytes per command.
+ * While bytes remain it answers UPLOAD_BUSY and the host sends END again;
+ * STATUS reports UPLOAD_STATE_VERIFY and the bytes read back so far. The
+ * image header is written after the last step, if the CRC still matches.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "upload.h"
+#include "crc.h"
+
+#define UPLOAD_OK       0x00U   // DAP_OK
+#define UPLOAD_ERROR    0xFFU   // DAP_ERROR
+
+static uint32_t get32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+// Prepare the upload state. A zero-initialised upload_t uses the default labels.
+//   image, algo: partition labels, NULL for the defaults
+void upload_init(upload_t *u, const char *image, const char *algo)
+{
+	memset(u, 0, sizeof(*u));
+	u->name[UPLOAD_TARGET_IMAGE] = (image != NULL) ? image : UPLOAD_PART_IMAGE;
+	u->name[UPLOAD_TARGET_ALGO]  = (algo != NULL) ? algo : UPLOAD_PART_ALGO;
+}
+
+// Start or resume an upload.
+//   offset: first byte the host has to send
+dap_err_t upload_begin(upload_t *u, uint8_t target, uint16_t format, uint32_t base, uint32_t size, uint32_t crc,
+                       uint32_t *offset)
+{
+	const char *name;
+	dap_err_t status;
+
+	*offset = 0;
+	if (target >= UPLOAD_TARGETS)
+	{
+		return ERROR_INTERNAL;
+	}
+
+	if (u->active && (u->target == target) && (u->format == format) && (u->base == base) &&
+	    (u->size == size) && (u->crc == crc))
+	{
+		*offset = u->out.offset;
+		return ERROR_SUCCESS;
+	}
+
+	upload_abort(u);
+	name = u->name[target];
+	if (name == NULL)
+	{
+		name = (target == UPLOAD_TARGET_IMAGE) ? UPLOAD_PART_IMAGE : UPLOAD_PART_ALGO;
+	}
+	status = image_map_writer_open(&u->out, name);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+	if (size > u->out.part_size - sizeof(u->out.header))
+	{
+		image_map_writer_abort(&u->out);
+		return ERROR_FILE_BOUNDS;
+	}
+
+	u->active  = 1;
+	u->verify  = 0;
+	u->target  = target;
+	u->format  = format;
+	u->base    = base;
+	u->size    = size;
+	u->crc     = crc;
+	u->running = 0;
+	return ERROR_SUCCESS;
+}
+
+// Store one chunk.
+//   next:   offset the host has to continue from
+//   return: ERROR_SUCCESS if the chunk is stored or was stored before,
+//           ERROR_ALGO_DATA_SEQ for a gap, ERROR_BL_UPDT_BAD_CRC for a bad
+//           chunk CRC, ERROR_FILE_BOUNDS beyond the announced size,
+//           other errors from the partition writer
+dap_err_t upload_data(upload_t *u, uint32_t offset, const uint8_t *data, uint32_t size, uint32_t crc,
+                      uint32_t *next)
+{
+	dap_err_t status;
+
+	*next = u->out.offset;
+	if (!u->active)
+	{
+		return ERROR_UNINIT;
+	}
+	if ((offset < u->out.offset) && (size <= u->out.offset - offset))
+	{
+		return ERROR_SUCCESS;
+	}
+	if (offset != u->out.offset)
+	{
+		return ERROR_ALGO_DATA_SEQ;
+	}
+	if (size > u->size - u->out.offset)
+	{
+		return ERROR_FILE_BOUNDS;
+	}
+	if (crc32(data, size) != crc)
+	{
+		return ERROR_BL_UPDT_BAD_CRC;
+	}
+
+	status = image_map_writer_write(&u->out, data, size);
+	if (status == ERROR_SUCCESS)
+	{
+		u->running = crc32_continue(u->running, data, size);
+	}
+	*next = u->out.offset;
+	return status;
+}
+
+// Finish the upload, one read-back step per call.
+//   return: ERROR_SUCCESS_DONE_OR_CONTINUE while the read-back is not
+//           finished (call again), ERROR_SUCCESS once the image is committed,
+//           ERROR_BL_UPDT_BAD_CRC or another error otherwise
+dap_err_t upload_end(upload_t *u)
+{
+	dap_err_t status;
+
+	if (!u->active)
+	{
+		return ERROR_UNINIT;
+	}
+	if (!u->verify)
+	{
+		if (u->out.offset != u->size)
+		{
+			return ERROR_FILE_BOUNDS;
+		}
+		if (u->running != u->crc)
+		{
+			upload_abort(u);
+			return ERROR_BL_UPDT_BAD_CRC;
+		}
+		u->verify = 1;
+	}
+
+	status = image_map_writer_verify(&u->out, UPLOAD_VERIFY_STEP);
+	if (status == ERROR_SUCCESS)
+	{
+		return ERROR_SUCCESS_DONE_OR_CONTINUE;
+	}
+	if (status != ERROR_SUCCESS_DONE)
+	{
+		upload_abort(u);
+		return status;
+	}
+	status = image_map_writer_close(&u->out, u->format, u->base, &u->crc);
+	u->active = 0;
+	return status;
+}
+
+void upload_abort(upload_t *u)
+{
+	if (u->active)
+	{
+		image_map_writer_abort(&u->out);
+		u->active = 0;
+	}
+}
+
+// Process one upload vendor command.
+//   cmd:      command ID, UPLOAD_CMD_*
+//   request:  request data after the command ID
+//   response: response data after the command ID
+//   return:   number of bytes in response (lower 16 bits)
+//             number of bytes in request (upper 16 bits), without the command ID
+uint32_t upload_command(upload_t *u, uint8_t cmd, const uint8_t *request, uint8_t *response)
+{
+	uint32_t offset = 0, len;
+	dap_err_t status;
+
+	switch (cmd)
+	{
+	case UPLOAD_CMD_BEGIN:
+		status = upload_begin(u, request[0], (uint16_t)(request[1] | (request[2] << 8)), get32(&request[3]),
+		                      get32(&request[7]), get32(&request[11]), &offset);
+		response[0] = (status == ERROR_SUCCESS) ? UPLOAD_OK : UPLOAD_ERROR;
+		response[1] = (uint8_t)status;
+		put32(&response[2], offset);
+		response[6] = UPLOAD_CHUNK_MAX;
+		return (15U << 16) | 7U;
+
+	case UPLOAD_CMD_DATA:
+		len = request[8];
+		if (len > UPLOAD_CHUNK_MAX)
+		{
+			len    = 0;
+			status = ERROR_INTERNAL;
+			offset = u->out.offset;
+		}
+		else
+		{
+			status = upload_data(u, get32(&request[0]), &request[9], len, get32(&request[4]), &offset);
+		}
+		response[0] = (status == ERROR_SUCCESS) ? UPLOAD_OK : UPLOAD_ERROR;
+		put32(&response[1], offset);
+		return ((9U + len) << 16) | 5U;
+
+	case UPLOAD_CMD_END:
+		status = upload_end(u);
+		if (status == ERROR_SUCCESS_DONE_OR_CONTINUE)
+		{
+			response[0] = UPLOAD_BUSY;
+			response[1] = ERROR_SUCCESS;
+		}
+		else
+		{
+			response[0] = (status == ERROR_SUCCESS) ? UPLOAD_OK : UPLOAD_ERROR;
+			response[1] = (uint8_t)status;
+		}
+		return 2U;
+
+	case UPLOAD_CMD_STATUS:
+		if (!u->active)
+		{
+			response[0] = UPLOAD_STATE_IDLE;
+			offset      = 0;
+		}
+		else if (u->verify)
+		{
+			response[0] = UPLOAD_STATE_VERIFY;
+			offset      = u->out.checked;
+		}
+		else
+		{
+			response[0] = UPLOAD_STATE_DATA;
+			offset      = u->out.offset;
+		}
+		put32(&response[1], offset);
+		put32(&response[5], u->active ? u->size : 0);
+		return 9U;
+
+	default:
+		return 0;
+	}
+}
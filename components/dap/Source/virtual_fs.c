@@ -0,0 +1,328 @@
+/**
+ * @file    virtual_fs.c
+ * @brief   Virtual FAT16 volume for drag-and-drop programming
+ *
+ * The volume exists only as a function of the sector number: boot sector,
+ * FAT, root directory and the two text files are generated on every read,
+ * so no disk image is kept in RAM. The root directory holds INFO.TXT and
+ * STATUS.TXT, every other cluster reads as free and empty.
+ *
+ * Writes to the FAT and the directory are dropped. A data sector that
+ * starts like an Intel HEX, S-record, ELF or UF2 file starts a job: the
+ * sink is opened and this and the following contiguous sectors are passed
+ * to the image decoder while they arrive. Hosts allocate a file copied onto
+ * an empty volume in one run of clusters and write it in order, so the file
+ * is decoded without knowing its directory entry. The job ends when the
+ * decoder reports the end of the image or when the caller signals a pause
+ * in writes with virtual_fs_timeout(). Sectors that continue a finished or
+ * failed file are ignored.
+ *
+ * After a job the caller should report a media change so that the host
+ * drops its cached view and reads the new STATUS.TXT.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "virtual_fs.h"
+
+#define VFS_IDLE            0U
+#define VFS_STREAM          1U      // decoding a file
+#define VFS_DRAIN           2U      // ignoring the rest of a finished file
+
+#define VFS_CLUSTER_INFO    2U
+#define VFS_CLUSTER_STATUS  3U
+#define VFS_CLUSTER_FIRST   4U      // first cluster free for files
+
+#define VFS_FAT_DATE        (((2025U - 1980U) << 9) | (1U << 5) | 1U)
+#define VFS_ATTR_READ_ONLY  0x01U
+#define VFS_ATTR_LABEL      0x08U
+
+static const char info_txt[] =
+	"ESP32-S3 DAPLink offline programmer\r\n"
+	"\r\n"
+	"Copy an Intel HEX, S-record, ELF or UF2 file to this drive.\r\n"
+	"The result of the last copy is shown in STATUS.TXT.\r\n";
+
+static const char *format_name[] = {"unknown", "HEX", "S-record", "ELF", "UF2", "binary"};
+
+static void put16(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+	put16(p, v);
+	put16(p + 2, v >> 16);
+}
+
+static uint8_t is_hex(uint8_t c)
+{
+	return ((c >= '0') && (c <= '9')) || ((c >= 'A') && (c <= 'F')) || ((c >= 'a') && (c <= 'f'));
+}
+
+static uint8_t all_hex(const uint8_t *p, uint32_t n)
+{
+	while (n--)
+	{
+		if (!is_hex(*p++))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Format of a file starting in this sector. Text formats need a complete
+// record header, so file contents that merely start with ':' or 'S' do not
+// start a job.
+static image_format_t vfs_detect(const uint8_t *buf)
+{
+	image_format_t format = image_detect(buf, VFS_SECTOR_SIZE);
+
+	switch (format)
+	{
+	case IMAGE_FORMAT_HEX:
+		return all_hex(&buf[1], 8) ? format : IMAGE_FORMAT_UNKNOWN;
+	case IMAGE_FORMAT_SREC:
+		return ((buf[1] >= '0') && (buf[1] <= '9') && all_hex(&buf[2], 4)) ? format : IMAGE_FORMAT_UNKNOWN;
+	case IMAGE_FORMAT_UF2:
+		return ((buf[4] == 0x57) && (buf[5] == 0x51) && (buf[6] == 0x5D) && (buf[7] == 0x9E)) ? format :
+		       IMAGE_FORMAT_UNKNOWN;
+	case IMAGE_FORMAT_ELF:
+		return format;
+	default:
+		return IMAGE_FORMAT_UNKNOWN;
+	}
+}
+
+// Contents of STATUS.TXT
+static uint32_t vfs_status(const virtual_fs_t *vfs, char *buf, uint32_t size)
+{
+	int len;
+
+	if (vfs->state == VFS_STREAM)
+	{
+		len = snprintf(buf, size, "BUSY: %lu bytes of %s received\r\n", (unsigned long)vfs->dec.position,
+		               format_name[vfs->format]);
+	}
+	else if (vfs->jobs == 0)
+	{
+		len = snprintf(buf, size, "READY\r\n");
+	}
+	else if (vfs->result == ERROR_SUCCESS)
+	{
+		len = snprintf(buf, size, "OK: %lu bytes of %s\r\n", (unsigned long)vfs->received,
+		               format_name[vfs->format]);
+	}
+	else
+	{
+		len = snprintf(buf, size, "FAIL: %s\r\n", error_get_string(vfs->result));
+	}
+	return ((len < 0) || ((uint32_t)len >= size)) ? size - 1 : (uint32_t)len;
+}
+
+static void vfs_boot_sector(uint8_t *buf)
+{
+	buf[0] = 0xEB;
+	buf[1] = 0x3C;
+	buf[2] = 0x90;
+	memcpy(&buf[3], "MSWIN4.1", 8);
+	put16(&buf[11], VFS_SECTOR_SIZE);
+	buf[13] = VFS_CLUSTER_SECTORS;
+	put16(&buf[14], VFS_FAT_START);             // reserved sectors
+	buf[16] = 2;                                // number of FATs
+	put16(&buf[17], VFS_ROOT_ENTRIES);
+	put16(&buf[19], 0);                         // total sectors in the 32-bit field
+	buf[21] = 0xF8;                             // fixed disk
+	put16(&buf[22], VFS_FAT_SECTORS);
+	put16(&buf[24], 63);                        // sectors per track
+	put16(&buf[26], 255);                       // heads
+	put32(&buf[28], 0);                         // hidden sectors
+	put32(&buf[32], VFS_SECTOR_COUNT);
+	buf[36] = 0x80;                             // drive number
+	buf[38] = 0x29;                             // extended boot signature
+	put32(&buf[39], 0x44415031U);               // volume serial number
+	memcpy(&buf[43], "DAPLINK    ", 11);
+	memcpy(&buf[54], "FAT16   ", 8);
+	buf[510] = 0x55;
+	buf[511] = 0xAA;
+}
+
+static void vfs_fat_sector(uint32_t index, uint8_t *buf)
+{
+	uint32_t i, cluster;
+
+	for (i = 0; i < VFS_SECTOR_SIZE / 2; i++)
+	{
+		cluster = index * (VFS_SECTOR_SIZE / 2) + i;
+		if (cluster == 0)
+		{
+			put16(&buf[2 * i], 0xFFF8);
+		}
+		else if (cluster < VFS_CLUSTER_FIRST)
+		{
+			put16(&buf[2 * i], 0xFFFF);         // reserved entry and end of the single-cluster files
+		}
+	}
+}
+
+static void vfs_dir_entry(uint8_t *entry, const char *name, uint8_t attr, uint32_t cluster, uint32_t size)
+{
+	memcpy(entry, name, 11);
+	entry[11] = attr;
+	put16(&entry[16], VFS_FAT_DATE);            // creation date
+	put16(&entry[18], VFS_FAT_DATE);            // last access date
+	put16(&entry[24], VFS_FAT_DATE);            // modification date
+	put16(&entry[26], cluster);
+	put32(&entry[28], size);
+}
+
+void virtual_fs_init(virtual_fs_t *vfs, const virtual_fs_sink_t *sink)
+{
+	memset(vfs, 0, sizeof(*vfs));
+	vfs->sink = *sink;
+}
+
+// Generate one sector of the volume.
+void virtual_fs_read(virtual_fs_t *vfs, uint32_t sector, uint8_t *buf)
+{
+	char status[VFS_SECTOR_SIZE];
+	uint32_t cluster, offset, len;
+
+	memset(buf, 0, VFS_SECTOR_SIZE);
+
+	if (sector == 0)
+	{
+		vfs_boot_sector(buf);
+	}
+	else if (sector < VFS_ROOT_START)
+	{
+		vfs_fat_sector((sector - VFS_FAT_START) % VFS_FAT_SECTORS, buf);
+	}
+	else if (sector == VFS_ROOT_START)
+	{
+		vfs_dir_entry(&buf[0], "DAPLINK    ", VFS_ATTR_LABEL, 0, 0);
+		vfs_dir_entry(&buf[32], "INFO    TXT", VFS_ATTR_READ_ONLY, VFS_CLUSTER_INFO, sizeof(info_txt) - 1);
+		vfs_dir_entry(&buf[64], "STATUS  TXT", VFS_ATTR_READ_ONLY, VFS_CLUSTER_STATUS,
+		              vfs_status(vfs, status, sizeof(status)));
+	}
+	else if (sector >= VFS_DATA_START)
+	{
+		cluster = (sector - VFS_DATA_START) / VFS_CLUSTER_SECTORS + 2U;
+		offset  = ((sector - VFS_DATA_START) % VFS_CLUSTER_SECTORS) * VFS_SECTOR_SIZE;
+		if ((cluster == VFS_CLUSTER_INFO) && (offset < sizeof(info_txt) - 1))
+		{
+			len = sizeof(info_txt) - 1 - offset;
+			memcpy(buf, &info_txt[offset], (len < VFS_SECTOR_SIZE) ? len : VFS_SECTOR_SIZE);
+		}
+		else if ((cluster == VFS_CLUSTER_STATUS) && (offset == 0))
+		{
+			memcpy(buf, status, vfs_status(vfs, status, sizeof(status)));
+		}
+	}
+}
+
+// End the current job and report it to the sink
+static void vfs_finish(virtual_fs_t *vfs, dap_err_t status)
+{
+	vfs->received = vfs->dec.position;
+	vfs->result   = vfs->sink.close(vfs->sink.ctx, status);
+	vfs->state    = VFS_DRAIN;
+	vfs->changed  = 1;
+}
+
+// Accept one written sector.
+void virtual_fs_write(virtual_fs_t *vfs, uint32_t sector, const uint8_t *buf)
+{
+	image_format_t format;
+	dap_err_t status;
+
+	// FAT, directory and our own files are not kept
+	if (sector < VFS_DATA_START + (VFS_CLUSTER_FIRST - 2U) * VFS_CLUSTER_SECTORS)
+	{
+		return;
+	}
+
+	if ((vfs->state != VFS_IDLE) && (sector == vfs->next_sector))
+	{
+		vfs->next_sector++;
+		if (vfs->state == VFS_STREAM)
+		{
+			status = image_decoder_write(&vfs->dec, buf, VFS_SECTOR_SIZE);
+			if (status == ERROR_SUCCESS_DONE)
+			{
+				vfs_finish(vfs, ERROR_SUCCESS);
+			}
+			else if (status != ERROR_SUCCESS)
+			{
+				vfs_finish(vfs, status);
+			}
+		}
+		return;
+	}
+
+	// Other files written while a job runs (host metadata) are ignored
+	if (vfs->state == VFS_STREAM)
+	{
+		return;
+	}
+
+	format = vfs_detect(buf);
+	if (format == IMAGE_FORMAT_UNKNOWN)
+	{
+		return;
+	}
+
+	vfs->jobs++;
+	vfs->format      = format;
+	vfs->next_sector = sector;
+	image_decoder_init(&vfs->dec, format, 0, vfs->sink.record, vfs->sink.ctx);
+	status = vfs->sink.open(vfs->sink.ctx, format);
+	if (status != ERROR_SUCCESS)
+	{
+		vfs->next_sector = sector + 1;
+		vfs->received    = 0;
+		vfs->result      = status;
+		vfs->state       = VFS_DRAIN;
+		vfs->changed     = 1;
+		return;
+	}
+	vfs->state = VFS_STREAM;
+	virtual_fs_write(vfs, sector, buf);
+}
+
+// No write for a while: finish a job whose end was not detected.
+void virtual_fs_timeout(virtual_fs_t *vfs)
+{
+	if (vfs->state == VFS_STREAM)
+	{
+		vfs_finish(vfs, image_decoder_finish(&vfs->dec));
+	}
+	else
+	{
+		vfs->state = VFS_IDLE;
+	}
+}
+
+// Copy what virtual_fs_read() reports from the volume that takes the writes,
+// so reads can be served from a copy while a write or a job end is running.
+void virtual_fs_status_copy(virtual_fs_t *view, const virtual_fs_t *vfs)
+{
+	view->state        = vfs->state;
+	view->jobs         = vfs->jobs;
+	view->result       = vfs->result;
+	view->received     = vfs->received;
+	view->format       = vfs->format;
+	view->dec.position = vfs->dec.position;
+}
+
+// Report and clear a finished job, the host should see a media change.
+uint8_t virtual_fs_changed(virtual_fs_t *vfs)
+{
+	uint8_t changed = vfs->changed;
+
+	vfs->changed = 0;
+	return changed;
+}
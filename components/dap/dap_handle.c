@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -6,96 +7,183 @@
 #include "esp_log.h"
 
 #include "dap_handle.h"
+#include "DAP_config.h"
 #include "DAP.h"
+#include "swd_clock_calib.h"
+#include "jtag_spi.h"
 
 static const char *TAG = "DAP_HANDLE";
 
+// 每个调试端口一个 DAP 任务。任务固定在一个核上运行，保证 TIMESTAMP_GET (CCOUNT) 单调；
+// 端口 0 在 DAP_TASK_CORE 上，其余端口依次分布到另一个核
+#define DAP_TASK_CORE   (portNUM_PROCESSORS - 1)
+
 // DAP 数据包结构
 typedef struct {
     uint16_t length;
     uint8_t buf[DAP_PACKET_SIZE];
 } dap_packet_t;
 
-// DAP 处理相关句柄
-static RingbufHandle_t dap_request_buf = NULL;   // 请求缓冲区
-static RingbufHandle_t dap_response_buf = NULL;  // 响应缓冲区
-static SemaphoreHandle_t dap_mutex = NULL;       // DAP 互斥锁
-static TaskHandle_t dap_task_handle = NULL;      // DAP 任务句柄
+// 调试端口引擎：请求/响应缓冲区、互斥锁和处理任务
+typedef struct {
+    uint8_t port;                   // 调试端口号 (DAP_PortBind)
+    RingbufHandle_t request_buf;    // 请求缓冲区
+    RingbufHandle_t response_buf;   // 响应缓冲区
+    SemaphoreHandle_t mutex;        // 端口互斥锁
+    TaskHandle_t task;              // DAP 任务句柄
+    uint32_t latency_last;          // 命令处理耗时统计 (TIMESTAMP_CLOCK 计数)
+    uint32_t latency_max;
+} dap_engine_t;
+
+static dap_engine_t dap_engines[DAP_PORT_COUNT];
+
+#if (SWO_STREAM != 0)
+static TaskHandle_t swo_task;       // SWO 流式跟踪任务
+#endif
+
+int dap_handle_port_core(uint8_t port)
+{
+    return (DAP_TASK_CORE + port) % portNUM_PROCESSORS;
+}
 
 esp_err_t dap_handle_init(void)
 {
-    // 创建互斥锁
-    dap_mutex = xSemaphoreCreateMutex();
-    if (dap_mutex == NULL) {
-        ESP_LOGE(TAG, "Failed to create mutex");
-        return ESP_FAIL;
+    char name[16];
+
+    for (uint8_t port = 0; port < DAP_PORT_COUNT; port++) {
+        dap_engine_t *engine = &dap_engines[port];
+
+        engine->port = port;
+
+        // 创建互斥锁
+        engine->mutex = xSemaphoreCreateMutex();
+        if (engine->mutex == NULL) {
+            ESP_LOGE(TAG, "Failed to create mutex");
+            return ESP_FAIL;
+        }
+
+        // 创建环形缓冲区，增加缓冲区大小
+        engine->request_buf = xRingbufferCreate(sizeof(dap_packet_t) * DAP_BUFFER_NUM * 2, RINGBUF_TYPE_BYTEBUF);
+        engine->response_buf = xRingbufferCreate(sizeof(dap_packet_t) * DAP_BUFFER_NUM * 2, RINGBUF_TYPE_BYTEBUF);
+        if (engine->request_buf == NULL || engine->response_buf == NULL) {
+            ESP_LOGE(TAG, "Failed to create ring buffer");
+            return ESP_FAIL;
+        }
+
+        // 初始化端口的 DAP 状态和引脚
+        DAP_PortBind(port);
+        DAP_Setup();
+
+        // 用 CCOUNT 实测 SWCLK，建立 频率 -> 延时 查找表 (与端口无关，只做一次)
+        if (port == 0) {
+            if (swd_clock_calibrate(SWJ_ClockMeasure, CPU_CLOCK)) {
+                Set_DAP_Clock_Delay(DAP_Data.nominal_clock);
+                ESP_LOGI(TAG, "SWCLK 校准完成: 请求 %lu Hz, 实际 %lu Hz", DAP_Data.nominal_clock, DAP_Data.actual_clock);
+            } else {
+                ESP_LOGW(TAG, "SWCLK 校准失败，使用估算延时");
+            }
+        } else {
+            Set_DAP_Clock_Delay(DAP_Data.nominal_clock);
+        }
     }
+    DAP_PortBind(0);
 
-    // 创建环形缓冲区，增加缓冲区大小
-    dap_request_buf = xRingbufferCreate(sizeof(dap_packet_t) * DAP_BUFFER_NUM * 2, RINGBUF_TYPE_BYTEBUF);
-    dap_response_buf = xRingbufferCreate(sizeof(dap_packet_t) * DAP_BUFFER_NUM * 2, RINGBUF_TYPE_BYTEBUF);
-    if (dap_request_buf == NULL || dap_response_buf == NULL) {
-        ESP_LOGE(TAG, "Failed to create ring buffer");
+    // JTAG 长序列用 SPI 外设移位，失败时退回 GPIO 翻转
+    jtag_spi_init();
+
+    // 每个端口创建一个 DAP 处理任务，提高优先级和堆栈大小，分布在两个核上
+    for (uint8_t port = 0; port < DAP_PORT_COUNT; port++) {
+        snprintf(name, sizeof(name), "DAP_HANDLE%u", port);
+        BaseType_t ret = xTaskCreatePinnedToCore(dap_handle_task, name, 8192, &dap_engines[port],
+                                                 configMAX_PRIORITIES - 2, &dap_engines[port].task,
+                                                 dap_handle_port_core(port));
+        if (ret != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create DAP task");
+            return ESP_FAIL;
+        }
+    }
+
+#if (SWO_STREAM != 0)
+    // SWO 流式跟踪任务：把跟踪缓冲区的数据发到 CMSIS-DAP 接口的 SWO 端点
+    if (xTaskCreate(SWO_Thread, "SWO", 3072, NULL, configMAX_PRIORITIES - 3, &swo_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create SWO task");
         return ESP_FAIL;
     }
+#endif
 
-    // 初始化 DAP
-    DAP_Setup();
-    
-    // 创建 DAP 处理任务，提高优先级和堆栈大小
-    BaseType_t ret = xTaskCreate(dap_handle_task, "DAP_HANDLE", 8192, NULL, configMAX_PRIORITIES - 2, &dap_task_handle);
-    if (ret != pdPASS) {
-        ESP_LOGE(TAG, "Failed to create DAP task");
+#if (DAP_UART != 0)
+    // 目标串口桥：UART 驱动和收发任务，默认经 CDC 串口 (USB COM 口) 转发
+    if (UART_Setup() == 0U) {
+        ESP_LOGE(TAG, "Failed to setup DAP UART");
         return ESP_FAIL;
     }
+#endif
 
-    ESP_LOGI(TAG, "DAP handle initialized");
+    ESP_LOGI(TAG, "DAP handle initialized, %u port(s)", (unsigned)DAP_PORT_COUNT);
     return ESP_OK;
 }
 
 void dap_handle_deinit(void)
 {
-    if (dap_task_handle) {
-        vTaskDelete(dap_task_handle);
-        dap_task_handle = NULL;
+#if (SWO_STREAM != 0)
+    if (swo_task) {
+        vTaskDelete(swo_task);
+        swo_task = NULL;
     }
+#endif
 
-    if (dap_request_buf) {
-        vRingbufferDelete(dap_request_buf);
-        dap_request_buf = NULL;
-    }
+    for (uint8_t port = 0; port < DAP_PORT_COUNT; port++) {
+        dap_engine_t *engine = &dap_engines[port];
 
-    if (dap_response_buf) {
-        vRingbufferDelete(dap_response_buf);
-        dap_response_buf = NULL;
-    }
+        if (engine->task) {
+            vTaskDelete(engine->task);
+            engine->task = NULL;
+        }
+
+        if (engine->request_buf) {
+            vRingbufferDelete(engine->request_buf);
+            engine->request_buf = NULL;
+        }
+
+        if (engine->response_buf) {
+            vRingbufferDelete(engine->response_buf);
+            engine->response_buf = NULL;
+        }
 
-    if (dap_mutex) {
-        vSemaphoreDelete(dap_mutex);
-        dap_mutex = NULL;
+        if (engine->mutex) {
+            vSemaphoreDelete(engine->mutex);
+            engine->mutex = NULL;
+        }
     }
 }
 
 esp_err_t dap_handle_request(uint8_t *request, uint16_t req_size, uint8_t *response, uint16_t *resp_size)
 {
-    if (!request || !response || !resp_size || req_size > DAP_PACKET_SIZE) {
+    return dap_handle_request_port(0, request, req_size, response, resp_size);
+}
+
+esp_err_t dap_handle_request_port(uint8_t port, uint8_t *request, uint16_t req_size, uint8_t *response,
+                                  uint16_t *resp_size)
+{
+    if (port >= DAP_PORT_COUNT || !request || !response || !resp_size || req_size > DAP_PACKET_SIZE) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    dap_engine_t *engine = &dap_engines[port];
     dap_packet_t packet = {
         .length = req_size
     };
     memcpy(packet.buf, request, req_size);
 
     // 发送请求到环形缓冲区
-    if (xRingbufferSend(dap_request_buf, &packet, sizeof(dap_packet_t), pdMS_TO_TICKS(100)) != pdTRUE) {
+    if (xRingbufferSend(engine->request_buf, &packet, sizeof(dap_packet_t), pdMS_TO_TICKS(100)) != pdTRUE) {
         ESP_LOGW(TAG, "Failed to send request to ring buffer");
         return ESP_FAIL;
     }
 
     // 等待响应
     size_t size;
-    dap_packet_t *resp = (dap_packet_t *)xRingbufferReceive(dap_response_buf, &size, pdMS_TO_TICKS(100));
+    dap_packet_t *resp = (dap_packet_t *)xRingbufferReceive(engine->response_buf, &size, pdMS_TO_TICKS(100));
     if (!resp) {
         ESP_LOGW(TAG, "No response received");
         return ESP_FAIL;
@@ -106,44 +194,75 @@ esp_err_t dap_handle_request(uint8_t *request, uint16_t req_size, uint8_t *respo
     *resp_size = resp->length;
 
     // 释放缓冲区
-    vRingbufferReturnItem(dap_response_buf, resp);
+    vRingbufferReturnItem(engine->response_buf, resp);
     return ESP_OK;
 }
 
+esp_err_t dap_handle_port_take(uint8_t port, TickType_t timeout)
+{
+    if (port >= DAP_PORT_COUNT || dap_engines[port].mutex == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (xSemaphoreTake(dap_engines[port].mutex, timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // 调用任务从此访问该端口的 DAP_Data、引脚和 swd_host 状态
+    DAP_PortBind(port);
+    return ESP_OK;
+}
+
+void dap_handle_port_give(uint8_t port)
+{
+    if (port < DAP_PORT_COUNT && dap_engines[port].mutex != NULL) {
+        xSemaphoreGive(dap_engines[port].mutex);
+    }
+}
+
 void dap_handle_task(void *arg)
 {
+    dap_engine_t *engine = (dap_engine_t *)arg;
     size_t size;
     dap_packet_t response;
     uint32_t cmd_count = 0;
 
-    ESP_LOGI(TAG, "DAP 处理任务启动");
+    // 本任务只服务这一个端口
+    DAP_PortBind(engine->port);
+    ESP_LOGI(TAG, "DAP 处理任务启动, 端口 %u, 核 %d", engine->port, xPortGetCoreID());
 
     while (1) {
         // 等待请求
-        dap_packet_t *req = (dap_packet_t *)xRingbufferReceive(dap_request_buf, &size, portMAX_DELAY);
+        dap_packet_t *req = (dap_packet_t *)xRingbufferReceive(engine->request_buf, &size, portMAX_DELAY);
         if (!req) {
             continue;
         }
 
         cmd_count++;
         // 打印请求命令
-        ESP_LOGI(TAG, "[%lu] DAP 命令: 0x%02X, 长度: %d", cmd_count, req->buf[0], req->length);
+        ESP_LOGD(TAG, "[%u:%lu] DAP 命令: 0x%02X, 长度: %d", engine->port, cmd_count, req->buf[0], req->length);
         
         // 处理 DAP 命令
-        if (xSemaphoreTake(dap_mutex, portMAX_DELAY) == pdTRUE) {
+        if (xSemaphoreTake(engine->mutex, portMAX_DELAY) == pdTRUE) {
+            uint32_t start = TIMESTAMP_GET();
             response.length = DAP_ProcessCommand(req->buf, response.buf);
-            xSemaphoreGive(dap_mutex);
+            engine->latency_last = TIMESTAMP_GET() - start;
+            if (engine->latency_last > engine->latency_max) {
+                engine->latency_max = engine->latency_last;
+            }
+            xSemaphoreGive(engine->mutex);
 
             // 打印响应
-            ESP_LOGI(TAG, "[%lu] DAP 响应: 长度: %d", cmd_count, response.length);
+            ESP_LOGD(TAG, "[%u:%lu] DAP 响应: 长度: %d, 耗时: %lu us (最大 %lu us)", engine->port, cmd_count,
+                     response.length, engine->latency_last / (TIMESTAMP_CLOCK / 1000000U),
+                     engine->latency_max / (TIMESTAMP_CLOCK / 1000000U));
             
             // 发送响应
-            if (xRingbufferSend(dap_response_buf, &response, sizeof(dap_packet_t), pdMS_TO_TICKS(100)) != pdTRUE) {
-                ESP_LOGW(TAG, "[%lu] 发送响应失败", cmd_count);
+            if (xRingbufferSend(engine->response_buf, &response, sizeof(dap_packet_t), pdMS_TO_TICKS(100)) != pdTRUE) {
+                ESP_LOGW(TAG, "[%u:%lu] 发送响应失败", engine->port, cmd_count);
             }
         }
 
         // 释放请求缓冲区
-        vRingbufferReturnItem(dap_request_buf, req);
+        vRingbufferReturnItem(engine->request_buf, req);
     }
 }
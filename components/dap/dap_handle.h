@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
 
 // DAP 数据包大小
 #define DAP_PACKET_SIZE 64
@@ -22,8 +23,20 @@ esp_err_t dap_handle_init(void);
 // 反初始化 DAP 处理模块
 void dap_handle_deinit(void);
 
-// 处理 DAP 命令
+// 处理 DAP 命令 (调试端口 0)
 esp_err_t dap_handle_request(uint8_t *request, uint16_t req_size, uint8_t *response, uint16_t *resp_size);
 
-// DAP 处理任务
+// 在指定调试端口上处理 DAP 命令，由该端口的 DAP 任务执行
+esp_err_t dap_handle_request_port(uint8_t port, uint8_t *request, uint16_t req_size, uint8_t *response,
+                                  uint16_t *resp_size);
+
+// 独占调试端口并绑定到调用任务 (直接调用 swd_host 的脱机烧录用)，用完 dap_handle_port_give 释放。
+// 不同端口可在不同任务中并行烧录；调用任务应固定在 dap_handle_port_core(port) 上
+esp_err_t dap_handle_port_take(uint8_t port, TickType_t timeout);
+void dap_handle_port_give(uint8_t port);
+
+// 调试端口的 DAP 任务所在的核
+int dap_handle_port_core(uint8_t port);
+
+// DAP 处理任务，arg 为端口引擎
 void dap_handle_task(void *arg);
@@ -0,0 +1,438 @@
+/**
+ * @file gdb_server.c
+ * @brief 探针上的 GDB 服务器：CDC 上的远程串行协议直接通过 swd_host 访问目标
+ *
+ * 协议处理在 gdb_rsp.c，这里提供目标访问、烧录和任务。主机上不需要 OpenOCD/pyOCD，
+ * GDB 直接 "target remote /dev/ttyACM0" 连接探针的 CDC 串口。
+ *
+ * 和 RTT 引擎一样每轮占用调试端口后再访问目标，主机调试会话连接 (debug_port 不为 DISABLED)
+ * 时不碰目标。GDB 空闲时任务只在有数据时被唤醒；目标运行时每个节拍查询一次是否停下。
+ *
+ * vFlash 命令使用算法分区中的 .FLM：第一次擦除时构建缓存镜像并把算法写入目标 RAM，
+ * 擦除按扇区表逐个扇区进行，写入数据按页缓冲后调用 ProgramPage，vFlashDone 写出最后不满的页。
+ * 内存映射由同一个扇区表生成，映射以外的地址都作为 RAM 提供给 GDB。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "gdb_server.h"
+#include "dap_handle.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "swd_host.h"
+#include "gdb_rsp.h"
+#include "flash_algo.h"
+#include "sector_map.h"
+#include "image_map.h"
+#include "upload.h"
+
+static const char *TAG = "GDB";
+
+#define GDB_TASK_PRIORITY   3
+#define GDB_CHUNK           256U                    // 每次从 CDC 读取的最大字节数
+#define GDB_PORT_WAIT       pdMS_TO_TICKS(100)      // 等待端口的最长时间，烧录结束前 GDB 只能等着
+#define GDB_RETRY           pdMS_TO_TICKS(1000)     // 连接目标失败后的重试间隔
+#define GDB_IDLE            pdMS_TO_TICKS(200)      // GDB 未连接时的检查间隔
+#define GDB_ALGO_CACHE_SIZE 0x4000U                 // 算法缓存镜像 (扇区表 + 算法)
+#define GDB_MAP_SIZE        2048U                   // 内存映射 XML
+
+// FlashOS Init/UnInit 的功能码
+#define FLASH_FUNC_ERASE    1
+#define FLASH_FUNC_PROGRAM  2
+
+typedef struct {
+    TaskHandle_t task;
+    gdb_rsp_t rsp;
+
+    // 烧录算法，会话中第一次用到时加载
+    bool loaded;
+    uint8_t *cache;
+    uint8_t *page;                  // 页缓冲
+    flash_algo_t algo;
+    sector_map_t map;
+    bool on_target;                 // 算法已写入目标 RAM
+    uint32_t func;                  // 当前 Init 的功能码，0 = 未初始化
+    uint32_t page_size;
+    uint32_t page_addr;
+    bool page_dirty;
+    char xml[GDB_MAP_SIZE];
+} gdb_server_t;
+
+static gdb_server_t gdb;
+
+static uint8_t gdb_read_mem(void *ctx, uint32_t addr, uint8_t *data, uint32_t size)
+{
+    (void)ctx;
+    return swd_read_memory(addr, data, size);
+}
+
+static uint8_t gdb_write_mem(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    (void)ctx;
+    return swd_write_memory(addr, (uint8_t *)data, size);
+}
+
+static uint8_t gdb_read_reg(void *ctx, uint32_t sel, uint32_t *val)
+{
+    (void)ctx;
+    return swd_read_core_register(sel, val);
+}
+
+static uint8_t gdb_write_reg(void *ctx, uint32_t sel, uint32_t val)
+{
+    (void)ctx;
+    return swd_write_core_register(sel, val);
+}
+
+// 从映射的算法分区读 .FLM
+static uint8_t gdb_algo_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    const uint8_t *p = image_map_view((const image_map_t *)ctx, offset, len);
+
+    if (p == NULL) {
+        return 0;
+    }
+    memcpy(buf, p, len);
+    return 1;
+}
+
+static void gdb_algo_free(void)
+{
+    free(gdb.cache);
+    free(gdb.page);
+    gdb.cache = NULL;
+    gdb.page = NULL;
+    gdb.loaded = false;
+}
+
+// 加载算法分区中的 .FLM 并建立扇区表
+static bool gdb_algo_load(void)
+{
+    image_map_t m;
+    uint32_t used;
+    dap_err_t err;
+
+    if (gdb.loaded) {
+        return true;
+    }
+    err = image_map_open(&m, UPLOAD_PART_ALGO);
+    if (err != ERROR_SUCCESS) {
+        ESP_LOGW(TAG, "算法分区中没有 .FLM (%d)", err);
+        return false;
+    }
+    gdb.cache = malloc(GDB_ALGO_CACHE_SIZE);
+    err = (gdb.cache == NULL) ? ERROR_FAILURE : image_map_check(&m);
+    if (err == ERROR_SUCCESS) {
+        err = flash_algo_build(gdb_algo_read, &m, GDB_ALGO_RAM_START, GDB_ALGO_RAM_SIZE,
+                               gdb.cache, GDB_ALGO_CACHE_SIZE, &used);
+    }
+    image_map_close(&m);
+    if (err == ERROR_SUCCESS) {
+        err = flash_algo_load(gdb.cache, used, &gdb.algo);
+    }
+    if (err == ERROR_SUCCESS) {
+        sector_map_init(&gdb.map);
+        err = sector_map_add_algo(&gdb.map, &gdb.algo);
+    }
+    if (err != ERROR_SUCCESS) {
+        ESP_LOGE(TAG, "加载烧录算法失败: %s", error_get_string(err));
+        gdb_algo_free();
+        return false;
+    }
+
+    gdb.page_size = gdb.algo.device.page_size;
+    if (gdb.page_size > gdb.algo.target.program_buffer_size) {
+        gdb.page_size = gdb.algo.target.program_buffer_size;
+    }
+    gdb.page = malloc(gdb.page_size);
+    if (gdb.page == NULL) {
+        gdb_algo_free();
+        return false;
+    }
+    gdb.loaded = true;
+    ESP_LOGI(TAG, "烧录算法 %s, 0x%08lx + 0x%lx", gdb.algo.device.name,
+             gdb.algo.device.start, gdb.algo.device.size);
+    return true;
+}
+
+static bool gdb_algo_call(uint32_t entry, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+    return swd_flash_syscall_exec(&gdb.algo.target.sys_call_s, entry, a1, a2, a3, 0);
+}
+
+// 切换 Init 的功能码 (擦除/编程)，必要时先把算法写入目标 RAM
+static bool gdb_algo_init(uint32_t func)
+{
+    program_target_t *t = &gdb.algo.target;
+
+    if (!gdb_algo_load()) {
+        return false;
+    }
+    if (gdb.func == func) {
+        return true;
+    }
+    if (!gdb.on_target) {
+        if (!swd_write_memory(t->algo_start, (uint8_t *)t->algo_blob, t->algo_size)) {
+            return false;
+        }
+        gdb.on_target = true;
+    }
+    if (gdb.func != 0 && !gdb_algo_call(t->uninit, gdb.func, 0, 0)) {
+        gdb.func = 0;
+        return false;
+    }
+    gdb.func = 0;
+    if (!gdb_algo_call(t->init, gdb.algo.device.start, 0, func)) {
+        return false;
+    }
+    gdb.func = func;
+    return true;
+}
+
+static bool gdb_page_flush(void)
+{
+    program_target_t *t = &gdb.algo.target;
+
+    if (!gdb.page_dirty) {
+        return true;
+    }
+    gdb.page_dirty = false;
+    return swd_write_memory(t->program_buffer, gdb.page, gdb.page_size) &&
+           gdb_algo_call(t->program_page, gdb.page_addr, gdb.page_size, t->program_buffer);
+}
+
+static uint8_t gdb_flash_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+    sector_info_t sector;
+    uint32_t end = addr + size;
+
+    (void)ctx;
+    if (!gdb_algo_init(FLASH_FUNC_ERASE)) {
+        return 0;
+    }
+    while (addr < end) {
+        if (!sector_map_lookup(&gdb.map, addr, &sector, NULL)) {
+            return 0;
+        }
+        if (!gdb_algo_call(gdb.algo.target.erase_sector, sector.start, 0, 0)) {
+            ESP_LOGE(TAG, "擦除扇区 0x%08lx 失败", sector.start);
+            return 0;
+        }
+        addr = sector.start + sector.size;
+    }
+    return 1;
+}
+
+// GDB 按地址顺序写入，数据凑满一页后编程；跨页时先写出上一页
+static uint8_t gdb_flash_write(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    uint32_t base, offset, n;
+
+    (void)ctx;
+    if (!gdb_algo_init(FLASH_FUNC_PROGRAM)) {
+        return 0;
+    }
+    while (size != 0) {
+        base = addr - (addr - gdb.algo.device.start) % gdb.page_size;
+        if (!gdb.page_dirty || base != gdb.page_addr) {
+            if (!gdb_page_flush()) {
+                return 0;
+            }
+            memset(gdb.page, (uint8_t)gdb.algo.device.erased_value, gdb.page_size);
+            gdb.page_addr = base;
+        }
+        offset = addr - base;
+        n = gdb.page_size - offset;
+        if (n > size) {
+            n = size;
+        }
+        memcpy(gdb.page + offset, data, n);
+        gdb.page_dirty = true;
+        addr += n;
+        data += n;
+        size -= n;
+        if (offset + n == gdb.page_size && !gdb_page_flush()) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint8_t gdb_flash_done(void *ctx)
+{
+    bool ok;
+
+    (void)ctx;
+    if (!gdb.loaded) {
+        return 1;
+    }
+    ok = gdb_page_flush();
+    if (gdb.func != 0) {
+        ok &= gdb_algo_call(gdb.algo.target.uninit, gdb.func, 0, 0);
+        gdb.func = 0;
+    }
+    return ok;
+}
+
+// 扇区表中的区域作为 flash，其余地址作为 RAM
+static const char *gdb_memory_map(void *ctx)
+{
+    uint32_t start = 0;
+    int n;
+
+    (void)ctx;
+    n = snprintf(gdb.xml, sizeof(gdb.xml),
+                 "<?xml version=\"1.0\"?>"
+                 "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" "
+                 "\"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
+                 "<memory-map>");
+    if (gdb_algo_load()) {
+        for (uint32_t i = 0; i < gdb.map.run_count; i++) {
+            const sector_run_t *run = &gdb.map.runs[i];
+
+            if (run->start > start) {
+                n += snprintf(gdb.xml + n, sizeof(gdb.xml) - n,
+                              "<memory type=\"ram\" start=\"0x%lx\" length=\"0x%lx\"/>",
+                              start, run->start - start);
+            }
+            n += snprintf(gdb.xml + n, sizeof(gdb.xml) - n,
+                          "<memory type=\"flash\" start=\"0x%lx\" length=\"0x%lx\">"
+                          "<property name=\"blocksize\">0x%lx</property></memory>",
+                          run->start, run->end - run->start, run->size);
+            start = run->end;
+            if (n >= (int)sizeof(gdb.xml) - 128) {
+                break;
+            }
+        }
+    }
+    snprintf(gdb.xml + n, sizeof(gdb.xml) - n,
+             "<memory type=\"ram\" start=\"0x%lx\" length=\"0x%llx\"/></memory-map>",
+             start, 0x100000000ULL - start);
+    return gdb.xml;
+}
+
+static void gdb_output(void *ctx, const uint8_t *data, uint32_t num)
+{
+    (void)ctx;
+    gdb_host_write(data, num);
+}
+
+static const gdb_rsp_target_t gdb_target = {
+    .read_mem = gdb_read_mem,
+    .write_mem = gdb_write_mem,
+    .read_reg = gdb_read_reg,
+    .write_reg = gdb_write_reg,
+    .flash_erase = gdb_flash_erase,
+    .flash_write = gdb_flash_write,
+    .flash_done = gdb_flash_done,
+    .memory_map = gdb_memory_map,
+    .output = gdb_output,
+};
+
+// 会话结束：烧录算法留在 RAM 中的状态作废，下次会话重新加载
+static void gdb_end(void)
+{
+    if (gdb.rsp.attached) {
+        gdb_rsp_detach(&gdb.rsp);
+        ESP_LOGI(TAG, "GDB 断开");
+    }
+    gdb.on_target = false;
+    gdb.func = 0;
+    gdb.page_dirty = false;
+    gdb_algo_free();
+}
+
+// 占用端口后执行一步：连接目标、处理 GDB 数据、查询运行中的目标
+// 返回下一次执行前等待的节拍数
+static TickType_t gdb_step(void)
+{
+    static uint8_t buf[GDB_CHUNK];
+    uint32_t n;
+
+    if (!gdb.rsp.attached) {
+        // 新会话 (或 GDB 发出 D/k 后重新连接)，先停住目标
+        if (!swd_init_debug() || !gdb_rsp_attach(&gdb.rsp)) {
+            return GDB_RETRY;
+        }
+        gdb.on_target = false;
+        gdb.func = 0;
+        ESP_LOGI(TAG, "GDB 连接，目标已停止");
+    }
+
+    while ((n = gdb_host_read(buf, sizeof(buf))) != 0) {
+        gdb_rsp_input(&gdb.rsp, buf, n);
+    }
+    if (!gdb.rsp.attached) {
+        gdb_end();
+        return GDB_IDLE;
+    }
+    return gdb_rsp_poll(&gdb.rsp) ? 1 : portMAX_DELAY;
+}
+
+static void gdb_task(void *arg)
+{
+    TickType_t delay = GDB_IDLE;
+
+    (void)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, delay);
+
+        if (!gdb_host_connected()) {
+            if (gdb.rsp.attached && dap_handle_port_take(GDB_PORT, GDB_PORT_WAIT) == ESP_OK) {
+                // GDB 没有发 D 就关闭了串口，放开目标
+                if (DAP_Data.debug_port == DAP_PORT_DISABLED) {
+                    gdb_end();
+                }
+                dap_handle_port_give(GDB_PORT);
+            }
+            gdb.rsp.attached = 0;
+            delay = GDB_IDLE;
+            continue;
+        }
+
+        if (dap_handle_port_take(GDB_PORT, GDB_PORT_WAIT) != ESP_OK) {
+            delay = 1;
+            continue;
+        }
+        if (DAP_Data.debug_port != DAP_PORT_DISABLED) {
+            // 主机调试会话正在使用该端口
+            dap_handle_port_give(GDB_PORT);
+            delay = GDB_IDLE;
+            continue;
+        }
+        delay = gdb_step();
+        dap_handle_port_give(GDB_PORT);
+    }
+}
+
+esp_err_t gdb_server_init(void)
+{
+    gdb_rsp_init(&gdb.rsp, &gdb_target);
+    if (xTaskCreatePinnedToCore(gdb_task, "GDB", 6144, NULL, GDB_TASK_PRIORITY, &gdb.task,
+                                dap_handle_port_core(GDB_PORT)) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create GDB task");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void gdb_server_deinit(void)
+{
+    if (gdb.task) {
+        vTaskDelete(gdb.task);
+        gdb.task = NULL;
+    }
+}
+
+void gdb_wake(void)
+{
+    if (gdb.task) {
+        xTaskNotifyGive(gdb.task);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// GDB 服务器使用的调试端口
+#define GDB_PORT            0
+
+// 烧录算法在目标中使用的 RAM (算法、页缓冲和栈)，vFlash 命令会覆盖这段 RAM
+#define GDB_ALGO_RAM_START  0x20000000U
+#define GDB_ALGO_RAM_SIZE   0x4000U
+
+// 创建 GDB 服务器任务。CDC 串口被识别为 GDB 连接、且端口没有主机调试会话时停住目标，
+// 在 CDC 上提供 GDB 远程串行协议；烧录算法取自算法分区 (upload.h 的 UPLOAD_PART_ALGO)
+esp_err_t gdb_server_init(void);
+void gdb_server_deinit(void);
+
+// GDB 有新数据或断开，立即处理
+void gdb_wake(void);
+
+// 主机端 GDB 连接，由 USB 层 (usb_descriptors.c 的 CDC 接口) 提供
+bool gdb_host_connected(void);
+uint32_t gdb_host_read(uint8_t *buf, uint32_t size);
+void gdb_host_write(const uint8_t *buf, uint32_t num);
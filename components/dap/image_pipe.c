@@ -0,0 +1,227 @@
+/**
+ * @file image_pipe.c
+ * @brief 压缩镜像流水线：一个核解压，另一个核做 SWD 上传
+ *
+ * 解压任务固定在调试端口的 DAP 任务之外的核上，按顺序读取 image_store 块，解压到空闲
+ * 缓冲区后放入 full 队列；调用者 (端口所在的核) 取出块写入目标 RAM，写完后交还缓冲区。
+ * 两个缓冲区轮流使用，解压与 SWD 传输重叠进行。未压缩的块直接读入缓冲区，不做拷贝。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+#include "image_pipe.h"
+#include "dap_handle.h"
+#include "crc.h"
+
+static const char *TAG = "IMAGE_PIPE";
+
+// full 队列中的元素
+typedef struct {
+    image_pipe_block_t block;
+    esp_err_t status;
+} image_pipe_item_t;
+
+struct image_pipe {
+    image_pipe_read_t read;
+    void *ctx;
+    image_store_header_t header;
+    uint8_t *raw[IMAGE_PIPE_SLOTS];     // 解压输出缓冲区
+    uint8_t *comp;                      // 压缩数据缓冲区
+    QueueHandle_t free_q;               // 空闲缓冲区编号
+    QueueHandle_t full_q;               // 已解压的块
+    SemaphoreHandle_t done;             // 解压任务已退出
+    volatile bool abort;
+};
+
+// 读取并解压一个块到 slot
+static esp_err_t image_pipe_decode(image_pipe_t *pipe, uint8_t slot, image_pipe_block_t *out)
+{
+    image_store_block_t block;
+    uint32_t comp_size;
+
+    if (!pipe->read(pipe->ctx, &block, sizeof(block))) {
+        return ESP_FAIL;
+    }
+    if (image_store_check_block(&pipe->header, &block) != ERROR_SUCCESS) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    comp_size = block.comp_size & ~IMAGE_STORE_STORED;
+    if (block.comp_size & IMAGE_STORE_STORED) {
+        // 未压缩块直接读入输出缓冲区
+        if (!pipe->read(pipe->ctx, pipe->raw[slot], comp_size)) {
+            return ESP_FAIL;
+        }
+        if (crc32(pipe->raw[slot], block.raw_size) != block.crc) {
+            return ESP_ERR_INVALID_CRC;
+        }
+    } else {
+        if (!pipe->read(pipe->ctx, pipe->comp, comp_size)) {
+            return ESP_FAIL;
+        }
+        if (image_store_decode_block(&block, pipe->comp, pipe->raw[slot], pipe->header.block_size) != ERROR_SUCCESS) {
+            return ESP_ERR_INVALID_CRC;
+        }
+    }
+
+    out->addr = block.addr;
+    out->size = block.raw_size;
+    out->data = pipe->raw[slot];
+    out->slot = slot;
+    return ESP_OK;
+}
+
+static void image_pipe_task(void *arg)
+{
+    image_pipe_t *pipe = (image_pipe_t *)arg;
+    image_pipe_item_t item = { 0 };
+    uint8_t slot;
+    uint32_t i;
+
+    for (i = 0; i < pipe->header.block_count; i++) {
+        xQueueReceive(pipe->free_q, &slot, portMAX_DELAY);
+        if (pipe->abort) {
+            break;
+        }
+
+        item.status = image_pipe_decode(pipe, slot, &item.block);
+        xQueueSend(pipe->full_q, &item, portMAX_DELAY);
+        if (item.status != ESP_OK) {
+            ESP_LOGE(TAG, "块 %lu 解压失败: %s", i, esp_err_to_name(item.status));
+            break;
+        }
+    }
+
+    if (i == pipe->header.block_count) {
+        // 结束标记
+        item.status = ESP_ERR_NOT_FOUND;
+        xQueueSend(pipe->full_q, &item, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(pipe->done);
+    vTaskDelete(NULL);
+}
+
+static void image_pipe_free(image_pipe_t *pipe)
+{
+    for (int i = 0; i < IMAGE_PIPE_SLOTS; i++) {
+        heap_caps_free(pipe->raw[i]);
+    }
+    heap_caps_free(pipe->comp);
+    if (pipe->free_q) {
+        vQueueDelete(pipe->free_q);
+    }
+    if (pipe->full_q) {
+        vQueueDelete(pipe->full_q);
+    }
+    if (pipe->done) {
+        vSemaphoreDelete(pipe->done);
+    }
+    free(pipe);
+}
+
+esp_err_t image_pipe_open(image_pipe_t **pipe_out, uint8_t port, image_pipe_read_t read, void *ctx,
+                          image_store_header_t *header)
+{
+    image_pipe_t *pipe;
+    int core = (dap_handle_port_core(port) + 1) % portNUM_PROCESSORS;
+
+    if (!pipe_out || !read) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pipe = calloc(1, sizeof(image_pipe_t));
+    if (pipe == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    pipe->read = read;
+    pipe->ctx = ctx;
+
+    // 读取并校验容器头
+    if (!read(ctx, &pipe->header, sizeof(pipe->header)) || image_store_check_header(&pipe->header) != ERROR_SUCCESS) {
+        ESP_LOGE(TAG, "镜像头无效");
+        free(pipe);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    // 缓冲区放在内部 RAM，解压和 SWD 访问都更快
+    for (int i = 0; i < IMAGE_PIPE_SLOTS; i++) {
+        pipe->raw[i] = heap_caps_malloc(pipe->header.block_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    pipe->comp = heap_caps_malloc(IMAGE_STORE_BOUND(pipe->header.block_size), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    pipe->free_q = xQueueCreate(IMAGE_PIPE_SLOTS, sizeof(uint8_t));
+    pipe->full_q = xQueueCreate(IMAGE_PIPE_SLOTS + 1, sizeof(image_pipe_item_t));
+    pipe->done = xSemaphoreCreateBinary();
+    if (!pipe->raw[IMAGE_PIPE_SLOTS - 1] || !pipe->raw[0] || !pipe->comp || !pipe->free_q || !pipe->full_q || !pipe->done) {
+        ESP_LOGE(TAG, "内存不足");
+        image_pipe_free(pipe);
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (uint8_t slot = 0; slot < IMAGE_PIPE_SLOTS; slot++) {
+        xQueueSend(pipe->free_q, &slot, 0);
+    }
+
+    if (xTaskCreatePinnedToCore(image_pipe_task, "IMAGE_PIPE", 4096, pipe, configMAX_PRIORITIES - 3,
+                                NULL, core) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create pipe task");
+        image_pipe_free(pipe);
+        return ESP_FAIL;
+    }
+
+    if (header) {
+        *header = pipe->header;
+    }
+    ESP_LOGI(TAG, "镜像: %lu 块, 块大小 %lu, 原始 %lu 字节, 压缩 %lu 字节", pipe->header.block_count,
+             pipe->header.block_size, pipe->header.raw_size, pipe->header.data_size);
+    *pipe_out = pipe;
+    return ESP_OK;
+}
+
+esp_err_t image_pipe_next(image_pipe_t *pipe, image_pipe_block_t *block)
+{
+    image_pipe_item_t item;
+
+    if (!pipe || !block) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xQueueReceive(pipe->full_q, &item, portMAX_DELAY);
+    if (item.status != ESP_OK) {
+        // 让后续调用得到同样的结果
+        xQueueSendToFront(pipe->full_q, &item, 0);
+        return item.status;
+    }
+    *block = item.block;
+    return ESP_OK;
+}
+
+void image_pipe_release(image_pipe_t *pipe, const image_pipe_block_t *block)
+{
+    if (pipe && block) {
+        xQueueSend(pipe->free_q, &block->slot, portMAX_DELAY);
+    }
+}
+
+void image_pipe_close(image_pipe_t *pipe)
+{
+    uint8_t slot = 0;
+
+    if (!pipe) {
+        return;
+    }
+
+    // 唤醒可能在等待空闲缓冲区的解压任务，然后等它退出
+    pipe->abort = true;
+    xQueueSend(pipe->free_q, &slot, 0);
+    xSemaphoreTake(pipe->done, portMAX_DELAY);
+    image_pipe_free(pipe);
+}
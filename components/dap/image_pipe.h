@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "image_store.h"
+
+// 解压缓冲区数量 (双缓冲：一块在 SWD 上传，一块在解压)
+#define IMAGE_PIPE_SLOTS 2
+
+// 顺序读回调：读取 len 字节到 buf，成功返回 1
+typedef uint8_t (*image_pipe_read_t)(void *ctx, void *buf, uint32_t len);
+
+// 解压后的一个块，data 在 image_pipe_release 之前有效
+typedef struct {
+    uint32_t addr;
+    uint32_t size;
+    uint8_t *data;
+    uint8_t slot;
+} image_pipe_block_t;
+
+typedef struct image_pipe image_pipe_t;
+
+// 读取容器头并启动解压任务。解压任务运行在调试端口 port 的 DAP 任务之外的核上，
+// 调用者 (上传块的任务) 应固定在 dap_handle_port_core(port) 上
+esp_err_t image_pipe_open(image_pipe_t **pipe, uint8_t port, image_pipe_read_t read, void *ctx,
+                          image_store_header_t *header);
+
+// 取下一个解压好的块；ESP_ERR_NOT_FOUND 表示已到末尾
+esp_err_t image_pipe_next(image_pipe_t *pipe, image_pipe_block_t *block);
+
+// 块已上传完毕，缓冲区交还给解压任务
+void image_pipe_release(image_pipe_t *pipe, const image_pipe_block_t *block);
+
+// 停止解压任务并释放资源
+void image_pipe_close(image_pipe_t *pipe);
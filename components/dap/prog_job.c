@@ -0,0 +1,793 @@
+/**
+ * @file prog_job.c
+ * @brief 脱机烧录任务：把镜像分区中的镜像烧录到调试端口上的目标
+ *
+ * 任务由厂商命令启动 (DAP_vendor.c)，固定在端口 DAP 任务所在的核上。烧录算法取自算法分区，
+ * 镜像取自镜像分区，两者都由上传命令或 U 盘写入；任务期间以读者身份映射镜像分区，
+ * 同时写入的一方得到 ERROR_IMAGE_BUSY。
+ *
+ * 和自动调速一样，端口只在每一步 (连接、擦除一个扇区、编程一页) 中占用，DAP 任务在步骤之间
+ * 回答状态查询。任务期间 debug_port 标为 SWD，RTT 引擎和 GDB 服务器不碰目标。
+ *
+ * 步骤：加载算法并建立扇区表，统计镜像覆盖的地址范围，按扇区表擦除，编程，复位运行。
+ * 压缩容器 (U 盘存入的格式) 在目标 RAM 放得下解压程序时原样上传，由目标解压后编程
+ * (target_lz4.c)，SWD 上只传压缩数据；放不下时由 image_pipe 在另一个核上逐块解压，
+ * 本任务把解压好的块逐页编程。
+ *
+ * HEX/S-record/ELF/UF2 文件解码、拼成整页后存入 PSRAM 中的镜像缓存 (image_cache.c)，键是文件
+ * 内容的哈希。统计地址范围和编程都从缓存重放；产线上反复烧录同一个镜像时不再读分区、不再解码。
+ * 缓存由所有端口共用，查找和建立时加锁，重放的条目已被钉住，不用加锁。镜像大到缓存放不下时
+ * 直接解码两遍，一遍统计范围，一遍编程。
+ * 二进制文件直接从映射编程 (image_map_program)，只有首尾不满一页的部分经过页缓冲。
+ *
+ * 擦除前先查空 (blank_check.c)：已经是空的扇区不擦。查空程序和目标端解压程序用同一段 RAM，
+ * prog_store_target 在编程前重新加载解压程序。主机声明镜像占满整个器件时允许整片擦除，
+ * 由代价模型决定；实测的扇区擦除时间留给该端口下一次同一器件的烧录。
+ *
+ * 一拖多 (swd_gang.c)：端口 0 的 SWCLK 同时驱动多块相同的目标板，每块板有自己的 SWDIO 和
+ * nRESET，所有目标同时收到同样的数据，烧录 N 块的时间和 1 块相同。出错的目标被剔除，其余
+ * 继续；状态中报告仍然有效的目标。各目标内容不同，因此一拖多时不查空 (按擦除计划全部擦除)，
+ * 压缩容器也不在目标上解压。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+#include "prog_job.h"
+#include "dap_handle.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "swd_host.h"
+#include "swd_gang.h"
+#include "debug_cm.h"
+#include "flash_algo.h"
+#include "sector_map.h"
+#include "image_map.h"
+#include "image_store.h"
+#include "image_pipe.h"
+#include "image_decoder.h"
+#include "image_cache.h"
+#include "page_asm.h"
+#include "target_lz4.h"
+#include "blank_check.h"
+#include "upload.h"
+
+static const char *TAG = "PROG";
+
+#define PROG_TASK_PRIORITY   3
+#define PROG_ALGO_CACHE_SIZE 0x4000U    // 算法缓存镜像 (扇区表 + 算法)
+#define PROG_RANGES          64U        // 镜像中不连续的地址范围
+#define PROG_PLAN_SIZE       64U        // 擦除计划中的扇区段
+#define PROG_ASM_PAGES       4U         // 解码时拼页用的页缓冲数
+#define PROG_CACHE_SIZE      0x400000U  // PSRAM 中镜像缓存的容量
+#define PROG_GANG_PORT       0U         // swd_gang 使用端口 0 的 SWCLK/SWDIO/nRESET
+#define PROG_GANG_RESET_MS   20U
+#define DBG_Addr             (0xe000edf0)
+
+// FlashOS Init/UnInit 的功能码
+#define FLASH_FUNC_ERASE    1
+#define FLASH_FUNC_PROGRAM  2
+
+typedef struct {
+    uint8_t port;
+    uint8_t flags;                  // PROG_JOB_CHIP_ERASE
+    uint8_t gang;                   // 一拖多的目标数，0 = 单个目标
+    volatile uint8_t gang_mask;     // 仍然有效的目标
+    volatile uint8_t state;
+    volatile uint8_t result;
+    volatile uint32_t done;
+    volatile uint32_t total;
+
+    image_map_t image;
+    uint32_t read_pos;              // image_pipe 顺序读取的位置，只由解压任务访问
+    uint8_t *cache;                 // 算法缓存镜像
+    uint8_t *page;                  // 不满一页时的页缓冲
+    flash_algo_t algo;
+    sector_map_t map;
+    uint32_t page_size;
+    uint32_t func;                  // 当前 Init 的功能码，0 = 未初始化
+    bool connected;
+    sector_range_t ranges[PROG_RANGES];
+    uint32_t range_count;
+    sector_extent_t plan[PROG_PLAN_SIZE];
+    uint32_t plan_count;
+    blank_check_t blank;            // 查空和擦除计划的状态，每个端口一份
+    sector_extent_t erase[PROG_PLAN_SIZE];
+    uint32_t erase_count;
+    uint8_t chip;                   // 1 = 整片擦除代替 erase
+    uint32_t erase_us_per_kb;       // 上次实测的擦除速度，0 = 未测
+    uint32_t erase_device;          // 实测时器件的起始地址
+    target_lz4_t lz4;               // 目标端解压程序的位置
+    bool lz4_fits;
+    image_decoder_t dec;
+    page_asm_t pages;
+    image_cache_entry_t *entry;     // 解码后的镜像，钉住到任务结束；NULL = 缓存放不下
+} prog_job_t;
+
+static prog_job_t prog_jobs[DAP_PORT_COUNT];
+static portMUX_TYPE prog_lock = portMUX_INITIALIZER_UNLOCKED;
+static image_cache_t prog_cache;
+static SemaphoreHandle_t prog_cache_lock = NULL;
+
+// 从映射的算法分区读 .FLM
+static uint8_t prog_algo_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    const uint8_t *p = image_map_view((const image_map_t *)ctx, offset, len);
+
+    if (p == NULL) {
+        return 0;
+    }
+    memcpy(buf, p, len);
+    return 1;
+}
+
+// 加载算法分区中的 .FLM 并建立扇区表
+static dap_err_t prog_algo_load(prog_job_t *job)
+{
+    image_map_t m;
+    uint32_t used;
+    dap_err_t err;
+
+    err = image_map_open(&m, UPLOAD_PART_ALGO);
+    if (err != ERROR_SUCCESS) {
+        return (err == ERROR_IMAGE_BUSY) ? err : ERROR_ALGO_MISSING;
+    }
+    job->cache = malloc(PROG_ALGO_CACHE_SIZE);
+    err = (job->cache == NULL) ? ERROR_FAILURE : image_map_check(&m);
+    if (err == ERROR_SUCCESS) {
+        err = flash_algo_build(prog_algo_read, &m, PROG_ALGO_RAM_START, PROG_ALGO_RAM_SIZE,
+                               job->cache, PROG_ALGO_CACHE_SIZE, &used);
+    }
+    image_map_close(&m);
+    if (err == ERROR_SUCCESS) {
+        err = flash_algo_load(job->cache, used, &job->algo);
+    }
+    if (err == ERROR_SUCCESS) {
+        sector_map_init(&job->map);
+        err = sector_map_add_algo(&job->map, &job->algo);
+    }
+    if (err != ERROR_SUCCESS) {
+        return err;
+    }
+
+    // ProgramPage 的长度：不超过编程缓冲区，取 2 的幂，页地址按它对齐
+    job->page_size = job->algo.device.page_size;
+    if (job->page_size > job->algo.target.program_buffer_size) {
+        job->page_size = job->algo.target.program_buffer_size;
+    }
+    while ((job->page_size & (job->page_size - 1)) != 0) {
+        job->page_size &= job->page_size - 1;
+    }
+    job->page = malloc(job->page_size);
+    if (job->page_size == 0 || job->page == NULL) {
+        return ERROR_ALGO_DATA_SEQ;
+    }
+    ESP_LOGI(TAG, "[%u] 烧录算法 %s, 0x%08lx + 0x%lx, 页 %lu", job->port, job->algo.device.name,
+             job->algo.device.start, job->algo.device.size, job->page_size);
+    return ERROR_SUCCESS;
+}
+
+// 记录一段要编程的地址，按页对齐；和上一段相接或落在同一页时合并
+static dap_err_t prog_add_range(prog_job_t *job, uint32_t addr, uint32_t size)
+{
+    uint32_t start = addr & ~(job->page_size - 1);
+    uint32_t end = (addr + size + job->page_size - 1) & ~(job->page_size - 1);
+    sector_range_t *last = (job->range_count != 0) ? &job->ranges[job->range_count - 1] : NULL;
+
+    if (last != NULL && start >= last->start && start <= last->start + last->size) {
+        if (end > last->start + last->size) {
+            job->total += end - (last->start + last->size);
+            last->size = end - last->start;
+        }
+        return ERROR_SUCCESS;
+    }
+    if (job->range_count == PROG_RANGES) {
+        return ERROR_SECTOR_MAP;
+    }
+    job->ranges[job->range_count].start = start;
+    job->ranges[job->range_count].size = end - start;
+    job->range_count++;
+    job->total += end - start;
+    return ERROR_SUCCESS;
+}
+
+// 压缩容器：逐个读块头，跳过块数据。块头在映射中不一定按字对齐，先复制出来
+static dap_err_t prog_store_ranges(prog_job_t *job)
+{
+    image_store_header_t header;
+    image_store_block_t block;
+    const uint8_t *p;
+    uint32_t offset = sizeof(header);
+    dap_err_t err;
+
+    p = image_map_view(&job->image, 0, sizeof(header));
+    if (p == NULL) {
+        return ERROR_IMAGE_STORE;
+    }
+    memcpy(&header, p, sizeof(header));
+    err = image_store_check_header(&header);
+    if (err == ERROR_SUCCESS) {
+        job->lz4_fits = job->gang == 0 &&
+                        target_lz4_place(&job->algo.target, header.block_size, &job->lz4) == ERROR_SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < header.block_count && err == ERROR_SUCCESS; i++) {
+        p = image_map_view(&job->image, offset, sizeof(block));
+        if (p == NULL) {
+            return ERROR_IMAGE_STORE;
+        }
+        memcpy(&block, p, sizeof(block));
+        err = image_store_check_block(&header, &block);
+        if (err == ERROR_SUCCESS) {
+            err = prog_add_range(job, block.addr, block.raw_size);
+        }
+        offset += sizeof(block) + (block.comp_size & ~IMAGE_STORE_STORED);
+    }
+    return err;
+}
+
+// 只统计地址范围的页回调
+static dap_err_t prog_range_page(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    (void)data;
+    return prog_add_range((prog_job_t *)ctx, addr, size);
+}
+
+// 解码 HEX/S-record/ELF/UF2 镜像，拼好的整页交给 write。文件在映射中，一次交给解码器
+static dap_err_t prog_decode(prog_job_t *job, page_write_t write, void *ctx)
+{
+    uint32_t pool_size = PROG_ASM_PAGES * job->page_size;
+    uint8_t *pool = malloc(pool_size);
+    dap_err_t err;
+
+    if (pool == NULL) {
+        return ERROR_FAILURE;
+    }
+    err = page_asm_init(&job->pages, pool, pool_size, job->page_size, (uint8_t)job->algo.device.erased_value,
+                        write, ctx);
+    if (err == ERROR_SUCCESS) {
+        image_decoder_init(&job->dec, (image_format_t)job->image.header.format, job->image.header.base,
+                           page_asm_record, &job->pages);
+        err = image_decoder_write(&job->dec, image_map_view(&job->image, 0, job->image.header.size),
+                                  job->image.header.size);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = image_decoder_finish(&job->dec);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = page_asm_flush(&job->pages);
+    }
+    free(pool);
+    return err;
+}
+
+// 解码后的镜像：缓存中没有时解码并存入缓存，然后从缓存统计地址范围
+static dap_err_t prog_decoded_ranges(prog_job_t *job)
+{
+    uint32_t layout[2] = { job->page_size, job->algo.device.erased_value };
+    image_cache_key_t key;
+    image_cache_builder_t b;
+    dap_err_t err = ERROR_SUCCESS;
+
+    // 页大小和擦除值也算进键里，同一文件换了烧录算法就重新解码
+    image_cache_key_init(&key);
+    image_cache_key_update(&key, image_map_view(&job->image, 0, job->image.header.size), job->image.header.size);
+    image_cache_key_update(&key, (const uint8_t *)layout, sizeof(layout));
+
+    xSemaphoreTake(prog_cache_lock, portMAX_DELAY);
+    job->entry = image_cache_find(&prog_cache, &key);
+    if (job->entry == NULL && image_cache_begin(&prog_cache, &key, job->page_size, &b) == ERROR_SUCCESS) {
+        err = prog_decode(job, image_cache_page, &b);
+        if (err == ERROR_SUCCESS) {
+            job->entry = image_cache_commit(&b);
+        } else {
+            image_cache_abort(&b);
+        }
+    } else if (job->entry != NULL) {
+        ESP_LOGI(TAG, "[%u] 镜像在缓存中", job->port);
+    }
+    xSemaphoreGive(prog_cache_lock);
+
+    if (job->entry != NULL) {
+        return image_cache_replay(job->entry, prog_range_page, job);
+    }
+    if (err != ERROR_SUCCESS && err != ERROR_IMAGE_CACHE) {
+        return err;
+    }
+    ESP_LOGW(TAG, "[%u] 镜像缓存放不下，编程时重新解码", job->port);
+    return prog_decode(job, prog_range_page, job);
+}
+
+// 统计镜像覆盖的地址范围，得到擦除计划
+static dap_err_t prog_plan(prog_job_t *job)
+{
+    dap_err_t err;
+
+    switch (job->image.header.format) {
+    case IMAGE_MAP_FORMAT_STORE:
+        err = prog_store_ranges(job);
+        break;
+    case IMAGE_FORMAT_HEX:
+    case IMAGE_FORMAT_SREC:
+    case IMAGE_FORMAT_ELF:
+    case IMAGE_FORMAT_UF2:
+        err = prog_decoded_ranges(job);
+        break;
+    case IMAGE_FORMAT_BIN:
+        err = prog_add_range(job, job->image.header.base, job->image.header.size);
+        break;
+    default:
+        err = ERROR_IMAGE_PARSER;
+        break;
+    }
+    if (err == ERROR_SUCCESS) {
+        err = sector_map_plan(&job->map, job->ranges, job->range_count, job->plan, PROG_PLAN_SIZE,
+                              &job->plan_count);
+    }
+    return err;
+}
+
+// 一拖多时下面两个函数作用于所有有效目标，只要还有目标有效就算成功
+static bool prog_call(prog_job_t *job, uint32_t entry, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+    if (job->gang != 0) {
+        job->gang_mask = swd_gang_flash_syscall_exec(&job->algo.target.sys_call_s, entry, a1, a2, a3, 0);
+        return job->gang_mask != 0;
+    }
+    return swd_flash_syscall_exec(&job->algo.target.sys_call_s, entry, a1, a2, a3, 0);
+}
+
+static bool prog_write(prog_job_t *job, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    if (job->gang != 0) {
+        job->gang_mask = swd_gang_write_memory(addr, data, size);
+        return job->gang_mask != 0;
+    }
+    return swd_write_memory(addr, (uint8_t *)data, size);
+}
+
+// 切换 Init 的功能码 (擦除/编程)，调用者已占用端口
+static bool prog_algo_init(prog_job_t *job, uint32_t func)
+{
+    program_target_t *t = &job->algo.target;
+
+    if (job->func == func) {
+        return true;
+    }
+    if (job->func != 0 && !prog_call(job, t->uninit, job->func, 0, 0)) {
+        job->func = 0;
+        return false;
+    }
+    job->func = 0;
+    if (!prog_call(job, t->init, job->algo.device.start, 0, func)) {
+        return false;
+    }
+    job->func = func;
+    return true;
+}
+
+// 复位目标并停在复位向量，写入烧录算法
+static dap_err_t prog_connect(prog_job_t *job)
+{
+    program_target_t *t = &job->algo.target;
+    dap_err_t err = ERROR_SUCCESS;
+
+    if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+        return ERROR_FAILURE;
+    }
+    if (job->gang != 0) {
+        job->gang_mask = swd_gang_init(job->gang);
+        if (job->gang_mask != 0) {
+            job->gang_mask = swd_gang_reset_program();
+        }
+        if (job->gang_mask == 0) {
+            err = ERROR_RESET;
+        }
+    } else if (!swd_set_target_state_hw(RESET_PROGRAM)) {
+        err = ERROR_RESET;
+    }
+    if (err == ERROR_SUCCESS && !prog_write(job, t->algo_start, (const uint8_t *)t->algo_blob, t->algo_size)) {
+        err = ERROR_ALGO_DL;
+    }
+    // swd_init 复位了端口状态，从这里到任务结束端口都算作在用
+    DAP_Data.debug_port = DAP_PORT_SWD;
+    job->connected = true;
+    dap_handle_port_give(job->port);
+    return err;
+}
+
+// 查空，把擦除计划缩减为需要擦除的扇区，或者改为整片擦除
+static dap_err_t prog_blank_check(prog_job_t *job)
+{
+    dap_err_t err;
+
+    blank_check_init(&job->blank, &job->algo, job->flags & PROG_JOB_CHIP_ERASE);
+    if (job->erase_us_per_kb != 0 && job->erase_device == job->algo.device.start) {
+        job->blank.erase_us_per_kb = job->erase_us_per_kb;
+    }
+    // 目标 RAM 放不下查空程序时由本机读回比较
+    blank_check_place(&job->blank, &job->algo.target);
+
+    if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+        return ERROR_FAILURE;
+    }
+    err = blank_check_load(&job->blank);
+    if (err == ERROR_SUCCESS) {
+        err = blank_check_plan(&job->blank, &job->map, job->plan, job->plan_count, job->erase, PROG_PLAN_SIZE,
+                               &job->erase_count, &job->chip);
+    }
+    dap_handle_port_give(job->port);
+    if (err == ERROR_SUCCESS) {
+        ESP_LOGI(TAG, "[%u] 查空 %lu 个扇区, 跳过 %lu 个%s", job->port, job->blank.checked, job->blank.skipped,
+                 job->chip ? ", 整片擦除" : "");
+    }
+    return err;
+}
+
+// 擦除一个扇区或整片 (sector == NULL)，调用者已占用端口；扇区擦除的耗时交给代价模型
+static dap_err_t prog_erase_one(prog_job_t *job, const sector_info_t *sector)
+{
+    uint32_t start;
+    bool ok;
+
+    if (!prog_algo_init(job, FLASH_FUNC_ERASE)) {
+        return ERROR_INIT;
+    }
+    if (sector == NULL) {
+        return prog_call(job, job->algo.target.erase_chip, 0, 0, 0) ? ERROR_SUCCESS : ERROR_ERASE_ALL;
+    }
+    start = TIMESTAMP_GET();
+    ok = prog_call(job, job->algo.target.erase_sector, sector->start, 0, 0);
+    if (!ok) {
+        ESP_LOGE(TAG, "[%u] 擦除扇区 0x%08lx 失败", job->port, sector->start);
+        return ERROR_ERASE_SECTOR;
+    }
+    blank_check_learn(&job->blank, sector->size, (TIMESTAMP_GET() - start) / (TIMESTAMP_CLOCK / 1000000U));
+    return ERROR_SUCCESS;
+}
+
+// 按查空后的擦除列表逐个扇区擦除，每个扇区占用一次端口
+static dap_err_t prog_erase(prog_job_t *job)
+{
+    sector_info_t sector;
+    uint32_t addr, k;
+    dap_err_t err = ERROR_SUCCESS;
+
+    if (job->gang != 0) {
+        memcpy(job->erase, job->plan, job->plan_count * sizeof(job->plan[0]));
+        job->erase_count = job->plan_count;
+    } else {
+        err = prog_blank_check(job);
+    }
+    if (err == ERROR_SUCCESS && job->chip) {
+        if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+            return ERROR_FAILURE;
+        }
+        err = prog_erase_one(job, NULL);
+        dap_handle_port_give(job->port);
+        return err;
+    }
+
+    for (uint32_t i = 0; i < job->erase_count && err == ERROR_SUCCESS; i++) {
+        for (k = 0, addr = job->erase[i].start; k < job->erase[i].count && err == ERROR_SUCCESS;
+             k++, addr += sector.size) {
+            if (!sector_map_lookup(&job->map, addr, &sector, NULL)) {
+                return ERROR_ALGO_MISSING;
+            }
+            if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+                return ERROR_FAILURE;
+            }
+            err = prog_erase_one(job, &sector);
+            dap_handle_port_give(job->port);
+        }
+    }
+    if (job->erase_count != 0) {
+        job->erase_us_per_kb = job->blank.erase_us_per_kb;
+        job->erase_device = job->algo.device.start;
+    }
+    return err;
+}
+
+// 编程一页 (page_write_t)：数据写入目标的编程缓冲区后调用 ProgramPage
+static dap_err_t prog_page(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    prog_job_t *job = (prog_job_t *)ctx;
+    program_target_t *t = &job->algo.target;
+    dap_err_t err = ERROR_SUCCESS;
+
+    if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+        return ERROR_FAILURE;
+    }
+    if (!prog_algo_init(job, FLASH_FUNC_PROGRAM)) {
+        err = ERROR_INIT;
+    } else if (!prog_write(job, t->program_buffer, data, size)) {
+        err = ERROR_ALGO_DATA_SEQ;
+    } else if (!prog_call(job, t->program_page, addr, size, t->program_buffer)) {
+        ESP_LOGE(TAG, "[%u] 编程 0x%08lx 失败", job->port, addr);
+        err = ERROR_WRITE;
+    }
+    dap_handle_port_give(job->port);
+    if (err == ERROR_SUCCESS) {
+        job->done += size;
+    }
+    return err;
+}
+
+// 一段连续数据逐页编程。整页直接从 data 上传，首尾不满一页的部分用擦除值补齐
+static dap_err_t prog_data(prog_job_t *job, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    uint32_t page, skip, chunk;
+    dap_err_t err = ERROR_SUCCESS;
+
+    while (size != 0 && err == ERROR_SUCCESS) {
+        page = addr & ~(job->page_size - 1);
+        skip = addr - page;
+        chunk = job->page_size - skip;
+        if (chunk > size) {
+            chunk = size;
+        }
+        if (chunk == job->page_size) {
+            err = prog_page(job, page, data, chunk);
+        } else {
+            memset(job->page, (uint8_t)job->algo.device.erased_value, job->page_size);
+            memcpy(job->page + skip, data, chunk);
+            err = prog_page(job, page, job->page, job->page_size);
+        }
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return err;
+}
+
+// image_pipe 的顺序读回调，在解压任务中执行
+static uint8_t prog_pipe_read(void *ctx, void *buf, uint32_t len)
+{
+    prog_job_t *job = (prog_job_t *)ctx;
+    const uint8_t *p = image_map_view(&job->image, job->read_pos, len);
+
+    if (p == NULL) {
+        return 0;
+    }
+    memcpy(buf, p, len);
+    job->read_pos += len;
+    return 1;
+}
+
+// 压缩容器：另一个核解压下一块的同时，本任务编程上一块
+static dap_err_t prog_store_pipe(prog_job_t *job)
+{
+    image_pipe_t *pipe;
+    image_pipe_block_t block;
+    esp_err_t ret = ESP_OK;
+    dap_err_t err = ERROR_SUCCESS;
+
+    job->read_pos = 0;
+    if (image_pipe_open(&pipe, job->port, prog_pipe_read, job, NULL) != ESP_OK) {
+        return ERROR_IMAGE_STORE;
+    }
+    while (err == ERROR_SUCCESS && (ret = image_pipe_next(pipe, &block)) == ESP_OK) {
+        err = prog_data(job, block.addr, block.data, block.size);
+        image_pipe_release(pipe, &block);
+    }
+    if (err == ERROR_SUCCESS && ret != ESP_ERR_NOT_FOUND) {
+        err = ERROR_IMAGE_STORE;
+    }
+    image_pipe_close(pipe);
+    return err;
+}
+
+// 压缩容器：块数据原样上传到目标 RAM，在目标上解压后逐页编程
+static dap_err_t prog_store_target(prog_job_t *job)
+{
+    image_store_header_t header;
+    image_store_block_t block;
+    const uint8_t *p;
+    uint32_t offset = sizeof(header), comp;
+    dap_err_t err;
+
+    // 容器已在 prog_store_ranges 中检查过
+    memcpy(&header, image_map_view(&job->image, 0, sizeof(header)), sizeof(header));
+    if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+        return ERROR_FAILURE;
+    }
+    err = target_lz4_load(&job->lz4);
+    dap_handle_port_give(job->port);
+
+    for (uint32_t i = 0; i < header.block_count && err == ERROR_SUCCESS; i++) {
+        memcpy(&block, image_map_view(&job->image, offset, sizeof(block)), sizeof(block));
+        comp = block.comp_size & ~IMAGE_STORE_STORED;
+        p = image_map_view(&job->image, offset + sizeof(block), comp);
+        if (p == NULL) {
+            return ERROR_IMAGE_STORE;
+        }
+        if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+            return ERROR_FAILURE;
+        }
+        err = prog_algo_init(job, FLASH_FUNC_PROGRAM) ? target_lz4_program(&job->algo.target, &job->lz4, &block, p) :
+                                                        ERROR_INIT;
+        dap_handle_port_give(job->port);
+        if (err == ERROR_SUCCESS) {
+            job->done += block.raw_size;
+        }
+        offset += sizeof(block) + comp;
+    }
+    return err;
+}
+
+static dap_err_t prog_program(prog_job_t *job)
+{
+    switch (job->image.header.format) {
+    case IMAGE_MAP_FORMAT_STORE:
+        return job->lz4_fits ? prog_store_target(job) : prog_store_pipe(job);
+    case IMAGE_FORMAT_HEX:
+    case IMAGE_FORMAT_SREC:
+    case IMAGE_FORMAT_ELF:
+    case IMAGE_FORMAT_UF2:
+        return (job->entry != NULL) ? image_cache_replay(job->entry, prog_page, job) : prog_decode(job, prog_page, job);
+    case IMAGE_FORMAT_BIN:
+        return image_map_program(&job->image, job->page_size, (uint8_t)job->algo.device.erased_value, job->page,
+                                 prog_page, job);
+    default:
+        return ERROR_IMAGE_PARSER;
+    }
+}
+
+// 结束算法，成功时复位目标运行，失败时只放开引脚；端口交还给主机和 RTT/GDB
+static void prog_finish(prog_job_t *job, bool ok)
+{
+    if (dap_handle_port_take(job->port, portMAX_DELAY) != ESP_OK) {
+        return;
+    }
+    if (job->func != 0) {
+        prog_call(job, job->algo.target.uninit, job->func, 0, 0);
+        job->func = 0;
+    }
+    if (job->gang != 0) {
+        // 退出调试后复位运行
+        if (ok && swd_gang_write_word(DBG_HCSR, DBGKEY) != 0) {
+            swd_gang_set_reset(swd_gang_active(), 1);
+            vTaskDelay(pdMS_TO_TICKS(PROG_GANG_RESET_MS));
+            swd_gang_set_reset(swd_gang_active(), 0);
+        }
+        job->gang_mask = swd_gang_active();
+        swd_gang_off();
+    } else if (!ok || !swd_set_target_state_hw(RESET_RUN)) {
+        swd_off();
+    }
+    DAP_Data.debug_port = DAP_PORT_DISABLED;
+    job->connected = false;
+    dap_handle_port_give(job->port);
+}
+
+static dap_err_t prog_run(prog_job_t *job)
+{
+    dap_err_t err;
+
+    err = image_map_open(&job->image, UPLOAD_PART_IMAGE);
+    if (err == ERROR_SUCCESS) {
+        err = image_map_check(&job->image);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = prog_algo_load(job);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = prog_plan(job);
+    }
+    if (err == ERROR_SUCCESS) {
+        ESP_LOGI(TAG, "[%u] 镜像 %lu 字节, 擦除 %lu 段", job->port, job->total, job->plan_count);
+        err = prog_connect(job);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = prog_erase(job);
+    }
+    if (err == ERROR_SUCCESS) {
+        err = prog_program(job);
+    }
+    if (job->connected) {
+        prog_finish(job, err == ERROR_SUCCESS);
+    }
+
+    if (job->entry != NULL) {
+        xSemaphoreTake(prog_cache_lock, portMAX_DELAY);
+        image_cache_release(&prog_cache, job->entry);
+        xSemaphoreGive(prog_cache_lock);
+        job->entry = NULL;
+    }
+    image_map_close(&job->image);
+    free(job->cache);
+    free(job->page);
+    job->cache = NULL;
+    job->page = NULL;
+    return err;
+}
+
+static void prog_job_task(void *arg)
+{
+    prog_job_t *job = (prog_job_t *)arg;
+    dap_err_t err = prog_run(job);
+
+    if (err == ERROR_SUCCESS) {
+        ESP_LOGI(TAG, "[%u] 烧录完成, %lu 字节", job->port, job->done);
+    } else {
+        ESP_LOGE(TAG, "[%u] 烧录失败: %s", job->port, error_get_string(err));
+    }
+    job->result = (uint8_t)err;
+    job->state = (err == ERROR_SUCCESS) ? PROG_JOB_DONE : PROG_JOB_FAILED;
+    vTaskDelete(NULL);
+}
+
+esp_err_t prog_job_init(void)
+{
+    prog_cache_lock = xSemaphoreCreateMutex();
+    if (prog_cache_lock == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    image_cache_init(&prog_cache, PROG_CACHE_SIZE, NULL);
+    return ESP_OK;
+}
+
+bool prog_job_start(uint8_t port, uint8_t flags, uint8_t gang)
+{
+    prog_job_t *job;
+    bool busy;
+
+    if (port >= DAP_PORT_COUNT || prog_cache_lock == NULL ||
+        (gang != 0 && (port != PROG_GANG_PORT || gang > SWD_GANG_MAX))) {
+        return false;
+    }
+    job = &prog_jobs[port];
+
+    // 任何端口的 DAP 任务都可以为任一端口启动任务
+    portENTER_CRITICAL(&prog_lock);
+    busy = (job->state == PROG_JOB_BUSY);
+    if (!busy) {
+        job->state = PROG_JOB_BUSY;
+    }
+    portEXIT_CRITICAL(&prog_lock);
+    if (busy) {
+        return false;
+    }
+
+    memset(&job->image, 0, sizeof(job->image));
+    job->port = port;
+    job->flags = flags;
+    job->gang = gang;
+    job->gang_mask = 0;
+    job->result = ERROR_SUCCESS;
+    job->done = 0;
+    job->total = 0;
+    job->func = 0;
+    job->connected = false;
+    job->range_count = 0;
+    job->plan_count = 0;
+    job->erase_count = 0;
+    job->chip = 0;
+    job->lz4_fits = false;
+    job->entry = NULL;
+
+    if (xTaskCreatePinnedToCore(prog_job_task, "PROG", 6144, job, PROG_TASK_PRIORITY, NULL,
+                                dap_handle_port_core(port)) != pdPASS) {
+        job->result = ERROR_FAILURE;
+        job->state = PROG_JOB_FAILED;
+        return false;
+    }
+    return true;
+}
+
+void prog_job_get_status(uint8_t port, prog_job_status_t *status)
+{
+    memset(status, 0, sizeof(*status));
+    if (port >= DAP_PORT_COUNT) {
+        return;
+    }
+    status->state = prog_jobs[port].state;
+    status->result = prog_jobs[port].result;
+    status->done = prog_jobs[port].done;
+    status->total = prog_jobs[port].total;
+    status->gang = prog_jobs[port].gang_mask;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// 烧录算法在目标中使用的 RAM (算法、页缓冲和栈)，烧录会覆盖这段 RAM
+#define PROG_ALGO_RAM_START 0x20000000U
+#define PROG_ALGO_RAM_SIZE  0x4000U
+
+// 烧录任务状态，prog_job_get_status()
+#define PROG_JOB_IDLE       0U      // 该端口还没有启动过烧录
+#define PROG_JOB_BUSY       1U      // 正在烧录
+#define PROG_JOB_DONE       2U      // 烧录完成，目标已复位运行
+#define PROG_JOB_FAILED     3U      // 烧录失败，result 为错误码
+
+// prog_job_start() 的 flags
+#define PROG_JOB_CHIP_ERASE 0x01U   // 镜像占满整个器件，允许整片擦除
+
+typedef struct {
+    uint8_t state;          // PROG_JOB_IDLE ..
+    uint8_t result;         // dap_err_t
+    uint32_t done;          // 已交给 ProgramPage 的字节数
+    uint32_t total;         // 需要编程的字节数，统计出来之前为 0
+    uint8_t gang;           // 一拖多：仍然有效的目标 (bit n = 目标 n)，单个目标时为 0
+} prog_job_status_t;
+
+// 建立各端口共用的镜像缓存 (PSRAM)
+esp_err_t prog_job_init(void);
+
+// 在后台任务中把镜像分区 (upload.h 的 UPLOAD_PART_IMAGE) 中的镜像烧录到调试端口上的目标，
+// 烧录算法取自算法分区 (UPLOAD_PART_ALGO)。任务结束前主机不应使用该端口。
+// gang 不为 0 时在端口 0 上同时烧录 gang 块相同的目标板 (swd_gang.h)。
+// 返回 false 表示端口或目标数无效、该端口已有任务在运行或无法创建任务
+bool prog_job_start(uint8_t port, uint8_t flags, uint8_t gang);
+
+// 端口上最近一次烧录任务的状态
+void prog_job_get_status(uint8_t port, prog_job_status_t *status);
@@ -0,0 +1,360 @@
+/**
+ * @file rtt.c
+ * @brief SEGGER RTT 引擎：在探针上找控制块，上行通道 0 转发到 CDC，CDC 输入写入下行通道 0
+ *
+ * 只在 CDC 终端打开时工作。每次访问目标都以不等待的方式占用调试端口：端口被脱机烧录
+ * 或 DAP 命令占用时跳过本轮，主机调试会话连接 (debug_port 不为 DISABLED) 时完全不碰
+ * 目标，所以不会和烧录或主机调试器争抢 SWD 带宽。任务优先级低于 DAP 任务。
+ *
+ * 控制块搜索按 RTT_SCAN_BLOCK 分段块读目标 RAM，每段之间释放端口；段内按对齐的字比较
+ * "SEGG"，命中后再读控制块头核对完整 ID。轮询时一次块读取上行/下行通道 0 的描述符，
+ * 数据按主机端剩余空间读取，主机来不及接收时数据留在目标缓冲区，不丢失。
+ * 轮询间隔随缓冲区占用变化：有数据时在一个节拍内连续读取，空闲时逐步加倍到 RTT_POLL_MAX。
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "rtt.h"
+#include "dap_handle.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "swd_host.h"
+
+static const char *TAG = "RTT";
+
+#define RTT_TASK_PRIORITY   3
+#define RTT_SCAN_BLOCK      1024U                   // 每次占用端口搜索的字节数
+#define RTT_CHUNK           1024U                   // 每次转发的最大字节数
+#define RTT_MAX_BUFFERS     16U                     // 控制块中通道数的合理上限
+#define RTT_POLL_MAX        pdMS_TO_TICKS(100)      // 空闲时的最长轮询间隔
+#define RTT_RETRY           pdMS_TO_TICKS(1000)     // 连接或搜索失败后的重试间隔
+#define RTT_IDLE            pdMS_TO_TICKS(200)      // 终端未打开或端口被主机使用时的检查间隔
+
+#define RTT_ID_WORD         0x47474553U             // "SEGG"，小端
+#define RTT_CB_HEADER       24U                     // acID[16], MaxNumUpBuffers, MaxNumDownBuffers
+
+// 目标中的 SEGGER_RTT_BUFFER_UP / SEGGER_RTT_BUFFER_DOWN
+typedef struct {
+    uint32_t name;
+    uint32_t buffer;
+    uint32_t size;
+    uint32_t wr;
+    uint32_t rd;
+    uint32_t flags;
+} rtt_buffer_t;
+
+#define RTT_WR_OFFSET       12U
+#define RTT_RD_OFFSET       16U
+
+typedef struct {
+    TaskHandle_t task;
+    volatile uint32_t search_base;
+    volatile uint32_t search_size;
+    volatile bool restart;          // 搜索范围改变
+    bool attached;                  // SWD 已连接
+    uint32_t scan;                  // 下一段搜索地址
+    uint32_t cb;
+    uint32_t num_up;
+    uint32_t num_down;
+    uint32_t up_bytes;
+    uint32_t down_bytes;
+} rtt_engine_t;
+
+static rtt_engine_t rtt = {
+    .search_base = RTT_SEARCH_BASE,
+    .search_size = RTT_SEARCH_SIZE,
+};
+
+static uint8_t rtt_data[RTT_CHUNK];
+
+// 核对控制块头，成功时记录地址和通道数
+static bool rtt_check(uint32_t addr)
+{
+    static const char id[] = "SEGGER RTT";
+    uint32_t header[RTT_CB_HEADER / 4];
+
+    if (!swd_read_memory(addr, (uint8_t *)header, sizeof(header))) {
+        return false;
+    }
+    if (memcmp(header, id, sizeof(id)) != 0 ||
+        header[4] == 0 || header[4] > RTT_MAX_BUFFERS || header[5] > RTT_MAX_BUFFERS) {
+        return false;
+    }
+    rtt.cb = addr;
+    rtt.num_up = header[4];
+    rtt.num_down = header[5];
+    return true;
+}
+
+// 搜索一段目标 RAM
+// 返回 false 表示 SWD 出错
+static bool rtt_scan_block(void)
+{
+    static uint32_t block[RTT_SCAN_BLOCK / 4];
+    uint32_t end = rtt.search_base + rtt.search_size;
+    uint32_t n = end - rtt.scan;
+
+    if (n > RTT_SCAN_BLOCK) {
+        n = RTT_SCAN_BLOCK;
+    }
+    if (!swd_read_memory(rtt.scan, (uint8_t *)block, n)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < n / 4; i++) {
+        if (block[i] == RTT_ID_WORD && rtt_check(rtt.scan + i * 4)) {
+            ESP_LOGI(TAG, "控制块 0x%08lx, 上行 %lu, 下行 %lu", rtt.cb, rtt.num_up, rtt.num_down);
+            return true;
+        }
+    }
+    rtt.scan += n;
+    return true;
+}
+
+// 读环形缓冲区 [rd, rd + n)，可能回绕
+static bool rtt_read_ring(const rtt_buffer_t *buf, uint32_t rd, uint8_t *data, uint32_t n)
+{
+    uint32_t first = buf->size - rd;
+
+    if (first > n) {
+        first = n;
+    }
+    if (!swd_read_memory(buf->buffer + rd, data, first)) {
+        return false;
+    }
+    return n == first || swd_read_memory(buf->buffer, data + first, n - first);
+}
+
+static bool rtt_write_ring(const rtt_buffer_t *buf, uint32_t wr, uint8_t *data, uint32_t n)
+{
+    uint32_t first = buf->size - wr;
+
+    if (first > n) {
+        first = n;
+    }
+    if (!swd_write_memory(buf->buffer + wr, data, first)) {
+        return false;
+    }
+    return n == first || swd_write_memory(buf->buffer, data + first, n - first);
+}
+
+// 轮询一次通道 0
+// 返回 -1 表示 SWD 出错或描述符无效，否则为轮询前上行缓冲区中的字节数
+static int rtt_poll(void)
+{
+    rtt_buffer_t desc[RTT_MAX_BUFFERS + 1];
+    rtt_buffer_t *up = &desc[0];
+    rtt_buffer_t *down = &desc[rtt.num_up];
+    uint32_t up_addr = rtt.cb + RTT_CB_HEADER;
+    uint32_t down_addr = up_addr + rtt.num_up * sizeof(rtt_buffer_t);
+    uint32_t count = rtt.num_up + (rtt.num_down ? 1 : 0);
+    uint32_t avail, n;
+    int level;
+
+    // 上行通道 0 到下行通道 0 的描述符一次读完
+    if (!swd_read_memory(up_addr, (uint8_t *)desc, count * sizeof(rtt_buffer_t))) {
+        return -1;
+    }
+    if (up->size == 0 || up->wr >= up->size || up->rd >= up->size) {
+        return -1;
+    }
+
+    avail = (up->wr >= up->rd) ? up->wr - up->rd : up->size - up->rd + up->wr;
+    level = (int)avail;
+    n = rtt_host_space();
+    if (n > avail) {
+        n = avail;
+    }
+    if (n > RTT_CHUNK) {
+        n = RTT_CHUNK;
+    }
+    if (n != 0) {
+        if (!rtt_read_ring(up, up->rd, rtt_data, n)) {
+            return -1;
+        }
+        up->rd = (up->rd + n) % up->size;
+        if (!swd_write_memory(up_addr + RTT_RD_OFFSET, (uint8_t *)&up->rd, 4)) {
+            return -1;
+        }
+        rtt.up_bytes += rtt_host_write(rtt_data, n);
+    }
+
+    if (rtt.num_down != 0 && down->size != 0 && down->wr < down->size && down->rd < down->size) {
+        // 留一个字节区分满和空
+        avail = (down->rd > down->wr) ? down->rd - down->wr - 1 : down->size - down->wr + down->rd - 1;
+        if (avail > RTT_CHUNK) {
+            avail = RTT_CHUNK;
+        }
+        n = avail ? rtt_host_read(rtt_data, avail) : 0;
+        if (n != 0) {
+            if (!rtt_write_ring(down, down->wr, rtt_data, n)) {
+                return -1;
+            }
+            // 数据写完后再更新 WrOff
+            down->wr = (down->wr + n) % down->size;
+            if (!swd_write_memory(down_addr + RTT_WR_OFFSET, (uint8_t *)&down->wr, 4)) {
+                return -1;
+            }
+            rtt.down_bytes += n;
+        }
+    }
+    return level;
+}
+
+// 控制块失效，重新搜索
+static void rtt_lost(void)
+{
+    rtt.cb = 0;
+    rtt.scan = rtt.search_base;
+}
+
+// 放开目标，控制块地址保留，重新连接后核对
+static void rtt_detach(void)
+{
+    rtt.attached = false;
+}
+
+// 占用端口后执行一步：连接、搜索或轮询
+// 返回下一次执行前等待的节拍数
+static TickType_t rtt_step(TickType_t delay)
+{
+    TickType_t start;
+    bool moved = false;
+    int level;
+
+    if (rtt.restart) {
+        rtt.restart = false;
+        rtt_lost();
+    }
+
+    if (!rtt.attached) {
+        if (!swd_init_debug()) {
+            return RTT_RETRY;
+        }
+        rtt.attached = true;
+        // 目标可能已复位或更换了程序，重新核对控制块
+        if (rtt.cb != 0 && !rtt_check(rtt.cb)) {
+            rtt_lost();
+        }
+    }
+
+    if (rtt.cb == 0) {
+        if (rtt.search_size == 0) {
+            if (!rtt_check(rtt.search_base)) {
+                return RTT_RETRY;
+            }
+        } else if (!rtt_scan_block()) {
+            rtt_detach();
+            return RTT_RETRY;
+        } else if (rtt.cb == 0) {
+            if (rtt.scan < rtt.search_base + rtt.search_size) {
+                return 1;
+            }
+            // 搜完一遍没找到，目标可能还没初始化 RTT
+            rtt.scan = rtt.search_base;
+            return RTT_RETRY;
+        }
+        return 1;
+    }
+
+    // 有数据时在一个节拍内连续轮询，下个节拍继续；每个节拍至少睡一次，空闲任务才能运行
+    start = xTaskGetTickCount();
+    do {
+        level = rtt_poll();
+        if (level < 0) {
+            rtt_detach();
+            return RTT_RETRY;
+        }
+        moved |= (level != 0);
+    } while (level != 0 && rtt_host_space() != 0 && xTaskGetTickCount() == start);
+
+    if (moved) {
+        return 1;
+    }
+    if (delay < RTT_POLL_MAX) {
+        return (delay * 2 < RTT_POLL_MAX) ? delay * 2 : RTT_POLL_MAX;
+    }
+    // 长时间空闲，顺便核对控制块是否还在
+    if (!rtt_check(rtt.cb)) {
+        rtt_lost();
+        return 1;
+    }
+    return RTT_POLL_MAX;
+}
+
+static void rtt_task(void *arg)
+{
+    TickType_t delay = RTT_IDLE;
+
+    (void)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, delay);
+
+        if (!rtt_host_connected()) {
+            if (rtt.attached) {
+                rtt_detach();
+            }
+            delay = RTT_IDLE;
+            continue;
+        }
+
+        // 端口忙 (脱机烧录或 DAP 命令) 时不等待，下一轮再试
+        if (dap_handle_port_take(RTT_PORT, 0) != ESP_OK) {
+            delay = 1;
+            continue;
+        }
+        if (DAP_Data.debug_port != DAP_PORT_DISABLED) {
+            // 主机调试会话正在使用该端口，它缓存的 AP 状态不能被打乱
+            dap_handle_port_give(RTT_PORT);
+            rtt_detach();
+            delay = RTT_IDLE;
+            continue;
+        }
+        delay = rtt_step(delay);
+        dap_handle_port_give(RTT_PORT);
+    }
+}
+
+esp_err_t rtt_init(void)
+{
+    rtt_lost();
+    if (xTaskCreatePinnedToCore(rtt_task, "RTT", 4096, NULL, RTT_TASK_PRIORITY, &rtt.task,
+                                dap_handle_port_core(RTT_PORT)) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create RTT task");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void rtt_deinit(void)
+{
+    if (rtt.task) {
+        vTaskDelete(rtt.task);
+        rtt.task = NULL;
+    }
+}
+
+void rtt_set_search(uint32_t base, uint32_t size)
+{
+    rtt.search_base = base & ~3U;
+    rtt.search_size = size & ~3U;
+    rtt.restart = true;
+    rtt_wake();
+}
+
+void rtt_get_status(rtt_status_t *status)
+{
+    status->cb = rtt.cb;
+    status->up_bytes = rtt.up_bytes;
+    status->down_bytes = rtt.down_bytes;
+}
+
+void rtt_wake(void)
+{
+    if (rtt.task) {
+        xTaskNotifyGive(rtt.task);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// RTT 引擎使用的调试端口
+#define RTT_PORT            0
+
+// 默认控制块搜索范围 (Cortex-M SRAM 起始 64KB)
+#define RTT_SEARCH_BASE     0x20000000U
+#define RTT_SEARCH_SIZE     0x10000U
+
+typedef struct {
+    uint32_t cb;            // 控制块地址，0 = 未找到
+    uint32_t up_bytes;      // 上行通道 0 转发到主机的字节数
+    uint32_t down_bytes;    // 写入下行通道 0 的字节数
+} rtt_status_t;
+
+// 创建 RTT 任务。CDC 终端打开、且端口没有主机调试会话时连接目标，
+// 找到 _SEGGER_RTT 后在上行通道 0 和 CDC 之间转发数据
+esp_err_t rtt_init(void);
+void rtt_deinit(void);
+
+// 设置控制块搜索范围，size 为 0 时 base 就是控制块地址；重新搜索
+void rtt_set_search(uint32_t base, uint32_t size);
+
+void rtt_get_status(rtt_status_t *status);
+
+// 主机有新输入，立即轮询
+void rtt_wake(void);
+
+// 主机端终端，由 USB 层 (usb_descriptors.c 的 CDC 接口) 提供
+bool rtt_host_connected(void);
+uint32_t rtt_host_space(void);
+uint32_t rtt_host_write(const uint8_t *buf, uint32_t num);
+uint32_t rtt_host_read(uint8_t *buf, uint32_t size);
@@ -0,0 +1,197 @@
+/**
+ * @file msc_disk.c
+ * @brief USB MSC 虚拟磁盘：拖放文件即可烧录
+ *
+ * 读请求在 USB 任务中直接由 virtual_fs 按扇区生成 (不保存磁盘映像)；写请求只把扇区复制到
+ * 空闲缓冲区后放入队列，由固定在 MSC_DISK_CORE 上的任务交给 virtual_fs 解码，
+ * 这样 USB 传输与解码、写入镜像分区同时进行。缓冲区用完时返回 0，TinyUSB
+ * 稍后重试 (流控)。一次任务结束后报告介质更换，主机重新读取 STATUS.TXT。
+ *
+ * 解码、擦写和任务结束时整个镜像的回读校验都只在 MSC 任务中进行，不持有 vfs_lock；
+ * 读请求用的是每个扇区处理完后复制出来的状态 (view)，vfs_lock 只保护这次复制。
+ * 镜像分区由 image_map 的分区占用记录和上传命令 (upload.c) 互斥，正在上传时拖入的
+ * 文件以 ERROR_IMAGE_BUSY 结束。
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "tusb.h"
+
+#include "msc_disk.h"
+
+static const char *TAG = "MSC_DISK";
+
+// 写队列中的一个扇区
+typedef struct {
+    uint32_t sector;
+    uint8_t buf;
+} msc_write_t;
+
+static virtual_fs_t vfs;                           // 只由 MSC 任务访问
+static virtual_fs_t view;                          // 读请求看到的状态
+static SemaphoreHandle_t vfs_lock = NULL;          // 保护 view，读写分别在两个任务中
+static QueueHandle_t free_q = NULL;                // 空闲缓冲区编号
+static QueueHandle_t write_q = NULL;               // 待处理的扇区
+static uint8_t buffers[MSC_DISK_BUFFERS][VFS_SECTOR_SIZE];
+static volatile bool media_changed = false;
+static TickType_t not_ready_until = 0;
+
+static void msc_disk_task(void *param)
+{
+    (void)param;
+    msc_write_t item;
+
+    while (1) {
+        bool got = xQueueReceive(write_q, &item, pdMS_TO_TICKS(MSC_DISK_TIMEOUT_MS)) == pdTRUE;
+
+        if (got) {
+            virtual_fs_write(&vfs, item.sector, buffers[item.buf]);
+        } else {
+            virtual_fs_timeout(&vfs);
+        }
+
+        xSemaphoreTake(vfs_lock, portMAX_DELAY);
+        virtual_fs_status_copy(&view, &vfs);
+        xSemaphoreGive(vfs_lock);
+
+        if (virtual_fs_changed(&vfs)) {
+            ESP_LOGI(TAG, "任务 %lu 结束: %s", vfs.jobs, error_get_string(vfs.result));
+            media_changed = true;
+        }
+
+        if (got) {
+            xQueueSend(free_q, &item.buf, 0);
+        }
+    }
+}
+
+esp_err_t msc_disk_init(const virtual_fs_sink_t *sink)
+{
+    if (!sink || !sink->open || !sink->record || !sink->close) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    vfs_lock = xSemaphoreCreateMutex();
+    free_q = xQueueCreate(MSC_DISK_BUFFERS, sizeof(uint8_t));
+    write_q = xQueueCreate(MSC_DISK_BUFFERS, sizeof(msc_write_t));
+    if (!vfs_lock || !free_q || !write_q) {
+        ESP_LOGE(TAG, "Failed to create queues");
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint8_t i = 0; i < MSC_DISK_BUFFERS; i++) {
+        xQueueSend(free_q, &i, 0);
+    }
+
+    virtual_fs_init(&vfs, sink);
+    virtual_fs_init(&view, sink);
+
+    if (xTaskCreatePinnedToCore(msc_disk_task, "MSC_DISK", 6144, NULL, configMAX_PRIORITIES - 3, NULL,
+                                MSC_DISK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create MSC task");
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "虚拟磁盘 %lu 扇区", (uint32_t)VFS_SECTOR_COUNT);
+    return ESP_OK;
+}
+
+//--------------------------------------------------------------------+
+// TinyUSB MSC 回调
+//--------------------------------------------------------------------+
+
+void tud_msc_inquiry_cb(uint8_t lun, uint8_t vendor_id[8], uint8_t product_id[16], uint8_t product_rev[4])
+{
+    (void)lun;
+    memcpy(vendor_id, "XING    ", 8);
+    memcpy(product_id, "DAPLink Offline ", 16);
+    memcpy(product_rev, "1.0 ", 4);
+}
+
+bool tud_msc_test_unit_ready_cb(uint8_t lun)
+{
+    if (media_changed) {
+        media_changed = false;
+        not_ready_until = xTaskGetTickCount() + pdMS_TO_TICKS(MSC_DISK_EJECT_MS);
+    }
+    if ((int32_t)(not_ready_until - xTaskGetTickCount()) > 0) {
+        tud_msc_set_sense(lun, SCSI_SENSE_NOT_READY, 0x3A, 0x00);  // Medium not present
+        return false;
+    }
+    return true;
+}
+
+void tud_msc_capacity_cb(uint8_t lun, uint32_t *block_count, uint16_t *block_size)
+{
+    (void)lun;
+    *block_count = VFS_SECTOR_COUNT;
+    *block_size = VFS_SECTOR_SIZE;
+}
+
+bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, bool load_eject)
+{
+    (void)lun;
+    (void)power_condition;
+    (void)start;
+    (void)load_eject;
+    return true;
+}
+
+int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
+{
+    (void)lun;
+    uint8_t *out = (uint8_t *)buffer;
+
+    if (offset != 0 || (bufsize % VFS_SECTOR_SIZE) != 0) {
+        return -1;
+    }
+
+    // MSC 任务正在复制状态时不阻塞 USB 任务，返回 0 由 TinyUSB 稍后重试
+    if (xSemaphoreTake(vfs_lock, 0) != pdTRUE) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < bufsize / VFS_SECTOR_SIZE; i++) {
+        virtual_fs_read(&view, lba + i, out + i * VFS_SECTOR_SIZE);
+    }
+    xSemaphoreGive(vfs_lock);
+    return (int32_t)bufsize;
+}
+
+int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize)
+{
+    (void)lun;
+    uint32_t done = 0;
+    msc_write_t item;
+
+    if (offset != 0 || (bufsize % VFS_SECTOR_SIZE) != 0) {
+        return -1;
+    }
+
+    // 只接收有空闲缓冲区的扇区，其余的由 TinyUSB 稍后重新提交
+    while (done < bufsize && xQueueReceive(free_q, &item.buf, 0) == pdTRUE) {
+        item.sector = lba + done / VFS_SECTOR_SIZE;
+        memcpy(buffers[item.buf], buffer + done, VFS_SECTOR_SIZE);
+        xQueueSend(write_q, &item, portMAX_DELAY);
+        done += VFS_SECTOR_SIZE;
+    }
+    return (int32_t)done;
+}
+
+int32_t tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, uint16_t bufsize)
+{
+    (void)buffer;
+    (void)bufsize;
+
+    switch (scsi_cmd[0]) {
+    case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
+        return 0;
+
+    default:
+        tud_msc_set_sense(lun, SCSI_SENSE_ILLEGAL_REQUEST, 0x20, 0x00);  // Invalid command
+        return -1;
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "esp_err.h"
+#include "virtual_fs.h"
+
+// 处理写入扇区的任务所在的核 (DAP 任务在另一个核上)
+#define MSC_DISK_CORE 0
+
+// 写入扇区缓冲数量：USB 接收与解码并行进行
+#define MSC_DISK_BUFFERS 16
+
+// 超过该时间没有写入，则认为文件已传输完毕
+#define MSC_DISK_TIMEOUT_MS 1000
+
+// 介质更换后报告未就绪的时间，主机据此重新读取目录
+#define MSC_DISK_EJECT_MS 500
+
+// 启动虚拟磁盘，拖入的文件解码后交给 sink
+esp_err_t msc_disk_init(const virtual_fs_sink_t *sink);
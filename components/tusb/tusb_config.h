@@ -33,6 +33,8 @@
 #ifndef _TUSB_CONFIG_H_
 #define _TUSB_CONFIG_H_
 
+#include "sdkconfig.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -81,6 +83,23 @@ extern "C" {
 // 启用 HID 通用输入输出功能
 #define CFG_TUD_HID_GENERIC      1
 
+//--------------------------------------------------------------------+
+// MSC 设备类配置
+//--------------------------------------------------------------------+
+
+// 启用 MSC 设备类（拖放烧录虚拟磁盘，msc_disk.c 实现回调，不使用 esp_tinyusb 的 MSC 存储驱动）
+// 和 SWO 流式跟踪端点二选一 (Kconfig DAP_USB_EXTRA_IN)
+#undef CFG_TUD_MSC
+#ifdef CONFIG_DAP_USB_MSC
+#define CFG_TUD_MSC              1
+#else
+#define CFG_TUD_MSC              0
+#endif
+
+// MSC 缓冲区，一个扇区
+#undef CFG_TUD_MSC_EP_BUFSIZE
+#define CFG_TUD_MSC_EP_BUFSIZE   512
+
 #ifdef __cplusplus
 }
 #endif
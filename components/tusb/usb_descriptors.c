@@ -5,13 +5,14 @@
  * @LastEditTime: 2025-02-15 17:21:44
  * @FilePath: \Offline_download_tool\components\tusb\usb_descriptors.c
  */
+#include <string.h>
 #include "tusb.h"
 #include "device/usbd.h"
 #include "class/cdc/cdc.h"
 #include "usb_descriptors.h"
 #include "tinyusb.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
 
 static const char *TAG = "USB";
 
@@ -23,6 +24,7 @@ enum {
     STRID_SERIAL,
     STRID_CDC,
     STRID_VENDOR,
+    STRID_MSC,
     STRID_NUM
 };
 
@@ -31,12 +33,33 @@ enum {
 #define EPNUM_CDC_OUT     0x02  // CDC输出端点
 #define EPNUM_CDC_IN      0x82  // CDC输入端点
 
-// VENDOR端点 (CMSIS-DAP v2)
+// VENDOR端点 (CMSIS-DAP v2)，SWO 端点 EPNUM_VENDOR_SWO 见 usb_descriptors.h
 #define EPNUM_VENDOR_OUT   0x03  // VENDOR输出端点
 #define EPNUM_VENDOR_IN    0x83  // VENDOR输入端点
 
+// MSC端点 (拖放烧录虚拟磁盘)
+#define EPNUM_MSC_OUT      0x04  // MSC输出端点
+#define EPNUM_MSC_IN       0x84  // MSC输入端点
+
+#ifdef CONFIG_DAP_USB_SWO_STREAM
+#define TUD_CMSIS_DAP_DESCRIPTOR(_itfnum, _stridx, _epout, _epin, _epswo, _epsize) \
+    9, TUSB_DESC_INTERFACE, _itfnum, 0, 3, TUSB_CLASS_VENDOR_SPECIFIC, 0x00, 0x00, _stridx, \
+    7, TUSB_DESC_ENDPOINT, _epout, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0, \
+    7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0, \
+    7, TUSB_DESC_ENDPOINT, _epswo, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0
+#else
+#define TUD_CMSIS_DAP_DESCRIPTOR(_itfnum, _stridx, _epout, _epin, _epswo, _epsize) \
+    TUD_VENDOR_DESCRIPTOR(_itfnum, _stridx, _epout, _epin, _epsize)
+#endif
+
+#ifdef CONFIG_DAP_USB_MSC
+#define USB_MSC_DESC_LEN   TUD_MSC_DESC_LEN
+#else
+#define USB_MSC_DESC_LEN   0
+#endif
+
 // 配置描述符总长度
-#define CONFIG_TOTAL_LEN (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + TUD_VENDOR_DESC_LEN)
+#define CONFIG_TOTAL_LEN (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + TUD_CMSIS_DAP_DESC_LEN + USB_MSC_DESC_LEN)
 
 // 设备描述符
 static const tusb_desc_device_t desc_device = {
@@ -67,8 +90,13 @@ static const uint8_t desc_configuration[] = {
                       8, EPNUM_CDC_OUT, EPNUM_CDC_IN, 64),
 
     // VENDOR描述符（CMSIS-DAP v2）
-    TUD_VENDOR_DESCRIPTOR(ITF_NUM_VENDOR, STRID_VENDOR, EPNUM_VENDOR_OUT, 
-                         EPNUM_VENDOR_IN, 64)
+    TUD_CMSIS_DAP_DESCRIPTOR(ITF_NUM_VENDOR, STRID_VENDOR, EPNUM_VENDOR_OUT,
+                             EPNUM_VENDOR_IN, EPNUM_VENDOR_SWO, 64),
+
+#ifdef CONFIG_DAP_USB_MSC
+    // MSC描述符（拖放烧录）
+    TUD_MSC_DESCRIPTOR(ITF_NUM_MSC, STRID_MSC, EPNUM_MSC_OUT, EPNUM_MSC_IN, 64)
+#endif
 };
 
 // 字符串描述符
@@ -78,7 +106,8 @@ static const char* string_descriptor[] = {
     [STRID_PRODUCT] = "CMSIS-DAP v2",
     [STRID_SERIAL] = "123456",
     [STRID_CDC] = "CDC Serial",
-    [STRID_VENDOR] = "CMSIS-DAP v2 Interface"
+    [STRID_VENDOR] = "CMSIS-DAP v2 Interface",
+    [STRID_MSC] = "DAPLink MSC"
 };
 
 // 导出描述符配置
@@ -102,20 +131,6 @@ size_t get_tusb_string_descriptor_count(void)
     return STRID_NUM;
 }
 
-// CDC事件回调
-void tud_cdc_line_coding_cb(uint8_t itf, cdc_line_coding_t const* p_line_coding)
-{
-    (void)itf;
-    (void)p_line_coding;
-}
-
-void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts)
-{
-    (void)itf;
-    (void)dtr;
-    (void)rts;
-}
-
 #ifdef CONFIG_TINYUSB_VENDOR_ENABLED
 // BOS描述符回调函数
 uint8_t const *tud_descriptor_bos_cb(void) __attribute__((weak));
@@ -11,6 +11,7 @@
 #define USB_DESCRIPTORS_H_
 
 #include "tinyusb.h"
+#include "sdkconfig.h"
 
 // 定义接口编号枚举
 enum
@@ -18,9 +19,23 @@ enum
     ITF_NUM_CDC_CTRL = 0,     // CDC控制接口编号
     ITF_NUM_CDC_DATA,         // CDC数据接口编号
     ITF_NUM_VENDOR,           // 厂商特定接口编号
+#ifdef CONFIG_DAP_USB_MSC
+    ITF_NUM_MSC,              // MSC虚拟磁盘接口编号
+#endif
     ITF_NUM_TOTAL            // 接口总数
 };
 
+// CMSIS-DAP v2 接口的 SWO 流式跟踪端点 (bulk IN)。IN 端点不够同时给 MSC 和 SWO，
+// 两者由 Kconfig 的 DAP_USB_EXTRA_IN 二选一，SWO 使用 MSC 空出的 IN FIFO
+#define EPNUM_VENDOR_SWO   0x85
+
+// CMSIS-DAP v2 接口描述符长度：命令 OUT、响应 IN，打开 SWO 流式跟踪时多一个 bulk IN 端点
+#ifdef CONFIG_DAP_USB_SWO_STREAM
+#define TUD_CMSIS_DAP_DESC_LEN  (9 + 7 + 7 + 7)
+#else
+#define TUD_CMSIS_DAP_DESC_LEN  TUD_VENDOR_DESC_LEN
+#endif
+
 // 定义厂商请求类型枚举
 enum
 {
@@ -0,0 +1,357 @@
+/**
+ * @file usb_glue.c
+ * @brief USB 设备类和 DAP 组件之间的胶水：CDC 终端 (目标串口、RTT、ITM 文本、GDB) 和 SWO 流式端点
+ *
+ * 描述符 (usb_descriptors.c) 还编进 esp_tinyusb 库，那里没有 DAP 组件的头文件，
+ * 所以用到 DAP_config.h、rtt.h、gdb_server.h 的回调都放在这里，只在本组件内编译。
+ */
+
+#include <string.h>
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+#include "class/vendor/vendor_device.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "usb_descriptors.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "rtt.h"
+#include "gdb_server.h"
+
+// CDC 串口是目标的终端：目标串口 (UART.c)、RTT 上行通道 0 和 SWO ITM 文本都输出到这里。
+// 主机输入在 RTT 找到控制块后写入 RTT 下行通道 0，否则发到目标串口。
+// 端点都已用完，不能再加一个 CDC 给 GDB 服务器 (gdb_server.c)：串口打开后主机发的第一个字节
+// 决定它的用途，'+'、'$' 或 ^C 是 GDB，其他字节或 CDC_DETECT_TICKS 内没有输入是终端
+#define CDC_DETECT_TICKS    pdMS_TO_TICKS(200)
+
+enum {
+    CDC_CLOSED = 0,
+    CDC_UNDECIDED,
+    CDC_CONSOLE,
+    CDC_GDB,
+};
+
+static volatile uint8_t cdc_func;
+static volatile TickType_t cdc_opened;
+
+static uint8_t cdc_function(void)
+{
+    uint8_t c;
+
+    if (!tud_cdc_connected()) {
+        return CDC_CLOSED;
+    }
+    if (cdc_func == CDC_UNDECIDED) {
+        if (tud_cdc_peek(&c)) {
+            cdc_func = (c == '+' || c == '$' || c == 0x03) ? CDC_GDB : CDC_CONSOLE;
+        } else if (xTaskGetTickCount() - cdc_opened >= CDC_DETECT_TICKS) {
+            cdc_func = CDC_CONSOLE;
+        }
+    }
+    return cdc_func;
+}
+
+#if (DAP_UART != 0) && (DAP_UART_USB_COM_PORT != 0)
+static volatile bool com_port_active;   // DAP_UART_Transport 选择了 USB COM 口
+
+// CDC 线路参数转换成 DAP_UART_Configure 的控制字节后应用到目标串口。
+// 停止位 (0/1/2 = 1/1.5/2 位) 和校验 (0..4 = 无/奇/偶/mark/space) 的编码两者相同，
+// 数据位 8 编码为 0，5..7 不变，其他值编码为无效的 1，由 UART.c 拒绝
+static void com_port_apply(cdc_line_coding_t const *coding)
+{
+    uint32_t control;
+
+    if (coding->data_bits == 8) {
+        control = 0;
+    } else if (coding->data_bits >= 5 && coding->data_bits <= 7) {
+        control = coding->data_bits;
+    } else {
+        control = 1;
+    }
+    control |= (uint32_t)(coding->parity & 0x07) << 3;
+    control |= (uint32_t)(coding->stop_bits & 0x03) << 6;
+    UART_COM_PORT_Configure(control, coding->bit_rate);
+}
+
+uint8_t USB_COM_PORT_Activate(uint32_t cmd)
+{
+    cdc_line_coding_t coding;
+
+    com_port_active = (cmd != 0);
+    if (com_port_active && tud_mounted()) {
+        tud_cdc_get_line_coding(&coding);
+        com_port_apply(&coding);
+    }
+    return 0;
+}
+
+uint32_t USB_COM_PORT_Read(uint8_t *buf, uint32_t size)
+{
+    rtt_status_t rtt;
+
+    rtt_get_status(&rtt);
+    if (rtt.cb != 0 || cdc_function() != CDC_CONSOLE) {
+        return 0;
+    }
+    return tud_cdc_read(buf, size);
+}
+
+// 终端没打开或串口被 GDB 使用时丢弃数据，和普通 USB 串口一样；用途未定时先留在缓冲区
+uint32_t USB_COM_PORT_Write(const uint8_t *buf, uint32_t num)
+{
+    uint32_t n;
+
+    switch (cdc_function()) {
+    case CDC_CONSOLE:
+        break;
+    case CDC_UNDECIDED:
+        return 0;
+    default:
+        return num;
+    }
+    n = tud_cdc_write(buf, num);
+    tud_cdc_write_flush();
+    return n;
+}
+#endif
+
+// CDC事件回调
+void tud_cdc_line_coding_cb(uint8_t itf, cdc_line_coding_t const* p_line_coding)
+{
+    (void)itf;
+#if (DAP_UART != 0) && (DAP_UART_USB_COM_PORT != 0)
+    // 波特率等参数修改立即生效，不中断收发
+    if (com_port_active) {
+        com_port_apply(p_line_coding);
+    }
+#else
+    (void)p_line_coding;
+#endif
+}
+
+void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts)
+{
+    (void)itf;
+    (void)rts;
+    if (dtr) {
+        cdc_opened = xTaskGetTickCount();
+        cdc_func = CDC_UNDECIDED;
+    } else {
+        cdc_func = CDC_CLOSED;
+    }
+#if (DAP_UART != 0) && (DAP_UART_USB_COM_PORT != 0)
+    // 终端打开或关闭：积压的目标串口数据开始发送或被丢弃
+    UART_COM_PORT_Event();
+#endif
+    rtt_wake();
+    gdb_wake();
+}
+
+void tud_cdc_tx_complete_cb(uint8_t itf)
+{
+    (void)itf;
+#if (DAP_UART != 0) && (DAP_UART_USB_COM_PORT != 0)
+    UART_COM_PORT_Event();
+#endif
+}
+
+// RTT 引擎的主机端终端 (rtt.c)：上行通道 0 写入 CDC，CDC 收到的数据写入下行通道 0
+bool rtt_host_connected(void)
+{
+    return cdc_function() == CDC_CONSOLE;
+}
+
+uint32_t rtt_host_space(void)
+{
+    return tud_cdc_write_available();
+}
+
+uint32_t rtt_host_write(const uint8_t *buf, uint32_t num)
+{
+    uint32_t n = tud_cdc_write(buf, num);
+    tud_cdc_write_flush();
+    return n;
+}
+
+uint32_t rtt_host_read(uint8_t *buf, uint32_t size)
+{
+    if (cdc_function() != CDC_CONSOLE) {
+        return 0;
+    }
+    return tud_cdc_read(buf, size);
+}
+
+// GDB 服务器的主机端连接 (gdb_server.c)
+bool gdb_host_connected(void)
+{
+    return cdc_function() == CDC_GDB;
+}
+
+uint32_t gdb_host_read(uint8_t *buf, uint32_t size)
+{
+    if (cdc_function() != CDC_GDB) {
+        return 0;
+    }
+    return tud_cdc_read(buf, size);
+}
+
+// 应答一定要完整发出，FIFO 满时等待，直到 GDB 关闭串口
+void gdb_host_write(const uint8_t *buf, uint32_t num)
+{
+    uint32_t n;
+
+    while (num != 0 && tud_cdc_connected()) {
+        n = tud_cdc_write(buf, num);
+        tud_cdc_write_flush();
+        if (n == 0) {
+            vTaskDelay(1);
+            continue;
+        }
+        buf += n;
+        num -= n;
+    }
+}
+
+void tud_cdc_rx_cb(uint8_t itf)
+{
+    (void)itf;
+#if (DAP_UART != 0) && (DAP_UART_USB_COM_PORT != 0)
+    UART_COM_PORT_Event();
+#endif
+    rtt_wake();
+    gdb_wake();
+}
+
+#if (SWO_ITM != 0)
+// SWO ITM 文本通道 (SWO.c)：目标 printf 输出转发到 CDC 串口，串口没打开或不是终端时丢弃
+// FIFO 满时最多等 SWO_TEXT_WAIT 个系统节拍，不让主机端的终端拖住 SWO 采集
+#define SWO_TEXT_WAIT   10
+
+void SWO_TextOutput(const uint8_t *buf, uint32_t num)
+{
+    uint32_t n;
+    int wait = 0;
+
+    while (num != 0 && cdc_function() == CDC_CONSOLE) {
+        n = tud_cdc_write(buf, num);
+        tud_cdc_write_flush();
+        if (n == 0) {
+            if (++wait > SWO_TEXT_WAIT) {
+                break;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+        buf += n;
+        num -= n;
+    }
+}
+#endif
+
+#if (SWO_STREAM != 0)
+//--------------------------------------------------------------------+
+// SWO 流式跟踪端点
+//--------------------------------------------------------------------+
+
+// TinyUSB 的 vendor 类只管理一对端点 (多出的 IN 端点会顶替响应端点)，所以 CMSIS-DAP 接口
+// 由这里的应用类驱动打开：命令/响应端点交给 vendor 类，SWO 端点自己处理
+static volatile bool swo_abort;         // 正在传输的数据已被 SWO_AbortTransfer 丢弃
+static uint8_t *swo_next_buf;           // 丢弃的传输未完成时排队的下一次传输
+static uint32_t swo_next_num;
+
+static void swo_xfer_start(uint8_t *buf, uint32_t num)
+{
+    if (!usbd_edpt_claim(BOARD_TUD_RHPORT, EPNUM_VENDOR_SWO)) {
+        // 端点仍在发送被丢弃的数据，完成后再发
+        swo_next_buf = buf;
+        swo_next_num = num;
+        return;
+    }
+    if (!usbd_edpt_xfer(BOARD_TUD_RHPORT, EPNUM_VENDOR_SWO, buf, (uint16_t)num)) {
+        usbd_edpt_release(BOARD_TUD_RHPORT, EPNUM_VENDOR_SWO);
+        SWO_TransferComplete();     // 未连接，数据直接丢弃
+    }
+}
+
+// CMSIS-DAP SWO 流式传输接口 (SWO.c)
+void SWO_QueueTransfer(uint8_t *buf, uint32_t num)
+{
+    swo_abort = false;
+    swo_xfer_start(buf, num);
+}
+
+void SWO_AbortTransfer(void)
+{
+    swo_next_buf = NULL;
+    swo_abort = true;
+}
+
+static void dap_itf_reset(uint8_t rhport)
+{
+    (void)rhport;
+    swo_next_buf = NULL;
+    swo_abort = false;
+}
+
+static uint16_t dap_itf_open(uint8_t rhport, tusb_desc_interface_t const *desc_itf, uint16_t max_len)
+{
+    TU_VERIFY(desc_itf->bInterfaceClass == TUSB_CLASS_VENDOR_SPECIFIC &&
+              desc_itf->bInterfaceNumber == ITF_NUM_VENDOR && desc_itf->bNumEndpoints == 3, 0);
+    TU_VERIFY(max_len >= TUD_CMSIS_DAP_DESC_LEN, 0);
+
+    // 去掉 SWO 端点后交给 vendor 类
+    uint8_t desc[TUD_VENDOR_DESC_LEN];
+    memcpy(desc, desc_itf, sizeof(desc));
+    ((tusb_desc_interface_t *)desc)->bNumEndpoints = 2;
+    TU_VERIFY(vendord_open(rhport, (tusb_desc_interface_t const *)desc, sizeof(desc)) == sizeof(desc), 0);
+
+    tusb_desc_endpoint_t const *desc_swo = (tusb_desc_endpoint_t const *)((uint8_t const *)desc_itf + TUD_VENDOR_DESC_LEN);
+    TU_ASSERT(desc_swo->bDescriptorType == TUSB_DESC_ENDPOINT && desc_swo->bEndpointAddress == EPNUM_VENDOR_SWO, 0);
+    TU_ASSERT(usbd_edpt_open(rhport, desc_swo), 0);
+
+    return TUD_CMSIS_DAP_DESC_LEN;
+}
+
+static bool dap_itf_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request)
+{
+    return tud_vendor_control_xfer_cb(rhport, stage, request);
+}
+
+static bool dap_itf_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+    if (ep_addr != EPNUM_VENDOR_SWO) {
+        return vendord_xfer_cb(rhport, ep_addr, result, xferred_bytes);
+    }
+
+    if (!swo_abort) {
+        SWO_TransferComplete();
+    } else {
+        swo_abort = false;
+        if (swo_next_buf != NULL) {
+            uint8_t *buf = swo_next_buf;
+            swo_next_buf = NULL;
+            swo_xfer_start(buf, swo_next_num);
+        }
+    }
+    return true;
+}
+
+static const usbd_class_driver_t dap_itf_driver = {
+#if CFG_TUSB_DEBUG >= CFG_TUD_LOG_LEVEL
+    .name = "CMSIS-DAP",
+#endif
+    .init = NULL,
+    .reset = dap_itf_reset,
+    .open = dap_itf_open,
+    .control_xfer_cb = dap_itf_control_xfer_cb,
+    .xfer_cb = dap_itf_xfer_cb,
+    .sof = NULL,
+};
+
+// 应用类驱动先于内置驱动匹配接口
+usbd_class_driver_t const *usbd_app_driver_get_cb(uint8_t *driver_count)
+{
+    *driver_count = 1;
+    return &dap_itf_driver;
+}
+#endif
@@ -13,15 +13,23 @@
 #include <stdio.h>
 #include "esp_log.h"
 #include "esp_system.h"
+#include "nvs_flash.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "tusb.h"
 #include "sdkconfig.h"
 #include "led.h"
 #include "dap_handle.h"
+#include "rtt.h"
+#include "gdb_server.h"
+#include "prog_job.h"
 #include "usb_descriptors.h"
 #include "tinyusb.h"
 #include "class/vendor/vendor_device.h"
+#ifdef CONFIG_DAP_USB_MSC
+#include "msc_disk.h"
+#include "image_slot.h"
+#endif
 #include <inttypes.h>
 
 static const char *TAG = "MAIN";
@@ -30,14 +38,19 @@ static const char *TAG = "MAIN";
 #define BULK_BUFFER_SIZE 64
 static uint32_t cmd_count = 0;
 
+#ifdef CONFIG_DAP_USB_MSC
+// 拖放到 USB 磁盘的镜像解码后压缩存入镜像分区
+static image_slot_t msc_slot;
+#endif
+
 // BULK 传输回调函数
 void tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bufsize)
 {
     cmd_count++;
-    ESP_LOGI(TAG, "[%lu] 收到 BULK 数据 - 接口: %d, 大小: %" PRIu16 " 字节", cmd_count, itf, bufsize);
+    ESP_LOGD(TAG, "[%lu] 收到 BULK 数据 - 接口: %d, 大小: %" PRIu16 " 字节", cmd_count, itf, bufsize);
     
     if (bufsize > 0) {
-        ESP_LOGI(TAG, "[%lu] 命令ID: 0x%02X", cmd_count, buffer[0]);
+        ESP_LOGD(TAG, "[%lu] 命令ID: 0x%02X", cmd_count, buffer[0]);
         ESP_LOG_BUFFER_HEX_LEVEL(TAG, buffer, bufsize, ESP_LOG_DEBUG);
     }
     
@@ -47,14 +60,14 @@ void tud_vendor_rx_cb(uint8_t itf, uint8_t const* buffer, uint16_t bufsize)
     // 处理DAP命令
     esp_err_t err = dap_handle_request((uint8_t*)buffer, bufsize, response, &resp_len);
     if (err == ESP_OK && resp_len > 0) {
-        ESP_LOGI(TAG, "[%lu] 准备发送响应，大小: %" PRIu16 " 字节", cmd_count, resp_len);
+        ESP_LOGD(TAG, "[%lu] 准备发送响应，大小: %" PRIu16 " 字节", cmd_count, resp_len);
         ESP_LOG_BUFFER_HEX_LEVEL(TAG, response, resp_len, ESP_LOG_DEBUG);
         
         // 尝试发送响应，如果失败则重试
         int retry = 3;
         while (retry--) {
             if (tud_vendor_write(response, resp_len)) {
-                ESP_LOGI(TAG, "[%lu] 响应发送成功", cmd_count);
+                ESP_LOGD(TAG, "[%lu] 响应发送成功", cmd_count);
                 break;
             } else {
                 ESP_LOGW(TAG, "[%lu] 发送响应失败，剩余重试次数: %d", cmd_count, retry);
@@ -109,6 +122,14 @@ void app_main(void)
 {
     ESP_LOGI(TAG, "DAP Link 启动...");
 
+    // 初始化 NVS（保存每个目标的 SWD 时钟调优结果）
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+
     // 初始化LED
     led_init();
     ESP_LOGI(TAG, "LED 初始化完成");
@@ -117,6 +138,31 @@ void app_main(void)
     ESP_ERROR_CHECK(dap_handle_init());
     ESP_LOGI(TAG, "DAP 初始化完成");
 
+    // 初始化 RTT 引擎 (CDC 终端打开后自动连接目标并转发 RTT 通道 0)
+    ESP_ERROR_CHECK(rtt_init());
+    ESP_LOGI(TAG, "RTT 引擎初始化完成");
+
+    // 初始化 GDB 服务器 (CDC 串口上的第一个字节是 GDB 报文时停住目标，提供远程调试和烧录)
+    ESP_ERROR_CHECK(gdb_server_init());
+    ESP_LOGI(TAG, "GDB 服务器初始化完成");
+
+    // 初始化脱机烧录 (厂商命令启动，把镜像分区中的镜像烧录到目标)
+    ESP_ERROR_CHECK(prog_job_init());
+    ESP_LOGI(TAG, "脱机烧录初始化完成");
+
+#ifdef CONFIG_DAP_USB_MSC
+    // 初始化 USB 虚拟磁盘 (和 SWO 流式跟踪端点二选一)
+    image_slot_init(&msc_slot, IMAGE_SLOT_PARTITION);
+    const virtual_fs_sink_t msc_sink = {
+        .open = image_slot_open,
+        .record = image_slot_record,
+        .close = image_slot_close,
+        .ctx = &msc_slot,
+    };
+    ESP_ERROR_CHECK(msc_disk_init(&msc_sink));
+    ESP_LOGI(TAG, "MSC 虚拟磁盘初始化完成");
+#endif
+
     // 初始化 TinyUSB
     const tinyusb_config_t tusb_cfg = {
         .device_descriptor = get_tusb_desc_device(),
@@ -0,0 +1,512 @@
+/**
+ * @file    blanksim.c
+ * @brief   Blank check planner against a simulated target with mixed sectors
+ *
+ * usage: blanksim [-n iterations] [-s seed]
+ *
+ * The target has 512 KB of flash in 2 KB, 8 KB and 32 KB sectors and 32 KB
+ * of RAM. swd_read_memory and swd_write_memory access it directly;
+ * swd_flash_syscall_exec runs the downloaded scanner on a small Thumb
+ * interpreter, so the hand assembled blob is executed as the target would.
+ *
+ * Each iteration plans a random range on flash that is virgin, partly
+ * programmed, fully programmed or dirty only in the last word of some
+ * sectors, with the probe and the target scanner, with and without chip
+ * erase, and with failing syscalls. Every dirty sector must end up erased,
+ * no blank sector may be erased unless its check failed, and the extents
+ * must be ascending, merged and inside the plan. The time saved against
+ * erasing every planned sector is estimated from the SWD traffic, the
+ * scanner instructions and the default erase rates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "blank_check.h"
+#include "swd_host.h"
+#include "sim.h"
+
+#define FLASH_BASE          0x08000000U
+#define FLASH_SIZE          0x80000U
+#define RAM_BASE            0x20000000U
+#define RAM_SIZE            0x8000U
+#define BKPT_ADDR           (RAM_BASE + 1U)     // breakpoint of the syscall return
+#define MAX_STEPS           50000000U
+#define MAX_EXTENTS         256U
+
+// Cost estimate, matches the planner defaults
+#define SWD_KB_PER_S        512U
+#define CALL_US             1000U
+#define CORE_MHZ            48U
+#define ERASE_US_PER_KB     10000U
+
+enum { CONTENT_VIRGIN, CONTENT_PARTIAL, CONTENT_FULL, CONTENT_TAIL, CONTENTS };
+
+static const char *content_names[] = { "virgin", "partial", "full", "tail" };
+
+static const sector_info_t sectors[] = {
+	{ FLASH_BASE,            0x800U  },
+	{ FLASH_BASE + 0x8000U,  0x2000U },
+	{ FLASH_BASE + 0x20000U, 0x8000U },
+};
+
+static uint8_t flash[FLASH_SIZE];
+static uint8_t ram[RAM_SIZE];
+static uint8_t dirty[FLASH_SIZE / 0x800U];  // per 2 KB unit, dirty sectors mark all their units
+
+// Target traffic of the current plan
+static uint32_t swd_bytes;
+static uint32_t syscalls;
+static uint64_t instructions;
+static uint8_t syscall_fail;
+
+static uint8_t *target_ptr(uint32_t addr, uint32_t size)
+{
+	if ((addr >= FLASH_BASE) && (addr - FLASH_BASE <= FLASH_SIZE) && (size <= FLASH_SIZE - (addr - FLASH_BASE)))
+	{
+		return &flash[addr - FLASH_BASE];
+	}
+	if ((addr >= RAM_BASE) && (addr - RAM_BASE <= RAM_SIZE) && (size <= RAM_SIZE - (addr - RAM_BASE)))
+	{
+		return &ram[addr - RAM_BASE];
+	}
+	return NULL;
+}
+
+uint8_t swd_read_memory(uint32_t address, uint8_t *data, uint32_t size)
+{
+	uint8_t *p = target_ptr(address, size);
+
+	if (p == NULL)
+	{
+		return 0;
+	}
+	memcpy(data, p, size);
+	swd_bytes += size;
+	return 1;
+}
+
+uint8_t swd_write_memory(uint32_t address, uint8_t *data, uint32_t size)
+{
+	uint8_t *p = target_ptr(address, size);
+
+	if (p == NULL)
+	{
+		return 0;
+	}
+	memcpy(p, data, size);
+	swd_bytes += size;
+	return 1;
+}
+
+static uint8_t load32(uint32_t addr, uint32_t *val)
+{
+	uint8_t *p = target_ptr(addr, 4);
+
+	if ((p == NULL) || ((addr & 3U) != 0))
+	{
+		return 0;
+	}
+	*val = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	return 1;
+}
+
+static uint8_t store32(uint32_t addr, uint32_t val)
+{
+	uint8_t *p = target_ptr(addr, 4);
+
+	if ((p == NULL) || ((addr & 3U) != 0))
+	{
+		return 0;
+	}
+	p[0] = (uint8_t)val;
+	p[1] = (uint8_t)(val >> 8);
+	p[2] = (uint8_t)(val >> 16);
+	p[3] = (uint8_t)(val >> 24);
+	return 1;
+}
+
+// ARMv6-M subset: the instructions the scanner uses
+uint8_t swd_flash_syscall_exec(const program_syscall_t *sys, uint32_t entry, uint32_t arg1, uint32_t arg2,
+                               uint32_t arg3, uint32_t arg4)
+{
+	uint32_t r[16] = {0}, op, a, b, res, steps, i;
+	uint8_t n = 0, z = 0, c = 0, v = 0, taken;
+	uint8_t *p;
+
+	syscalls++;
+	if (syscall_fail)
+	{
+		return 0;
+	}
+	r[0]  = arg1;
+	r[1]  = arg2;
+	r[2]  = arg3;
+	r[3]  = arg4;
+	r[9]  = sys->static_base;
+	r[13] = sys->stack_pointer;
+	r[14] = sys->breakpoint;
+	r[15] = entry & ~1U;
+
+	for (steps = 0; steps < MAX_STEPS; steps++)
+	{
+		if (r[15] == (sys->breakpoint & ~1U))
+		{
+			instructions += steps;
+			return r[0] == 0;
+		}
+		p = target_ptr(r[15], 2);
+		if (p == NULL)
+		{
+			return 0;
+		}
+		op = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+		r[15] += 2;
+
+		if ((op & 0xF800U) == 0x2000U)          // movs rd, #imm8
+		{
+			res = op & 0xFFU;
+			r[(op >> 8) & 7U] = res;
+			n = 0;
+			z = (res == 0);
+		}
+		else if ((op & 0xF000U) == 0x3000U || (op & 0xF800U) == 0x2800U || (op & 0xFFC0U) == 0x4280U)
+		{
+			// adds/subs rdn, #imm8, cmp rn, #imm8, cmp rn, rm
+			if ((op & 0xFFC0U) == 0x4280U)
+			{
+				a = r[op & 7U];
+				b = r[(op >> 3) & 7U];
+				op = 0x2800U;               // compare
+			}
+			else
+			{
+				a = r[(op >> 8) & 7U];
+				b = op & 0xFFU;
+			}
+			if ((op & 0xF800U) == 0x3000U)
+			{
+				res = a + b;
+				c = (res < a);
+				v = (uint8_t)((~(a ^ b) & (a ^ res)) >> 31);
+			}
+			else
+			{
+				res = a - b;
+				c = (a >= b);
+				v = (uint8_t)(((a ^ b) & (a ^ res)) >> 31);
+			}
+			n = (uint8_t)(res >> 31);
+			z = (res == 0);
+			if ((op & 0xF800U) != 0x2800U)
+			{
+				r[(op >> 8) & 7U] = res;
+			}
+		}
+		else if ((op & 0xF000U) == 0x6000U)     // ldr/str rt, [rn, #imm5 * 4]
+		{
+			a = r[(op >> 3) & 7U] + ((op >> 6) & 0x1FU) * 4U;
+			if ((op & 0x0800U) ? !load32(a, &r[op & 7U]) : !store32(a, r[op & 7U]))
+			{
+				return 0;
+			}
+		}
+		else if ((op & 0xF000U) == 0xD000U && (op & 0x0E00U) != 0x0E00U)     // b<cond>
+		{
+			switch ((op >> 8) & 0xFU)
+			{
+			case 0x0: taken = z; break;
+			case 0x1: taken = !z; break;
+			case 0x2: taken = c; break;
+			case 0x3: taken = !c; break;
+			case 0x4: taken = n; break;
+			case 0x5: taken = !n; break;
+			case 0xA: taken = (n == v); break;
+			case 0xB: taken = (n != v); break;
+			default: return 0;
+			}
+			if (taken)
+			{
+				r[15] += 2U + (uint32_t)((int32_t)(int8_t)(op & 0xFFU) * 2);
+			}
+		}
+		else if ((op & 0xF800U) == 0xE000U)     // b
+		{
+			r[15] += 2U + (uint32_t)(((int32_t)(op << 21) >> 21) * 2);
+		}
+		else if ((op & 0xFE00U) == 0xB400U)     // push {reglist, lr}
+		{
+			for (i = 15; i-- > 0;)
+			{
+				if (((i < 8U) && (op & (1U << i))) || ((i == 14U) && (op & 0x100U)))
+				{
+					r[13] -= 4U;
+					if (!store32(r[13], r[i]))
+					{
+						return 0;
+					}
+				}
+			}
+		}
+		else if ((op & 0xFE00U) == 0xBC00U)     // pop {reglist, pc}
+		{
+			for (i = 0; i < 16U; i++)
+			{
+				if (((i < 8U) && (op & (1U << i))) || ((i == 15U) && (op & 0x100U)))
+				{
+					if (!load32(r[13], &r[i]))
+					{
+						return 0;
+					}
+					r[13] += 4U;
+				}
+			}
+			r[15] &= ~1U;
+		}
+		else
+		{
+			printf("scanner: unknown instruction %04X at %08X\n", op, r[15] - 2U);
+			return 0;
+		}
+	}
+	return 0;
+}
+
+// Sector start and size of an address
+static void sector_of(uint32_t addr, uint32_t *start, uint32_t *size)
+{
+	uint32_t i = sizeof(sectors) / sizeof(sectors[0]);
+
+	while ((i-- > 1U) && (addr < sectors[i].start))
+	{
+	}
+	*size  = sectors[i].size;
+	*start = addr - ((addr - sectors[i].start) % *size);
+}
+
+static void fill_flash(uint32_t content)
+{
+	uint32_t addr, start, size, pos;
+
+	memset(flash, 0xFF, sizeof(flash));
+	memset(dirty, 0, sizeof(dirty));
+	for (addr = FLASH_BASE; addr < FLASH_BASE + FLASH_SIZE; addr = start + size)
+	{
+		sector_of(addr, &start, &size);
+		if ((content == CONTENT_VIRGIN) || ((content != CONTENT_FULL) && (rnd(3) != 0)))
+		{
+			continue;
+		}
+		if (content == CONTENT_TAIL)
+		{
+			pos = size - 1U - rnd(4);
+		}
+		else
+		{
+			pos = (content == CONTENT_FULL) ? 0 : rnd(size);
+		}
+		flash[start - FLASH_BASE + pos] = (uint8_t)rnd(0xFF);
+		memset(&dirty[(start - FLASH_BASE) / 0x800U], 1, size / 0x800U);
+	}
+}
+
+// Check one plan against the flash contents
+//   return: number of errors
+static uint32_t verify(const sector_extent_t *plan, uint32_t plan_count, const sector_extent_t *erase,
+                       uint32_t erase_count, uint8_t chip, uint8_t checks_fail, uint64_t *erase_bytes)
+{
+	static uint8_t erased[FLASH_SIZE / 0x800U];
+	uint32_t i, u, errors = 0;
+
+	*erase_bytes = 0;
+	if (chip)
+	{
+		*erase_bytes = FLASH_SIZE / 4U;     // chip erase works on several blocks at once
+		return 0;
+	}
+
+	memset(erased, 0, sizeof(erased));
+	for (i = 0; i < erase_count; i++)
+	{
+		if ((i != 0) && ((erase[i].start < erase[i - 1].start + erase[i - 1].size) ||
+		                 ((erase[i].start == erase[i - 1].start + erase[i - 1].size) &&
+		                  (erase[i].first == erase[i - 1].first + erase[i - 1].count))))
+		{
+			printf("  extent %u at %08X not ascending or not merged\n", i, erase[i].start);
+			errors++;
+		}
+		for (u = 0; u < erase[i].size / 0x800U; u++)
+		{
+			erased[(erase[i].start - FLASH_BASE) / 0x800U + u] = 1;
+		}
+		*erase_bytes += erase[i].size;
+	}
+
+	for (i = 0; i < plan_count; i++)
+	{
+		for (u = (plan[i].start - FLASH_BASE) / 0x800U; u < (plan[i].start + plan[i].size - FLASH_BASE) / 0x800U; u++)
+		{
+			if (dirty[u] && !erased[u])
+			{
+				printf("  dirty sector at %08X not erased\n", FLASH_BASE + u * 0x800U);
+				return errors + 1U;
+			}
+			if (!dirty[u] && erased[u] && !checks_fail)
+			{
+				printf("  blank sector at %08X erased\n", FLASH_BASE + u * 0x800U);
+				return errors + 1U;
+			}
+			erased[u] = 0;
+		}
+	}
+	for (u = 0; u < sizeof(erased); u++)
+	{
+		if (erased[u])
+		{
+			printf("  %08X erased outside the plan\n", FLASH_BASE + u * 0x800U);
+			return errors + 1U;
+		}
+	}
+	return errors;
+}
+
+static double estimate_ms(uint64_t erase_bytes)
+{
+	return (double)erase_bytes * ERASE_US_PER_KB / 1024.0 / 1000.0 + (double)swd_bytes / SWD_KB_PER_S / 1024.0 * 1000.0 +
+	       (double)syscalls * CALL_US / 1000.0 + (double)instructions / CORE_MHZ / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+	static const char *method_names[] = { "none", "probe", "target" };
+	static sector_extent_t plan[16], erase[MAX_EXTENTS];
+	static double saved[CONTENTS][2], total[CONTENTS][2];
+	flash_algo_t algo;
+	sector_map_t map;
+	sector_range_t range;
+	blank_check_t bc;
+	sim_args_t args;
+	uint32_t it, content, method, allow_chip, fail;
+	uint32_t plan_count, erase_count, failed = 0, i;
+	uint64_t erase_bytes, plan_bytes;
+	uint8_t chip;
+	dap_err_t status;
+	int opt;
+
+	sim_args_init(&args, 200);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS)) != -1)
+	{
+		if (!sim_option(&args, opt, optarg))
+		{
+			fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n", argv[0]);
+			return 2;
+		}
+	}
+	sim_seed(args.seed);
+	printf("seed %u\n", args.seed);
+
+	memset(&algo, 0, sizeof(algo));
+	strcpy(algo.device.name, "simulated 512 KB");
+	algo.device.type                   = 1;
+	algo.device.start                  = FLASH_BASE;
+	algo.device.size                   = FLASH_SIZE;
+	algo.device.erased_value           = 0xFF;
+	algo.sectors                       = sectors;
+	algo.sector_count                  = sizeof(sectors) / sizeof(sectors[0]);
+	algo.target.algo_start             = RAM_BASE;
+	algo.target.algo_size              = 0x1000;
+	algo.target.program_buffer         = RAM_BASE + 0x1000U;
+	algo.target.program_buffer_size    = 0x800;
+	algo.target.erase_chip             = 1;
+	algo.target.sys_call_s.breakpoint    = BKPT_ADDR;
+	algo.target.sys_call_s.stack_pointer = RAM_BASE + RAM_SIZE;
+
+	sector_map_init(&map);
+	if (sector_map_add_algo(&map, &algo) != ERROR_SUCCESS)
+	{
+		printf("sector map rejected\n");
+		return 1;
+	}
+
+	for (it = 0; (it < args.count) && (failed < 10U); it++)
+	{
+		content     = it % CONTENTS;
+		range.start = FLASH_BASE + rnd(FLASH_SIZE / 2U);
+		range.size  = 1U + rnd(FLASH_BASE + FLASH_SIZE - range.start);
+		fill_flash(content);
+		if (sector_map_plan(&map, &range, 1, plan, 16, &plan_count) != ERROR_SUCCESS)
+		{
+			printf("iteration %u: no plan for %08X+%X\n", it, range.start, range.size);
+			failed++;
+			continue;
+		}
+		for (i = 0, plan_bytes = 0; i < plan_count; i++)
+		{
+			plan_bytes += plan[i].size;
+		}
+
+		for (method = 0; method < 2U; method++)
+		{
+			for (allow_chip = 0; allow_chip < 2U; allow_chip++)
+			{
+				for (fail = 0; fail < 2U; fail++)
+				{
+					blank_check_init(&bc, &algo, (uint8_t)allow_chip);
+					if (method && ((blank_check_place(&bc, &algo.target) != ERROR_SUCCESS) ||
+					               (blank_check_load(&bc) != ERROR_SUCCESS)))
+					{
+						printf("iteration %u: scanner not placed\n", it);
+						failed++;
+						continue;
+					}
+					swd_bytes    = 0;
+					syscalls     = 0;
+					instructions = 0;
+					syscall_fail = (uint8_t)(fail && method);
+					status = blank_check_plan(&bc, &map, plan, plan_count, erase, MAX_EXTENTS, &erase_count,
+					                          &chip);
+					if (status != ERROR_SUCCESS)
+					{
+						printf("iteration %u: plan failed with %d\n", it, (int)status);
+						failed++;
+						continue;
+					}
+					if (verify(plan, plan_count, erase, erase_count, chip, syscall_fail, &erase_bytes) != 0U)
+					{
+						printf("iteration %u: %s flash, %s, chip %u, failing syscalls %u\n", it,
+						       content_names[content], method_names[bc.method], allow_chip, syscall_fail);
+						failed++;
+					}
+					if (!allow_chip && !fail)
+					{
+						saved[content][method] += (double)plan_bytes * ERASE_US_PER_KB / 1024.0 / 1000.0 -
+						                          estimate_ms(erase_bytes);
+						total[content][method] += (double)plan_bytes * ERASE_US_PER_KB / 1024.0 / 1000.0;
+					}
+				}
+			}
+		}
+	}
+
+	// The learned erase rate follows the measurements
+	blank_check_init(&bc, &algo, 0);
+	for (i = 0; i < 32U; i++)
+	{
+		blank_check_learn(&bc, 0x2000U, CALL_US + 8U * 2500U);
+	}
+	if ((bc.erase_us_per_kb < 2490U) || (bc.erase_us_per_kb > 2510U))
+	{
+		printf("learned %u us per KB instead of 2500\n", bc.erase_us_per_kb);
+		failed++;
+	}
+
+	printf("erase time saved against erasing every planned sector:\n");
+	for (content = 0; content < CONTENTS; content++)
+	{
+		printf("  %-8s probe %5.1f%%  target %5.1f%%\n", content_names[content],
+		       (total[content][0] > 0) ? 100.0 * saved[content][0] / total[content][0] : 0.0,
+		       (total[content][1] > 0) ? 100.0 * saved[content][1] / total[content][1] : 0.0);
+	}
+	return sim_report(it, "iterations", failed);
+}
@@ -0,0 +1,394 @@
+/**
+ * @file    cachebench.c
+ * @brief   Hit rate, eviction and replay throughput of the image cache
+ *
+ * usage: cachebench [-c capacity_kb] [-H heap_kb] [-n images] [-p max_pages] [-j jobs] [-z skew] [-s seed]
+ *
+ * The cache runs on a heap-backed allocator that counts every block and can
+ * be limited below the cache capacity (-H), like a PSRAM heap shared with
+ * other users. A job picks one of n images with Zipf popularity, looks it up
+ * and either replays the cached pages or builds a new entry from the image,
+ * as the programming path on the probe does. Replayed pages and their CRCs
+ * are checked against the image. After every job the memory charged to the
+ * cache must equal the live heap blocks and stay within the capacity.
+ * Without a heap limit the hits are compared with a reference LRU model of
+ * the same entry sizes. Finally the replay rate and the page CRC lookup rate
+ * of the most popular entry are measured.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "image_cache.h"
+#include "crc.h"
+#include "sim.h"
+
+#define BENCH_BASE          0x08000000U
+#define BENCH_PAGE          4096U
+#define MAX_IMAGES          1024U
+
+// Heap with a byte limit, sizes are kept in a header in front of each block
+typedef struct
+{
+	uint32_t limit;                     // 0 = no limit
+	uint32_t live;                      // bytes handed out
+	uint32_t peak;
+	uint32_t blocks;
+	uint32_t failures;
+} heap_t;
+
+typedef struct
+{
+	uint32_t pages;
+	image_cache_key_t key;
+	double weight;                      // cumulative Zipf weight
+} bench_image_t;
+
+// Replay sink: checks each page against the image, or only copies it out
+typedef struct
+{
+	const image_cache_entry_t *entry;
+	uint32_t image;
+	uint32_t pages;
+	uint32_t errors;
+	uint8_t check;
+} sink_t;
+
+// Reference LRU over entry sizes
+typedef struct
+{
+	uint32_t order[MAX_IMAGES];         // image indices, most recently used first
+	uint32_t count;
+	uint32_t used;
+	uint32_t hits;
+} model_t;
+
+static bench_image_t images[MAX_IMAGES];
+static uint8_t page_buf[BENCH_PAGE];
+
+static void *heap_alloc(void *ctx, uint32_t size)
+{
+	heap_t *h = (heap_t *)ctx;
+	uint32_t *block;
+
+	if ((h->limit != 0U) && (size > h->limit - h->live))
+	{
+		h->failures++;
+		return NULL;
+	}
+	block = (uint32_t *)malloc(size + 16U);
+	if (block == NULL)
+	{
+		h->failures++;
+		return NULL;
+	}
+	block[0] = size;
+	h->live += size;
+	h->blocks++;
+	if (h->live > h->peak)
+	{
+		h->peak = h->live;
+	}
+	return block + 4;
+}
+
+static void heap_free(void *ctx, void *ptr)
+{
+	heap_t *h = (heap_t *)ctx;
+	uint32_t *block = (uint32_t *)ptr - 4;
+
+	h->live -= block[0];
+	h->blocks--;
+	free(block);
+}
+
+// Contents of one page, a function of image and page index
+static void page_fill(uint32_t image, uint32_t page, uint8_t *data)
+{
+	uint32_t i, x = ((image + 1U) * 0x9E3779B9U) ^ (page * 0x85EBCA6BU);
+
+	for (i = 0; i < BENCH_PAGE; i += 4)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		memcpy(&data[i], &x, 4);
+	}
+}
+
+// Memory the cache charges for an image, as image_cache_begin/page allocate it
+static uint32_t entry_bytes(uint32_t pages)
+{
+	uint32_t per_chunk = IMAGE_CACHE_CHUNK_SIZE / BENCH_PAGE;
+	uint32_t chunk = (uint32_t)sizeof(void *) + 2U * sizeof(uint32_t);
+
+	chunk = (chunk + sizeof(void *) - 1U) & ~(uint32_t)(sizeof(void *) - 1U);
+	chunk += per_chunk * (sizeof(image_cache_page_t) + BENCH_PAGE);
+	return (uint32_t)sizeof(image_cache_entry_t) + ((pages + per_chunk - 1U) / per_chunk) * chunk;
+}
+
+static uint32_t pick(uint32_t count)
+{
+	double r = (double)rnd(0x40000000U) / (double)0x40000000U * images[count - 1U].weight;
+	uint32_t lo = 0, hi = count - 1U, mid;
+
+	while (lo < hi)
+	{
+		mid = (lo + hi) / 2U;
+		if (images[mid].weight > r)
+		{
+			hi = mid;
+		}
+		else
+		{
+			lo = mid + 1U;
+		}
+	}
+	return lo;
+}
+
+static dap_err_t sink_page(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	sink_t *s = (sink_t *)ctx;
+	uint32_t page = (addr - BENCH_BASE) / BENCH_PAGE, crc;
+
+	if (s->check)
+	{
+		page_fill(s->image, page, page_buf);
+		if ((size != BENCH_PAGE) || (page != s->pages) || (memcmp(data, page_buf, BENCH_PAGE) != 0) ||
+		    !image_cache_page_crc(s->entry, addr, &crc) || (crc != crc32(page_buf, BENCH_PAGE)))
+		{
+			s->errors++;
+		}
+	}
+	else
+	{
+		memcpy(page_buf, data, size);   // hand over to the programming buffer
+	}
+	s->pages++;
+	return ERROR_SUCCESS;
+}
+
+static uint8_t model_access(model_t *m, uint32_t image, uint32_t capacity)
+{
+	uint32_t i, bytes = entry_bytes(images[image].pages);
+
+	for (i = 0; i < m->count; i++)
+	{
+		if (m->order[i] == image)
+		{
+			memmove(&m->order[1], &m->order[0], i * sizeof(m->order[0]));
+			m->order[0] = image;
+			m->hits++;
+			return 1;
+		}
+	}
+	while ((m->count != 0U) && ((bytes > capacity) || (m->used + bytes > capacity)))
+	{
+		m->count--;
+		m->used -= entry_bytes(images[m->order[m->count]].pages);
+	}
+	if (bytes <= capacity)
+	{
+		memmove(&m->order[1], &m->order[0], m->count * sizeof(m->order[0]));
+		m->order[0] = image;
+		m->count++;
+		m->used += bytes;
+	}
+	return 0;
+}
+
+// One programming job
+//   return: 1 if the image was replayed from the cache
+static uint8_t job(image_cache_t *c, uint32_t image, sink_t *sink, uint32_t *uncached)
+{
+	image_cache_builder_t b;
+	image_cache_entry_t *e;
+	uint32_t i;
+
+	e = image_cache_find(c, &images[image].key);
+	if (e != NULL)
+	{
+		sink->entry = e;
+		sink->image = image;
+		sink->pages = 0;
+		image_cache_replay(e, sink_page, sink);
+		if (sink->pages != images[image].pages)
+		{
+			sink->errors++;
+		}
+		image_cache_release(c, e);
+		return 1;
+	}
+
+	if (image_cache_begin(c, &images[image].key, BENCH_PAGE, &b) != ERROR_SUCCESS)
+	{
+		(*uncached)++;
+		return 0;
+	}
+	for (i = 0; i < images[image].pages; i++)
+	{
+		page_fill(image, i, page_buf);
+		if (image_cache_page(&b, BENCH_BASE + i * BENCH_PAGE, page_buf, BENCH_PAGE) != ERROR_SUCCESS)
+		{
+			(*uncached)++;
+			return 0;
+		}
+	}
+	image_cache_release(c, image_cache_commit(&b));
+	return 0;
+}
+
+static double seconds(clock_t start)
+{
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Replay and page CRC lookup rates of a cached image
+static void bench(image_cache_t *c, uint32_t image)
+{
+	image_cache_entry_t *e = image_cache_find(c, &images[image].key);
+	sink_t sink = {e, image, 0, 0, 0};
+	uint32_t i, crc, pages = images[image].pages, runs = 0, lookups = 0, found = 0;
+	clock_t start;
+	double secs;
+
+	if (e == NULL)
+	{
+		printf("bench: image %u not cached\n", image);
+		return;
+	}
+	start = clock();
+	do
+	{
+		sink.pages = 0;
+		image_cache_replay(e, sink_page, &sink);
+		runs++;
+	} while ((secs = seconds(start)) < 0.3);
+	printf("replay:   %8.1f MB/s (%u pages per image)\n",
+	       (double)runs * pages * BENCH_PAGE / secs / 1e6, pages);
+
+	start = clock();
+	do
+	{
+		for (i = 0; i < 1000U; i++)
+		{
+			found += image_cache_page_crc(e, BENCH_BASE + rnd(pages) * BENCH_PAGE + rnd(BENCH_PAGE), &crc);
+		}
+		lookups += 1000U;
+	} while ((secs = seconds(start)) < 0.3);
+	printf("page_crc: %8.2f M lookups/s%s\n", lookups / secs / 1e6, (found == lookups) ? "" : " (missed pages)");
+	image_cache_release(c, e);
+}
+
+int main(int argc, char **argv)
+{
+	static model_t model;
+	heap_t heap = {0, 0, 0, 0, 0};
+	image_cache_alloc_t alloc = {heap_alloc, heap_free, &heap};
+	image_cache_t cache;
+	sink_t sink = {NULL, 0, 0, 0, 1};
+	uint32_t capacity = 8192U * 1024U, count, max_pages = 256, jobs = 2000;
+	uint32_t i, p, image, hit, uncached = 0, total = 0, failed = 0;
+	sim_args_t args;
+	double skew = 1.0, weight = 0.0;
+	int opt;
+
+	sim_args_init(&args, 32);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "c:H:p:j:z:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'c':
+				capacity = (uint32_t)strtoul(optarg, NULL, 0) * 1024U;
+				break;
+			case 'H':
+				heap.limit = (uint32_t)strtoul(optarg, NULL, 0) * 1024U;
+				break;
+			case 'p':
+				max_pages = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'j':
+				jobs = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'z':
+				skew = strtod(optarg, NULL);
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-c capacity_kb] [-H heap_kb] [-n images] [-p max_pages] [-j jobs] "
+					        "[-z skew] [-s seed]\n", argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	count = args.count;
+	if ((count == 0U) || (count > MAX_IMAGES) || (max_pages == 0U))
+	{
+		fprintf(stderr, "1 to %u images of at least one page\n", MAX_IMAGES);
+		return 2;
+	}
+	sim_seed(args.seed);
+
+	for (i = 0; i < count; i++)
+	{
+		images[i].pages = 1U + rnd(max_pages);
+		image_cache_key_init(&images[i].key);
+		for (p = 0; p < images[i].pages; p++)
+		{
+			page_fill(i, p, page_buf);
+			image_cache_key_update(&images[i].key, page_buf, BENCH_PAGE);
+		}
+		weight += 1.0 / pow((double)(i + 1U), skew);
+		images[i].weight = weight;
+		total += images[i].pages;
+	}
+	printf("seed %u: %u images, %u KB in total, capacity %u KB, heap limit %u KB, skew %.2f\n", args.seed, count,
+	       total * (BENCH_PAGE / 1024U), capacity / 1024U, heap.limit / 1024U, skew);
+
+	image_cache_init(&cache, capacity, &alloc);
+	for (i = 0; i < jobs; i++)
+	{
+		image = pick(count);
+		hit = job(&cache, image, &sink, &uncached);
+		if ((heap.live != cache.used) || (cache.used > capacity))
+		{
+			printf("job %u: %u bytes charged, %u bytes live\n", i, cache.used, heap.live);
+			failed++;
+		}
+		if ((heap.limit == 0U) && (model_access(&model, image, capacity) != hit))
+		{
+			printf("job %u: image %u %s, the LRU model disagrees\n", i, image, hit ? "hit" : "missed");
+			failed++;
+		}
+		if (failed >= 10U)
+		{
+			break;
+		}
+	}
+
+	printf("hits %u, misses %u (%.1f%% hit rate), evictions %u, uncached jobs %u\n", cache.hits, cache.misses,
+	       100.0 * cache.hits / (cache.hits + cache.misses), cache.evictions, uncached);
+	printf("%u entries, %u KB used, heap peak %u KB, %u failed allocations\n", cache.entry_count,
+	       cache.used / 1024U, heap.peak / 1024U, heap.failures);
+	if (sink.errors != 0U)
+	{
+		printf("%u replayed pages differ from the image\n", sink.errors);
+		failed++;
+	}
+
+	bench(&cache, 0);
+
+	image_cache_deinit(&cache);
+	if ((heap.live != 0U) || (heap.blocks != 0U))
+	{
+		printf("%u blocks, %u bytes left after deinit\n", heap.blocks, heap.live);
+		failed++;
+	}
+	return sim_report(i, "jobs", failed);
+}
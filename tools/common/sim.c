@@ -0,0 +1,58 @@
+/**
+ * @file    sim.c
+ * @brief   Common harness of the host simulators
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sim.h"
+
+uint32_t rng = 1;
+
+// Restart the generator, the same seed gives the same run.
+void sim_seed(uint32_t seed)
+{
+	rng = (seed != 0U) ? seed : 1U;
+}
+
+// Random number 0 .. n - 1, 0 for n == 0.
+uint32_t rnd(uint32_t n)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return (n != 0U) ? (rng % n) : 0U;
+}
+
+// Defaults of the shared options: count as given, seed from the time.
+void sim_args_init(sim_args_t *args, uint32_t count)
+{
+	args->count = count;
+	args->seed  = (uint32_t)time(NULL);
+}
+
+// Parse a shared option.
+//   return: 1 when opt was -n or -s, 0 otherwise (usage error for the tool)
+int sim_option(sim_args_t *args, int opt, const char *arg)
+{
+	switch (opt)
+	{
+		case 'n':
+			args->count = (uint32_t)strtoul(arg, NULL, 0);
+			return 1;
+		case 's':
+			args->seed = (uint32_t)strtoul(arg, NULL, 0);
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+// Print the closing line.
+//   return: exit status, 1 when anything failed
+int sim_report(unsigned long long count, const char *what, uint32_t failed)
+{
+	printf("%llu %s, %u failed\n", count, what, failed);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file    sim.h
+ * @brief   Common harness of the host simulators
+ *
+ * The simulators share a reproducible xorshift32 generator, the -n count and
+ * -s seed options (the seed defaults to the time, 0 counts as 1) and the
+ * closing "N things, M failed" line that sets the exit status. Tool specific
+ * options are parsed first, everything else goes through sim_option():
+ *
+ *   sim_args_init(&args, 200);
+ *   while ((opt = getopt(argc, argv, SIM_OPTIONS "o:")) != -1)
+ *       ... case 'o': ...; default: if (!sim_option(&args, opt, optarg)) usage
+ *   sim_seed(args.seed);
+ *   ...
+ *   return sim_report(args.count, "iterations", failed);
+ *
+ * Stand-ins for the ESP-IDF headers the simulated sources include are in
+ * stub/, sim.mk builds a tool from its own objects and sources of
+ * components/dap/Source.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#define SIM_OPTIONS "n:s:"
+
+typedef struct
+{
+	uint32_t count;                 // -n: iterations, packets, bytes, .. per tool
+	uint32_t seed;                  // -s: generator seed
+} sim_args_t;
+
+extern uint32_t rng;                // generator state, a fresh 32-bit value after each rnd()
+
+void sim_seed(uint32_t seed);
+uint32_t rnd(uint32_t n);
+void sim_args_init(sim_args_t *args, uint32_t count);
+int sim_option(sim_args_t *args, int opt, const char *arg);
+int sim_report(unsigned long long count, const char *what, uint32_t failed);
+
+#endif
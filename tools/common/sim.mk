@@ -0,0 +1,20 @@
+# Common rules of the host simulators, included by their Makefiles after
+#   PROG = tool name, OBJS = its objects (sources here or in components/dap/Source)
+# optionally LDLIBS, CPPFLAGS (e.g. -I../common/stub) and CLEAN (extra files)
+# make CFLAGS="-O1 -g -Wall -Wextra -fsanitize=address,undefined" LDFLAGS=-fsanitize=address,undefined
+# for a sanitizer build
+
+DAP      = ../../components/dap
+COMMON   = ../common
+CFLAGS  ?= -O2 -Wall -Wextra
+CPPFLAGS += -I$(COMMON) -I$(DAP)/Include
+
+vpath %.c $(DAP)/Source $(COMMON)
+
+$(PROG): $(OBJS) sim.o
+	$(CC) $(CFLAGS) $(LDFLAGS) -o $@ $(OBJS) sim.o $(LDLIBS)
+
+clean:
+	rm -f $(PROG) $(OBJS) sim.o $(CLEAN)
+
+.PHONY: clean
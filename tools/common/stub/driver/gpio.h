@@ -0,0 +1,42 @@
+// Host stand-in for the ESP-IDF GPIO driver: register accesses go to the simulated bus
+#pragma once
+
+#include <stdint.h>
+
+typedef int gpio_num_t;
+
+enum
+{
+	GPIO_NUM_NC = -1,
+	GPIO_NUM_0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7,
+	GPIO_NUM_8, GPIO_NUM_9, GPIO_NUM_10, GPIO_NUM_11, GPIO_NUM_12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15,
+	GPIO_NUM_16, GPIO_NUM_17, GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_21,
+	GPIO_NUM_38 = 38, GPIO_NUM_39, GPIO_NUM_40, GPIO_NUM_41, GPIO_NUM_42, GPIO_NUM_43, GPIO_NUM_44,
+	GPIO_NUM_45, GPIO_NUM_46, GPIO_NUM_47, GPIO_NUM_48,
+};
+
+typedef enum
+{
+	GPIO_MODE_INPUT,
+	GPIO_MODE_OUTPUT,
+	GPIO_MODE_INPUT_OUTPUT,
+	GPIO_MODE_INPUT_OUTPUT_OD,
+	GPIO_MODE_OUTPUT_OD,
+} gpio_mode_t;
+
+#define GPIO_OUT_W1TS_REG       0x60004008U
+#define GPIO_OUT_W1TC_REG       0x6000400CU
+#define GPIO_ENABLE_W1TS_REG    0x60004024U
+#define GPIO_ENABLE_W1TC_REG    0x60004028U
+#define GPIO_IN_REG             0x6000403CU
+
+void sim_peri_write(uint32_t reg, uint32_t val);
+uint32_t sim_peri_read(uint32_t reg);
+
+#define WRITE_PERI_REG(a, v)    sim_peri_write((a), (v))
+#define READ_PERI_REG(a)        sim_peri_read(a)
+
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode);
+int gpio_set_level(gpio_num_t pin, uint32_t level);
+int gpio_get_level(gpio_num_t pin);
+void gpio_pad_select_gpio(uint32_t pin);
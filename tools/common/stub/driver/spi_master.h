@@ -0,0 +1,64 @@
+// Host stand-in for the ESP-IDF SPI master driver: transactions clock the simulated TAPs
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef enum
+{
+	SPI1_HOST,
+	SPI2_HOST,
+	SPI3_HOST,
+} spi_host_device_t;
+
+typedef enum
+{
+	SPI_DMA_DISABLED = 0,
+	SPI_DMA_CH_AUTO = 3,
+} spi_dma_chan_t;
+
+typedef struct
+{
+	int mosi_io_num;
+	int miso_io_num;
+	int sclk_io_num;
+	int quadwp_io_num;
+	int quadhd_io_num;
+	int max_transfer_sz;
+	uint32_t flags;
+} spi_bus_config_t;
+
+typedef struct
+{
+	uint8_t mode;
+	int clock_speed_hz;
+	int spics_io_num;
+	uint32_t flags;
+	int queue_size;
+} spi_device_interface_config_t;
+
+typedef struct
+{
+	uint32_t flags;
+	size_t length;
+	size_t rxlength;
+	const void *tx_buffer;
+	void *rx_buffer;
+} spi_transaction_t;
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+#define SPI_DEVICE_TXBIT_LSBFIRST   (1U << 0)
+#define SPI_DEVICE_RXBIT_LSBFIRST   (1U << 1)
+#define SPI_DEVICE_BIT_LSBFIRST     (SPI_DEVICE_TXBIT_LSBFIRST | SPI_DEVICE_RXBIT_LSBFIRST)
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus, spi_dma_chan_t dma);
+esp_err_t spi_bus_free(spi_host_device_t host);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t handle);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
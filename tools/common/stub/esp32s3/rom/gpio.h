@@ -0,0 +1 @@
+// Host stand-in: the ROM GPIO functions are declared in driver/gpio.h
@@ -0,0 +1,20 @@
+// Host stand-in for FreeRTOS: the simulation runs in one thread
+#pragma once
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+
+typedef struct
+{
+	int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    {0}
+#define portENTER_CRITICAL(mux)         (void)(mux)
+#define portEXIT_CRITICAL(mux)          (void)(mux)
+#define pdMS_TO_TICKS(ms)               (ms)
+#define portMAX_DELAY                   0xFFFFFFFFU
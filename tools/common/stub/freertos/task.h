@@ -0,0 +1 @@
+// Host stand-in: nothing from the task API is used by the simulated code
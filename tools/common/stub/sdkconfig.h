@@ -0,0 +1,4 @@
+// Host stand-in for the generated configuration, only what DAP_config.h reads
+#pragma once
+
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 240
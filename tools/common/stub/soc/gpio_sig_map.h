@@ -0,0 +1,4 @@
+// Host stand-in for the GPIO matrix signal numbers
+#pragma once
+
+#define SIG_GPIO_OUT_IDX    256
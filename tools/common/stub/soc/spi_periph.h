@@ -0,0 +1,16 @@
+// Host stand-in for the SPI signal table
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+	uint8_t spiclk_out;
+	uint8_t spiclk_in;
+	uint8_t spid_out;
+	uint8_t spiq_out;
+	uint8_t spid_in;
+	uint8_t spiq_in;
+} spi_signal_conn_t;
+
+extern const spi_signal_conn_t spi_periph_signal[3];
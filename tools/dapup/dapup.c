@@ -0,0 +1,367 @@
+/**
+ * @file    dapup.c
+ * @brief   Upload images and flash algorithms to the probe over USB
+ *
+ * usage: dapup [-t image|algo] [-f format] [-b base] [-w window] [-s serial] [-p port [-c] [-g count]] FILE
+ *
+ * The file is sent with the pipelined upload protocol over the CMSIS-DAP v2
+ * bulk endpoints. An interrupted upload resumes where it stopped when the
+ * same command is run again, as long as the probe has not been reset or
+ * unplugged in between.
+ *
+ * With -p the probe then programs the stored image into the target on that
+ * debug port (offline programming job, prog_job.c) and dapup waits for the
+ * result. -c tells the probe that the image fills the whole device, so it may
+ * use a chip erase instead of erasing sector by sector. -g programs count
+ * identical boards at once on port 0 (gang programming, swd_gang.c); dapup
+ * reports the boards that dropped out.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <libusb-1.0/libusb.h>
+#include "upload_host.h"
+#include "upload.h"
+#include "image_decoder.h"
+
+#define DAPUP_VID           0x0D28
+#define DAPUP_PID           0x0204
+#define DAPUP_INTERFACE     2           // ITF_NUM_VENDOR
+#define DAPUP_EP_OUT        0x03
+#define DAPUP_EP_IN         0x83
+#define DAPUP_WINDOW        8U          // responses of 8 chunks fit the probe's 64 byte IN FIFO
+#define DAPUP_TIMEOUT_MS    1000U
+#define DAPUP_PROGRAM       0x8AU       // ID_DAP_Vendor10, offline programming job
+#define DAPUP_STATUS_ONLY   0x80U
+#define DAPUP_CHIP_ERASE    0x01U
+#define DAPUP_POLL_MS       100U
+
+typedef struct
+{
+	libusb_device_handle *dev;
+} usb_link_t;
+
+static int usb_write(void *ctx, const uint8_t *buf, uint32_t len)
+{
+	usb_link_t *link = (usb_link_t *)ctx;
+	int done = 0;
+
+	if (libusb_bulk_transfer(link->dev, DAPUP_EP_OUT, (uint8_t *)buf, (int)len, &done, DAPUP_TIMEOUT_MS) != 0)
+	{
+		return -1;
+	}
+	return (done == (int)len) ? 0 : -1;
+}
+
+static int usb_read(void *ctx, uint8_t *buf, uint32_t len, uint32_t timeout_ms)
+{
+	usb_link_t *link = (usb_link_t *)ctx;
+	int done = 0;
+
+	if (libusb_bulk_transfer(link->dev, DAPUP_EP_IN, buf, (int)len, &done, timeout_ms) != 0)
+	{
+		return -1;
+	}
+	return done;
+}
+
+static libusb_device_handle *usb_open(const char *serial)
+{
+	libusb_device **list;
+	libusb_device_handle *dev = NULL, *h;
+	struct libusb_device_descriptor desc;
+	unsigned char sn[64];
+	ssize_t i, n;
+
+	n = libusb_get_device_list(NULL, &list);
+	for (i = 0; (i < n) && (dev == NULL); i++)
+	{
+		if ((libusb_get_device_descriptor(list[i], &desc) != 0) || (desc.idVendor != DAPUP_VID) ||
+		    (desc.idProduct != DAPUP_PID) || (libusb_open(list[i], &h) != 0))
+		{
+			continue;
+		}
+		if ((serial != NULL) &&
+		    ((libusb_get_string_descriptor_ascii(h, desc.iSerialNumber, sn, sizeof(sn)) < 0) ||
+		     (strcmp((const char *)sn, serial) != 0)))
+		{
+			libusb_close(h);
+			continue;
+		}
+		dev = h;
+	}
+	libusb_free_device_list(list, 1);
+
+	if ((dev != NULL) && (libusb_claim_interface(dev, DAPUP_INTERFACE) != 0))
+	{
+		libusb_close(dev);
+		dev = NULL;
+	}
+	return dev;
+}
+
+static int format_from_name(const char *name)
+{
+	static const struct
+	{
+		const char *ext;
+		int format;
+	} table[] = {
+		{".hex", IMAGE_FORMAT_HEX}, {".ihex", IMAGE_FORMAT_HEX}, {".srec", IMAGE_FORMAT_SREC},
+		{".s19", IMAGE_FORMAT_SREC}, {".s28", IMAGE_FORMAT_SREC}, {".s37", IMAGE_FORMAT_SREC},
+		{".mot", IMAGE_FORMAT_SREC}, {".elf", IMAGE_FORMAT_ELF}, {".axf", IMAGE_FORMAT_ELF},
+		{".flm", IMAGE_FORMAT_ELF}, {".uf2", IMAGE_FORMAT_UF2}, {".bin", IMAGE_FORMAT_BIN},
+		{".dlz", IMAGE_MAP_FORMAT_STORE},
+	};
+	const char *ext = strrchr(name, '.');
+	size_t i;
+
+	for (i = 0; (ext != NULL) && (i < sizeof(table) / sizeof(table[0])); i++)
+	{
+		if (strcasecmp(ext, table[i].ext) == 0)
+		{
+			return table[i].format;
+		}
+	}
+	return -1;
+}
+
+static int format_from_arg(const char *arg)
+{
+	static const char *names[] = {"hex", "srec", "elf", "uf2", "bin"};
+	size_t i;
+
+	if (strcmp(arg, "store") == 0)
+	{
+		return IMAGE_MAP_FORMAT_STORE;
+	}
+	for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+	{
+		if (strcmp(arg, names[i]) == 0)
+		{
+			return IMAGE_FORMAT_HEX + (int)i;
+		}
+	}
+	return -1;
+}
+
+static uint8_t *read_file(const char *name, uint32_t *size)
+{
+	FILE *f = fopen(name, "rb");
+	uint8_t *data = NULL;
+	long len;
+
+	if (f == NULL)
+	{
+		return NULL;
+	}
+	if ((fseek(f, 0, SEEK_END) == 0) && ((len = ftell(f)) >= 0) && (len <= 0x7FFFFFFF) &&
+	    (fseek(f, 0, SEEK_SET) == 0) && ((data = malloc(len ? (size_t)len : 1U)) != NULL))
+	{
+		if (fread(data, 1, (size_t)len, f) != (size_t)len)
+		{
+			free(data);
+			data = NULL;
+		}
+		*size = (uint32_t)len;
+	}
+	fclose(f);
+	return data;
+}
+
+static void progress(void *ctx, uint32_t done, uint32_t size)
+{
+	(void)ctx;
+	fprintf(stderr, "\r%u / %u bytes (%u%%)", done, size, size ? (unsigned)((uint64_t)done * 100U / size) : 100U);
+}
+
+// Start the programming job on a debug port and poll it until it has ended.
+//   flags:  DAPUP_CHIP_ERASE or 0
+//   gang:   number of gang targets, 0 = single target
+//   return: 0 = programmed, probe error code (> 0) or -1 (transport or protocol error)
+static int program(usb_link_t *link, uint8_t port, uint8_t flags, uint8_t gang)
+{
+	uint8_t req[4] = {DAPUP_PROGRAM, flags, port, gang}, rsp[64];
+	uint8_t all = (uint8_t)((1U << gang) - 1U);
+	uint32_t done, total;
+
+	for (;;)
+	{
+		if ((usb_write(link, req, sizeof(req)) != 0) || (usb_read(link, rsp, sizeof(rsp), DAPUP_TIMEOUT_MS) < 13) ||
+		    (rsp[0] != DAPUP_PROGRAM))
+		{
+			return -1;
+		}
+		if (rsp[1] != 0)
+		{
+			fprintf(stderr, "dapup: port %u is busy or does not exist\n", port);
+			return -1;
+		}
+		done  = (uint32_t)rsp[4] | ((uint32_t)rsp[5] << 8) | ((uint32_t)rsp[6] << 16) | ((uint32_t)rsp[7] << 24);
+		total = (uint32_t)rsp[8] | ((uint32_t)rsp[9] << 8) | ((uint32_t)rsp[10] << 16) | ((uint32_t)rsp[11] << 24);
+		if (rsp[2] != 1)
+		{
+			// Done or failed (idle cannot follow a start)
+			fprintf(stderr, "\n");
+			if ((gang != 0) && (rsp[12] != all))
+			{
+				fprintf(stderr, "dapup: gang targets failed (bit n = target n): 0x%02x\n",
+				        (unsigned)(all & ~rsp[12]));
+			}
+			return (rsp[2] == 2) ? 0 : ((rsp[3] != 0) ? rsp[3] : -1);
+		}
+		fprintf(stderr, "\rprogramming %u / %u bytes", done, total);
+		req[1] = DAPUP_STATUS_ONLY;
+		usleep(DAPUP_POLL_MS * 1000U);
+	}
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: dapup [-t image|algo] [-f hex|srec|elf|uf2|bin|store] [-b base] [-w window]\n"
+	                "             [-s serial] [-p port [-c] [-g count]] FILE\n");
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	upload_host_opts_t opts = {UPLOAD_TARGET_IMAGE, 0, 0, DAPUP_WINDOW, DAPUP_TIMEOUT_MS, progress, NULL};
+	upload_transport_t t = {usb_write, usb_read, NULL};
+	const char *serial = NULL;
+	int format = -1, target = -1, port = -1, c, status;
+	uint8_t flags = 0, gang = 0;
+	uint32_t size, resumed = 0;
+	usb_link_t link;
+	uint8_t *data;
+
+	while ((c = getopt(argc, argv, "t:f:b:w:s:p:cg:")) != -1)
+	{
+		switch (c)
+		{
+		case 't':
+			if (strcmp(optarg, "algo") == 0)
+			{
+				target = UPLOAD_TARGET_ALGO;
+			}
+			else if (strcmp(optarg, "image") == 0)
+			{
+				target = UPLOAD_TARGET_IMAGE;
+			}
+			else
+			{
+				usage();
+			}
+			break;
+		case 'f':
+			format = format_from_arg(optarg);
+			break;
+		case 'b':
+			opts.base = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'w':
+			opts.window = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			serial = optarg;
+			break;
+		case 'p':
+			port = (int)strtol(optarg, NULL, 0);
+			break;
+		case 'c':
+			flags |= DAPUP_CHIP_ERASE;
+			break;
+		case 'g':
+			gang = (uint8_t)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage();
+		}
+	}
+	if (optind != argc - 1)
+	{
+		usage();
+	}
+	if (format < 0)
+	{
+		format = format_from_name(argv[optind]);
+	}
+	if (format < 0)
+	{
+		fprintf(stderr, "dapup: unknown format of %s, use -f\n", argv[optind]);
+		return 2;
+	}
+	if (target < 0)
+	{
+		size_t len = strlen(argv[optind]);
+		target = ((len > 4) && (strcasecmp(&argv[optind][len - 4], ".flm") == 0)) ? UPLOAD_TARGET_ALGO :
+		         UPLOAD_TARGET_IMAGE;
+	}
+	opts.target = (uint8_t)target;
+	opts.format = (uint16_t)format;
+
+	data = read_file(argv[optind], &size);
+	if (data == NULL)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+
+	if (libusb_init(NULL) != 0)
+	{
+		fprintf(stderr, "dapup: libusb_init failed\n");
+		return 1;
+	}
+	link.dev = usb_open(serial);
+	if (link.dev == NULL)
+	{
+		fprintf(stderr, "dapup: no probe found\n");
+		libusb_exit(NULL);
+		return 1;
+	}
+	t.ctx = &link;
+
+	status = upload_host_run(&t, &opts, data, size, &resumed);
+	fprintf(stderr, "\n");
+	if (resumed != 0)
+	{
+		fprintf(stderr, "dapup: resumed at %u bytes\n", resumed);
+	}
+	if (status == UPLOAD_HOST_OK)
+	{
+		fprintf(stderr, "dapup: %u bytes stored\n", size);
+		if ((port >= 0) && (opts.target == UPLOAD_TARGET_IMAGE))
+		{
+			status = program(&link, (uint8_t)port, flags, gang);
+			if (status == 0)
+			{
+				fprintf(stderr, "dapup: target on port %d programmed\n", port);
+			}
+			else if (status > 0)
+			{
+				fprintf(stderr, "dapup: programming failed, probe error %d\n", status);
+			}
+			else
+			{
+				fprintf(stderr, "dapup: programming status lost\n");
+			}
+		}
+	}
+	else if (status > 0)
+	{
+		fprintf(stderr, "dapup: probe error %d\n", status);
+	}
+	else
+	{
+		fprintf(stderr, "dapup: %s\n", (status == UPLOAD_HOST_TRANSPORT) ? "transfer failed, run again to resume" :
+		                               (status == UPLOAD_HOST_STALLED) ? "no progress" : "protocol error");
+	}
+
+	libusb_release_interface(link.dev, DAPUP_INTERFACE);
+	libusb_close(link.dev);
+	libusb_exit(NULL);
+	free(data);
+	return (status == UPLOAD_HOST_OK) ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file    upload_host.c
+ * @brief   Host side of the pipelined image upload protocol
+ *
+ * Sends BEGIN, keeps up to opts->window DATA commands in flight and checks
+ * each response as it arrives. A DAP_ERROR response (lost or corrupted
+ * chunk) makes the sender collect the responses still outstanding and
+ * restart from the offset the probe reports (go-back-N). A timeout is
+ * handled the same way after asking the probe for its offset with STATUS.
+ * END makes the probe check the CRC of the whole file and commit it. The
+ * probe reads the partition back in steps and answers UPLOAD_BUSY until the
+ * last one, so END is repeated as long as it is busy.
+ *
+ * The engine only needs a packet transport, so it runs against the USB
+ * endpoints as well as against upload_command() called in-process.
+ */
+
+#include <string.h>
+#include "upload_host.h"
+#include "upload.h"
+#include "crc.h"
+
+#define UPLOAD_HOST_RETRIES     16U     // consecutive rewinds without progress
+
+static uint32_t get32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+// Read one response to cmd with at least len bytes
+static int response(const upload_transport_t *t, const upload_host_opts_t *o, uint8_t cmd, uint8_t *buf,
+                    uint32_t len)
+{
+	int n = t->read(t->ctx, buf, UPLOAD_PACKET_SIZE, o->timeout_ms);
+
+	if (n < 0)
+	{
+		return UPLOAD_HOST_TRANSPORT;
+	}
+	if (((uint32_t)n < len) || (buf[0] != cmd))
+	{
+		return UPLOAD_HOST_PROTOCOL;
+	}
+	return UPLOAD_HOST_OK;
+}
+
+// After a timeout: drop stale responses and ask the probe where to continue
+static int resync(const upload_transport_t *t, const upload_host_opts_t *o, uint32_t *offset)
+{
+	uint8_t pkt[UPLOAD_PACKET_SIZE];
+	int n;
+
+	pkt[0] = UPLOAD_CMD_STATUS;
+	if (t->write(t->ctx, pkt, 1) != 0)
+	{
+		return UPLOAD_HOST_TRANSPORT;
+	}
+	do
+	{
+		n = t->read(t->ctx, pkt, UPLOAD_PACKET_SIZE, o->timeout_ms);
+		if (n < 0)
+		{
+			return UPLOAD_HOST_TRANSPORT;
+		}
+	} while (pkt[0] != UPLOAD_CMD_STATUS);
+
+	if ((n < 10) || (pkt[1] == 0))
+	{
+		return UPLOAD_HOST_PROTOCOL;
+	}
+	*offset = get32(&pkt[2]);
+	return UPLOAD_HOST_OK;
+}
+
+static int send_data(const upload_transport_t *t, const uint8_t *data, uint32_t offset, uint32_t len)
+{
+	uint8_t pkt[UPLOAD_PACKET_SIZE];
+
+	pkt[0] = UPLOAD_CMD_DATA;
+	put32(&pkt[1], offset);
+	put32(&pkt[5], crc32(&data[offset], len));
+	pkt[9] = (uint8_t)len;
+	memcpy(&pkt[UPLOAD_DATA_HEADER], &data[offset], len);
+	return (t->write(t->ctx, pkt, UPLOAD_DATA_HEADER + len) == 0) ? UPLOAD_HOST_OK : UPLOAD_HOST_TRANSPORT;
+}
+
+// Upload a file.
+//   resumed: bytes the probe already had from an interrupted upload, may be NULL
+//   return:  UPLOAD_HOST_OK, UPLOAD_HOST_* or a device error code (> 0)
+int upload_host_run(const upload_transport_t *t, const upload_host_opts_t *o, const uint8_t *data,
+                    uint32_t size, uint32_t *resumed)
+{
+	uint8_t pkt[UPLOAD_PACKET_SIZE];
+	uint32_t acked, next, chunk, len, inflight = 0, retries = 0;
+	uint32_t window = (o->window != 0) ? o->window : 1U;
+	int status;
+
+	pkt[0] = UPLOAD_CMD_BEGIN;
+	pkt[1] = o->target;
+	pkt[2] = (uint8_t)o->format;
+	pkt[3] = (uint8_t)(o->format >> 8);
+	put32(&pkt[4], o->base);
+	put32(&pkt[8], size);
+	put32(&pkt[12], crc32(data, size));
+	if (t->write(t->ctx, pkt, 16) != 0)
+	{
+		return UPLOAD_HOST_TRANSPORT;
+	}
+	status = response(t, o, UPLOAD_CMD_BEGIN, pkt, 8);
+	if (status != UPLOAD_HOST_OK)
+	{
+		return status;
+	}
+	if (pkt[1] != 0)
+	{
+		return (pkt[2] != 0) ? pkt[2] : UPLOAD_HOST_PROTOCOL;
+	}
+	acked = next = get32(&pkt[3]);
+	chunk = pkt[7];
+	if ((chunk == 0) || (chunk > UPLOAD_CHUNK_MAX) || (acked > size))
+	{
+		return UPLOAD_HOST_PROTOCOL;
+	}
+	if (resumed != NULL)
+	{
+		*resumed = acked;
+	}
+
+	while (acked < size)
+	{
+		while ((inflight < window) && (next < size))
+		{
+			len = (size - next < chunk) ? (size - next) : chunk;
+			status = send_data(t, data, next, len);
+			if (status != UPLOAD_HOST_OK)
+			{
+				return status;
+			}
+			next += len;
+			inflight++;
+		}
+
+		status = response(t, o, UPLOAD_CMD_DATA, pkt, 6);
+		if (status == UPLOAD_HOST_TRANSPORT)
+		{
+			// A command or response was lost
+			status = resync(t, o, &next);
+			if ((status != UPLOAD_HOST_OK) || (next > size) || (++retries > UPLOAD_HOST_RETRIES))
+			{
+				return (status != UPLOAD_HOST_OK) ? status : UPLOAD_HOST_STALLED;
+			}
+			acked    = next;
+			inflight = 0;
+			continue;
+		}
+		if (status != UPLOAD_HOST_OK)
+		{
+			return status;
+		}
+		inflight--;
+
+		if (pkt[1] == 0)
+		{
+			if (get32(&pkt[2]) > acked)
+			{
+				acked   = get32(&pkt[2]);
+				retries = 0;
+			}
+		}
+		else
+		{
+			// Collect the responses to chunks sent after the failed one
+			while (inflight != 0)
+			{
+				status = response(t, o, UPLOAD_CMD_DATA, pkt, 6);
+				if (status == UPLOAD_HOST_TRANSPORT)
+				{
+					status = resync(t, o, &next);
+					put32(&pkt[2], next);
+					inflight = 0;
+					break;
+				}
+				if (status != UPLOAD_HOST_OK)
+				{
+					return status;
+				}
+				inflight--;
+			}
+			if (status != UPLOAD_HOST_OK)
+			{
+				return status;
+			}
+			if (get32(&pkt[2]) > acked)
+			{
+				retries = 0;
+			}
+			else if (++retries > UPLOAD_HOST_RETRIES)
+			{
+				return UPLOAD_HOST_STALLED;
+			}
+			acked = next = get32(&pkt[2]);
+			if (acked > size)
+			{
+				return UPLOAD_HOST_PROTOCOL;
+			}
+		}
+
+		if (o->progress != NULL)
+		{
+			o->progress(o->ctx, acked, size);
+		}
+	}
+
+	// Responses to retransmissions beyond the end
+	while (inflight != 0)
+	{
+		status = response(t, o, UPLOAD_CMD_DATA, pkt, 6);
+		if (status == UPLOAD_HOST_TRANSPORT)
+		{
+			status = resync(t, o, &next);
+			inflight = 0;
+		}
+		else
+		{
+			inflight--;
+		}
+		if (status != UPLOAD_HOST_OK)
+		{
+			return status;
+		}
+	}
+
+	do
+	{
+		pkt[0] = UPLOAD_CMD_END;
+		if (t->write(t->ctx, pkt, 1) != 0)
+		{
+			return UPLOAD_HOST_TRANSPORT;
+		}
+		status = response(t, o, UPLOAD_CMD_END, pkt, 3);
+		if (status != UPLOAD_HOST_OK)
+		{
+			return status;
+		}
+	} while (pkt[1] == UPLOAD_BUSY);
+	return (pkt[1] == 0) ? UPLOAD_HOST_OK : ((pkt[2] != 0) ? pkt[2] : UPLOAD_HOST_PROTOCOL);
+}
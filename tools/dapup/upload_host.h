@@ -0,0 +1,46 @@
+/**
+ * @file    upload_host.h
+ * @brief   Host side of the pipelined image upload protocol
+ */
+#ifndef UPLOAD_HOST_H
+#define UPLOAD_HOST_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Packet transport, e.g. the vendor bulk endpoints or an in-process loop.
+typedef struct
+{
+	int (*write)(void *ctx, const uint8_t *buf, uint32_t len);                  // 0 on success
+	int (*read)(void *ctx, uint8_t *buf, uint32_t len, uint32_t timeout_ms);    // bytes read, < 0 on error
+	void *ctx;
+} upload_transport_t;
+
+typedef struct
+{
+	uint8_t target;                 // UPLOAD_TARGET_*
+	uint16_t format;                // image_format_t or IMAGE_MAP_FORMAT_STORE
+	uint32_t base;                  // load address of binary images
+	uint32_t window;                // DATA commands in flight
+	uint32_t timeout_ms;
+	void (*progress)(void *ctx, uint32_t done, uint32_t size);
+	void *ctx;
+} upload_host_opts_t;
+
+//! Result codes besides the device error codes (dap_err_t).
+#define UPLOAD_HOST_OK          0
+#define UPLOAD_HOST_TRANSPORT   (-1)    // transport error or timeout, run again to resume
+#define UPLOAD_HOST_PROTOCOL    (-2)    // unexpected response
+#define UPLOAD_HOST_STALLED     (-3)    // no progress after repeated retransmissions
+
+int upload_host_run(const upload_transport_t *t, const upload_host_opts_t *opts, const uint8_t *data,
+                    uint32_t size, uint32_t *resumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
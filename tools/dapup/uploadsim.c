@@ -0,0 +1,345 @@
+/**
+ * @file    uploadsim.c
+ * @brief   Run the upload engine against upload_command() in-process
+ *
+ * usage: uploadsim [-n size] [-w window] [-s seed] [-e erase_ms] [-r read_kb_per_ms] [-t timeout_ms] [-o file]
+ *
+ * The transport hands each packet straight to upload_command(), which writes
+ * to a file in place of the image partition, and queues the response. It
+ * can drop or corrupt DATA commands and drop responses, which the host sees
+ * as a timeout. Four runs are made: a clean upload, a lossy one, one that is
+ * cut off and resumed, and one where the stored file is damaged during the
+ * read-back at END, which must then fail without a valid header. While that
+ * upload runs, the partition must be refused to a second writer (the USB
+ * drive) and to a mapping.
+ *
+ * Every command is charged the flash time it would take on the probe, from
+ * the sectors it erased, the bytes it programmed and the bytes it read back.
+ * No command may exceed the host timeout, as the probe answers each request
+ * before it takes the next one.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "upload_host.h"
+#include "upload.h"
+#include "crc.h"
+#include "sim.h"
+
+#define QUEUE_SIZE          256U
+#define PROGRAM_KB_PER_MS   0.4         // page program, about 0.6 ms per 256 bytes
+
+typedef struct
+{
+	upload_t dev;
+	uint8_t queue[QUEUE_SIZE][UPLOAD_PACKET_SIZE];
+	uint32_t length[QUEUE_SIZE];
+	uint32_t head;
+	uint32_t tail;
+	uint32_t drop_cmd;                  // 1 in n DATA commands is lost, 0 = none
+	uint32_t corrupt;                   // 1 in n DATA commands has a flipped bit
+	uint32_t drop_rsp;                  // 1 in n responses is lost
+	uint32_t cut;                       // writes until the transport fails, 0 = never
+	uint32_t commands;
+	uint32_t busy;                      // END answered UPLOAD_BUSY
+	double erase_ms;
+	double read_kb_per_ms;
+	double worst_ms;
+	uint8_t worst_cmd;
+} sim_t;
+
+static const char *cmd_names[] = { "BEGIN", "DATA", "END", "STATUS" };
+
+
+// Growth of a writer counter over one command; BEGIN may restart it from 0
+static uint32_t delta(uint32_t before, uint32_t after)
+{
+	return (after >= before) ? (after - before) : after;
+}
+
+static int sim_write(void *ctx, const uint8_t *buf, uint32_t len)
+{
+	sim_t *s = (sim_t *)ctx;
+	uint8_t req[UPLOAD_PACKET_SIZE] = {0}, rsp[UPLOAD_PACKET_SIZE] = {0};
+	uint32_t erased = s->dev.out.erased, checked = s->dev.out.checked, offset = s->dev.out.offset, num;
+	double ms;
+
+	if ((s->cut != 0U) && (--s->cut == 0U))
+	{
+		return -1;
+	}
+	memcpy(req, buf, len);
+	if (req[0] == UPLOAD_CMD_DATA)
+	{
+		if ((s->drop_cmd != 0U) && (rnd(s->drop_cmd) == 0U))
+		{
+			return 0;
+		}
+		if ((s->corrupt != 0U) && (rnd(s->corrupt) == 0U) && (len > UPLOAD_DATA_HEADER))
+		{
+			req[UPLOAD_DATA_HEADER + rnd(len - UPLOAD_DATA_HEADER)] ^= (uint8_t)(1U << rnd(8));
+		}
+	}
+
+	rsp[0] = req[0];
+	num = upload_command(&s->dev, req[0], &req[1], &rsp[1]);
+	s->commands++;
+	if ((req[0] == UPLOAD_CMD_END) && (rsp[1] == UPLOAD_BUSY))
+	{
+		s->busy++;
+	}
+
+	ms = (double)(delta(erased, s->dev.out.erased) / IMAGE_MAP_SECTOR_SIZE) * s->erase_ms +
+	     (double)delta(offset, s->dev.out.offset) / 1024.0 / PROGRAM_KB_PER_MS +
+	     (double)delta(checked, s->dev.out.checked) / 1024.0 / s->read_kb_per_ms;
+	if (ms > s->worst_ms)
+	{
+		s->worst_ms  = ms;
+		s->worst_cmd = req[0];
+	}
+
+	if ((s->drop_rsp != 0U) && (rnd(s->drop_rsp) == 0U))
+	{
+		return 0;
+	}
+	if (s->tail - s->head < QUEUE_SIZE)
+	{
+		memcpy(s->queue[s->tail % QUEUE_SIZE], rsp, UPLOAD_PACKET_SIZE);
+		s->length[s->tail % QUEUE_SIZE] = (num & 0xFFFFU) + 1U;
+		s->tail++;
+	}
+	return 0;
+}
+
+// An empty queue is a timeout
+static int sim_read(void *ctx, uint8_t *buf, uint32_t len, uint32_t timeout_ms)
+{
+	sim_t *s = (sim_t *)ctx;
+	uint32_t n;
+
+	(void)timeout_ms;
+	if (s->head == s->tail)
+	{
+		return -1;
+	}
+	n = s->length[s->head % QUEUE_SIZE];
+	memcpy(buf, s->queue[s->head % QUEUE_SIZE], (n < len) ? n : len);
+	s->head++;
+	return (int)n;
+}
+
+// The stored image must be valid and equal to data
+static int check_image(const char *path, const uint8_t *data, uint32_t size)
+{
+	image_map_t m;
+	int failed;
+
+	if (image_map_open(&m, path) != ERROR_SUCCESS)
+	{
+		printf("  no valid image stored\n");
+		return 1;
+	}
+	failed = (m.header.size != size) || (memcmp(m.data, data, size) != 0) || (image_map_check(&m) != ERROR_SUCCESS);
+	image_map_close(&m);
+	if (failed)
+	{
+		printf("  stored image differs\n");
+	}
+	return failed;
+}
+
+static int run(const char *name, sim_t *s, const upload_host_opts_t *o, const uint8_t *data, uint32_t size,
+               const char *path)
+{
+	upload_transport_t t = {sim_write, sim_read, s};
+	uint32_t resumed = 0;
+	int status, attempts = 0, failed;
+
+	s->commands = s->busy = 0;
+	s->worst_ms = 0.0;
+	do
+	{
+		s->head = s->tail = 0;
+		status = upload_host_run(&t, o, data, size, &resumed);
+		attempts++;
+	} while ((status == UPLOAD_HOST_TRANSPORT) && (attempts < 100));
+
+	failed = (status != UPLOAD_HOST_OK) || check_image(path, data, size);
+	printf("%-8s %s after %d run%s, resumed at %u, %u commands, END busy %u times, slowest %s %.1f ms\n", name,
+	       (status == UPLOAD_HOST_OK) ? "ok" : "FAILED", attempts, (attempts > 1) ? "s" : "", resumed, s->commands,
+	       s->busy, cmd_names[s->worst_cmd - UPLOAD_CMD_BEGIN], s->worst_ms);
+	return failed;
+}
+
+// Damage the file during the read-back: END must fail and leave no header
+static int damaged(sim_t *s, const uint8_t *data, uint32_t size, const char *path)
+{
+	uint8_t req[UPLOAD_PACKET_SIZE], rsp[UPLOAD_PACKET_SIZE];
+	uint32_t offset, next, len, steps = 0;
+	image_map_writer_t w;
+	image_map_t m;
+	int fd, failed = 0;
+
+	req[0] = 0;
+	req[1] = 5;
+	req[2] = 0;
+	memset(&req[3], 0, 4);
+	memcpy(&req[7], &size, 4);
+	offset = crc32(data, size);
+	memcpy(&req[11], &offset, 4);
+	upload_command(&s->dev, UPLOAD_CMD_BEGIN, req, rsp);
+	if ((image_map_writer_open(&w, path) != ERROR_IMAGE_BUSY) || (image_map_open(&m, path) != ERROR_IMAGE_BUSY))
+	{
+		printf("damaged: partition not held by the upload\n");
+		failed = 1;
+	}
+	image_map_close(&m);
+	for (offset = 0; offset < size; offset += len)
+	{
+		len = (size - offset < UPLOAD_CHUNK_MAX) ? (size - offset) : UPLOAD_CHUNK_MAX;
+		if (upload_data(&s->dev, offset, &data[offset], len, crc32(&data[offset], len), &next) != ERROR_SUCCESS)
+		{
+			printf("damaged: DATA refused at %u\n", next);
+			return 1;
+		}
+	}
+
+	upload_command(&s->dev, UPLOAD_CMD_END, req, rsp);
+	upload_command(&s->dev, UPLOAD_CMD_STATUS, req, &rsp[2]);
+	if ((rsp[0] != UPLOAD_BUSY) || (rsp[2] != UPLOAD_STATE_VERIFY) || (s->dev.out.checked != UPLOAD_VERIFY_STEP))
+	{
+		printf("damaged: END did not start the read-back in steps\n");
+		failed = 1;
+	}
+
+	fd = open(path, O_WRONLY);
+	if ((fd < 0) || (pwrite(fd, "x", 1, sizeof(image_map_header_t) + size - 1U) != 1))
+	{
+		perror(path);
+		return 1;
+	}
+	close(fd);
+
+	do
+	{
+		upload_command(&s->dev, UPLOAD_CMD_END, req, rsp);
+		steps++;
+	} while ((rsp[0] == UPLOAD_BUSY) && (steps < size));
+	if ((rsp[0] != 0xFFU) || (rsp[1] != ERROR_IMAGE_STORE) || (image_map_open(&m, path) != ERROR_IMAGE_STORE))
+	{
+		printf("damaged: END answered %02X/%u for a changed partition\n", rsp[0], rsp[1]);
+		failed = 1;
+	}
+	printf("damaged  %s, read-back rejected after %u more END commands\n", failed ? "FAILED" : "ok", steps);
+	return failed;
+}
+
+int main(int argc, char **argv)
+{
+	static sim_t sim;
+	upload_host_opts_t o = {UPLOAD_TARGET_IMAGE, 5, 0x08000000U, 32, 100, NULL, NULL};
+	char path[64] = "/tmp/uploadsim.XXXXXX";
+	const char *file = NULL;
+	sim_args_t args;
+	uint32_t size, i;
+	double limit = 100.0, worst = 0.0;
+	uint8_t *data;
+	int opt, fd;
+	uint32_t failed = 0;
+
+	sim.erase_ms       = 45.0;
+	sim.read_kb_per_ms = 10.0;
+	sim_args_init(&args, 0x100000U);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "w:e:r:t:o:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'w':
+				o.window = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'e':
+				sim.erase_ms = strtod(optarg, NULL);
+				break;
+			case 'r':
+				sim.read_kb_per_ms = strtod(optarg, NULL);
+				break;
+			case 't':
+				limit = strtod(optarg, NULL);
+				break;
+			case 'o':
+				file = optarg;
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-n size] [-w window] [-s seed] [-e erase_ms] [-r read_kb_per_ms] "
+					        "[-t timeout_ms] [-o file]\n", argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	size = args.count;
+	if ((size <= UPLOAD_VERIFY_STEP) || (o.window == 0U) || (o.window > QUEUE_SIZE / 2U))
+	{
+		fprintf(stderr, "size above %u bytes and a window of 1 to %u\n", UPLOAD_VERIFY_STEP, QUEUE_SIZE / 2U);
+		return 2;
+	}
+	if (file == NULL)
+	{
+		fd = mkstemp(path);
+		if (fd < 0)
+		{
+			perror(path);
+			return 2;
+		}
+		close(fd);
+		file = path;
+	}
+	sim_seed(args.seed);
+	data = (uint8_t *)malloc(size);
+	if (data == NULL)
+	{
+		return 2;
+	}
+	for (i = 0; i < size; i++)
+	{
+		data[i] = (uint8_t)rnd(256);
+	}
+	upload_init(&sim.dev, file, file);
+	printf("seed %u, %u bytes, window %u, sector erase %.0f ms, read-back %.0f KB/ms\n", args.seed, size, o.window,
+	       sim.erase_ms, sim.read_kb_per_ms);
+
+	failed += run("clean", &sim, &o, data, size, file);
+	worst = (sim.worst_ms > worst) ? sim.worst_ms : worst;
+
+	sim.drop_cmd = 50;
+	sim.corrupt  = 70;
+	sim.drop_rsp = 100;
+	data[0] ^= 1;
+	failed += run("lossy", &sim, &o, data, size, file);
+	worst = (sim.worst_ms > worst) ? sim.worst_ms : worst;
+
+	sim.drop_cmd = sim.corrupt = sim.drop_rsp = 0;
+	sim.cut = size / UPLOAD_CHUNK_MAX / 2U;
+	data[0] ^= 1;
+	failed += run("resume", &sim, &o, data, size, file);
+	worst = (sim.worst_ms > worst) ? sim.worst_ms : worst;
+
+	failed += damaged(&sim, data, size, file);
+
+	if (file == path)
+	{
+		unlink(path);
+	}
+	free(data);
+	if (worst >= limit)
+	{
+		printf("a command takes %.1f ms of flash time, the host gives up after %.0f ms\n", worst, limit);
+		failed++;
+	}
+	return sim_report(4, "runs", failed);
+}
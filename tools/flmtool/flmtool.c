@@ -0,0 +1,208 @@
+/**
+ * @file    flmtool.c
+ * @brief   Build and check flash algorithm cache images from .FLM files
+ *
+ * usage: flmtool [-r ram_start] [-s ram_size] [-o cache.bin] FILE.FLM...
+ *
+ * Every file goes through flash_algo_build() and flash_algo_load() exactly as
+ * on the probe. The device, sector runs, RAM layout and entry points are
+ * printed and the image is checked: the build is reproducible, a corrupted
+ * image is rejected, the entry points are Thumb addresses inside the blob, the
+ * sectors lie inside the device and buffer and stack fit the RAM. With -o the
+ * cache image of a single file is written out.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "flash_algo.h"
+
+#define FLMTOOL_RAM_START   0x20000000U
+#define FLMTOOL_RAM_SIZE    0x4000U     // same window as the GDB server
+
+static uint32_t ram_start = FLMTOOL_RAM_START;
+static uint32_t ram_size = FLMTOOL_RAM_SIZE;
+static int failed;
+
+static void fail(const char *file, const char *what)
+{
+	printf("%s: %s\n", file, what);
+	failed = 1;
+}
+
+static void check_entry(const char *file, const flash_algo_t *algo, const char *name, uint32_t addr)
+{
+	char msg[96];
+
+	if (addr == 0U)
+	{
+		return;
+	}
+	if (!(addr & 1U) || ((addr & ~1U) < algo->target.algo_start + 32U) ||
+	    ((addr & ~1U) >= algo->target.algo_start + algo->target.algo_size))
+	{
+		snprintf(msg, sizeof(msg), "%s 0x%08X is not a Thumb address inside the blob", name, addr);
+		fail(file, msg);
+	}
+}
+
+static void show(const char *file, const flash_algo_t *algo, uint32_t used)
+{
+	const flash_algo_device_t *dev = &algo->device;
+	const program_target_t *t = &algo->target;
+	uint32_t i, end;
+
+	printf("%s: %s (type %u, FlashOS %u.%02u)\n", file, dev->name, dev->type,
+	       dev->version >> 8, dev->version & 0xFFU);
+	printf("  flash    0x%08X + 0x%X, page 0x%X, erased 0x%02X, timeouts %u/%u ms\n", dev->start, dev->size,
+	       dev->page_size, dev->erased_value, dev->program_timeout, dev->erase_timeout);
+	for (i = 0; i < algo->sector_count; i++)
+	{
+		end = (i + 1U < algo->sector_count) ? algo->sectors[i + 1U].start : dev->start + dev->size;
+		printf("  sectors  0x%08X .. 0x%08X, 0x%X each\n", algo->sectors[i].start, end, algo->sectors[i].size);
+	}
+	printf("  ram      algo 0x%08X + 0x%X, buffer 0x%08X + 0x%X, stack 0x%08X\n", t->algo_start,
+	       t->algo_size, t->program_buffer, t->program_buffer_size, t->sys_call_s.stack_pointer);
+	printf("  entries  Init 0x%08X UnInit 0x%08X EraseChip 0x%08X EraseSector 0x%08X\n", t->init, t->uninit,
+	       t->erase_chip, t->erase_sector);
+	printf("           ProgramPage 0x%08X Verify 0x%08X, static base 0x%08X\n", t->program_page, t->verify,
+	       t->sys_call_s.static_base);
+	printf("  cache    %u bytes\n", used);
+}
+
+static void check(const char *file, const flash_algo_t *algo, uint8_t *cache, uint32_t used)
+{
+	const flash_algo_device_t *dev = &algo->device;
+	const program_target_t *t = &algo->target;
+	flash_algo_t copy;
+	uint32_t i, last;
+
+	check_entry(file, algo, "Init", t->init);
+	check_entry(file, algo, "UnInit", t->uninit);
+	check_entry(file, algo, "EraseChip", t->erase_chip);
+	check_entry(file, algo, "EraseSector", t->erase_sector);
+	check_entry(file, algo, "ProgramPage", t->program_page);
+	check_entry(file, algo, "Verify", t->verify);
+
+	if ((t->algo_blob[0] != 0xE00ABE00U) || (t->sys_call_s.breakpoint != t->algo_start + 1U))
+	{
+		fail(file, "blob does not start with the breakpoint header");
+	}
+	if ((t->program_buffer < t->algo_start + t->algo_size) ||
+	    (t->program_buffer + t->program_buffer_size + FLASH_ALGO_STACK_SIZE > t->sys_call_s.stack_pointer) ||
+	    (t->sys_call_s.stack_pointer > ram_start + ram_size))
+	{
+		fail(file, "RAM layout overlaps");
+	}
+
+	last = dev->start + dev->size;
+	for (i = 0; i < algo->sector_count; i++)
+	{
+		if ((algo->sectors[i].size == 0U) || (algo->sectors[i].start >= last) ||
+		    ((i == 0U) ? (algo->sectors[i].start != dev->start) :
+		                 (algo->sectors[i].start <= algo->sectors[i - 1U].start)))
+		{
+			fail(file, "sector runs are not ascending inside the device");
+			break;
+		}
+	}
+
+	// One flipped bit in the blob must be caught by the image CRC
+	cache[used - 1U] ^= 0x01U;
+	if (flash_algo_load(cache, used, &copy) == ERROR_SUCCESS)
+	{
+		fail(file, "corrupted image accepted");
+	}
+	cache[used - 1U] ^= 0x01U;
+}
+
+static int run(const char *file, const char *out)
+{
+	uint32_t size = sizeof(flash_algo_cache_t) + FLASH_ALGO_MAX_SECTORS * sizeof(sector_info_t) + ram_size;
+	uint8_t *cache = malloc(size), *again = malloc(size);
+	uint32_t used = 0, used2 = 0;
+	flash_algo_t algo;
+	dap_err_t err;
+	FILE *f, *o;
+
+	if ((cache == NULL) || (again == NULL) || ((f = fopen(file, "rb")) == NULL))
+	{
+		perror(file);
+		free(cache);
+		free(again);
+		return 1;
+	}
+
+	err = flash_algo_build(flash_algo_read_file, f, ram_start, ram_size, cache, size, &used);
+	if (err == ERROR_SUCCESS)
+	{
+		err = flash_algo_load(cache, used, &algo);
+	}
+	if (err != ERROR_SUCCESS)
+	{
+		fail(file, error_get_string(err));
+	}
+	else
+	{
+		show(file, &algo, used);
+		check(file, &algo, cache, used);
+
+		if ((flash_algo_build(flash_algo_read_file, f, ram_start, ram_size, again, size, &used2) != ERROR_SUCCESS) ||
+		    (used2 != used) || (memcmp(cache, again, used) != 0))
+		{
+			fail(file, "second build differs");
+		}
+
+		if (out != NULL)
+		{
+			if (((o = fopen(out, "wb")) == NULL) || (fwrite(cache, 1, used, o) != used) || (fclose(o) != 0))
+			{
+				perror(out);
+				failed = 1;
+			}
+		}
+	}
+
+	fclose(f);
+	free(cache);
+	free(again);
+	return failed;
+}
+
+int main(int argc, char **argv)
+{
+	const char *out = NULL;
+	int opt, i;
+
+	while ((opt = getopt(argc, argv, "r:s:o:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'r':
+			ram_start = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			ram_size = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			out = optarg;
+			break;
+		default:
+			optind = argc + 1;
+			break;
+		}
+	}
+
+	if ((optind >= argc) || ((out != NULL) && (argc - optind != 1)))
+	{
+		fprintf(stderr, "usage: %s [-r ram_start] [-s ram_size] [-o cache.bin] FILE.FLM...\n", argv[0]);
+		return 2;
+	}
+
+	for (i = optind; i < argc; i++)
+	{
+		run(argv[i], out);
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,720 @@
+/**
+ * @file    gangsim.c
+ * @brief   Gang SWD engine against bit-level models of several targets
+ *
+ * usage: gangsim [-t targets] [-n bytes] [-s seed]
+ *
+ * swd_gang.c is built unchanged; its GPIO register accesses go to a
+ * simulated bus (../common/stub/driver/gpio.h). Each target is an SWD
+ * slave that samples SWDIO on the rising edge of the shared SWCLK and
+ * drives its own line, with a DP, a MEM-AP, 16 KB of RAM and the core
+ * debug registers. An undriven line reads high (pull-up). Driving a line
+ * from both the probe and a target is reported as contention.
+ *
+ * The runs cover connect and IDCODE, reset and halt, broadcast writes
+ * across auto-increment pages, per-target reads, WAIT retries on one
+ * target, a verify mismatch, FAULT, a read parity error, an empty socket,
+ * a failing flash function and the registers each target sees for a
+ * syscall. Failing targets must be dropped and the others must carry on
+ * with correct memory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "swd_gang.h"
+#include "swd_host.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "debug_cm.h"
+#include "sim.h"
+
+#define DBG_Addr            0xE000EDF0U
+#define RAM_BASE            0x20000000U
+#define RAM_SIZE            0x4000U
+#define TARGET_IDCODE       0x0BC11477U
+#define DCRSR_ADDR          0xE000EDF4U
+#define DCRDR_ADDR          0xE000EDF8U
+#define HALT_POLLS          3U          // DHCSR reads before a running core halts
+
+typedef enum
+{
+	PHASE_REQUEST,
+	PHASE_TURN,
+	PHASE_ACK1,
+	PHASE_ACK2,
+	PHASE_ACK3,
+	PHASE_RDATA,
+	PHASE_RPARITY,
+	PHASE_RTURN,
+	PHASE_WTURN,
+	PHASE_WDATA,
+	PHASE_WPARITY,
+	PHASE_LOCKED,                       // protocol error, until a line reset
+} phase_t;
+
+typedef struct
+{
+	uint32_t pin;
+	uint8_t present;                    // 0 = empty socket, never drives
+	uint8_t drive;
+	uint8_t out;
+	phase_t phase;
+	uint32_t bits;
+	uint32_t shift;
+	uint32_t ones;                      // consecutive high bits, 50 = line reset
+	uint32_t ack;
+	uint32_t request;                   // APnDP, RnW, A[3:2]
+	uint32_t rdata;
+	uint8_t up;                         // valid request seen since the last line reset
+	uint32_t errors;                    // protocol errors once up
+
+	// Fault injection
+	uint32_t wait_every;                // every n-th AP access answers WAIT
+	uint32_t fault_at;                  // AP access that answers FAULT
+	uint32_t parity_at;                 // AP read with a bad parity
+	uint32_t result;                    // R0 returned by a flash function
+
+	// Debug port
+	uint32_t ap_count;
+	uint32_t ctrl;
+	uint32_t select;
+	uint32_t rdbuff;
+	uint32_t csw;
+	uint32_t tar;
+
+	// Core
+	uint8_t ram[RAM_SIZE];
+	uint32_t reg[17];
+	uint32_t dhcsr;
+	uint32_t demcr;
+	uint32_t dcrdr;
+	uint8_t halted;
+	uint32_t run_polls;                 // DHCSR reads until the running core halts
+	uint32_t calls;
+	uint32_t entry;                     // PC of the last call
+} target_t;
+
+DAP_Port_t DAP_Ports[DAP_PORT_COUNT];
+__thread DAP_Port_t *DAP_Port = &DAP_Ports[0];
+
+static const uint8_t swdio_pins[SWD_GANG_MAX] = SWD_GANG_SWDIO_PINS;
+static const uint8_t nreset_pins[SWD_GANG_MAX] = SWD_GANG_nRESET_PINS;
+
+static target_t targets[SWD_GANG_MAX];
+static uint32_t target_count;
+static uint32_t gpio_out, gpio_oe;
+static uint64_t reset_low;              // nRESET pins held low, GPIO0..63
+static uint32_t contention;
+static uint64_t clocks;
+
+static uint32_t parity32(uint32_t v)
+{
+	v ^= v >> 16;
+	v ^= v >> 8;
+	v ^= v >> 4;
+	v ^= v >> 2;
+	v ^= v >> 1;
+	return v & 1U;
+}
+
+// Level of every GPIO0..31 as the probe samples it
+static uint32_t bus_lines(void)
+{
+	uint32_t lines = gpio_out & gpio_oe, t;
+
+	lines |= ~gpio_oe;
+	for (t = 0; t < target_count; t++)
+	{
+		if (targets[t].drive && !((gpio_oe >> targets[t].pin) & 1U) && !targets[t].out)
+		{
+			lines &= ~(1U << targets[t].pin);
+		}
+	}
+	return lines;
+}
+
+static uint32_t mem_read(target_t *t, uint32_t addr)
+{
+	uint32_t val = 0;
+
+	if ((addr >= RAM_BASE) && (addr - RAM_BASE < RAM_SIZE))
+	{
+		memcpy(&val, &t->ram[addr - RAM_BASE], 4);
+	}
+	else if (addr == DBG_HCSR)
+	{
+		if (!t->halted && t->run_polls && (--t->run_polls == 0U))
+		{
+			t->halted = 1;
+		}
+		val = (t->dhcsr & 0xFFFFU) | S_REGRDY | (t->halted ? S_HALT : 0U);
+	}
+	else if (addr == DBG_EMCR)
+	{
+		val = t->demcr;
+	}
+	else if (addr == DCRDR_ADDR)
+	{
+		val = t->dcrdr;
+	}
+	return val;
+}
+
+// Run a flash function: check the call and return t->result
+static void core_run(target_t *t)
+{
+	t->calls++;
+	t->entry     = t->reg[15];
+	t->reg[0]    = t->result;
+	t->reg[15]   = t->reg[14];
+	t->run_polls = HALT_POLLS;
+}
+
+static void mem_write(target_t *t, uint32_t addr, uint32_t val)
+{
+	uint32_t sel;
+
+	if ((addr >= RAM_BASE) && (addr - RAM_BASE < RAM_SIZE))
+	{
+		memcpy(&t->ram[addr - RAM_BASE], &val, 4);
+	}
+	else if ((addr == DBG_HCSR) && ((val & 0xFFFF0000U) == DBGKEY))
+	{
+		t->dhcsr = val & 0xFFFFU;
+		if ((val & C_DEBUGEN) && (val & C_HALT))
+		{
+			t->halted = 1;
+		}
+		else if ((val & C_DEBUGEN) && t->halted)
+		{
+			t->halted = 0;
+			core_run(t);
+		}
+	}
+	else if (addr == DBG_EMCR)
+	{
+		t->demcr = val;
+	}
+	else if (addr == DCRDR_ADDR)
+	{
+		t->dcrdr = val;
+	}
+	else if (addr == DCRSR_ADDR)
+	{
+		sel = val & 0x1FU;
+		if (sel < 17U)
+		{
+			if (val & (1U << 16))
+			{
+				t->reg[sel] = t->dcrdr;
+			}
+			else
+			{
+				t->dcrdr = t->reg[sel];
+			}
+		}
+	}
+}
+
+// Register access after an OK acknowledge, reads return the value for the data phase
+static uint32_t reg_access(target_t *t, uint32_t wdata)
+{
+	uint32_t ap = t->request & 1U, rnw = (t->request >> 1) & 1U, a = t->request & 0x0CU, prev;
+
+	if (!ap)
+	{
+		if (rnw)
+		{
+			return (a == DP_IDCODE) ? TARGET_IDCODE : (a == DP_CTRL_STAT) ? t->ctrl : (a == DP_RDBUFF) ? t->rdbuff : 0U;
+		}
+		if (a == DP_CTRL_STAT)
+		{
+			// Power-up requests are acknowledged at once
+			t->ctrl = (wdata & ~(CDBGPWRUPACK | CSYSPWRUPACK)) | ((wdata & (CDBGPWRUPREQ | CSYSPWRUPREQ)) << 1);
+		}
+		else if (a == DP_SELECT)
+		{
+			t->select = wdata;
+		}
+		else if (a == DP_ABORT)
+		{
+			t->ctrl &= ~STICKYERR;
+		}
+		return 0;
+	}
+
+	a |= t->select & APBANKSEL;
+	if (rnw)
+	{
+		// Posted read: return the previous result, start the next one
+		prev = t->rdbuff;
+		if (a == AP_CSW)
+		{
+			t->rdbuff = t->csw;
+		}
+		else if (a == AP_TAR)
+		{
+			t->rdbuff = t->tar;
+		}
+		else if (a == AP_DRW)
+		{
+			t->rdbuff = mem_read(t, t->tar);
+			t->tar += (t->csw & CSW_SADDRINC) ? 4U : 0U;
+		}
+		return prev;
+	}
+	if (a == AP_CSW)
+	{
+		t->csw = wdata;
+	}
+	else if (a == AP_TAR)
+	{
+		t->tar = wdata;
+	}
+	else if (a == AP_DRW)
+	{
+		mem_write(t, t->tar, wdata);
+		t->tar += (t->csw & CSW_SADDRINC) ? 4U : 0U;
+	}
+	return 0;
+}
+
+// Rising SWCLK edge: sample SWDIO, then update the output
+static void target_edge(target_t *t, uint32_t level)
+{
+	uint32_t host = (gpio_oe >> t->pin) & 1U, bit = (level >> t->pin) & 1U, ap, rnw, a;
+
+	if (!t->present)
+	{
+		return;
+	}
+	if (host && bit)
+	{
+		if (++t->ones >= 50U)
+		{
+			t->phase = PHASE_REQUEST;
+			t->bits  = 0;
+			t->drive = 0;
+			t->up    = 0;
+			return;
+		}
+	}
+	else
+	{
+		t->ones = 0;
+	}
+
+	switch (t->phase)
+	{
+	case PHASE_REQUEST:
+		if ((t->bits == 0) && !bit)
+		{
+			return;             // idle
+		}
+		t->shift = (t->bits == 0) ? bit : (t->shift | (bit << t->bits));
+		if (++t->bits < 8U)
+		{
+			return;
+		}
+		t->bits = 0;
+		ap  = (t->shift >> 1) & 1U;
+		rnw = (t->shift >> 2) & 1U;
+		a   = ((t->shift >> 3) & 3U) << 2;
+		if (!(t->shift & 1U) || ((t->shift >> 6) & 1U) || !((t->shift >> 7) & 1U) ||
+		    (parity32(t->shift & 0x1EU) != ((t->shift >> 5) & 1U)))
+		{
+			// The JTAG-to-SWD sequence lands here before the link is up,
+			// all ones are the start of a line reset
+			t->errors += t->up && (t->shift != 0xFFU);
+			t->phase = PHASE_LOCKED;
+			return;
+		}
+		t->up = 1;
+		t->request = ap | (rnw << 1) | a;
+		t->ack = DAP_TRANSFER_OK;
+		if (ap)
+		{
+			t->ap_count++;
+			if (t->wait_every && ((t->ap_count % t->wait_every) == 0U))
+			{
+				t->ack = DAP_TRANSFER_WAIT;
+			}
+			if (t->fault_at && (t->ap_count >= t->fault_at))
+			{
+				t->ack = DAP_TRANSFER_FAULT;
+				t->ctrl |= STICKYERR;
+			}
+		}
+		if ((t->ack == DAP_TRANSFER_OK) && rnw)
+		{
+			t->rdata = reg_access(t, 0);
+		}
+		t->phase = PHASE_TURN;
+		return;
+
+	case PHASE_TURN:
+		t->drive = 1;
+		t->out   = t->ack & 1U;
+		t->phase = PHASE_ACK1;
+		return;
+
+	case PHASE_ACK1:
+		t->out   = (t->ack >> 1) & 1U;
+		t->phase = PHASE_ACK2;
+		return;
+
+	case PHASE_ACK2:
+		t->out   = (t->ack >> 2) & 1U;
+		t->phase = PHASE_ACK3;
+		return;
+
+	case PHASE_ACK3:
+		if ((t->ack == DAP_TRANSFER_OK) && (t->request & 2U))
+		{
+			t->out   = t->rdata & 1U;
+			t->bits  = 1;
+			t->phase = PHASE_RDATA;
+		}
+		else
+		{
+			// Turnaround before write data, or after WAIT/FAULT
+			t->drive = 0;
+			t->phase = (t->ack == DAP_TRANSFER_OK) ? PHASE_WTURN : PHASE_RTURN;
+		}
+		return;
+
+	case PHASE_RDATA:
+		if (t->bits < 32U)
+		{
+			t->out = (t->rdata >> t->bits) & 1U;
+			t->bits++;
+		}
+		else
+		{
+			t->out = parity32(t->rdata);
+			if ((t->request & 1U) && t->parity_at && (t->ap_count == t->parity_at))
+			{
+				t->out ^= 1U;
+				t->parity_at = 0;
+			}
+			t->phase = PHASE_RPARITY;
+		}
+		return;
+
+	case PHASE_RPARITY:
+		t->drive = 0;
+		t->phase = PHASE_RTURN;
+		return;
+
+	case PHASE_RTURN:
+		t->bits  = 0;
+		t->phase = PHASE_REQUEST;
+		return;
+
+	case PHASE_WTURN:
+		t->bits  = 0;
+		t->shift = 0;
+		t->phase = PHASE_WDATA;
+		return;
+
+	case PHASE_WDATA:
+		t->shift |= bit << t->bits;
+		if (++t->bits == 32U)
+		{
+			t->phase = PHASE_WPARITY;
+		}
+		return;
+
+	case PHASE_WPARITY:
+		if (bit == parity32(t->shift))
+		{
+			reg_access(t, t->shift);
+		}
+		else
+		{
+			t->errors++;
+		}
+		t->bits  = 0;
+		t->phase = PHASE_REQUEST;
+		return;
+
+	case PHASE_LOCKED:
+		return;
+	}
+}
+
+void sim_peri_write(uint32_t reg, uint32_t val)
+{
+	uint32_t old = gpio_out, level, t;
+
+	if (reg == GPIO_OUT_W1TS_REG)
+	{
+		gpio_out |= val;
+	}
+	else if (reg == GPIO_OUT_W1TC_REG)
+	{
+		gpio_out &= ~val;
+	}
+	else if (reg == GPIO_ENABLE_W1TS_REG)
+	{
+		gpio_oe |= val;
+	}
+	else if (reg == GPIO_ENABLE_W1TC_REG)
+	{
+		gpio_oe &= ~val;
+	}
+
+	for (t = 0; t < target_count; t++)
+	{
+		if (targets[t].drive && ((gpio_oe >> targets[t].pin) & 1U))
+		{
+			contention++;
+		}
+	}
+
+	if (!(old & (1U << PIN_SWCLK)) && (gpio_out & (1U << PIN_SWCLK)))
+	{
+		clocks++;
+		level = bus_lines();
+		for (t = 0; t < target_count; t++)
+		{
+			target_edge(&targets[t], level);
+		}
+	}
+}
+
+uint32_t sim_peri_read(uint32_t reg)
+{
+	return (reg == GPIO_IN_REG) ? bus_lines() : 0U;
+}
+
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode)
+{
+	if (pin < 32)
+	{
+		if (mode == GPIO_MODE_INPUT)
+		{
+			gpio_oe &= ~(1U << pin);
+		}
+		else
+		{
+			gpio_oe |= 1U << pin;
+		}
+	}
+	return 0;
+}
+
+// nRESET low resets the core; with VC_CORERESET it halts on the reset vector
+int gpio_set_level(gpio_num_t pin, uint32_t level)
+{
+	uint32_t t;
+
+	if (pin < 32)
+	{
+		gpio_out = level ? (gpio_out | (1U << pin)) : (gpio_out & ~(1U << pin));
+	}
+	for (t = 0; t < target_count; t++)
+	{
+		if ((nreset_pins[t] == pin) && ((reset_low >> pin) & 1U) && level)
+		{
+			targets[t].halted = (targets[t].demcr & VC_CORERESET) ? 1U : 0U;
+		}
+	}
+	reset_low = level ? (reset_low & ~(1ULL << pin)) : (reset_low | (1ULL << pin));
+	return 0;
+}
+
+int gpio_get_level(gpio_num_t pin)
+{
+	return (pin < 32) ? (int)((bus_lines() >> pin) & 1U) : !((reset_low >> pin) & 1U);
+}
+
+void gpio_pad_select_gpio(uint32_t pin)
+{
+	(void)pin;
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+	return (uint32_t)clocks;
+}
+
+void delaymS(uint32_t ms)
+{
+	(void)ms;
+}
+
+static uint32_t failed;
+
+static void expect(const char *what, uint8_t got, uint8_t want)
+{
+	if (got != want)
+	{
+		printf("%s: active %02X, expected %02X\n", what, got, want);
+		failed++;
+	}
+}
+
+// Memory of the active targets must equal data
+static void expect_memory(const char *what, uint32_t offset, const uint8_t *data, uint32_t size)
+{
+	uint32_t t;
+
+	for (t = 0; t < target_count; t++)
+	{
+		if ((swd_gang_active() & (1U << t)) && (memcmp(&targets[t].ram[offset], data, size) != 0))
+		{
+			printf("%s: memory of target %u differs\n", what, t);
+			failed++;
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t data[RAM_SIZE];
+	program_syscall_t sys = {RAM_BASE + 1U, RAM_BASE + 0x800U, RAM_BASE + RAM_SIZE - 0x100U};
+	uint32_t idcode[SWD_GANG_MAX], val[SWD_GANG_MAX];
+	sim_args_t args;
+	uint32_t size, i, t;
+	uint8_t all;
+	uint64_t start;
+	int opt;
+
+	target_count = SWD_GANG_MAX;
+	sim_args_init(&args, 0x1000);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "t:")) != -1)
+	{
+		switch (opt)
+		{
+			case 't':
+				target_count = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-t targets] [-n bytes] [-s seed]\n", argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	size = args.count & ~3U;
+	if ((target_count < 6U) || (target_count > SWD_GANG_MAX) || (size < 0x100U) || (size > RAM_SIZE / 2U))
+	{
+		fprintf(stderr, "6 to %u targets and 256 to %u bytes\n", SWD_GANG_MAX, RAM_SIZE / 2U);
+		return 2;
+	}
+	sim_seed(args.seed);
+	printf("seed %u, %u targets, %u bytes\n", args.seed, target_count, size);
+
+	// Target 0 fails verify, 1 its flash function, 2 answers WAIT and then
+	// FAULT, 3 a read parity, the last socket is empty, the others are good
+	DAP_Data.fast_clock = 1U;
+	for (t = 0; t < target_count; t++)
+	{
+		targets[t].pin     = swdio_pins[t];
+		targets[t].present = (t + 1U < target_count);
+	}
+	for (i = 0; i < size; i++)
+	{
+		data[i] = (uint8_t)rnd(256);
+	}
+
+	all = (uint8_t)((1U << target_count) - 1U);
+	expect("init", swd_gang_init((uint8_t)target_count), all);
+	all &= (uint8_t)~(1U << (target_count - 1U));
+	expect("connect with an empty socket", swd_gang_init_debug(idcode), all);
+	for (t = 0; t + 1U < target_count; t++)
+	{
+		if (idcode[t] != TARGET_IDCODE)
+		{
+			printf("IDCODE of target %u is %08X\n", t, idcode[t]);
+			failed++;
+		}
+	}
+	expect("reset and halt", swd_gang_reset_program(), all);
+
+	// Broadcast write across auto-increment pages
+	targets[2].wait_every = 2U + rnd(3);
+	start = clocks;
+	expect("write with WAIT", swd_gang_write_memory(RAM_BASE + 0x100U, data, size), all);
+	printf("write: %llu SWCLK cycles for %u bytes to each of %u targets\n", (unsigned long long)(clocks - start),
+	       size, target_count - 1U);
+	expect_memory("write with WAIT", 0x100U, data, size);
+	expect("verify with WAIT", swd_gang_verify_memory(RAM_BASE + 0x100U, data, size), all);
+	targets[2].wait_every = 0;
+
+	// Per-target read data
+	for (t = 0; t + 1U < target_count; t++)
+	{
+		val[t] = 0x5A000000U | t;
+		memcpy(&targets[t].ram[0], &val[t], 4);
+		val[t] = 0;
+	}
+	expect("read word", swd_gang_read_word(RAM_BASE, val), all);
+	for (t = 0; t + 1U < target_count; t++)
+	{
+		if (val[t] != (0x5A000000U | t))
+		{
+			printf("read word: target %u returned %08X\n", t, val[t]);
+			failed++;
+		}
+	}
+
+	// Every target must see the same call, target 1 returns an error
+	targets[1].result = 1;
+	all &= (uint8_t)~2U;
+	expect("syscall", swd_gang_flash_syscall_exec(&sys, RAM_BASE + 0x21U, 1, 2, 3, 4), all);
+	for (t = 0; t + 1U < target_count; t++)
+	{
+		if ((targets[t].calls != 1U) || (targets[t].entry != RAM_BASE + 0x21U) ||
+		    (targets[t].reg[0] != targets[t].result) || (targets[t].reg[1] != 2U) ||
+		    (targets[t].reg[2] != 3U) || (targets[t].reg[3] != 4U) ||
+		    (targets[t].reg[9] != sys.static_base) || (targets[t].reg[13] != sys.stack_pointer) ||
+		    (targets[t].reg[15] != sys.breakpoint) || (targets[t].reg[16] != 0x01000000U))
+		{
+			printf("syscall: target %u saw a wrong call\n", t);
+			failed++;
+		}
+	}
+
+	// One flipped bit on target 0
+	targets[0].ram[0x100U + rnd(size)] ^= (uint8_t)(1U << rnd(8));
+	all &= (uint8_t)~1U;
+	expect("verify mismatch", swd_gang_verify_memory(RAM_BASE + 0x100U, data, size), all);
+
+	// FAULT on target 2 in the middle of the next write
+	for (i = 0; i < size; i++)
+	{
+		data[i] = (uint8_t)rnd(256);
+	}
+	targets[2].fault_at = targets[2].ap_count + 10U + rnd(size / 4U);
+	all &= (uint8_t)~4U;
+	expect("write with FAULT", swd_gang_write_memory(RAM_BASE + 0x100U, data, size), all);
+	expect_memory("write with FAULT", 0x100U, data, size);
+
+	// A bad read parity on target 3 during verify
+	targets[3].parity_at = targets[3].ap_count + 3U + rnd(size / 4U);
+	all &= (uint8_t)~8U;
+	expect("read parity error", swd_gang_verify_memory(RAM_BASE + 0x100U, data, size), all);
+	expect("failed targets", swd_gang_failed(), (uint8_t)(0x0FU | (1U << (target_count - 1U))));
+
+	for (t = 0; t < target_count; t++)
+	{
+		if (targets[t].errors != 0U)
+		{
+			printf("target %u saw %u protocol errors\n", t, targets[t].errors);
+			failed++;
+		}
+	}
+	if (contention != 0U)
+	{
+		printf("probe and target drove a line at the same time %u times\n", contention);
+		failed++;
+	}
+	swd_gang_off();
+	return sim_report(clocks, "SWCLK cycles", failed);
+}
@@ -0,0 +1,526 @@
+/**
+ * @file    gdbsim.c
+ * @brief   Run the probe's GDB server against a simulated Cortex-M on a pty
+ *
+ * usage: gdbsim [-1] [-v]
+ *
+ *   -1  FPB revision 1 (ARMv7-M) instead of revision 2
+ *   -v  log the packets to stderr
+ *
+ * Prints the pty to connect to, e.g. "target remote /dev/pts/3" in GDB.
+ * The target has 64KB of flash at 0 (1KB sectors, vFlash commands only) and
+ * 64KB of RAM at 0x20000000. Its program loops over the halfwords 0x100 to
+ * 0x1FE and increments the word at 0x20000100 every 8 instructions, enough
+ * for breakpoints, watchpoints, stepping and ^C to have something to stop.
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include "gdb_rsp.h"
+
+#define NVIC_Addr       (0xe000e000)
+#define DBG_Addr        (0xe000edf0)
+#include "debug_cm.h"
+
+#define SIM_FLASH_SIZE  0x10000U
+#define SIM_SECTOR_SIZE 0x400U
+#define SIM_RAM_BASE    0x20000000U
+#define SIM_RAM_SIZE    0x10000U
+#define SIM_LOOP_START  0x100U
+#define SIM_LOOP_END    0x200U
+#define SIM_COUNTER     0x20000100U
+#define SIM_BURST       1000U           // instructions run per DHCSR read
+#define SIM_FPB_COUNT   6U
+#define SIM_DWT_COUNT   4U
+
+typedef struct
+{
+	uint8_t flash[SIM_FLASH_SIZE];
+	uint8_t ram[SIM_RAM_SIZE];
+	uint32_t reg[21];                   // DCRSR selectors 0..20
+	uint32_t dhcsr, demcr, dfsr;
+	uint8_t halted;
+	uint32_t fp_ctrl, fp_comp[SIM_FPB_COUNT];
+	uint32_t dwt_comp[SIM_DWT_COUNT], dwt_mask[SIM_DWT_COUNT], dwt_function[SIM_DWT_COUNT];
+	uint32_t fpb_rev;
+	uint32_t steps;
+	int fd;
+	int verbose;
+} sim_t;
+
+static sim_t sim;
+
+static void sim_reset(void)
+{
+	memcpy(&sim.reg[13], &sim.flash[0], 4);
+	memcpy(&sim.reg[15], &sim.flash[4], 4);
+	sim.reg[15] &= ~1U;
+	sim.reg[16] = 0x01000000U;
+	sim.reg[17] = sim.reg[13];
+	sim.halted = (sim.demcr & VC_CORERESET) && (sim.dhcsr & C_DEBUGEN);
+	if (sim.halted)
+	{
+		sim.dfsr |= VCATCH;
+	}
+}
+
+static uint8_t fpb_match(uint32_t pc)
+{
+	uint32_t n, comp;
+
+	if (!(sim.fp_ctrl & 1U))
+	{
+		return 0U;
+	}
+	for (n = 0U; n < SIM_FPB_COUNT; n++)
+	{
+		comp = sim.fp_comp[n];
+		if (!(comp & 1U))
+		{
+			continue;
+		}
+		if (sim.fpb_rev == 0U)
+		{
+			if (((comp & 0x1FFFFFFCU) == (pc & ~3U)) &&
+			    ((comp >> 30) & ((pc & 2U) ? 2U : 1U)))
+			{
+				return 1U;
+			}
+		}
+		else if ((comp & ~1U) == pc)
+		{
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+// Data write of the program, returns 1 if a watchpoint triggered
+static uint8_t dwt_write(uint32_t addr)
+{
+	uint32_t n, mask;
+
+	for (n = 0U; n < SIM_DWT_COUNT; n++)
+	{
+		mask = ~((1UL << sim.dwt_mask[n]) - 1U);
+		if (((sim.dwt_function[n] & 0x0FU) == 6U || (sim.dwt_function[n] & 0x0FU) == 7U) &&
+		    ((addr & mask) == (sim.dwt_comp[n] & mask)))
+		{
+			sim.dwt_function[n] |= 0x01000000U;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+// Execute one instruction, returns 1 if the core halted
+static uint8_t sim_execute(void)
+{
+	uint32_t counter;
+
+	sim.reg[15] += 2U;
+	if (sim.reg[15] >= SIM_LOOP_END)
+	{
+		sim.reg[15] = SIM_LOOP_START;
+	}
+	if ((++sim.steps % 8U) == 0U)
+	{
+		memcpy(&counter, &sim.ram[SIM_COUNTER - SIM_RAM_BASE], 4);
+		counter++;
+		memcpy(&sim.ram[SIM_COUNTER - SIM_RAM_BASE], &counter, 4);
+		if ((sim.dhcsr & C_DEBUGEN) && (sim.demcr & TRCENA) && dwt_write(SIM_COUNTER))
+		{
+			sim.dfsr |= DWTTRAP;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static void sim_run(void)
+{
+	uint32_t n;
+
+	for (n = 0U; (n < SIM_BURST) && !sim.halted; n++)
+	{
+		if ((sim.dhcsr & C_DEBUGEN) && fpb_match(sim.reg[15]))
+		{
+			sim.dfsr |= BKPT;
+			sim.halted = 1U;
+			break;
+		}
+		sim.halted = sim_execute();
+	}
+}
+
+static uint8_t sim_read_word(uint32_t addr, uint32_t *val)
+{
+	uint32_t n;
+
+	switch (addr)
+	{
+	case DBG_HCSR:
+		sim_run();
+		*val = (sim.dhcsr & 0x0000FFFFU) | S_REGRDY | (sim.halted ? S_HALT : 0U);
+		return 1U;
+	case DBG_EMCR:
+		*val = sim.demcr;
+		return 1U;
+	case NVIC_DFSR:
+		*val = sim.dfsr;
+		return 1U;
+	case 0xE0002000U:
+		*val = (sim.fpb_rev << 28) | (SIM_FPB_COUNT << 4) | sim.fp_ctrl;
+		return 1U;
+	case 0xE0001000U:
+		*val = SIM_DWT_COUNT << 28;
+		return 1U;
+	}
+	if ((addr >= 0xE0002008U) && (addr < 0xE0002008U + 4U * SIM_FPB_COUNT))
+	{
+		*val = sim.fp_comp[(addr - 0xE0002008U) / 4U];
+		return 1U;
+	}
+	if ((addr >= 0xE0001020U) && (addr < 0xE0001020U + 16U * SIM_DWT_COUNT))
+	{
+		n = (addr - 0xE0001020U) / 16U;
+		switch (addr & 0x0FU)
+		{
+		case 0x0U:
+			*val = sim.dwt_comp[n];
+			return 1U;
+		case 0x4U:
+			*val = sim.dwt_mask[n];
+			return 1U;
+		case 0x8U:
+			// MATCHED clears on read
+			*val = sim.dwt_function[n];
+			sim.dwt_function[n] &= ~0x01000000U;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static uint8_t sim_write_word(uint32_t addr, uint32_t val)
+{
+	uint32_t n;
+
+	switch (addr)
+	{
+	case DBG_HCSR:
+		if ((val & 0xFFFF0000U) != DBGKEY)
+		{
+			return 1U;
+		}
+		sim.dhcsr = val & 0x0000FFFFU;
+		if (!(val & C_DEBUGEN))
+		{
+			sim.halted = 0U;
+		}
+		else if (val & C_HALT)
+		{
+			if (!sim.halted)
+			{
+				sim.dfsr |= HALTED;
+			}
+			sim.halted = 1U;
+		}
+		else if (sim.halted)
+		{
+			sim.halted = 0U;
+			if (val & C_STEP)
+			{
+				sim_execute();
+				sim.dfsr |= HALTED;
+				sim.halted = 1U;
+			}
+		}
+		return 1U;
+	case DBG_EMCR:
+		sim.demcr = val;
+		return 1U;
+	case NVIC_DFSR:
+		sim.dfsr &= ~val;
+		return 1U;
+	case NVIC_AIRCR:
+		if (val == (VECTKEY | SYSRESETREQ))
+		{
+			sim_reset();
+		}
+		return 1U;
+	case 0xE0002000U:
+		if (val & 2U)
+		{
+			sim.fp_ctrl = val & 1U;
+		}
+		return 1U;
+	}
+	if ((addr >= 0xE0002008U) && (addr < 0xE0002008U + 4U * SIM_FPB_COUNT))
+	{
+		sim.fp_comp[(addr - 0xE0002008U) / 4U] = val;
+		return 1U;
+	}
+	if ((addr >= 0xE0001020U) && (addr < 0xE0001020U + 16U * SIM_DWT_COUNT))
+	{
+		n = (addr - 0xE0001020U) / 16U;
+		switch (addr & 0x0FU)
+		{
+		case 0x0U:
+			sim.dwt_comp[n] = val;
+			return 1U;
+		case 0x4U:
+			sim.dwt_mask[n] = val & 0x1FU;
+			return 1U;
+		case 0x8U:
+			sim.dwt_function[n] = val & 0x0FU;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static uint8_t *sim_memory(uint32_t addr, uint32_t size)
+{
+	if ((addr < SIM_FLASH_SIZE) && (size <= SIM_FLASH_SIZE - addr))
+	{
+		return &sim.flash[addr];
+	}
+	if ((addr >= SIM_RAM_BASE) && (addr - SIM_RAM_BASE < SIM_RAM_SIZE) &&
+	    (size <= SIM_RAM_SIZE - (addr - SIM_RAM_BASE)))
+	{
+		return &sim.ram[addr - SIM_RAM_BASE];
+	}
+	return NULL;
+}
+
+static uint8_t read_mem(void *ctx, uint32_t addr, uint8_t *data, uint32_t size)
+{
+	uint8_t *p = sim_memory(addr, size);
+	uint32_t val;
+
+	(void)ctx;
+	if (p != NULL)
+	{
+		memcpy(data, p, size);
+		return 1U;
+	}
+	if ((size != 4U) || !sim_read_word(addr, &val))
+	{
+		return 0U;
+	}
+	memcpy(data, &val, 4U);
+	return 1U;
+}
+
+static uint8_t write_mem(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	uint32_t val;
+
+	(void)ctx;
+	if ((addr >= SIM_RAM_BASE) && (sim_memory(addr, size) != NULL))
+	{
+		memcpy(sim_memory(addr, size), data, size);
+		return 1U;
+	}
+	if (size != 4U)
+	{
+		return 0U;
+	}
+	memcpy(&val, data, 4U);
+	return sim_write_word(addr, val);
+}
+
+static uint8_t read_reg(void *ctx, uint32_t sel, uint32_t *val)
+{
+	(void)ctx;
+	if (!sim.halted || (sel > 20U))
+	{
+		return 0U;
+	}
+	*val = sim.reg[sel];
+	return 1U;
+}
+
+static uint8_t write_reg(void *ctx, uint32_t sel, uint32_t val)
+{
+	(void)ctx;
+	if (!sim.halted || (sel > 20U))
+	{
+		return 0U;
+	}
+	sim.reg[sel] = val;
+	return 1U;
+}
+
+static uint8_t flash_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+	(void)ctx;
+	if ((addr % SIM_SECTOR_SIZE) || (size % SIM_SECTOR_SIZE) || (sim_memory(addr, size) != sim.flash + addr))
+	{
+		return 0U;
+	}
+	memset(&sim.flash[addr], 0xFF, size);
+	return 1U;
+}
+
+static uint8_t flash_write(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	uint32_t n;
+
+	(void)ctx;
+	if ((addr >= SIM_FLASH_SIZE) || (size > SIM_FLASH_SIZE - addr))
+	{
+		return 0U;
+	}
+	// Programming only clears bits
+	for (n = 0U; n < size; n++)
+	{
+		sim.flash[addr + n] &= data[n];
+	}
+	return 1U;
+}
+
+static uint8_t flash_done(void *ctx)
+{
+	(void)ctx;
+	return 1U;
+}
+
+static const char *memory_map(void *ctx)
+{
+	(void)ctx;
+	return "<?xml version=\"1.0\"?>"
+	       "<memory-map>"
+	       "<memory type=\"flash\" start=\"0x0\" length=\"0x10000\">"
+	       "<property name=\"blocksize\">0x400</property></memory>"
+	       "<memory type=\"ram\" start=\"0x20000000\" length=\"0x10000\"/>"
+	       "</memory-map>";
+}
+
+static void output(void *ctx, const uint8_t *data, uint32_t num)
+{
+	ssize_t n;
+
+	(void)ctx;
+	if (sim.verbose)
+	{
+		fprintf(stderr, "<- %.*s\n", (int)num, (const char *)data);
+	}
+	while (num != 0U)
+	{
+		n = write(sim.fd, data, num);
+		if (n <= 0)
+		{
+			return;
+		}
+		data += n;
+		num -= (uint32_t)n;
+	}
+}
+
+static const gdb_rsp_target_t sim_target = {
+	.read_mem = read_mem,
+	.write_mem = write_mem,
+	.read_reg = read_reg,
+	.write_reg = write_reg,
+	.flash_erase = flash_erase,
+	.flash_write = flash_write,
+	.flash_done = flash_done,
+	.memory_map = memory_map,
+	.output = output,
+};
+
+// Raw pty, kept open so the master survives GDB closing its end
+static int open_pty(void)
+{
+	struct termios tio;
+	int slave;
+
+	sim.fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if ((sim.fd < 0) || (grantpt(sim.fd) != 0) || (unlockpt(sim.fd) != 0))
+	{
+		return -1;
+	}
+	slave = open(ptsname(sim.fd), O_RDWR | O_NOCTTY);
+	if ((slave < 0) || (tcgetattr(slave, &tio) != 0))
+	{
+		return -1;
+	}
+	cfmakeraw(&tio);
+	tcsetattr(slave, TCSANOW, &tio);
+	return slave;
+}
+
+int main(int argc, char **argv)
+{
+	static gdb_rsp_t rsp;
+	uint8_t buf[256];
+	struct pollfd pfd;
+	uint32_t vectors[2] = {SIM_RAM_BASE + SIM_RAM_SIZE, SIM_LOOP_START | 1U};
+	ssize_t n;
+	int opt;
+
+	sim.fpb_rev = 1U;
+	while ((opt = getopt(argc, argv, "1v")) != -1)
+	{
+		switch (opt)
+		{
+		case '1':
+			sim.fpb_rev = 0U;
+			break;
+		case 'v':
+			sim.verbose = 1;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-1] [-v]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	memset(sim.flash, 0xFF, sizeof(sim.flash));
+	memcpy(sim.flash, vectors, sizeof(vectors));
+	sim_reset();
+
+	if (open_pty() < 0)
+	{
+		perror("pty");
+		return 1;
+	}
+	printf("%s\n", ptsname(sim.fd));
+	fflush(stdout);
+
+	gdb_rsp_init(&rsp, &sim_target);
+	pfd.fd = sim.fd;
+	pfd.events = POLLIN;
+	while (1)
+	{
+		// Poll a running target every 10ms, as the probe does once per tick
+		if (poll(&pfd, 1, rsp.running ? 10 : -1) > 0)
+		{
+			n = read(sim.fd, buf, sizeof(buf));
+			if (n <= 0)
+			{
+				continue;
+			}
+			if (sim.verbose)
+			{
+				fprintf(stderr, "-> %.*s\n", (int)n, (const char *)buf);
+			}
+			if (!rsp.attached && !gdb_rsp_attach(&rsp))
+			{
+				fprintf(stderr, "attach failed\n");
+				return 1;
+			}
+			gdb_rsp_input(&rsp, buf, (uint32_t)n);
+		}
+		gdb_rsp_poll(&rsp);
+	}
+}
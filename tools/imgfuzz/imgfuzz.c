@@ -0,0 +1,699 @@
+/**
+ * @file    imgfuzz.c
+ * @brief   Fuzz and benchmark the image decoders and the page assembler
+ *
+ * usage: imgfuzz [-n iterations] [-s seed] [-b] [FILE...]
+ *
+ * Without FILE, random images are encoded as Intel HEX, S-record, ELF, UF2
+ * and binary, decoded in random chunk sizes through page_asm_record() and
+ * compared page by page with the source image (round trip). Each image is
+ * then mutated and decoded once in one piece and once in random chunks: both
+ * runs must end with the same status and the same sequence of pages, whatever
+ * the damage. -b measures the decode rate of a 1 MB image per format for USB
+ * packet and storage sized chunks. Files given on the command line are
+ * decoded with format detection and summarised.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "image_decoder.h"
+#include "sim.h"
+
+#define FUZZ_BASE           0x08000000U
+#define FUZZ_SIZE           0x20000U    // address window of the random images
+#define FUZZ_REGIONS        12U         // at most, leaves room for ELF extra headers
+#define FUZZ_POOL_PAGES     4U
+#define BENCH_SIZE          0x100000U
+#define BENCH_PAGE          4096U
+#define UF2_FAMILY          0xE48BFF56U // family of the encoded images
+#define UF2_FAMILY_OTHER    0x68ED2B88U // family the decoder has to skip
+
+typedef struct
+{
+	uint8_t *data;
+	uint32_t len;
+	uint32_t cap;
+} buf_t;
+
+typedef struct
+{
+	uint32_t addr;
+	uint32_t size;
+} region_t;
+
+// Page sink: records every page written by the assembler
+typedef struct
+{
+	uint8_t *mem;                       // FUZZ_SIZE bytes at FUZZ_BASE, NULL = do not store
+	uint8_t *written;                   // one flag per page of the window
+	uint32_t page_size;
+	uint32_t pages;
+	uint32_t hash;                      // FNV-1a over address and contents of all pages
+	uint32_t low;
+	uint32_t high;
+} sink_t;
+
+static const char *format_names[] = { "unknown", "hex", "srec", "elf", "uf2", "bin" };
+
+static uint8_t image[BENCH_SIZE];
+static uint8_t covered[FUZZ_SIZE];
+static uint32_t uf2_filter;             // UF2 family filter of the decoder, 0 = none
+
+static void put(buf_t *b, const void *data, uint32_t len)
+{
+	if (b->len + len > b->cap)
+	{
+		b->cap = (b->len + len) * 2U + 256U;
+		b->data = realloc(b->data, b->cap);
+		if (b->data == NULL)
+		{
+			perror("realloc");
+			exit(1);
+		}
+	}
+	memcpy(&b->data[b->len], data, len);
+	b->len += len;
+}
+
+static void put32(buf_t *b, uint32_t v)
+{
+	uint8_t le[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+
+	put(b, le, 4);
+}
+
+static void put16(buf_t *b, uint32_t v)
+{
+	uint8_t le[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+
+	put(b, le, 2);
+}
+
+static void put_hex(buf_t *b, const uint8_t *bytes, uint32_t n, int upper)
+{
+	static const char *digits[2] = {"0123456789abcdef", "0123456789ABCDEF"};
+	char c[2];
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		c[0] = digits[upper][bytes[i] >> 4];
+		c[1] = digits[upper][bytes[i] & 15];
+		put(b, c, 2);
+	}
+}
+
+/*
+ * Encoders: regions of image[] in ascending address order
+ */
+
+static void hex_record(buf_t *b, uint8_t type, uint32_t addr, const uint8_t *data, uint32_t n, int upper, int crlf)
+{
+	uint8_t line[4 + 255 + 1];
+	uint8_t sum = 0;
+	uint32_t i;
+
+	line[0] = (uint8_t)n;
+	line[1] = (uint8_t)(addr >> 8);
+	line[2] = (uint8_t)addr;
+	line[3] = type;
+	if (n != 0U)
+	{
+		memcpy(&line[4], data, n);
+	}
+	for (i = 0; i < n + 4; i++)
+	{
+		sum += line[i];
+	}
+	line[n + 4] = (uint8_t)-sum;
+	put(b, ":", 1);
+	put_hex(b, line, n + 5, upper);
+	put(b, crlf ? "\r\n" : "\n", crlf ? 2 : 1);
+}
+
+static void encode_hex(buf_t *b, const region_t *r, uint32_t count)
+{
+	uint32_t i, addr, end, n, upper16 = 0xFFFFFFFFU, max = 1U + rnd(255);
+	int upper = (int)rnd(2), crlf = (int)rnd(2);
+	uint8_t ext[2];
+
+	for (i = 0; i < count; i++)
+	{
+		for (addr = r[i].addr, end = r[i].addr + r[i].size; addr < end; addr += n)
+		{
+			if ((addr >> 16) != upper16)
+			{
+				upper16 = addr >> 16;
+				ext[0] = (uint8_t)(upper16 >> 8);
+				ext[1] = (uint8_t)upper16;
+				hex_record(b, 0x04, 0, ext, 2, upper, crlf);
+			}
+			n = 1U + rnd(max);
+			n = (n < end - addr) ? n : end - addr;
+			n = (n < 0x10000U - (addr & 0xFFFFU)) ? n : 0x10000U - (addr & 0xFFFFU);
+			hex_record(b, 0x00, addr & 0xFFFFU, &image[addr - FUZZ_BASE], n, upper, crlf);
+		}
+	}
+	hex_record(b, 0x01, 0, NULL, 0, upper, crlf);
+}
+
+static void srec_record(buf_t *b, uint8_t type, uint32_t addr, uint32_t alen, const uint8_t *data, uint32_t n)
+{
+	uint8_t line[1 + 4 + 255];
+	uint8_t sum = 0;
+	uint32_t i;
+	char head[2] = {'S', (char)('0' + type)};
+
+	line[0] = (uint8_t)(alen + n + 1U);
+	for (i = 0; i < alen; i++)
+	{
+		line[1 + i] = (uint8_t)(addr >> (8U * (alen - 1U - i)));
+	}
+	if (n != 0U)
+	{
+		memcpy(&line[1 + alen], data, n);
+	}
+	for (i = 0; i < 1U + alen + n; i++)
+	{
+		sum += line[i];
+	}
+	line[1 + alen + n] = (uint8_t)~sum;
+	put(b, head, 2);
+	put_hex(b, line, 2U + alen + n, 1);
+	put(b, "\n", 1);
+}
+
+static void encode_srec(buf_t *b, const region_t *r, uint32_t count)
+{
+	uint32_t i, addr, end, n, max = 1U + rnd(250);
+
+	srec_record(b, 0, 0, 2, (const uint8_t *)"imgfuzz", 7);
+	for (i = 0; i < count; i++)
+	{
+		for (addr = r[i].addr, end = r[i].addr + r[i].size; addr < end; addr += n)
+		{
+			n = 1U + rnd(max);
+			n = (n < end - addr) ? n : end - addr;
+			srec_record(b, 3, addr, 4, &image[addr - FUZZ_BASE], n);
+		}
+	}
+	srec_record(b, 7, FUZZ_BASE, 4, NULL, 0);
+}
+
+static void encode_elf(buf_t *b, const region_t *r, uint32_t count)
+{
+	uint32_t i, phnum = count + 2U, offset;
+	uint8_t pad[4] = {0};
+
+	put(b, "\177ELF\001\001\001", 7);
+	put(b, pad, 4);
+	put(b, pad, 4);
+	put(b, pad, 1);
+	put16(b, 2);                        // ET_EXEC
+	put16(b, 40);                       // EM_ARM
+	put32(b, 1);
+	put32(b, FUZZ_BASE | 1U);           // entry
+	put32(b, 52);                       // phoff
+	put32(b, 0);                        // shoff
+	put32(b, 0x05000200U);
+	put16(b, 52);
+	put16(b, 32);
+	put16(b, (uint16_t)phnum);
+	put16(b, 40);
+	put16(b, 0);
+	put16(b, 0);
+
+	// PT_LOAD per region (vaddr differs from the load address), a PT_NOTE and a .bss PT_LOAD
+	offset = 52U + phnum * 32U;
+	for (i = 0; i < count; i++)
+	{
+		offset = (offset + 3U) & ~3U;
+		put32(b, 1);
+		put32(b, offset);
+		put32(b, r[i].addr + 0x10000000U);
+		put32(b, r[i].addr);
+		put32(b, r[i].size);
+		put32(b, r[i].size);
+		put32(b, 5);
+		put32(b, 4);
+		offset += r[i].size;
+	}
+	put32(b, 4);
+	put32(b, 0);
+	put32(b, 0);
+	put32(b, 0);
+	put32(b, 0);
+	put32(b, 0);
+	put32(b, 4);
+	put32(b, 4);
+	put32(b, 1);
+	put32(b, 0);
+	put32(b, 0x20000000U);
+	put32(b, 0x20000000U);
+	put32(b, 0);
+	put32(b, 0x100);
+	put32(b, 6);
+	put32(b, 4);
+
+	for (i = 0; i < count; i++)
+	{
+		put(b, pad, ((b->len + 3U) & ~3U) - b->len);
+		put(b, &image[r[i].addr - FUZZ_BASE], r[i].size);
+	}
+}
+
+static void uf2_block(buf_t *b, uint32_t flags, uint32_t addr, const uint8_t *data, uint32_t n, uint32_t no,
+                      uint32_t total, uint32_t family)
+{
+	uint8_t payload[476];
+
+	memset(payload, 0, sizeof(payload));
+	memcpy(payload, data, n);
+	put32(b, 0x0A324655U);
+	put32(b, 0x9E5D5157U);
+	put32(b, flags);
+	put32(b, addr);
+	put32(b, n);
+	put32(b, no);
+	put32(b, total);
+	put32(b, family);
+	put(b, payload, sizeof(payload));
+	put32(b, 0x0AB16F30U);
+}
+
+static void encode_uf2(buf_t *b, const region_t *r, uint32_t count)
+{
+	uint32_t i, addr, end, n, total = 1U, no = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		total += (r[i].size + 255U) / 256U;
+	}
+
+	// With a family filter: another family first, numbered on its own, with
+	// data over the image that must not be written
+	if (uf2_filter != 0)
+	{
+		uf2_block(b, 0x00002000U, FUZZ_BASE, &image[FUZZ_SIZE], 256, 0, 2, UF2_FAMILY_OTHER);
+		uf2_block(b, 0x00002000U, FUZZ_BASE + 256U, &image[FUZZ_SIZE], 256, 1, 2, UF2_FAMILY_OTHER);
+	}
+
+	// A block for another memory that the decoder has to skip
+	uf2_block(b, 0x00002001U, 0x70000000U, image, 256, no++, total, UF2_FAMILY);
+	for (i = 0; i < count; i++)
+	{
+		for (addr = r[i].addr, end = r[i].addr + r[i].size; addr < end; addr += n)
+		{
+			n = (end - addr < 256U) ? end - addr : 256U;
+			uf2_block(b, 0x00002000U, addr, &image[addr - FUZZ_BASE], n, no++, total, UF2_FAMILY);
+		}
+	}
+}
+
+static void encode(buf_t *b, image_format_t format, const region_t *r, uint32_t count)
+{
+	static const uint8_t bom[] = { 0xEF, 0xBB, 0xBF };
+
+	b->len = 0;
+
+	// Text images sometimes start with a UTF-8 byte order mark and blank lines
+	if (((format == IMAGE_FORMAT_HEX) || (format == IMAGE_FORMAT_SREC)) && (rnd(4) == 0))
+	{
+		if (rnd(2) != 0)
+		{
+			put(b, bom, sizeof(bom));
+		}
+		put(b, (const uint8_t *)"\r\n \t\n", rnd(6));
+	}
+
+	switch (format)
+	{
+		case IMAGE_FORMAT_HEX:
+			encode_hex(b, r, count);
+			break;
+		case IMAGE_FORMAT_SREC:
+			encode_srec(b, r, count);
+			break;
+		case IMAGE_FORMAT_ELF:
+			encode_elf(b, r, count);
+			break;
+		case IMAGE_FORMAT_UF2:
+			encode_uf2(b, r, count);
+			break;
+		default:
+			put(b, &image[r[0].addr - FUZZ_BASE], r[0].size);
+			break;
+	}
+}
+
+/*
+ * Decoding
+ */
+
+static dap_err_t sink_page(void *ctx, uint32_t addr, const uint8_t *data, uint32_t size)
+{
+	sink_t *s = (sink_t *)ctx;
+	uint32_t i;
+
+	s->hash = (s->hash ^ addr) * 16777619U;
+	for (i = 0; i < size; i++)
+	{
+		s->hash = (s->hash ^ data[i]) * 16777619U;
+	}
+	s->low = (addr < s->low) ? addr : s->low;
+	s->high = (addr + size > s->high) ? addr + size : s->high;
+	s->pages++;
+
+	if ((s->mem != NULL) && (addr >= FUZZ_BASE) && (addr - FUZZ_BASE + size <= FUZZ_SIZE))
+	{
+		memcpy(&s->mem[addr - FUZZ_BASE], data, size);
+		s->written[(addr - FUZZ_BASE) / s->page_size]++;
+	}
+	return ERROR_SUCCESS;
+}
+
+// Decode in chunks of 1..max_chunk bytes (random), or of exactly max_chunk with fixed set
+static dap_err_t decode(const buf_t *in, image_format_t format, uint32_t page_size, uint32_t max_chunk, int fixed,
+                        sink_t *s)
+{
+	static uint8_t pool[FUZZ_POOL_PAGES * BENCH_PAGE];
+	static image_decoder_t dec;
+	page_asm_t pa;
+	uint32_t pos = 0, n;
+	dap_err_t status;
+
+	s->pages = 0;
+	s->hash = 2166136261U;
+	s->low = 0xFFFFFFFFU;
+	s->high = 0;
+	s->page_size = page_size;
+
+	status = page_asm_init(&pa, pool, FUZZ_POOL_PAGES * page_size, page_size, 0xFF, sink_page, s);
+	if (status != ERROR_SUCCESS)
+	{
+		return status;
+	}
+	image_decoder_init(&dec, format, FUZZ_BASE, page_asm_record, &pa);
+	dec.uf2_family = uf2_filter;
+
+	status = ERROR_SUCCESS;
+	while ((pos < in->len) && (status == ERROR_SUCCESS))
+	{
+		n = fixed ? max_chunk : 1U + rnd(max_chunk);
+		n = (n < in->len - pos) ? n : in->len - pos;
+		status = image_decoder_write(&dec, &in->data[pos], n);
+		pos += n;
+	}
+	if ((status == ERROR_SUCCESS) || (status == ERROR_SUCCESS_DONE))
+	{
+		status = image_decoder_finish(&dec);
+	}
+	if (status == ERROR_SUCCESS)
+	{
+		status = page_asm_flush(&pa);
+	}
+	return status;
+}
+
+/*
+ * Round trip and mutation
+ */
+
+static uint32_t random_image(image_format_t format, region_t *r, uint32_t page_size)
+{
+	uint32_t i, count, addr, size;
+
+	memset(covered, 0, sizeof(covered));
+	for (i = 0; i < FUZZ_SIZE; i++)
+	{
+		image[i] = (uint8_t)rnd(256);
+	}
+
+	// BIN is one contiguous region at the base; the others get sparse regions,
+	// close enough that several share a page
+	count = (format == IMAGE_FORMAT_BIN) ? 1U : 1U + rnd(FUZZ_REGIONS);
+	addr = FUZZ_BASE + ((format == IMAGE_FORMAT_BIN) ? 0U : rnd(2U * page_size));
+	for (i = 0; i < count; i++)
+	{
+		size = 1U + rnd((rnd(4) == 0) ? 8192U : 300U);
+		if (addr - FUZZ_BASE + size > FUZZ_SIZE)
+		{
+			break;
+		}
+		r[i].addr = addr;
+		r[i].size = size;
+		memset(&covered[addr - FUZZ_BASE], 1, size);
+		addr += size + rnd((rnd(2) == 0) ? 64U : 3U * page_size);
+		if (addr >= FUZZ_BASE + FUZZ_SIZE)
+		{
+			i++;
+			break;
+		}
+	}
+	return i;
+}
+
+static int round_trip(image_format_t format, buf_t *enc, sink_t *s, uint32_t iteration)
+{
+	static uint8_t expect[FUZZ_SIZE];
+	region_t r[FUZZ_REGIONS];
+	uint32_t count, page, pages = 0, i, any;
+	uint32_t page_size = 256U << rnd(5);
+	dap_err_t status;
+
+	count = random_image(format, r, page_size);
+	uf2_filter = ((format == IMAGE_FORMAT_UF2) && (rnd(2) != 0)) ? UF2_FAMILY : 0;
+	encode(enc, format, r, count);
+
+	memset(s->mem, 0xA5, FUZZ_SIZE);
+	memset(s->written, 0, FUZZ_SIZE / 256U);
+	status = decode(enc, (rnd(2) != 0) || (format == IMAGE_FORMAT_BIN) ? format : IMAGE_FORMAT_UNKNOWN,
+	                page_size, 1U + rnd(600), 0, s);
+	uf2_filter = 0;
+	if (status != ERROR_SUCCESS)
+	{
+		printf("%u %s: round trip failed: %s\n", iteration, format_names[format], error_get_string(status));
+		return 1;
+	}
+
+	for (page = 0; page < FUZZ_SIZE; page += page_size)
+	{
+		any = 0;
+		for (i = page; i < page + page_size; i++)
+		{
+			any |= covered[i];
+			expect[i] = covered[i] ? image[i] : 0xFF;
+		}
+		if (s->written[page / page_size] != (any ? 1U : 0U))
+		{
+			printf("%u %s: page 0x%08X written %u times\n", iteration, format_names[format], FUZZ_BASE + page,
+			       s->written[page / page_size]);
+			return 1;
+		}
+		if (any && (memcmp(&s->mem[page], &expect[page], page_size) != 0))
+		{
+			printf("%u %s: page 0x%08X differs\n", iteration, format_names[format], FUZZ_BASE + page);
+			return 1;
+		}
+		pages += any;
+	}
+	if (pages != s->pages)
+	{
+		printf("%u %s: %u pages expected, %u written\n", iteration, format_names[format], pages, s->pages);
+		return 1;
+	}
+	return 0;
+}
+
+static void mutate(buf_t *b)
+{
+	static const char text[] = "0123456789ABCDEFS:\r\n";
+	uint32_t n = 1U + rnd(8), pos, len;
+
+	while (n-- && (b->len != 0))
+	{
+		pos = rnd(b->len);
+		switch (rnd(6))
+		{
+			case 0:
+				b->data[pos] ^= (uint8_t)(1U << rnd(8));
+				break;
+			case 1:
+				b->data[pos] = (uint8_t)rnd(256);
+				break;
+			case 2:
+				b->data[pos] = (uint8_t)text[rnd(sizeof(text) - 1U)];
+				break;
+			case 3:
+				b->len = pos;
+				break;
+			case 4:
+				len = rnd(b->len - pos);
+				memmove(&b->data[pos], &b->data[pos + len], b->len - pos - len);
+				b->len -= len;
+				break;
+			default:
+				// Duplicate a slice in place of what follows it
+				len = rnd(b->len - pos);
+				len = (len < pos) ? len : pos;
+				memmove(&b->data[pos], &b->data[pos - len], len);
+				break;
+		}
+	}
+}
+
+static int mutation(image_format_t format, buf_t *enc, sink_t *s, uint32_t iteration)
+{
+	image_format_t as = (rnd(2) != 0) ? format : IMAGE_FORMAT_UNKNOWN;
+	uint32_t page_size = 256U << rnd(5), pages, hash;
+	dap_err_t whole, chunked;
+
+	mutate(enc);
+	whole = decode(enc, as, page_size, (enc->len != 0) ? enc->len : 1U, 1, s);
+	pages = s->pages;
+	hash = s->hash;
+	chunked = decode(enc, as, page_size, 1U + rnd(97), 0, s);
+
+	if ((whole != chunked) || (pages != s->pages) || (hash != s->hash))
+	{
+		printf("%u %s: mutated image decodes differently in chunks: %s / %s, %u / %u pages\n", iteration,
+		       format_names[format], error_get_string(whole), error_get_string(chunked), pages, s->pages);
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Benchmark and files
+ */
+
+static void bench(buf_t *enc, sink_t *s)
+{
+	static const uint32_t chunks[] = {64U, 4096U};
+	region_t r = {FUZZ_BASE, BENCH_SIZE};
+	uint32_t f, c, i;
+	uint64_t total;
+	clock_t start;
+	double secs;
+	dap_err_t status;
+
+	for (i = 0; i < BENCH_SIZE; i++)
+	{
+		image[i] = (uint8_t)rnd(256);
+	}
+	s->mem = NULL;
+
+	for (f = IMAGE_FORMAT_HEX; f <= IMAGE_FORMAT_BIN; f++)
+	{
+		encode(enc, (image_format_t)f, &r, 1);
+
+		for (c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+		{
+			total = 0;
+			start = clock();
+			do
+			{
+				status = decode(enc, (image_format_t)f, BENCH_PAGE, chunks[c], 1, s);
+				if (status != ERROR_SUCCESS)
+				{
+					printf("%s: %s\n", format_names[f], error_get_string(status));
+					return;
+				}
+				total += BENCH_SIZE;
+			} while ((secs = (double)(clock() - start) / CLOCKS_PER_SEC) < 0.3);
+			printf("%-4s %4u byte chunks: %7.1f MB/s of image data (%u bytes encoded)\n", format_names[f],
+			       chunks[c], total / secs / 1e6, enc->len);
+		}
+	}
+}
+
+static int decode_file(const char *name, sink_t *s)
+{
+	buf_t in = {NULL, 0, 0};
+	uint8_t chunk[4096];
+	size_t n;
+	dap_err_t status;
+	clock_t start;
+	FILE *f = fopen(name, "rb");
+
+	if (f == NULL)
+	{
+		perror(name);
+		return 1;
+	}
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) != 0)
+	{
+		put(&in, chunk, (uint32_t)n);
+	}
+	fclose(f);
+
+	s->mem = NULL;
+	start = clock();
+	status = decode(&in, IMAGE_FORMAT_UNKNOWN, BENCH_PAGE, sizeof(chunk), 1, s);
+	printf("%s: %s, %s, %u pages of %u in 0x%08X..0x%08X, %.3f s\n", name,
+	       format_names[(in.len >= 4) ? image_detect(in.data, in.len) : IMAGE_FORMAT_UNKNOWN],
+	       error_get_string(status), s->pages, BENCH_PAGE, (s->pages != 0) ? s->low : 0U, s->high,
+	       (double)(clock() - start) / CLOCKS_PER_SEC);
+	free(in.data);
+	return (status == ERROR_SUCCESS) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t mem[FUZZ_SIZE];
+	static uint8_t written[FUZZ_SIZE / 256U];
+	sink_t sink = {mem, written, 256U, 0, 0, 0, 0};
+	buf_t enc = {NULL, 0, 0};
+	sim_args_t args;
+	uint32_t i, failed = 0;
+	int opt, benchmark = 0;
+	image_format_t f;
+
+	sim_args_init(&args, 2000);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "b")) != -1)
+	{
+		switch (opt)
+		{
+			case 'b':
+				benchmark = 1;
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-n iterations] [-s seed] [-b] [FILE...]\n", argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	sim_seed(args.seed);
+
+	if (optind < argc)
+	{
+		for (i = (uint32_t)optind; i < (uint32_t)argc; i++)
+		{
+			failed |= (uint32_t)decode_file(argv[i], &sink);
+		}
+		return failed ? 1 : 0;
+	}
+
+	if (benchmark)
+	{
+		bench(&enc, &sink);
+		free(enc.data);
+		return 0;
+	}
+
+	printf("seed %u\n", args.seed);
+	for (i = 0; (i < args.count) && (failed < 10U); i++)
+	{
+		f = (image_format_t)(IMAGE_FORMAT_HEX + (i % IMAGE_FORMAT_BIN));
+		failed += (uint32_t)round_trip(f, &enc, &sink, i);
+		failed += (uint32_t)mutation(f, &enc, &sink, i);
+	}
+	free(enc.data);
+	return sim_report(i, "iterations", failed);
+}
@@ -0,0 +1,807 @@
+/**
+ * @file    jtagsim.c
+ * @brief   JTAG scans, bit-banged and through the SPI engine, against a mock TAP chain
+ *
+ * usage: jtagsim [-n iterations] [-o operations] [-s seed] [-g gpio_hz] [-c shift_us]
+ *
+ * JTAG_DP.c and jtag_spi.c are built unchanged; GPIO registers, the GPIO
+ * matrix and the SPI master go to a simulated scan chain (../common/stub/).
+ * Every iteration builds a random chain of up to DAP_JTAG_DEV_CNT TAPs with
+ * random IR lengths and one JTAG-DP among them, configures it the way
+ * DAP_JTAG_Configure does and runs random DPACC/APACC reads and writes,
+ * ABORT, IDCODE and raw sequences with TDO capture. The TAPs follow the
+ * IEEE 1149.1 state machine on the rising TCK edge; TCK and TDI come from
+ * GPIO or from SCLK/MOSI depending on the matrix routing, so a pin left on
+ * the wrong signal shows up as lost or extra edges.
+ *
+ * Checked: register contents and read data against a shadow model, WAIT
+ * retries, IR and bypass padding of the other devices, IR scans skipped
+ * by the cache, the TAP back in Run-Test/Idle after every operation, the
+ * SPI device mode, clock and routing, and the fall back to bit-banging
+ * when SPI is unavailable or a transaction fails. The same operations run
+ * bit-banged first, then with the engine, then with an engine whose shifts
+ * cost nothing beyond their bits (so it is used wherever it can be); each
+ * reports TCK cycles and CPU time per transfer and the share clocked by SPI.
+ *
+ * CPU time is a model, read back through esp_cpu_get_cycle_count: a
+ * bit-banged TCK costs one period of the bit-banged clock (the requested
+ * clock, capped at -g Hz), an SPI shift costs -c us plus its bits at the
+ * SPI clock. Nothing else is charged.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "driver/spi_master.h"
+#include "soc/spi_periph.h"
+#include "soc/gpio_sig_map.h"
+#include "esp_rom_gpio.h"
+#include "freertos/semphr.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "jtag_spi.h"
+#include "debug_cm.h"
+#include "sim.h"
+
+#define DP_IDCODE_VALUE     0x4BA00477U
+#define DP_IR_LENGTH        4U
+#define AP_REGS             64U         // 16 banks of 4 registers
+
+// TAP controller states
+enum
+{
+	TLR, RTI, SEL_DR, CAP_DR, SH_DR, EX1_DR, PAU_DR, EX2_DR, UPD_DR,
+	SEL_IR, CAP_IR, SH_IR, EX1_IR, PAU_IR, EX2_IR, UPD_IR,
+};
+
+static const uint8_t tap_next[16][2] = {
+	{RTI, TLR},       {RTI, SEL_DR},    {CAP_DR, SEL_IR}, {SH_DR, EX1_DR},
+	{SH_DR, EX1_DR},  {PAU_DR, UPD_DR}, {PAU_DR, EX2_DR}, {SH_DR, UPD_DR},
+	{RTI, SEL_DR},    {CAP_IR, TLR},    {SH_IR, EX1_IR},  {SH_IR, EX1_IR},
+	{PAU_IR, UPD_IR}, {PAU_IR, EX2_IR}, {SH_IR, UPD_IR},  {RTI, SEL_DR},
+};
+
+typedef struct
+{
+	uint32_t ir_length;
+	uint32_t ir;
+	uint64_t ir_shift;
+	uint64_t dr_shift;
+	uint32_t dr_length;
+} tap_t;
+
+// JTAG-DP behind one of the TAPs
+typedef struct
+{
+	uint32_t index;
+	uint32_t ctrl;
+	uint32_t select;
+	uint32_t ap[AP_REGS];
+	uint32_t result;                    // read result, captured by the next scan
+	uint32_t wait;                      // scans still answered with WAIT
+	uint32_t aborts;
+} dp_t;
+
+DAP_Port_t DAP_Ports[DAP_PORT_COUNT];
+__thread DAP_Port_t *DAP_Port = &DAP_Ports[0];
+static const DAP_Pins_t port_pins[DAP_PORT_COUNT] = DAP_PORT_PINS;
+__thread const DAP_Pins_t *DAP_Pins = &port_pins[0];
+
+const spi_signal_conn_t spi_periph_signal[3] = {
+	{0, 0, 0, 0, 0, 0},
+	{63, 63, 64, 65, 64, 65},           // SPI2: SCLK, MOSI, MISO
+	{0, 0, 0, 0, 0, 0},
+};
+
+static tap_t taps[DAP_JTAG_DEV_CNT];
+static uint32_t tap_count;
+static uint32_t tap_state = TLR;
+static dp_t dp;
+
+static uint32_t gpio_out;
+static uint32_t route[64];              // output signal per GPIO
+static uint32_t tck_level;
+static uint64_t tck_gpio, tck_spi;      // rising TCK edges by source
+static uint64_t cpu_cycles;             // modelled CPU time
+static uint32_t gpio_clock_max = 5000000U;
+static uint32_t spi_shift_cycles;       // fixed cost of one SPI transaction
+static uint32_t ir_updates;
+
+static uint8_t spi_bus_ok, spi_bus_up, spi_fail_every, spi_transactions;
+static uint32_t spi_clock;
+static struct spi_device_t
+{
+	int added;
+} spi_dev;
+static int mutex;
+
+static uint32_t failed;
+
+static void check(int ok, const char *what)
+{
+	if (!ok)
+	{
+		if (failed < 20U)
+		{
+			printf("%s\n", what);
+		}
+		failed++;
+	}
+}
+
+// DR length of a TAP for its current instruction
+static uint32_t tap_dr_length(uint32_t k)
+{
+	if (k != dp.index)
+	{
+		return 1U;                      // BYPASS
+	}
+	switch (taps[k].ir)
+	{
+		case JTAG_ABORT:
+		case JTAG_DPACC:
+		case JTAG_APACC:
+			return 35U;
+		case JTAG_IDCODE:
+			return 32U;
+		default:
+			return 1U;
+	}
+}
+
+static void dp_capture(tap_t *t)
+{
+	if ((t->ir == JTAG_DPACC) || (t->ir == JTAG_APACC))
+	{
+		// ACK: OK/FAULT = 010, WAIT = 001
+		t->dr_shift = ((uint64_t)dp.result << 3) | ((dp.wait != 0U) ? 1U : 2U);
+	}
+	else if (t->ir == JTAG_IDCODE)
+	{
+		t->dr_shift = DP_IDCODE_VALUE;
+	}
+	else
+	{
+		t->dr_shift = 0U;
+	}
+}
+
+static void dp_update(const tap_t *t)
+{
+	uint32_t rnw = (uint32_t)(t->dr_shift & 1U);
+	uint32_t a = (uint32_t)((t->dr_shift >> 1) & 3U);
+	uint32_t data = (uint32_t)(t->dr_shift >> 3);
+	uint32_t *reg;
+
+	if (t->ir == JTAG_ABORT)
+	{
+		if (data & DAPABORT)
+		{
+			dp.wait = 0U;
+			dp.aborts++;
+		}
+		return;
+	}
+	if ((t->ir != JTAG_DPACC) && (t->ir != JTAG_APACC))
+	{
+		return;
+	}
+	if (dp.wait != 0U)
+	{
+		dp.wait--;                      // WAIT: the update is ignored
+		return;
+	}
+
+	if (t->ir == JTAG_APACC)
+	{
+		reg = &dp.ap[(((dp.select & APBANKSEL) >> 4) << 2) | a];
+	}
+	else
+	{
+		reg = (a == 1U) ? &dp.ctrl : (a == 2U) ? &dp.select : NULL;
+	}
+	if (rnw)
+	{
+		dp.result = (reg != NULL) ? *reg : 0U;      // RDBUFF reads as zero
+	}
+	else if (reg != NULL)
+	{
+		*reg = data;
+	}
+}
+
+// TDO: LSB of the register selected in device 0 while shifting
+static uint32_t tap_tdo(void)
+{
+	if (tap_state == SH_IR)
+	{
+		return (uint32_t)(taps[0].ir_shift & 1U);
+	}
+	if (tap_state == SH_DR)
+	{
+		return (uint32_t)(taps[0].dr_shift & 1U);
+	}
+	return 0U;
+}
+
+static void tap_edge(uint32_t tms, uint32_t tdi)
+{
+	uint32_t k, in, out;
+	tap_t *t;
+
+	switch (tap_state)
+	{
+		case TLR:
+			for (k = 0; k < tap_count; k++)
+			{
+				taps[k].ir = (k == dp.index) ? JTAG_IDCODE : ((1U << taps[k].ir_length) - 1U);
+			}
+			break;
+		case CAP_IR:
+			for (k = 0; k < tap_count; k++)
+			{
+				taps[k].ir_shift = 1U;
+			}
+			break;
+		case CAP_DR:
+			for (k = 0; k < tap_count; k++)
+			{
+				taps[k].dr_length = tap_dr_length(k);
+				taps[k].dr_shift = 0U;
+				if (k == dp.index)
+				{
+					dp_capture(&taps[k]);
+				}
+			}
+			break;
+		case SH_IR:
+		case SH_DR:
+			// TDI enters the last device, device 0 drives TDO
+			in = tdi & 1U;
+			for (k = tap_count; k--;)
+			{
+				t = &taps[k];
+				if (tap_state == SH_IR)
+				{
+					out = (uint32_t)(t->ir_shift & 1U);
+					t->ir_shift = (t->ir_shift >> 1) | ((uint64_t)in << (t->ir_length - 1U));
+				}
+				else
+				{
+					out = (uint32_t)(t->dr_shift & 1U);
+					t->dr_shift = (t->dr_shift >> 1) | ((uint64_t)in << (t->dr_length - 1U));
+				}
+				in = out;
+			}
+			break;
+		case UPD_IR:
+			ir_updates++;
+			for (k = 0; k < tap_count; k++)
+			{
+				taps[k].ir = (uint32_t)taps[k].ir_shift & ((1U << taps[k].ir_length) - 1U);
+			}
+			break;
+		case UPD_DR:
+			dp_update(&taps[dp.index]);
+			break;
+		default:
+			break;
+	}
+	tap_state = tap_next[tap_state][tms & 1U];
+}
+
+// Pin levels as the TAPs see them: TCK and TDI follow the matrix routing
+static uint32_t pin_tdi(void)
+{
+	return (route[DAP_Pins->tdi] == SIG_GPIO_OUT_IDX) ? ((gpio_out >> DAP_Pins->tdi) & 1U) : 0U;
+}
+
+static uint32_t pin_tms(void)
+{
+	return (gpio_out >> DAP_Pins->swdio) & 1U;
+}
+
+// SCLK idles low outside transactions
+static void tck_update(void)
+{
+	uint32_t level;
+
+	level = (route[DAP_Pins->swclk] == SIG_GPIO_OUT_IDX) ? ((gpio_out >> DAP_Pins->swclk) & 1U) : 0U;
+	if (!tck_level && level)
+	{
+		tck_gpio++;
+		cpu_cycles += CPU_CLOCK / DAP_Data.actual_clock;
+		tap_edge(pin_tms(), pin_tdi());
+	}
+	tck_level = level;
+}
+
+void sim_peri_write(uint32_t reg, uint32_t val)
+{
+	if (reg == GPIO_OUT_W1TS_REG)
+	{
+		gpio_out |= val;
+	}
+	else if (reg == GPIO_OUT_W1TC_REG)
+	{
+		gpio_out &= ~val;
+	}
+	tck_update();
+}
+
+uint32_t sim_peri_read(uint32_t reg)
+{
+	return (reg == GPIO_IN_REG) ? (gpio_out & ~DAP_Pins->tdo_mask) | (tap_tdo() ? DAP_Pins->tdo_mask : 0U) : 0U;
+}
+
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode)
+{
+	(void)pin;
+	(void)mode;
+	return 0;
+}
+
+int gpio_set_level(gpio_num_t pin, uint32_t level)
+{
+	if ((pin >= 0) && (pin < 32))
+	{
+		sim_peri_write(level ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1U << pin);
+	}
+	return 0;
+}
+
+int gpio_get_level(gpio_num_t pin)
+{
+	if (pin == DAP_Pins->tdo)
+	{
+		return (int)tap_tdo();
+	}
+	return ((pin >= 0) && (pin < 32)) ? (int)((gpio_out >> pin) & 1U) : 0;
+}
+
+void gpio_pad_select_gpio(uint32_t pin)
+{
+	(void)pin;
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+	return (uint32_t)cpu_cycles;
+}
+
+void esp_rom_gpio_connect_out_signal(uint32_t gpio_num, uint32_t signal_idx, bool out_inv, bool oen_inv)
+{
+	check(!out_inv && !oen_inv, "inverted output routing");
+	route[gpio_num & 63U] = signal_idx;
+	tck_update();
+}
+
+void esp_rom_gpio_connect_in_signal(uint32_t gpio_num, uint32_t signal_idx, bool inv)
+{
+	check((gpio_num == (uint32_t)DAP_Pins->tdo) && (signal_idx == spi_periph_signal[JTAG_SPI_HOST].spiq_in) && !inv,
+	      "MISO not routed from TDO");
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus, spi_dma_chan_t dma)
+{
+	check((host == JTAG_SPI_HOST) && (dma == SPI_DMA_DISABLED) && (bus->sclk_io_num == -1) &&
+	      (bus->mosi_io_num == -1) && (bus->miso_io_num == -1) && (bus->max_transfer_sz >= (int)(JTAG_SPI_MAX_BITS / 8U)),
+	      "SPI bus configuration");
+	spi_bus_up = spi_bus_ok;
+	return spi_bus_ok ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host)
+{
+	(void)host;
+	spi_bus_up = 0;
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev,
+                             spi_device_handle_t *handle)
+{
+	check(spi_bus_up && (host == JTAG_SPI_HOST) && !spi_dev.added, "SPI device added twice or without a bus");
+	check((dev->mode == 0) && (dev->flags == SPI_DEVICE_BIT_LSBFIRST) && (dev->spics_io_num == -1),
+	      "SPI device mode");
+	check((dev->clock_speed_hz > 0) && ((uint32_t)dev->clock_speed_hz <= JTAG_SPI_MAX_CLOCK), "SPI clock out of range");
+	spi_clock = (uint32_t)dev->clock_speed_hz;
+	spi_dev.added = 1;
+	*handle = &spi_dev;
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+	check(handle == &spi_dev, "unknown SPI device removed");
+	spi_dev.added = 0;
+	return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait)
+{
+	(void)handle;
+	(void)wait;
+	return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t handle)
+{
+	(void)handle;
+}
+
+// Mode 0, LSB first: MISO is sampled and MOSI set up before each rising SCLK edge
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+	const spi_signal_conn_t *sig = &spi_periph_signal[JTAG_SPI_HOST];
+	const uint8_t *tx = trans->tx_buffer;
+	uint8_t *rx = trans->rx_buffer;
+	uint32_t i, tdo;
+
+	check((handle == &spi_dev) && spi_dev.added, "transaction without a device");
+	check((trans->length >= 1U) && (trans->length <= JTAG_SPI_MAX_BITS), "SPI transaction length");
+	check((rx == NULL) ? (trans->rxlength == 0U) : (trans->rxlength == trans->length), "SPI receive length");
+	cpu_cycles += spi_shift_cycles + trans->length * (CPU_CLOCK / spi_clock);
+	if ((route[DAP_Pins->swclk] != sig->spiclk_out) && (route[DAP_Pins->tdi] != sig->spid_out) && (rx == NULL))
+	{
+		return ESP_OK;                  // dry run, nothing routed to the pins
+	}
+	check((route[DAP_Pins->swclk] == sig->spiclk_out) && (route[DAP_Pins->tdi] == sig->spid_out),
+	      "TCK/TDI not routed to SCLK/MOSI");
+	check(spi_clock == ((DAP_Data.nominal_clock < JTAG_SPI_MAX_CLOCK) ? DAP_Data.nominal_clock : JTAG_SPI_MAX_CLOCK),
+	      "SPI clock does not follow the JTAG clock");
+
+	spi_transactions++;
+	if (spi_fail_every && ((spi_transactions % spi_fail_every) == 0U))
+	{
+		return ESP_FAIL;                // nothing clocked
+	}
+
+	if (rx != NULL)
+	{
+		memset(rx, 0xA5, (trans->rxlength + 7U) / 8U);     // the unused tail is garbage
+	}
+	for (i = 0; i < trans->length; i++)
+	{
+		tdo = tap_tdo();
+		tck_spi++;
+		tap_edge(pin_tms(), (tx[i >> 3] >> (i & 7U)) & 1U);
+		if (rx != NULL)
+		{
+			rx[i >> 3] = (uint8_t)((rx[i >> 3] & ~(1U << (i & 7U))) | (tdo << (i & 7U)));
+		}
+	}
+	return ESP_OK;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+	return &mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait)
+{
+	(void)wait;
+	check((sem == &mutex) && !mutex, "engine lock taken twice");
+	mutex = 1;
+	return 1;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+	check((sem == &mutex) && mutex, "engine lock given while free");
+	mutex = 0;
+	return 1;
+}
+
+// Shadow of the DP registers and the host's view of the cached IR
+static struct
+{
+	uint32_t ctrl;
+	uint32_t select;
+	uint32_t ap[AP_REGS];
+	uint32_t ir;                        // last IR written, 0 = unknown
+	uint32_t ir_scans;
+	uint32_t transfers;
+} host;
+
+static void host_ir(uint32_t ir)
+{
+	JTAG_IR(ir);
+	if (host.ir != ir)
+	{
+		host.ir_scans++;
+		host.ir = ir;
+	}
+	check(taps[dp.index].ir == ir, "IR of the DP not loaded");
+}
+
+// One access the way DAP_JTAG_Transfer issues it, WAIT is retried
+static uint8_t host_transfer(uint32_t request, uint32_t *data)
+{
+	uint32_t retry;
+	uint8_t ack;
+
+	host_ir((request & DAP_TRANSFER_APnDP) ? JTAG_APACC : JTAG_DPACC);
+	for (retry = 0; retry < 100U; retry++)
+	{
+		host.transfers++;
+		ack = JTAG_Transfer(request, data);
+		check(tap_state == RTI, "TAP not in Run-Test/Idle after a transfer");
+		if (ack != DAP_TRANSFER_WAIT)
+		{
+			break;
+		}
+	}
+	return ack;
+}
+
+// Posted read: the request, then RDBUFF returns the value
+static uint32_t host_read(uint32_t request)
+{
+	uint32_t val = 0;
+
+	check(host_transfer(request | DAP_TRANSFER_RnW, NULL) == DAP_TRANSFER_OK, "read request not acknowledged");
+	check(host_transfer(DP_RDBUFF | DAP_TRANSFER_RnW, &val) == DAP_TRANSFER_OK, "RDBUFF not acknowledged");
+	return val;
+}
+
+static void host_write(uint32_t request, uint32_t val)
+{
+	check(host_transfer(request, &val) == DAP_TRANSFER_OK, "write not acknowledged");
+}
+
+static void sequence(uint32_t tms, uint32_t bits, const uint8_t *tdi, uint8_t *tdo)
+{
+	JTAG_Sequence((tms ? JTAG_SEQUENCE_TMS : 0U) | ((tdo != NULL) ? JTAG_SEQUENCE_TDO : 0U) | (bits & 63U), tdi, tdo);
+	host.ir = 0;
+}
+
+// Test-Logic-Reset, then Run-Test/Idle
+static void tap_reset(void)
+{
+	static const uint8_t ones[1] = {0xFF}, zero[1] = {0};
+
+	sequence(1, 6, ones, NULL);
+	sequence(0, 1, zero, NULL);
+	check(tap_state == RTI, "TAP reset did not reach Run-Test/Idle");
+}
+
+// Random chain, configured like DAP_JTAG_Configure
+static void chain_build(void)
+{
+	uint32_t bits = 0, n;
+
+	memset(taps, 0, sizeof(taps));
+	memset(&dp, 0, sizeof(dp));
+	tap_count = 1U + rnd(DAP_JTAG_DEV_CNT);
+	dp.index = rnd(tap_count);
+	for (n = 0; n < tap_count; n++)
+	{
+		taps[n].ir_length = (n == dp.index) ? DP_IR_LENGTH : 2U + rnd(7);
+	}
+
+	DAP_Data.jtag_dev.count = (uint8_t)tap_count;
+	DAP_Data.jtag_dev.index = (uint8_t)dp.index;
+	JTAG_IR_Invalidate();
+	for (n = 0; n < tap_count; n++)
+	{
+		DAP_Data.jtag_dev.ir_length[n] = (uint8_t)taps[n].ir_length;
+		DAP_Data.jtag_dev.ir_before[n] = (uint16_t)bits;
+		bits += taps[n].ir_length;
+	}
+	for (n = 0; n < tap_count; n++)
+	{
+		bits -= taps[n].ir_length;
+		DAP_Data.jtag_dev.ir_after[n] = (uint16_t)bits;
+	}
+}
+
+// Raw Shift-DR through the chain with IDCODE in the DP, BYPASS elsewhere
+static void idcode_scan(void)
+{
+	static const uint8_t zeros[8] = {0}, one[1] = {1}, ones[1] = {0xFF};
+	uint8_t tdo[8];
+	uint32_t bits = tap_count - 1U + 32U + 8U, n, bit, want;
+
+	host_ir(JTAG_IDCODE);
+	check(JTAG_ReadIDCode() == DP_IDCODE_VALUE, "IDCODE read");
+	sequence(1, 1, one, NULL);                  // Select-DR-Scan
+	sequence(0, 2, zeros, NULL);                // Capture-DR, Shift-DR
+	sequence(0, bits, zeros, tdo);
+	for (n = 0; n < bits; n++)
+	{
+		bit = (tdo[n >> 3] >> (n & 7U)) & 1U;
+		want = ((n >= dp.index) && (n < dp.index + 32U)) ? ((DP_IDCODE_VALUE >> (n - dp.index)) & 1U) : 0U;
+		check(bit == want, "TDO of a raw sequence");
+	}
+	check((bits & 7U) == 0U || (tdo[bits >> 3] >> (bits & 7U)) == 0U, "bits beyond a raw sequence not cleared");
+	sequence(1, 2, ones, NULL);                 // Exit1-DR, Update-DR
+	sequence(0, 1, zeros, NULL);
+	check(tap_state == RTI, "raw sequence did not return to Run-Test/Idle");
+}
+
+static void run(uint32_t ops)
+{
+	uint32_t op, k, a, val, bank;
+
+	memset(&host, 0, sizeof(host));
+	ir_updates = 0;
+	DAP_Data.fast_clock = (uint8_t)rnd(2);
+	DAP_Data.clock_delay = 0;
+	DAP_Data.nominal_clock = 1000000U * (1U + rnd(40));
+	DAP_Data.actual_clock = (DAP_Data.nominal_clock < gpio_clock_max) ? DAP_Data.nominal_clock : gpio_clock_max;
+	DAP_Data.transfer.idle_cycles = (uint8_t)rnd(3);
+	chain_build();
+	tap_reset();
+	idcode_scan();
+	host_write(DP_CTRL_STAT, CSYSPWRUPREQ | CDBGPWRUPREQ);
+	host.ctrl = CSYSPWRUPREQ | CDBGPWRUPREQ;
+
+	for (op = 0; op < ops; op++)
+	{
+		switch (rnd(8))
+		{
+			case 0:
+			case 1:
+				// AP write in a random bank
+				bank = rnd(AP_REGS / 4U);
+				a = rnd(4);
+				val = rng;
+				if (host.select != (bank << 4))
+				{
+					host_write(DP_SELECT, bank << 4);
+					host.select = bank << 4;
+				}
+				host_write(DAP_TRANSFER_APnDP | (a << 2), val);
+				host.ap[(bank << 2) | a] = val;
+				break;
+			case 2:
+			case 3:
+				// AP read in the current bank
+				a = rnd(4);
+				val = host_read(DAP_TRANSFER_APnDP | (a << 2));
+				check(val == host.ap[(((host.select & APBANKSEL) >> 4) << 2) | a], "AP read data");
+				break;
+			case 4:
+				val = host_read(DP_CTRL_STAT);
+				check(val == host.ctrl, "CTRL/STAT read data");
+				break;
+			case 5:
+				// WAIT on the next few scans
+				dp.wait = 1U + rnd(3);
+				val = host_read(DAP_TRANSFER_APnDP | (rnd(4) << 2));
+				check(dp.wait == 0U, "WAIT not retried");
+				break;
+			case 6:
+				// Stuck in WAIT, cleared by ABORT
+				dp.wait = 1000U;
+				k = dp.aborts;
+				host_ir(JTAG_APACC);
+				check(JTAG_Transfer(DAP_TRANSFER_APnDP, &val) == DAP_TRANSFER_WAIT, "WAIT not reported");
+				JTAG_IR(JTAG_ABORT);
+				JTAG_WriteAbort(DAPABORT);
+				host.ir = JTAG_ABORT;
+				host.ir_scans++;
+				check((dp.aborts == k + 1U) && (dp.wait == 0U), "ABORT not written");
+				check(tap_state == RTI, "TAP not in Run-Test/Idle after ABORT");
+				break;
+			default:
+				if (rnd(8) == 0U)
+				{
+					// Raw sequences drop the cached IR
+					tap_reset();
+					idcode_scan();
+				}
+				else
+				{
+					val = host_read(DP_CTRL_STAT);
+				}
+				break;
+		}
+	}
+
+	check(dp.ctrl == host.ctrl, "CTRL/STAT contents");
+	check(memcmp(dp.ap, host.ap, sizeof(dp.ap)) == 0, "AP register contents");
+	check(ir_updates == host.ir_scans, "IR scans not skipped by the cache");
+	for (k = 0; k < tap_count; k++)
+	{
+		if ((k != dp.index) && (taps[k].ir != (1U << taps[k].ir_length) - 1U))
+		{
+			check(0, "other device not in BYPASS");
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	static const char *const pass_name[3] = {"bit-banged", "engine", "free engine"};
+	uint32_t ops = 200, shift_us = 6, i, pass;
+	sim_args_t args;
+	uint64_t gpio[3], spi[3], cpu[3], transfers[3];
+	int opt;
+
+	sim_args_init(&args, 200);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "o:g:c:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'o':
+				ops = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'g':
+				gpio_clock_max = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'c':
+				shift_us = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-n iterations] [-o operations] [-s seed] [-g gpio_hz] [-c shift_us]\n",
+					        argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	printf("seed %u\n", args.seed);
+
+	for (i = 0; i < 64U; i++)
+	{
+		route[i] = SIG_GPIO_OUT_IDX;
+	}
+	gpio_out = DAP_Pins->swclk_mask | DAP_Pins->swdio_mask | DAP_Pins->tdi_mask;
+	tck_level = 1;
+
+	if (gpio_clock_max == 0U)
+	{
+		gpio_clock_max = 1U;
+	}
+
+	// Pass 0 bit-bangs (the bus fails to come up), pass 1 uses the engine,
+	// pass 2 the engine with shifts charged for their bits only
+	for (pass = 0; pass < 3U; pass++)
+	{
+		spi_bus_ok = (uint8_t)(pass != 0U);
+		spi_shift_cycles = (pass == 1U) ? shift_us * (CPU_CLOCK / 1000000U) : 0U;
+		jtag_spi_init();
+		check(jtag_spi_available() == spi_bus_ok, "engine availability");
+		DAP_Pins = &port_pins[1];
+		check(jtag_spi_available() == 0U, "engine available on a port without JTAG pins");
+		DAP_Pins = &port_pins[0];
+
+		sim_seed(args.seed);
+		tck_gpio = tck_spi = cpu_cycles = 0;
+		transfers[pass] = 0;
+		for (i = 0; i < args.count; i++)
+		{
+			run(ops);
+			transfers[pass] += host.transfers;
+		}
+		gpio[pass] = tck_gpio;
+		spi[pass] = tck_spi;
+		cpu[pass] = cpu_cycles;
+		check((pass != 0U) || (tck_spi == 0U), "SPI clocked without the engine");
+		check((pass != 2U) || (tck_spi != 0U), "engine not used");
+	}
+	check(cpu[1] <= cpu[0], "engine slower than bit-banging");
+
+	// Engine with failing transactions: every shift must fall back to GPIO
+	spi_fail_every = 3;
+	sim_seed(args.seed);
+	for (i = 0; i < args.count / 4U + 1U; i++)
+	{
+		run(ops);
+	}
+
+	for (pass = 0; pass < 3U; pass++)
+	{
+		printf("%s: %.1f TCK cycles, %.2f us per transfer, %.0f%% by SPI\n", pass_name[pass],
+		       (double)(gpio[pass] + spi[pass]) / (double)(transfers[pass] ? transfers[pass] : 1U),
+		       (double)cpu[pass] / (double)(CPU_CLOCK / 1000000U) / (double)(transfers[pass] ? transfers[pass] : 1U),
+		       100.0 * (double)spi[pass] / (double)((gpio[pass] + spi[pass]) ? (gpio[pass] + spi[pass]) : 1U));
+	}
+	return sim_report(args.count, "iterations", failed);
+}
@@ -0,0 +1,167 @@
+/**
+ * @file    swdcalib.c
+ * @brief   Run the SWCLK calibration against a simulated cycle counter
+ *
+ * usage: swdcalib [-c cpu_mhz] [-f fast] [-s slow] [-k loop] [-j jitter] [-v]
+ *
+ * The simulated SWCLK generator costs fast CPU cycles per period on the fast
+ * path and slow + 2 * loop * delay cycles with PIN_DELAY_SLOW(delay). Each
+ * timing run adds call overhead and up to jitter cycles of disturbance, as
+ * cache misses do on the probe. The tool calibrates, sweeps the requested
+ * frequency and checks every lookup against the model: the reported clock must
+ * match the clock the chosen delay really produces, and must not exceed the
+ * request. A measurement that is not monotonic must leave the table alone.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "swd_clock_calib.h"
+
+#define SIM_OVERHEAD        24U         // cycles between the two CCOUNT reads outside the loop
+#define SIM_TOLERANCE       0.01        // allowed error of the reported clock
+
+static struct
+{
+	uint32_t cpu_clock;
+	uint32_t fast;
+	uint32_t slow;
+	uint32_t loop;
+	uint32_t jitter;
+	uint32_t ccount;                    // simulated CCOUNT, wraps like the real one
+	int verbose;
+} sim = {240000000U, 8U, 14U, 3U, 32U, 0xFFFF0000U, 0};
+
+static uint32_t sim_period(uint8_t fast, uint32_t delay)
+{
+	return fast ? sim.fast : (sim.slow + (2U * sim.loop * delay));
+}
+
+static uint32_t sim_measure(uint32_t delay, uint32_t cycles)
+{
+	uint32_t start = sim.ccount;
+
+	sim.ccount += (cycles * sim_period(delay == 0U, delay)) + SIM_OVERHEAD;
+	if (sim.jitter != 0U)
+	{
+		sim.ccount += (uint32_t)rand() % sim.jitter;
+	}
+	return sim.ccount - start;
+}
+
+static uint32_t sim_broken(uint32_t delay, uint32_t cycles)
+{
+	(void)delay;
+	return cycles * sim.slow;
+}
+
+static int sweep(void)
+{
+	uint32_t clock, delay, actual, real;
+	uint8_t fast;
+	double error, worst = 0.0;
+	int checked = 0, failed = 0;
+
+	for (clock = 10000U; clock <= 80000000U; clock += (clock / 16U))
+	{
+		if (!swd_clock_lookup(clock, &delay, &fast, &actual))
+		{
+			printf("%u Hz: lookup failed\n", clock);
+			return 1;
+		}
+
+		real = (uint32_t)((uint64_t)sim.cpu_clock / sim_period(fast, delay));
+		error = ((double)actual - real) / real;
+		if (error < 0)
+		{
+			error = -error;
+		}
+		if (error > worst)
+		{
+			worst = error;
+		}
+
+		// Only the fastest slow delay may overshoot, nothing is faster below the fast path
+		if ((error > SIM_TOLERANCE) ||
+		    (!fast && (delay > 1U) && (real > clock + (uint32_t)(clock * SIM_TOLERANCE))))
+		{
+			printf("%u Hz: %s delay %u reports %u Hz, generates %u Hz\n", clock,
+			       fast ? "fast" : "slow", delay, actual, real);
+			failed++;
+		}
+		else if (sim.verbose)
+		{
+			printf("%9u Hz: %s delay %5u -> %9u Hz (reported %9u Hz)\n", clock,
+			       fast ? "fast" : "slow", delay, real, actual);
+		}
+		checked++;
+	}
+
+	printf("%d frequencies, %d failed, worst error %.3f%%\n", checked, failed, worst * 100.0);
+	return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t delay, actual, before;
+	uint8_t fast;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "c:f:s:k:j:v")) != -1)
+	{
+		switch (opt)
+		{
+		case 'c':
+			sim.cpu_clock = (uint32_t)strtoul(optarg, NULL, 0) * 1000000U;
+			break;
+		case 'f':
+			sim.fast = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			sim.slow = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'k':
+			sim.loop = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			sim.jitter = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'v':
+			sim.verbose = 1;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-c cpu_mhz] [-f fast] [-s slow] [-k loop] [-j jitter] [-v]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if ((sim.cpu_clock == 0U) || (sim.fast == 0U) || (sim.loop == 0U) || (sim.slow <= sim.fast))
+	{
+		fprintf(stderr, "need cpu_mhz, fast, loop > 0 and slow > fast\n");
+		return 2;
+	}
+
+	if (swd_clock_lookup(1000000U, &delay, &fast, &actual))
+	{
+		printf("lookup succeeded before calibration\n");
+		return 1;
+	}
+
+	if (!swd_clock_calibrate(sim_measure, sim.cpu_clock))
+	{
+		printf("calibration failed\n");
+		return 1;
+	}
+
+	// A broken measurement is rejected and the table stays as it was
+	swd_clock_lookup(1000000U, &delay, &fast, &before);
+	if (swd_clock_calibrate(sim_broken, sim.cpu_clock) ||
+	    !swd_clock_lookup(1000000U, &delay, &fast, &actual) || (actual != before))
+	{
+		printf("non-monotonic measurement changed the table\n");
+		return 1;
+	}
+
+	return sweep();
+}
@@ -0,0 +1,725 @@
+/**
+ * @file    swosim.c
+ * @brief   Manchester SWO decoder against synthetic and recorded edge streams
+ *
+ * usage: swosim [-n packets] [-s seed] [-r capture.csv [-b baud]] [-w capture.csv]
+ *
+ * Without -r, trace packets are Manchester encoded at bit rates from
+ * RMT_MIN_BAUD to RMT_MAX_BAUD with edge jitter, drift, bit rate changes,
+ * glitches and back-to-back bursts. They go through a model of the RMT
+ * receiver as SWO.c sets it up (glitch filter, idle threshold, 15-bit
+ * durations, buffers of RMT_SYMBOLS, full buffers dropped) and are decoded
+ * frame by frame with the decoder buffer of the SWO thread. Every packet
+ * that reaches the decoder intact must come out byte exact; damaged ones
+ * may be lost, but the packets after them must not. -w saves the clean
+ * stream at -b baud as a capture.
+ *
+ * -r decodes a logic analyser export: CSV lines "time in seconds,level",
+ * one per edge or per sample, other lines are skipped. The bytes are
+ * printed in hex. -b sets the expected bit rate, 0 detects it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "swo_manchester.h"
+#include "sim.h"
+
+// As in SWO.c
+#define RMT_RESOLUTION  80000000U   // RMT tick rate (12.5 ns)
+#define RMT_SYMBOLS     1024U       // Edge pairs per receive buffer
+#define RMT_MIN_BAUD    10000U
+#define RMT_MAX_BAUD    10000000U
+
+#define MAX_PACKET      64U         // bytes per packet
+
+typedef struct
+{
+	double ticks;
+	uint8_t level;
+	uint8_t glitch;
+	int32_t packet;                 // packet the run belongs to, -1 = idle
+} run_t;
+
+typedef struct
+{
+	uint32_t offset;                // first byte in sent[]
+	uint8_t size;
+	uint8_t damaged;
+} packet_t;
+
+typedef struct
+{
+	uint32_t half_ticks;            // nominal half bit for swo_manchester_init
+	uint32_t min_ticks;             // glitch filter
+	uint32_t max_ticks;             // idle threshold, ends a frame
+} rmt_t;
+
+static run_t *runs;
+static uint32_t run_count, run_size;
+static packet_t *packets;
+static uint32_t packet_count;
+static uint8_t *sent, *received;
+static uint32_t sent_count, received_count, received_size;
+static uint32_t frames, frames_dropped;
+
+static uint32_t failed;
+static uint32_t checked;                // streams verified
+
+// Uniform in [lo, hi)
+static double rndf(double lo, double hi)
+{
+	return lo + (hi - lo) * (double)rnd(1000000) / 1000000.0;
+}
+
+static void *grow(void *p, uint32_t *size, uint32_t need, size_t item)
+{
+	if (need > *size)
+	{
+		*size = (need < 1024U) ? 1024U : need * 2U;
+		p = realloc(p, *size * item);
+		if (p == NULL)
+		{
+			fprintf(stderr, "out of memory\n");
+			exit(2);
+		}
+	}
+	return p;
+}
+
+// Append a run, merging with the previous one at the same level
+static void emit(uint8_t level, double ticks, int32_t packet, uint8_t glitch)
+{
+	if ((run_count != 0U) && (runs[run_count - 1U].level == level) && !glitch && !runs[run_count - 1U].glitch)
+	{
+		runs[run_count - 1U].ticks += ticks;
+		return;
+	}
+	runs = grow(runs, &run_size, run_count + 1U, sizeof(*runs));
+	runs[run_count].ticks = ticks;
+	runs[run_count].level = level;
+	runs[run_count].glitch = glitch;
+	runs[run_count].packet = packet;
+	run_count++;
+}
+
+static void stream_reset(void)
+{
+	run_count = 0;
+	packet_count = 0;
+	sent_count = 0;
+	received_count = 0;
+	frames = 0;
+	frames_dropped = 0;
+	emit(0, 1000.0, -1, 0);         // idle low before the first packet
+}
+
+// Manchester encode one packet followed by idle_halves of low line.
+//   half:   half bit in ticks; jitter: relative edge jitter; drift: relative rate change over the packet
+static void encode_packet(const uint8_t *data, uint32_t size, double half, double jitter, double drift,
+                          double idle_halves)
+{
+	uint32_t id = packet_count, i, k, slots = 2U + size * 16U, slot = 0;
+	double h;
+
+	packets = realloc(packets, (packet_count + 1U) * sizeof(*packets));
+	sent = realloc(sent, sent_count + size);
+	if ((packets == NULL) || (sent == NULL))
+	{
+		exit(2);
+	}
+	packets[id].offset = sent_count;
+	packets[id].size = (uint8_t)size;
+	packets[id].damaged = 0;
+	memcpy(&sent[sent_count], data, size);
+	sent_count += size;
+	packet_count++;
+
+	for (i = 0; i < 1U + size * 8U; i++)
+	{
+		// Start bit (1), then data LSB first: 1 = high/low, 0 = low/high
+		uint8_t bit = (i == 0U) ? 1U : (uint8_t)((data[(i - 1U) >> 3] >> ((i - 1U) & 7U)) & 1U);
+		for (k = 0; k < 2U; k++, slot++)
+		{
+			h = half * (1.0 + drift * (double)slot / (double)slots) * (1.0 + rndf(-jitter, jitter));
+			emit((uint8_t)(k ? !bit : bit), h, (int32_t)id, 0);
+		}
+	}
+	emit(0, half * idle_halves, (int32_t)id, 0);
+}
+
+// Short pulse of the other level inside a random run of a random packet
+static void add_glitch(double ticks)
+{
+	uint32_t i, n = run_count;
+	run_t *r;
+	double before;
+
+	for (i = 0; i < 100U; i++)
+	{
+		r = &runs[rnd(n)];
+		if ((r->packet >= 0) && !r->glitch && (r->ticks > ticks * 4.0))
+		{
+			break;
+		}
+	}
+	if (i == 100U)
+	{
+		return;
+	}
+
+	runs = grow(runs, &run_size, run_count + 2U, sizeof(*runs));
+	r = &runs[r - runs];
+	memmove(r + 3, r + 1, (size_t)(run_count - (uint32_t)(r - runs) - 1U) * sizeof(*runs));
+	run_count += 2U;
+	before = r->ticks * rndf(0.25, 0.75) - ticks / 2.0;
+	r[2] = r[0];
+	r[2].ticks = r->ticks - before - ticks;
+	r[0].ticks = before;
+	r[1].level = (uint8_t)!r->level;
+	r[1].ticks = ticks;
+	r[1].glitch = 1;
+	r[1].packet = r->packet;
+}
+
+static rmt_t rmt_setup(uint32_t baud)
+{
+	uint32_t half_ns = 1000000000U / 2U / baud;
+	uint32_t min_ns = (half_ns / 4U < 3000U) ? (half_ns / 4U) : 3000U;
+	rmt_t rmt;
+
+	// signal_range_min_ns / signal_range_max_ns as set by SWO.c
+	rmt.half_ticks = RMT_RESOLUTION / 2U / baud;
+	rmt.min_ticks = (uint32_t)((uint64_t)min_ns * RMT_RESOLUTION / 1000000000U);
+	rmt.max_ticks = (uint32_t)((uint64_t)half_ns * 4U * RMT_RESOLUTION / 1000000000U);
+	return rmt;
+}
+
+static void mark_damaged(int32_t packet)
+{
+	if (packet >= 0)
+	{
+		packets[packet].damaged = 1;
+	}
+}
+
+static void decode_frame(swo_manchester_t *dec, const uint32_t *symbols, uint32_t count)
+{
+	// The buffer of Manchester_Thread
+	static uint8_t data[RMT_SYMBOLS / 2U];
+	uint32_t dropped = dec->dropped, num;
+
+	frames++;
+	num = swo_manchester_decode(dec, symbols, count, data, sizeof(data));
+	if (dec->dropped != dropped)
+	{
+		printf("frame of %u symbols overflowed the decoder buffer\n", count);
+		failed++;
+	}
+	if (num != 0U)
+	{
+		received = grow(received, &received_size, received_count + num, 1);
+		memcpy(&received[received_count], data, num);
+		received_count += num;
+	}
+}
+
+// RMT receiver: pulses below min_ticks are filtered, a frame runs from the
+// first edge to a run longer than max_ticks (stored as a 0 duration), full
+// buffers are dropped by RMT_RecvDone and reception restarts at the next edge
+static void rmt_receive_all(const rmt_t *rmt, swo_manchester_t *dec)
+{
+	static uint32_t symbols[RMT_SYMBOLS];
+	uint32_t i, n = 0, count = 0, half = 0, ticks, start = 0;
+	double t = 0.0;
+	run_t *edges = malloc((run_count + 1U) * sizeof(*edges));
+
+	if (edges == NULL)
+	{
+		exit(2);
+	}
+
+	// Edges at tick resolution, filtered pulses extend the level before them
+	for (i = 0; i < run_count; i++)
+	{
+		ticks = (uint32_t)(t + runs[i].ticks + 0.5) - (uint32_t)(t + 0.5);
+		t += runs[i].ticks;
+		if ((n != 0U) && ((ticks < rmt->min_ticks) || (edges[n - 1U].level == runs[i].level)))
+		{
+			if ((ticks < rmt->min_ticks) && !runs[i].glitch)
+			{
+				mark_damaged(runs[i].packet);   // filtered next to a glitch, the edge moved
+			}
+			edges[n - 1U].ticks += ticks;
+			continue;
+		}
+		if (runs[i].glitch)
+		{
+			// May also look like a start bit in the idle line before the next packet
+			mark_damaged(runs[i].packet);
+			if ((uint32_t)runs[i].packet + 1U < packet_count)
+			{
+				mark_damaged(runs[i].packet + 1);
+			}
+		}
+		edges[n] = runs[i];
+		edges[n].ticks = ticks;
+		n++;
+	}
+
+	// The line is idle before the first edge
+	for (i = 1; i <= n; i++)
+	{
+		ticks = (i < n) ? (uint32_t)edges[i].ticks : 0U;
+		if (ticks > rmt->max_ticks)
+		{
+			ticks = 0;                  // idle: end of frame marker
+		}
+		if (half == 0U)
+		{
+			symbols[count] = SWO_MANCHESTER_SYMBOL(ticks, (i < n) ? edges[i].level : 0U, 0, 0);
+			half = 1;
+		}
+		else
+		{
+			symbols[count] |= SWO_MANCHESTER_SYMBOL(0, 0, ticks, (i < n) ? edges[i].level : 0U);
+			half = 0;
+			count++;
+		}
+
+		if (ticks == 0U)
+		{
+			decode_frame(dec, symbols, count + half);
+		}
+		else if (count == RMT_SYMBOLS)
+		{
+			// Buffer full: RMT_RecvDone drops the frame
+			frames_dropped++;
+			for (; start <= i; start++)
+			{
+				mark_damaged(edges[start].packet);
+			}
+			// The next frame starts inside a packet, resync takes the idle gap after it
+			if ((edges[i].packet >= 0) && ((uint32_t)edges[i].packet + 1U < packet_count))
+			{
+				mark_damaged(edges[i].packet + 1);
+			}
+		}
+		else
+		{
+			continue;
+		}
+		count = 0;
+		half = 0;
+		start = i + 1U;
+	}
+	free(edges);
+}
+
+// Every undamaged packet must appear in order and byte exact
+static void verify(const char *name)
+{
+	uint32_t p, pos = 0, at, found, lost = 0, damaged = 0;
+
+	checked++;
+	for (p = 0; p < packet_count; p++)
+	{
+		if (packets[p].damaged)
+		{
+			damaged++;
+			continue;
+		}
+		found = 0;
+		for (at = pos; at + packets[p].size <= received_count; at++)
+		{
+			if (memcmp(&received[at], &sent[packets[p].offset], packets[p].size) == 0)
+			{
+				found = 1;
+				pos = at + packets[p].size;
+				break;
+			}
+		}
+		if (!found)
+		{
+			lost++;
+		}
+	}
+	if (lost != 0U)
+	{
+		printf("%s: %u intact packets lost or corrupted\n", name, lost);
+		failed++;
+	}
+	printf("%s: %u packets, %u damaged, %u frames, %u dropped, %u bytes\n", name, packet_count, damaged, frames,
+	       frames_dropped, received_count);
+}
+
+static void random_packet(uint8_t *data, uint32_t *size)
+{
+	uint32_t i;
+
+	*size = 1U + rnd(MAX_PACKET);
+	for (i = 0; i < *size; i++)
+	{
+		data[i] = (uint8_t)rnd(256);
+	}
+}
+
+// Packets at one bit rate with jitter and drift, idle gaps in and beyond the frame threshold
+static void run_clean(uint32_t baud, uint32_t count, double jitter, uint32_t nominal)
+{
+	swo_manchester_t dec;
+	uint8_t data[MAX_PACKET];
+	uint32_t size, p, frame = 0;
+	rmt_t rmt = rmt_setup(baud);
+	char name[64];
+	double half = (double)RMT_RESOLUTION / 2.0 / (double)baud, idle;
+
+	stream_reset();
+	for (p = 0; p < count; p++)
+	{
+		random_packet(data, &size);
+		// Keep frames within a buffer: end the frame before a packet that might not fit
+		if ((run_count - frame + 3U + size * 16U) > 2U * RMT_SYMBOLS)
+		{
+			runs[run_count - 1U].ticks = (double)rmt.max_ticks * 1.25;
+			frame = run_count;
+		}
+		idle = rndf(3.5, 12.0);
+		encode_packet(data, size, half, jitter, rndf(-0.02, 0.02), idle);
+		if (idle * half > (double)rmt.max_ticks * 1.1)
+		{
+			frame = run_count;
+		}
+	}
+	swo_manchester_init(&dec, nominal ? rmt.half_ticks : 0U);
+	rmt_receive_all(&rmt, &dec);
+	snprintf(name, sizeof(name), "%u baud%s", baud, nominal ? "" : ", detected");
+	verify(name);
+	if ((dec.errors != 0U) || (received_count != sent_count))
+	{
+		printf("%s: %u errors, %u of %u bytes\n", name, dec.errors, received_count, sent_count);
+		failed++;
+	}
+}
+
+// Bit rate changes between packets. With a nominal rate the RMT is set up
+// for it as by SWO.c, its idle threshold of 4 half bits ends frames inside
+// packets below half the nominal rate, so the rates stay within 0.6..3x.
+// Detection runs with the filter off and the threshold of the slowest rate.
+// The first packet at a new rate may be lost: one start bit cannot tell a
+// small rate change from edge jitter.
+static void run_rate_changes(uint32_t count, uint32_t nominal_baud)
+{
+	swo_manchester_t dec;
+	uint8_t data[MAX_PACKET];
+	uint32_t size, p, baud, change, changes = 0;
+	rmt_t rmt = rmt_setup(nominal_baud ? nominal_baud : RMT_MIN_BAUD);
+	const char *name = nominal_baud ? "rate changes around the nominal rate" : "rate changes, detected";
+	double half = 0.0;
+
+	if (!nominal_baud)
+	{
+		rmt.min_ticks = 1U;
+	}
+	stream_reset();
+	for (p = 0; p < count; p++)
+	{
+		random_packet(data, &size);
+		change = (p == 0U) || (rnd(4) == 0U);
+		if (change)
+		{
+			baud = nominal_baud ? (uint32_t)((double)nominal_baud * rndf(0.6, 3.0)) :
+			                      RMT_MIN_BAUD + rnd(RMT_MAX_BAUD / 4U);
+			half = (double)RMT_RESOLUTION / 2.0 / (double)baud;
+			changes++;
+		}
+		// Idle beyond the threshold: every packet is a frame
+		encode_packet(data, size, half, 0.05, 0.0, (double)rmt.max_ticks * 1.25 / half);
+		if (change)
+		{
+			packets[p].damaged = 1;
+		}
+	}
+	swo_manchester_init(&dec, nominal_baud ? rmt.half_ticks : 0U);
+	rmt_receive_all(&rmt, &dec);
+	verify(name);
+	if (dec.errors > changes)
+	{
+		printf("%s: %u errors after %u changes\n", name, dec.errors, changes);
+		failed++;
+	}
+}
+
+// Glitches below and above the RMT filter
+static void run_glitches(uint32_t baud, uint32_t count)
+{
+	swo_manchester_t dec;
+	uint8_t data[MAX_PACKET];
+	uint32_t size, p;
+	rmt_t rmt = rmt_setup(baud);
+	double half = (double)RMT_RESOLUTION / 2.0 / (double)baud;
+
+	stream_reset();
+	for (p = 0; p < count; p++)
+	{
+		random_packet(data, &size);
+		encode_packet(data, size, half, 0.08, 0.0, rndf(3.5, 12.0));
+	}
+	for (p = 0; p < count / 2U; p++)
+	{
+		add_glitch((rnd(2) != 0U) ? rndf(0.1, 0.8) * rmt.min_ticks : rndf(1.5, 3.0) * rmt.min_ticks);
+	}
+	swo_manchester_init(&dec, rmt.half_ticks);
+	rmt_receive_all(&rmt, &dec);
+	verify("glitches");
+}
+
+// Bursts without a frame-ending gap overflow the RMT buffer
+static void run_bursts(uint32_t baud, uint32_t count)
+{
+	swo_manchester_t dec;
+	uint8_t data[MAX_PACKET];
+	uint32_t size, p;
+	rmt_t rmt = rmt_setup(baud);
+	double half = (double)RMT_RESOLUTION / 2.0 / (double)baud;
+
+	stream_reset();
+	for (p = 0; p < count; p++)
+	{
+		random_packet(data, &size);
+		encode_packet(data, size, half, 0.05, 0.0, (rnd(16) != 0U) ? 3.5 : 10.0);
+	}
+	swo_manchester_init(&dec, rmt.half_ticks);
+	rmt_receive_all(&rmt, &dec);
+	verify("bursts");
+	if ((frames_dropped == 0U) && (count >= 100U))
+	{
+		printf("bursts: no frame overflowed\n");
+		failed++;
+	}
+}
+
+// Capture: "time,level" per line
+static int capture_write(const char *path, uint32_t baud)
+{
+	FILE *f = fopen(path, "w");
+	double t = 0.0;
+	uint32_t i;
+
+	if (f == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	fprintf(f, "Time [s],Channel 0\n");
+	for (i = 0; i < run_count; i++)
+	{
+		fprintf(f, "%.10f,%u\n", t / RMT_RESOLUTION, runs[i].level);
+		t += runs[i].ticks;
+	}
+	fprintf(f, "%.10f,0\n", t / RMT_RESOLUTION);
+	fclose(f);
+	printf("%u edges at %u baud written to %s\n", run_count, baud, path);
+	return 1;
+}
+
+static int capture_read(FILE *f)
+{
+	char line[256];
+	double t, last = -1.0;
+	unsigned level, prev = 0;
+
+	run_count = 0;
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		if (sscanf(line, "%lf,%u", &t, &level) != 2)
+		{
+			continue;
+		}
+		if (last >= 0.0)
+		{
+			if (t < last)
+			{
+				return 0;
+			}
+			emit((uint8_t)(prev != 0U), (t - last) * RMT_RESOLUTION, -1, 0);
+		}
+		last = t;
+		prev = level;
+	}
+	emit(0, 1e9, -1, 0);            // idle to the end
+	return run_count > 1U;
+}
+
+static int decode_capture(const char *path, uint32_t baud)
+{
+	swo_manchester_t dec;
+	FILE *f = fopen(path, "r");
+	rmt_t rmt = rmt_setup(baud ? baud : RMT_MIN_BAUD);
+	uint32_t i;
+
+	if (f == NULL)
+	{
+		perror(path);
+		return 2;
+	}
+	if (!baud)
+	{
+		rmt.min_ticks = 1U;             // detection: any rate, filter off
+	}
+	received_count = 0;
+	if (!capture_read(f))
+	{
+		fclose(f);
+		fprintf(stderr, "%s: no edges\n", path);
+		return 2;
+	}
+	fclose(f);
+	swo_manchester_init(&dec, baud ? rmt.half_ticks : 0U);
+	rmt_receive_all(&rmt, &dec);
+	for (i = 0; i < received_count; i++)
+	{
+		printf("%02X%c", received[i], ((i & 15U) == 15U) ? '\n' : ' ');
+	}
+	if (received_count & 15U)
+	{
+		printf("\n");
+	}
+	printf("%u bytes, %u packets, %u errors, %u frames, %u dropped\n", received_count, dec.packets, dec.errors,
+	       frames, frames_dropped);
+	return 0;
+}
+
+// Decoder rate on a stream with a run per half bit, as needed at RMT_MAX_BAUD
+static void benchmark(void)
+{
+	static uint32_t symbols[RMT_SYMBOLS];
+	static uint8_t data[RMT_SYMBOLS / 2U];
+	swo_manchester_t dec;
+	uint32_t n, bits = 0, half = RMT_RESOLUTION / 2U / RMT_MAX_BAUD;
+	uint64_t total = 0;
+	clock_t start, stop;
+
+	// Start bit, then alternating 0x55 bytes: every run is one half bit
+	for (n = 0; n < RMT_SYMBOLS - 1U; n++)
+	{
+		symbols[n] = SWO_MANCHESTER_SYMBOL(half, 1, half, 0);
+	}
+	symbols[n] = SWO_MANCHESTER_SYMBOL(0, 0, 0, 0);
+
+	swo_manchester_init(&dec, half);
+	start = clock();
+	do
+	{
+		for (n = 0; n < 256U; n++)
+		{
+			bits += swo_manchester_decode(&dec, symbols, RMT_SYMBOLS, data, sizeof(data));
+		}
+		total += 256U * RMT_SYMBOLS;
+		stop = clock();
+	} while ((stop - start) < CLOCKS_PER_SEC / 4);
+	printf("decoder: %.1f M symbols/s on this host (%u bytes), %u M needed at %u baud\n",
+	       (double)total / ((double)(stop - start) / CLOCKS_PER_SEC) / 1e6, bits, RMT_MAX_BAUD / 1000000U,
+	       RMT_MAX_BAUD);
+}
+
+int main(int argc, char **argv)
+{
+	static const uint32_t rates[] = {RMT_MIN_BAUD, 115200U, 1000000U, 2000000U, 4000000U, 6000000U, RMT_MAX_BAUD};
+	const char *record = NULL, *write = NULL;
+	uint32_t count, baud = 0, i;
+	sim_args_t args;
+	FILE *f;
+	int opt;
+
+	sim_args_init(&args, 500);
+	while ((opt = getopt(argc, argv, SIM_OPTIONS "r:b:w:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'r':
+				record = optarg;
+				break;
+			case 'b':
+				baud = (uint32_t)strtoul(optarg, NULL, 0);
+				break;
+			case 'w':
+				write = optarg;
+				break;
+			default:
+				if (!sim_option(&args, opt, optarg))
+				{
+					fprintf(stderr, "usage: %s [-n packets] [-s seed] [-r capture.csv [-b baud]] [-w capture.csv]\n",
+					        argv[0]);
+					return 2;
+				}
+				break;
+		}
+	}
+	count = args.count;
+	if ((baud != 0U) && ((baud < RMT_MIN_BAUD) || (baud > RMT_MAX_BAUD)))
+	{
+		fprintf(stderr, "bit rate %u to %u\n", RMT_MIN_BAUD, RMT_MAX_BAUD);
+		return 2;
+	}
+	if (record != NULL)
+	{
+		return decode_capture(record, baud);
+	}
+
+	sim_seed(args.seed);
+	printf("seed %u\n", args.seed);
+
+	// Edge jitter of 10 %, at RMT_MAX_BAUD the 12.5 ns tick alone is 1/4 half bit
+	for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+	{
+		run_clean(rates[i], count, (rates[i] < RMT_MAX_BAUD) ? 0.10 : 0.0, 1);
+	}
+	run_clean(1000000U, count, 0.12, 0);
+	run_rate_changes(count, 0);
+	run_rate_changes(count, 2000000U);
+	run_glitches(1000000U, count);
+	run_bursts(4000000U, count);
+
+	// Write the clean stream and read it back like a recording
+	run_clean(baud ? baud : 2000000U, count, 0.1, 1);
+	f = tmpfile();
+	if (f != NULL)
+	{
+		double t = 0.0;
+		uint32_t sent_bytes = sent_count;
+		swo_manchester_t dec;
+		rmt_t rmt = rmt_setup(baud ? baud : 2000000U);
+
+		for (i = 0; i < run_count; i++)
+		{
+			fprintf(f, "%.10f,%u\n", t / RMT_RESOLUTION, runs[i].level);
+			t += runs[i].ticks;
+		}
+		rewind(f);
+		received_count = 0;
+		frames = frames_dropped = 0;
+		if (capture_read(f))
+		{
+			swo_manchester_init(&dec, rmt.half_ticks);
+			rmt_receive_all(&rmt, &dec);
+		}
+		fclose(f);
+		checked++;
+		if ((received_count != sent_bytes) || (memcmp(received, sent, sent_bytes) != 0))
+		{
+			printf("capture round trip: %u of %u bytes\n", received_count, sent_bytes);
+			failed++;
+		}
+	}
+	if (write != NULL)
+	{
+		run_clean(baud ? baud : 2000000U, count, 0.1, 1);
+		capture_write(write, baud ? baud : 2000000U);
+	}
+
+	benchmark();
+	return sim_report(checked, "streams", failed);
+}